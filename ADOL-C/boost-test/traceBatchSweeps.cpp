@@ -0,0 +1,171 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adolc.h>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(trace_batch_sweeps)
+
+/* The tests in this file compare the drivers evaluating a tape at many
+ * points at once with the drivers evaluating it point by point. The number
+ * of points exceeds a single block of DIRCHUNKSIZE bytes.
+ */
+
+static const short batchTag = 17;
+static const int batchN = 4;
+static const int batchPoints = 2500;
+
+static void fillPoints(double **X, double shift) {
+  for (int k = 0; k < batchPoints; ++k)
+    for (int i = 0; i < batchN; ++i)
+      X[k][i] =
+          0.3 + 0.5 * (i + 1) * (1.0 + k % 7) / 7.0 + shift * k / batchPoints;
+}
+
+/* all operations the batch sweeps evaluate themselves */
+static void traceSmoothFunction(const double *x, double *y) {
+  adouble ax[batchN], ay[2], t;
+
+  trace_on(batchTag);
+  for (int i = 0; i < batchN; ++i)
+    ax[i] <<= x[i];
+  t = ax[0] * ax[1] / ax[2] - 2.0 / ax[3] + pow(ax[0], 2.5);
+  t += sin(ax[1]) * cos(ax[2]) + exp(ax[3] / 3.0) + log(ax[0]);
+  t *= sqrt(ax[1]) - cbrt(ax[2]) + atan(ax[3]);
+  t -= asin(ax[0] / 4.0) * acos(ax[1] / 4.0) + asinh(ax[2]);
+  t += acosh(ax[3] + 1.0) * atanh(ax[0] / 5.0) + erf(ax[1]) * erfc(ax[2]);
+  t *= t;
+  t /= 3.0 - ax[0];
+  ay[0] = -t + (ax[0] - 1.0) * 4.0;
+  ay[1] = ax[3];
+  ay[1] *= ax[2] + 1.0;
+  ay[1] = 5.0 - ay[1];
+  ay[0] >>= y[0];
+  ay[1] >>= y[1];
+  trace_off();
+}
+
+BOOST_AUTO_TEST_CASE(ZosForwardBatch_Values) {
+  double **X = myalloc2(batchPoints, batchN);
+  double **Y = myalloc2(batchPoints, 2);
+  double y[2];
+
+  fillPoints(X, 1.0);
+  traceSmoothFunction(X[0], y);
+  BOOST_TEST(zos_forward_batch(batchTag, 2, batchN, batchPoints, X, Y) == 3);
+  for (int k = 0; k < batchPoints; ++k) {
+    BOOST_TEST(zos_forward(batchTag, 2, batchN, 0, X[k], y) == 3);
+    BOOST_TEST(Y[k][0] == y[0], tt::tolerance(tol));
+    BOOST_TEST(Y[k][1] == y[1], tt::tolerance(tol));
+  }
+
+  myfree2(X);
+  myfree2(Y);
+}
+
+BOOST_AUTO_TEST_CASE(GradientBatch_Values) {
+  double **X = myalloc2(batchPoints, batchN);
+  double **G = myalloc2(batchPoints, batchN);
+  double y, g[batchN];
+  adouble ax[batchN], ay;
+
+  fillPoints(X, -0.2);
+  trace_on(batchTag);
+  for (int i = 0; i < batchN; ++i)
+    ax[i] <<= X[0][i];
+  ay = ax[0] * ax[1] / ax[2] + pow(ax[3], 3.0) - 2.0 / ax[1];
+  ay *= sin(ax[0]) + cos(ax[1] * ax[2]) + exp(-ax[3]);
+  ay += sqrt(ax[0] + ax[3]) * log(ax[2]) - atan(ax[1]) * erf(ax[0]);
+  ay -= ax[0];
+  ay >>= y;
+  trace_off();
+
+  BOOST_TEST(gradient_batch(batchTag, batchN, batchPoints, X, G) == 3);
+  for (int k = 0; k < batchPoints; ++k) {
+    BOOST_TEST(gradient(batchTag, batchN, X[k], g) == 3);
+    for (int i = 0; i < batchN; ++i)
+      BOOST_TEST(G[k][i] == g[i], tt::tolerance(tol));
+  }
+
+  myfree2(X);
+  myfree2(G);
+}
+
+BOOST_AUTO_TEST_CASE(Batch_SwitchedComparisons) {
+  double **X = myalloc2(batchPoints, batchN);
+  double **Y = myalloc2(batchPoints, 1);
+  double **G = myalloc2(batchPoints, batchN);
+  double y, g[batchN];
+  adouble ax[batchN], ay;
+
+  fillPoints(X, 1.0);
+  /* the branch switches at the last points only */
+  const int numTaken = batchPoints - 3;
+  for (int k = numTaken; k < batchPoints; ++k)
+    X[k][0] = -X[k][0];
+
+  trace_on(batchTag);
+  for (int i = 0; i < batchN; ++i)
+    ax[i] <<= X[0][i];
+  if (ax[0] > 0)
+    ay = ax[0] * ax[1] + ax[2];
+  else
+    ay = ax[2] - ax[3];
+  ay >>= y;
+  trace_off();
+
+  BOOST_TEST(zos_forward_batch(batchTag, 1, batchN, batchPoints, X, Y) == -1);
+  BOOST_TEST(gradient_batch(batchTag, batchN, batchPoints, X, G) == -1);
+  /* the sweeps stop at the switched points */
+  for (int k = 0; k < numTaken; ++k) {
+    BOOST_TEST(zos_forward(batchTag, 1, batchN, 0, X[k], &y) >= 0);
+    BOOST_TEST(gradient(batchTag, batchN, X[k], g) >= 0);
+    BOOST_TEST(Y[k][0] == y, tt::tolerance(tol));
+    for (int i = 0; i < batchN; ++i)
+      BOOST_TEST(G[k][i] == g[i], tt::tolerance(tol));
+  }
+
+  myfree2(X);
+  myfree2(Y);
+  myfree2(G);
+}
+
+BOOST_AUTO_TEST_CASE(Batch_PointwiseFallback) {
+  const int numPoints = 9;
+  double **X = myalloc2(numPoints, batchN);
+  double **Y = myalloc2(numPoints, 1);
+  double **G = myalloc2(numPoints, batchN);
+  double y, g[batchN];
+  adouble ax[batchN], ay;
+
+  for (int k = 0; k < numPoints; ++k)
+    for (int i = 0; i < batchN; ++i)
+      X[k][i] = 0.25 * (k - 4) + 0.1 * i;
+
+  /* fmax is not evaluated by the batch sweeps */
+  trace_on(batchTag);
+  for (int i = 0; i < batchN; ++i)
+    ax[i] <<= X[0][i];
+  ay = fmax(ax[0] * ax[1], ax[2]) + ax[3] * ax[3];
+  ay >>= y;
+  trace_off();
+
+  int rc = zos_forward_batch(batchTag, 1, batchN, numPoints, X, Y);
+  BOOST_TEST(rc == gradient_batch(batchTag, batchN, numPoints, X, G));
+  for (int k = 0; k < numPoints; ++k) {
+    zos_forward(batchTag, 1, batchN, 0, X[k], &y);
+    BOOST_TEST(gradient(batchTag, batchN, X[k], g) >= 0);
+    BOOST_TEST(Y[k][0] == y);
+    for (int i = 0; i < batchN; ++i)
+      BOOST_TEST(G[k][i] == g[i]);
+  }
+
+  myfree2(X);
+  myfree2(Y);
+  myfree2(G);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,157 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adolc.h>
+
+#include <cmath>
+#include <vector>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(trace_checkpointing)
+
+/* The tests in this file compute the gradient of a time stepping process
+ * with the checkpointing facility for all kinds of checkpoint storage, with
+ * the sequential and the parallel reverse schedule, and compare it with the
+ * gradient of the fully taped process.
+ */
+
+static const short cpFullTag = 25;
+static const short cpPartTag = 26;
+static const short cpStepTag = 27;
+static const int cpN = 40;
+static const int cpSteps = 60;
+
+static int stepPassive(int n, double *y) {
+  std::vector<double> z(y, y + n);
+
+  for (int i = 0; i < n; ++i)
+    y[i] = z[i] + 0.01 * (std::sin(z[(i + n - 1) % n]) * z[(i + 1) % n] -
+                          0.5 * z[i]);
+  return 1;
+}
+
+static int stepActive(int n, adouble *y) {
+  std::vector<adouble> z(n);
+
+  for (int i = 0; i < n; ++i)
+    z[i] = y[i];
+  for (int i = 0; i < n; ++i)
+    y[i] = z[i] + 0.01 * (sin(z[(i + n - 1) % n]) * z[(i + 1) % n] -
+                          0.5 * z[i]);
+  return 1;
+}
+
+static void fullGradient(const double *x, double *grad) {
+  std::vector<adouble> ay(cpN);
+  adouble af;
+  double f;
+
+  trace_on(cpFullTag);
+  for (int i = 0; i < cpN; ++i)
+    ay[i] <<= x[i];
+  for (int s = 0; s < cpSteps; ++s)
+    stepActive(cpN, ay.data());
+  af = 0.0;
+  for (int i = 0; i < cpN; ++i)
+    af += ay[i] * ay[i];
+  af >>= f;
+  trace_off();
+
+  gradient(cpFullTag, cpN, x, grad);
+}
+
+static void traceCheckpointed(const double *x, int storage, int ramCheckpoints,
+                              bool parallel, bool retaping) {
+  /* the checkpointing addresses the state by its first location */
+  std::vector<adouble> ax(cpN);
+  ensureContiguousLocations(cpN);
+  std::vector<adouble> ay(cpN);
+  adouble af;
+  double f;
+
+  CP_Context cpc(stepActive);
+  cpc.setDoubleFct(stepPassive);
+  cpc.setNumberOfSteps(cpSteps);
+  cpc.setNumberOfCheckpoints(6);
+  cpc.setDimensionXY(cpN);
+  cpc.setInput(ay.data());
+  cpc.setOutput(ay.data());
+  cpc.setTapeNumber(cpStepTag);
+  cpc.setAlwaysRetaping(retaping);
+  cpc.setStorage(storage);
+  cpc.setNumberOfRamCheckpoints(ramCheckpoints);
+  cpc.setParallelReverse(parallel);
+
+  trace_on(cpPartTag, 1);
+  for (int i = 0; i < cpN; ++i) {
+    ax[i] <<= x[i];
+    ay[i] = ax[i];
+  }
+  cpc.checkpointing();
+  af = 0.0;
+  for (int i = 0; i < cpN; ++i)
+    af += ay[i] * ay[i];
+  af >>= f;
+  trace_off(1);
+}
+
+BOOST_AUTO_TEST_CASE(Checkpointing_Storages) {
+  const int storages[4][2] = {{ADOLC_CP_STORE_RAM, 0},
+                              {ADOLC_CP_STORE_COMPRESSED, 0},
+                              {ADOLC_CP_STORE_FILE, 0},
+                              {ADOLC_CP_STORE_FILE, 2}};
+  std::vector<double> x(cpN), ref(cpN), grad(cpN);
+
+  for (int i = 0; i < cpN; ++i)
+    x[i] = 0.5 + 0.02 * i;
+  fullGradient(x.data(), ref.data());
+
+  for (int s = 0; s < 4; ++s) {
+    traceCheckpointed(x.data(), storages[s][0], storages[s][1], false, false);
+    gradient(cpPartTag, cpN, x.data(), grad.data());
+    for (int i = 0; i < cpN; ++i)
+      BOOST_TEST(grad[i] == ref[i], tt::tolerance(tol));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Checkpointing_ParallelReverse) {
+  const int storages[3][2] = {{ADOLC_CP_STORE_RAM, 0},
+                              {ADOLC_CP_STORE_COMPRESSED, 0},
+                              {ADOLC_CP_STORE_FILE, 2}};
+  std::vector<double> x(cpN), ref(cpN), grad(cpN);
+  double **U = myalloc2(2, 1);
+  double **Z = myalloc2(2, cpN);
+  double f;
+
+  for (int i = 0; i < cpN; ++i)
+    x[i] = 0.4 + 0.03 * i;
+  fullGradient(x.data(), ref.data());
+  U[0][0] = 1.0;
+  U[1][0] = -2.0;
+
+  for (int s = 0; s < 3; ++s)
+    for (int retaping = 0; retaping < 2; ++retaping) {
+      traceCheckpointed(x.data(), storages[s][0], storages[s][1], true,
+                        retaping != 0);
+      gradient(cpPartTag, cpN, x.data(), grad.data());
+      for (int i = 0; i < cpN; ++i)
+        BOOST_TEST(grad[i] == ref[i], tt::tolerance(tol));
+
+      /* vector mode, the same sweep twice */
+      for (int rep = 0; rep < 2; ++rep) {
+        zos_forward(cpPartTag, 1, cpN, 1, x.data(), &f);
+        fov_reverse(cpPartTag, 1, cpN, 2, U, Z);
+        for (int i = 0; i < cpN; ++i) {
+          BOOST_TEST(Z[0][i] == ref[i], tt::tolerance(tol));
+          BOOST_TEST(Z[1][i] == -2.0 * ref[i], tt::tolerance(tol));
+        }
+      }
+    }
+  myfree2(U);
+  myfree2(Z);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
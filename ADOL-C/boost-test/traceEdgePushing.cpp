@@ -0,0 +1,141 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adolc.h>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(trace_edge_pushing)
+
+/* The tests in this file compare the sparse Hessian computed by edge pushing
+ * with the dense Hessian of the same tape. Every entry of the upper triangle
+ * that is nonzero in the dense Hessian has to be part of the sparse one, all
+ * entries of the sparse one have to agree with the dense one.
+ */
+
+static const short epTag = 18;
+
+static void checkEdgePushing(int n, const double *x) {
+  double **H = myalloc2(n, n);
+  unsigned int *rind = NULL, *cind = NULL;
+  double *values = NULL;
+  int nnz = 0, found = 0;
+
+  BOOST_TEST(hessian(epTag, n, x, H) >= 0);
+  BOOST_TEST(edge_push_hess(epTag, n, x, &nnz, &rind, &cind, &values) >= 0);
+
+  for (int k = 0; k < nnz; ++k) {
+    BOOST_TEST(rind[k] <= cind[k]);
+    BOOST_TEST((int)cind[k] < n);
+    if (k > 0)
+      BOOST_TEST((rind[k - 1] < rind[k] ||
+                  (rind[k - 1] == rind[k] && cind[k - 1] < cind[k])));
+    BOOST_TEST(values[k] == H[cind[k]][rind[k]], tt::tolerance(tol));
+  }
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j <= i; ++j)
+      if (H[i][j] != 0.0) {
+        bool inPattern = false;
+        for (int k = 0; k < nnz; ++k)
+          inPattern |= (int)rind[k] == j && (int)cind[k] == i;
+        BOOST_TEST(inPattern);
+        ++found;
+      }
+  BOOST_TEST(found > 0);
+
+  free(rind);
+  free(cind);
+  free(values);
+  myfree2(H);
+}
+
+BOOST_AUTO_TEST_CASE(EdgePushing_NetworkFunction) {
+  const int n = 24;
+  double x[n], y;
+  adouble ax[n], ay;
+
+  for (int i = 0; i < n; ++i)
+    x[i] = 0.4 + 0.05 * i;
+
+  /* every variable interacts with its neighbours and two distant nodes */
+  trace_on(epTag);
+  for (int i = 0; i < n; ++i)
+    ax[i] <<= x[i];
+  ay = 0.0;
+  for (int i = 0; i < n; ++i) {
+    const int j = (i + 1) % n, k = (i * 7 + 3) % n;
+    ay += ax[i] * ax[j] * sin(ax[k]) + exp(ax[i] - ax[j]) / ax[k];
+    ay += pow(ax[i], 3.0) * sqrt(ax[k]) - log(ax[j]) * atan(ax[i]);
+  }
+  ay += asin(ax[0] / 4.0) * erf(ax[1]) + acosh(ax[2] + 1.0) * cos(ax[3]);
+  ay += ax[4] * ax[4] + ax[5] / ax[5] + 2.0 / ax[6];
+  ay >>= y;
+  trace_off();
+
+  checkEdgePushing(n, x);
+}
+
+BOOST_AUTO_TEST_CASE(EdgePushing_InPlaceAndBranches) {
+  const int n = 6;
+  double x[n] = {0.9, -0.4, 1.3, 0.2, -1.1, 0.7}, y;
+  adouble ax[n], ay, t, u;
+
+  trace_on(epTag);
+  for (int i = 0; i < n; ++i)
+    ax[i] <<= x[i];
+  pdouble p = mkparam(1.5);
+  t = ax[0];
+  t *= ax[1];
+  t += ax[2] * ax[3];
+  t -= sin(ax[4]);
+  t /= ax[5];
+  t *= p;
+  u = fmax(ax[0] * ax[2], ax[1] * ax[3]) + fabs(ax[4] * ax[5]);
+  condassign(u, ax[1], u, u * ax[0]);
+  ay = t * t + u * ceil(ax[3]) + ax[2] * ax[2] * ax[2];
+  ay >>= y;
+  trace_off();
+
+  checkEdgePushing(n, x);
+}
+
+BOOST_AUTO_TEST_CASE(EdgePushing_ReusesArrays) {
+  const int n = 4;
+  double x[n] = {0.5, 1.5, -0.5, 2.0}, y;
+  adouble ax[n], ay;
+  unsigned int *rind = NULL, *cind = NULL;
+  double *values = NULL;
+  int nnz = 0;
+
+  trace_on(epTag);
+  for (int i = 0; i < n; ++i)
+    ax[i] <<= x[i];
+  ay = ax[0] * ax[1] + ax[2] * ax[2] * ax[3];
+  ay >>= y;
+  trace_off();
+
+  BOOST_TEST(edge_push_hess(epTag, n, x, &nnz, &rind, &cind, &values) >= 0);
+  /* (0,1), (2,2), (2,3) */
+  BOOST_TEST(nnz == 3);
+  unsigned int *const rindFirst = rind;
+  double *const valuesFirst = values;
+  x[3] = 3.0;
+  BOOST_TEST(edge_push_hess(epTag, n, x, &nnz, &rind, &cind, &values) >= 0);
+  BOOST_TEST(nnz == 3);
+  BOOST_TEST(rind == rindFirst);
+  BOOST_TEST(values == valuesFirst);
+  BOOST_TEST(values[0] == 1.0);
+  BOOST_TEST(values[1] == 6.0);
+  BOOST_TEST(values[2] == 2.0 * x[2]);
+
+  BOOST_TEST(edge_push_hess(epTag, n + 1, x, &nnz, &rind, &cind, &values) ==
+             -1);
+
+  free(rind);
+  free(cind);
+  free(values);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
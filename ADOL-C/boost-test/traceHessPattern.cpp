@@ -0,0 +1,140 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adolc.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(trace_hess_pattern)
+
+/* The tests in this file compare the Hessian sparsity patterns of the index
+ * graph with those of the IndexElement trees of nonl_ind_forward_*, and
+ * check that every nonzero of the dense Hessian is part of the pattern.
+ */
+
+static const short patTag = 21;
+
+static void freePattern(int n, unsigned int **crs) {
+  for (int i = 0; i < n; ++i)
+    free(crs[i]);
+}
+
+static void comparePatterns(int n, const double *x, bool tight) {
+  std::vector<unsigned int *> graph(n), trees(n);
+  double **H = myalloc2(n, n);
+
+  if (tight) {
+    BOOST_TEST(nonl_ind_graph_tight(patTag, 1, n, x, graph.data()) >= 0);
+    BOOST_TEST(nonl_ind_forward_tight(patTag, 1, n, x, trees.data()) >= 0);
+  } else {
+    BOOST_TEST(nonl_ind_graph_safe(patTag, 1, n, x, graph.data()) >= 0);
+    BOOST_TEST(nonl_ind_forward_safe(patTag, 1, n, x, trees.data()) >= 0);
+  }
+  hessian(patTag, n, x, H);
+
+  for (int i = 0; i < n; ++i) {
+    BOOST_TEST(graph[i][0] == trees[i][0]);
+    for (unsigned int k = 1; k <= graph[i][0] && k <= trees[i][0]; ++k)
+      BOOST_TEST(graph[i][k] == trees[i][k]);
+    for (unsigned int k = 2; k <= graph[i][0]; ++k)
+      BOOST_TEST(graph[i][k - 1] < graph[i][k]);
+    for (int j = 0; j <= i; ++j)
+      if (H[i][j] != 0.0) {
+        bool inPattern = false;
+        for (unsigned int k = 1; k <= graph[i][0]; ++k)
+          inPattern |= (int)graph[i][k] == j;
+        BOOST_TEST(inPattern);
+      }
+  }
+
+  freePattern(n, graph.data());
+  freePattern(n, trees.data());
+  myfree2(H);
+}
+
+BOOST_AUTO_TEST_CASE(HessPattern_ElementaryFunctions) {
+  const int n = 8;
+  double x[n] = {0.5, 1.2, -0.3, 0.8, 1.5, 2.0, -0.7, 0.25}, y;
+  adouble ax[n], ay, t;
+
+  trace_on(patTag);
+  for (int i = 0; i < n; ++i)
+    ax[i] <<= x[i];
+  t = ax[0] + 2.0 * ax[1];
+  t *= ax[2];
+  ay = t + sin(ax[3]) * cos(ax[4]) + exp(ax[5]) / ax[6];
+  ay += sqrt(ax[1]) + log(ax[5]) - atan(ax[7] - ax[0]) + 3.0 / ax[4];
+  ay += pow(ax[2], 3) + asin(ax[7]) + erf(ax[3]) * fabs(ax[6]);
+  ay -= ax[0] * ax[5] + ceil(ax[3]);
+  ay += ax[7] - ax[1];
+  ay >>= y;
+  trace_off();
+
+  comparePatterns(n, x, false);
+  comparePatterns(n, x, true);
+}
+
+BOOST_AUTO_TEST_CASE(HessPattern_Branches) {
+  const int n = 5;
+  double x[n] = {0.9, -0.4, 1.3, 0.2, -1.1}, y;
+  adouble ax[n], ay, u;
+
+  trace_on(patTag);
+  for (int i = 0; i < n; ++i)
+    ax[i] <<= x[i];
+  u = fmax(ax[0] * ax[1], ax[2] * ax[3]);
+  condassign(u, ax[4], u, u * ax[4]);
+  ay = u + fmin(ax[1], ax[4]) * ax[0];
+  ay >>= y;
+  trace_off();
+
+  /* the tight mode takes the branches of the tree based propagation */
+  comparePatterns(n, x, false);
+  comparePatterns(n, x, true);
+}
+
+BOOST_AUTO_TEST_CASE(HessPattern_PartiallySeparable) {
+  const int n = 2000;
+  std::vector<double> x(n);
+  std::vector<adouble> ax(n);
+  adouble ay;
+  double y;
+
+  for (int i = 0; i < n; ++i)
+    x[i] = 1.0 + 0.001 * i;
+
+  /* a long sum of element functions of three variables */
+  trace_on(patTag);
+  for (int i = 0; i < n; ++i)
+    ax[i] <<= x[i];
+  ay = 0.0;
+  for (int i = 1; i + 1 < n; ++i)
+    ay += ax[i - 1] * exp(ax[i]) + (ax[i] - ax[i + 1]) * (ax[i] - ax[i + 1]);
+  ay += sin(ax[0] + ax[n - 1]);
+  ay >>= y;
+  trace_off();
+
+  std::vector<unsigned int *> graph(n), trees(n);
+  BOOST_TEST(nonl_ind_graph_safe(patTag, 1, n, x.data(), graph.data()) >= 0);
+  BOOST_TEST(nonl_ind_forward_safe(patTag, 1, n, x.data(), trees.data()) >=
+             0);
+  for (int i = 0; i < n; ++i) {
+    BOOST_TEST(graph[i][0] == trees[i][0]);
+    for (unsigned int k = 1; k <= graph[i][0] && k <= trees[i][0]; ++k)
+      BOOST_TEST(graph[i][k] == trees[i][k]);
+  }
+  /* the row of an inner variable holds its two neighbours and itself */
+  BOOST_TEST(graph[n / 2][0] == 3u);
+  BOOST_TEST(graph[n / 2][1] == (unsigned int)(n / 2 - 1));
+  BOOST_TEST(graph[n / 2][3] == (unsigned int)(n / 2 + 1));
+
+  freePattern(n, graph.data());
+  freePattern(n, trees.data());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,107 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adolc.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(trace_jac_pattern)
+
+/* The tests in this file compare the Jacobian sparsity patterns of jac_pat
+ * for all ways of propagation with the serial propagation of index domains.
+ * The dimensions need several strips of bit patterns, which are distributed
+ * among the threads in builds with OpenMP.
+ */
+
+static const short jpTag = 22;
+
+static void traceBanded(int m, int n, const double *x) {
+  std::vector<adouble> ax(n), ay(m);
+  std::vector<double> y(m);
+
+  trace_on(jpTag);
+  for (int i = 0; i < n; ++i)
+    ax[i] <<= x[i];
+  for (int i = 0; i < m; ++i) {
+    const int j = i % n, k = (7 * i + 3) % n;
+    ay[i] = ax[j] * ax[(j + 1) % n] + sin(ax[k]);
+    ay[i] += fmax(ax[(j + 2) % n], ax[(j + 5) % n]);
+  }
+  for (int i = 0; i < m; ++i)
+    ay[i] >>= y[i];
+  trace_off();
+}
+
+static void freePattern(int m, unsigned int **crs) {
+  for (int i = 0; i < m; ++i)
+    free(crs[i]);
+}
+
+static void checkJacPatterns(int m, int n, const double *x) {
+  std::vector<unsigned int *> ref(m), pat(m);
+  const int ways[6][3] = {{0, 0, 0}, {0, 1, 0}, {1, 0, 1},
+                          {1, 1, 1}, {1, 0, 2}, {1, 1, 2}};
+
+  traceBanded(m, n, x);
+  BOOST_TEST(indopro_forward_safe(jpTag, m, n, x, ref.data()) >= 0);
+
+  for (int w = 0; w < 6; ++w) {
+    int options[3] = {ways[w][0], ways[w][1], ways[w][2]};
+    const bool tight = options[1] == 1;
+
+    BOOST_TEST(jac_pat(jpTag, m, n, x, pat.data(), options) >= 0);
+    for (int i = 0; i < m; ++i) {
+      const int j = i % n, k = (7 * i + 3) % n;
+      bool hasJ = false, hasK = false;
+      for (unsigned int l = 2; l <= pat[i][0]; ++l)
+        BOOST_TEST(pat[i][l - 1] < pat[i][l]);
+      for (unsigned int l = 1; l <= pat[i][0]; ++l) {
+        hasJ |= (int)pat[i][l] == j;
+        hasK |= (int)pat[i][l] == k;
+      }
+      BOOST_TEST(hasJ);
+      BOOST_TEST(hasK);
+      if (tight) {
+        /* the tight mode only keeps the larger argument of fmax */
+        BOOST_TEST(pat[i][0] + 1 >= ref[i][0]);
+        for (unsigned int l = 1; l <= pat[i][0]; ++l) {
+          bool inRef = false;
+          for (unsigned int r = 1; r <= ref[i][0]; ++r)
+            inRef |= pat[i][l] == ref[i][r];
+          BOOST_TEST(inRef);
+        }
+      } else {
+        BOOST_TEST(pat[i][0] == ref[i][0]);
+        for (unsigned int l = 1; l <= pat[i][0] && l <= ref[i][0]; ++l)
+          BOOST_TEST(pat[i][l] == ref[i][l]);
+      }
+    }
+    freePattern(m, pat.data());
+  }
+  freePattern(m, ref.data());
+}
+
+BOOST_AUTO_TEST_CASE(JacPattern_ForwardStrips) {
+  const int m = 300, n = 20000;
+  std::vector<double> x(n);
+
+  for (int i = 0; i < n; ++i)
+    x[i] = 1.0 + 0.001 * i;
+  checkJacPatterns(m, n, x.data());
+}
+
+BOOST_AUTO_TEST_CASE(JacPattern_ReverseStrips) {
+  const int m = 20000, n = 400;
+  std::vector<double> x(n);
+
+  for (int i = 0; i < n; ++i)
+    x[i] = 1.0 + 0.001 * i;
+  checkJacPatterns(m, n, x.data());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
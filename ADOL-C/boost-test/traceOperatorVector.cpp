@@ -3744,4 +3744,63 @@ BOOST_AUTO_TEST_CASE(CondeqassignOperator_FOV_Forward) {
   myfree2(yd);
 }
 
+/* The vector modes process the directions of the frequent operations in
+ * vectorized kernels, which have to agree exactly with the scalar modes for
+ * every direction, also for results sharing a location with an argument.
+ */
+BOOST_AUTO_TEST_CASE(VectorKernels_FOV_AgreeWithFOS) {
+  const int n = 3, m = 2, p = 13;
+  double x[n] = {0.7, -1.2, 0.4}, y[m], yScalar[m];
+  double xd[n], yd[m], u[m], z[n];
+  adouble ax[n], ay[m];
+
+  trace_on(1);
+  for (int i = 0; i < n; ++i)
+    ax[i] <<= x[i];
+  ay[0] = ax[0] * ax[0] - ax[1] * ax[2];
+  ay[0] = sin(ay[0]) + cos(ax[1]) * exp(ax[2]);
+  ay[0] += ax[0] * ax[1];
+  ay[0] -= ax[1] * ax[2];
+  ay[1] = ax[2] + ax[0];
+  ay[1] *= ay[1];
+  ay[0] >>= y[0];
+  ay[1] >>= y[1];
+  trace_off();
+
+  double **X = myalloc2(n, p);
+  double **Y = myalloc2(m, p);
+  double **U = myalloc2(p, m);
+  double **Z = myalloc2(p, n);
+  for (int l = 0; l < p; ++l) {
+    for (int i = 0; i < n; ++i)
+      X[i][l] = 0.5 * (l + 1) - 0.3 * i * l;
+    for (int j = 0; j < m; ++j)
+      U[l][j] = 1.0 + 0.25 * (l - 2 * j);
+  }
+
+  fov_forward(1, m, n, p, x, X, y, Y);
+  for (int l = 0; l < p; ++l) {
+    for (int i = 0; i < n; ++i)
+      xd[i] = X[i][l];
+    fos_forward(1, m, n, 0, x, xd, yScalar, yd);
+    for (int j = 0; j < m; ++j)
+      BOOST_TEST(Y[j][l] == yd[j]);
+  }
+
+  zos_forward(1, m, n, 1, x, y);
+  fov_reverse(1, m, n, p, U, Z);
+  for (int l = 0; l < p; ++l) {
+    for (int j = 0; j < m; ++j)
+      u[j] = U[l][j];
+    fos_reverse(1, m, n, u, z);
+    for (int i = 0; i < n; ++i)
+      BOOST_TEST(Z[l][i] == z[i]);
+  }
+
+  myfree2(X);
+  myfree2(Y);
+  myfree2(U);
+  myfree2(Z);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,365 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adolc.h>
+
+#include "const.h"
+
+#if defined(_OPENMP)
+#include <adolc/adolc_openmp.h>
+#endif
+
+BOOST_AUTO_TEST_SUITE(trace_parallel_sweeps)
+
+/* The tests in this file compare the drivers that distribute directions
+ * among threads with the serial drivers. Every direction is evaluated by a
+ * complete sweep of its own, hence both have to agree exactly, no matter
+ * whether ADOL-C was built with OpenMP or not.
+ */
+
+static const short parallelTag = 15;
+static const short parallelDiskTag = 16;
+static const short parallelTensorTag = 28;
+static const int parallelN = 6;
+static const int parallelM = 3;
+
+static void traceParallelFunction(const double *x, double *y) {
+  adouble ax[parallelN], ay[parallelM];
+
+  trace_on(parallelTag);
+  for (int i = 0; i < parallelN; ++i)
+    ax[i] <<= x[i];
+  for (int j = 0; j < parallelM; ++j) {
+    ay[j] = 0.0;
+    for (int i = 0; i < parallelN; ++i)
+      ay[j] += sin(ax[i] * (1.0 + j)) * ax[(i + j + 1) % parallelN];
+    ay[j] += exp(ax[j] / (2.0 + j));
+    ay[j] >>= y[j];
+  }
+  trace_off();
+}
+
+BOOST_AUTO_TEST_CASE(FovReverseMT_AllChunkings) {
+  double x[parallelN] = {0.4, -1.1, 0.9, 1.3, -0.2, 0.6};
+  double y[parallelM];
+  const int q = 4 * parallelM;
+  double **U = myalloc2(q, parallelM);
+  double **Z = myalloc2(q, parallelN);
+  double **ZMT = myalloc2(q, parallelN);
+
+  for (int k = 0; k < q; ++k)
+    for (int j = 0; j < parallelM; ++j)
+      U[k][j] = (k % parallelM == j) ? 1.0 + k : 0.1 * (j - k);
+
+  traceParallelFunction(x, y);
+  zos_forward(parallelTag, parallelM, parallelN, 1, x, y);
+  fov_reverse(parallelTag, parallelM, parallelN, q, U, Z);
+
+  /* more threads than directions and uneven chunks included */
+  for (int nthreads = 0; nthreads <= q + 1; ++nthreads) {
+    for (int k = 0; k < q; ++k)
+      for (int i = 0; i < parallelN; ++i)
+        ZMT[k][i] = 0.0;
+    BOOST_TEST(fov_reverse_mt(parallelTag, parallelM, parallelN, q, U, ZMT,
+                              nthreads) >= 0);
+    for (int k = 0; k < q; ++k)
+      for (int i = 0; i < parallelN; ++i)
+        BOOST_TEST(ZMT[k][i] == Z[k][i]);
+  }
+
+  myfree2(U);
+  myfree2(Z);
+  myfree2(ZMT);
+}
+
+BOOST_AUTO_TEST_CASE(FovReverseMT_Jacobian) {
+  double x[parallelN] = {-0.7, 0.3, 1.8, 0.5, -1.4, 0.1};
+  double y[parallelM];
+  double **J = myalloc2(parallelM, parallelN);
+  double **I = myallocI2(parallelM);
+  double **JRev = myalloc2(parallelM, parallelN);
+
+  traceParallelFunction(x, y);
+  /* few dependents, jacobian uses the reverse mode */
+  BOOST_TEST(jacobian(parallelTag, parallelM, parallelN, x, J) >= 0);
+
+  zos_forward(parallelTag, parallelM, parallelN, 1, x, y);
+  fov_reverse(parallelTag, parallelM, parallelN, parallelM, I, JRev);
+  for (int j = 0; j < parallelM; ++j)
+    for (int i = 0; i < parallelN; ++i)
+      BOOST_TEST(J[j][i] == JRev[j][i]);
+
+  /* the tape stays usable for the serial drivers */
+  double g[parallelN], u[parallelM] = {1.0, 0.0, 0.0};
+  fos_reverse(parallelTag, parallelM, parallelN, u, g);
+  for (int i = 0; i < parallelN; ++i)
+    BOOST_TEST(g[i] == J[0][i]);
+
+  myfree2(J);
+  myfreeI2(parallelM, I);
+  myfree2(JRev);
+}
+
+BOOST_AUTO_TEST_CASE(FovForwardMT_AllChunkings) {
+  double x[parallelN] = {1.2, -0.5, 0.3, -0.8, 2.1, 0.7};
+  double y[parallelM], yMT[parallelM];
+  const int p = 2 * parallelN + 1;
+  double **X = myalloc2(parallelN, p);
+  double **Y = myalloc2(parallelM, p);
+  double **YMT = myalloc2(parallelM, p);
+
+  for (int i = 0; i < parallelN; ++i)
+    for (int k = 0; k < p; ++k)
+      X[i][k] = (k % parallelN == i) ? 1.0 : 0.05 * (k - i);
+
+  traceParallelFunction(x, y);
+  fov_forward(parallelTag, parallelM, parallelN, p, x, X, y, Y);
+
+  /* automatic, single direction, uneven and oversized chunks */
+  const int chunks[] = {0, 1, 4, p, p + 3};
+  for (int chunk : chunks)
+    for (int nthreads = 0; nthreads <= 3; ++nthreads) {
+      for (int j = 0; j < parallelM; ++j) {
+        yMT[j] = 0.0;
+        for (int k = 0; k < p; ++k)
+          YMT[j][k] = 0.0;
+      }
+      BOOST_TEST(fov_forward_mt(parallelTag, parallelM, parallelN, p, x, X,
+                                yMT, YMT, nthreads, chunk) >= 0);
+      for (int j = 0; j < parallelM; ++j) {
+        BOOST_TEST(yMT[j] == y[j]);
+        for (int k = 0; k < p; ++k)
+          BOOST_TEST(YMT[j][k] == Y[j][k]);
+      }
+    }
+
+  myfree2(X);
+  myfree2(Y);
+  myfree2(YMT);
+}
+
+BOOST_AUTO_TEST_CASE(HovForwardMT_AllChunkings) {
+  double x[parallelN] = {-0.4, 0.8, 1.6, -1.2, 0.3, 0.5};
+  double y[parallelM], yMT[parallelM];
+  const int d = 3, p = parallelN + 2;
+  double ***X = myalloc3(parallelN, p, d);
+  double ***Y = myalloc3(parallelM, p, d);
+  double ***YMT = myalloc3(parallelM, p, d);
+
+  for (int i = 0; i < parallelN; ++i)
+    for (int k = 0; k < p; ++k)
+      for (int l = 0; l < d; ++l)
+        X[i][k][l] = (k % parallelN == i) ? 1.0 / (l + 1) : 0.1 * (k - i + l);
+
+  traceParallelFunction(x, y);
+  hov_forward(parallelTag, parallelM, parallelN, d, p, x, X, y, Y);
+
+  const int chunks[] = {0, 1, 3, p, p + 2};
+  for (int chunk : chunks)
+    for (int nthreads = 0; nthreads <= 3; ++nthreads) {
+      for (int j = 0; j < parallelM; ++j) {
+        yMT[j] = 0.0;
+        for (int k = 0; k < p; ++k)
+          for (int l = 0; l < d; ++l)
+            YMT[j][k][l] = 0.0;
+      }
+      BOOST_TEST(hov_forward_mt(parallelTag, parallelM, parallelN, d, p, x, X,
+                                yMT, YMT, nthreads, chunk) >= 0);
+      for (int j = 0; j < parallelM; ++j) {
+        BOOST_TEST(yMT[j] == y[j]);
+        for (int k = 0; k < p; ++k)
+          for (int l = 0; l < d; ++l)
+            BOOST_TEST(YMT[j][k][l] == Y[j][k][l]);
+      }
+    }
+
+  myfree3(X);
+  myfree3(Y);
+  myfree3(YMT);
+}
+
+BOOST_AUTO_TEST_CASE(TensorEvalMT_Threads) {
+  double x[parallelN] = {0.2, -0.9, 1.1, 0.6, -0.3, 0.8};
+  double y[parallelM];
+  const int p = 4;
+  double **S = myalloc2(parallelN, p);
+
+  for (int i = 0; i < parallelN; ++i)
+    for (int k = 0; k < p; ++k)
+      S[i][k] = (i == k) ? 1.0 : 0.1 * (i + k);
+
+  traceParallelFunction(x, y);
+  for (int d = 1; d <= 4; ++d) {
+    const int dimten = binomi(p + d, d);
+    double **tensor = myalloc2(parallelM, dimten);
+    double **tensorMT = myalloc2(parallelM, dimten);
+
+    BOOST_TEST(tensor_eval(parallelTag, parallelM, parallelN, d, p, x, tensor,
+                           S) >= 0);
+    for (int nthreads = 0; nthreads <= 3; ++nthreads) {
+      BOOST_TEST(tensor_eval_mt(parallelTag, parallelM, parallelN, d, p, x,
+                                tensorMT, S, nthreads) >= 0);
+      for (int j = 0; j < parallelM; ++j)
+        for (int k = 0; k < dimten; ++k)
+          BOOST_TEST(tensorMT[j][k] == tensor[j][k]);
+    }
+
+    myfree2(tensor);
+    myfree2(tensorMT);
+  }
+
+  myfree2(S);
+}
+
+BOOST_AUTO_TEST_CASE(TensorEval_ManyDirections) {
+  /* all derivatives of exp(x0 + 2 x1 + 3 x2) up to order 4 in the unit
+   * directions, 15 multiindices of order 4 */
+  const int n = 3, d = 4;
+  const double c[n] = {1.0, 2.0, 3.0};
+  double x[n] = {0.1, -0.2, 0.15}, y;
+  adouble ax[n], ay;
+
+  trace_on(parallelTensorTag);
+  for (int i = 0; i < n; ++i)
+    ax[i] <<= x[i];
+  ay = exp(ax[0] + 2.0 * ax[1] + 3.0 * ax[2]);
+  ay >>= y;
+  trace_off();
+
+  const int dimten = binomi(n + d, d);
+  double **tensor = myalloc2(1, dimten);
+  double **S = myallocI2(n);
+
+  /* a cached list of another degree is replaced */
+  BOOST_TEST(tensor_eval(parallelTensorTag, 1, n, 2, n, x, tensor, S) >= 0);
+  BOOST_TEST(tensor_eval(parallelTensorTag, 1, n, d, n, x, tensor, S) >= 0);
+
+  /* the variable indices of an entry in descending order, 0 for none */
+  int multi[d];
+  for (multi[0] = 0; multi[0] <= n; ++multi[0])
+    for (multi[1] = 0; multi[1] <= multi[0]; ++multi[1])
+      for (multi[2] = 0; multi[2] <= multi[1]; ++multi[2])
+        for (multi[3] = 0; multi[3] <= multi[2]; ++multi[3]) {
+          double expected = y;
+          for (int l = 0; l < d; ++l)
+            if (multi[l] > 0)
+              expected *= c[multi[l] - 1];
+          BOOST_TEST(tensor[0][tensor_address(d, multi)] == expected,
+                     tt::tolerance(tol));
+        }
+
+  myfree2(tensor);
+  myfreeI2(n, S);
+}
+
+BOOST_AUTO_TEST_CASE(FovForwardMT_LargeJacobian) {
+  double x[parallelN] = {0.9, 0.2, -1.3, 0.4, -0.6, 1.5};
+  double y[parallelM], yLarge[parallelM];
+  double **J = myalloc2(parallelM, parallelN);
+  double **I = myallocI2(parallelN);
+  double **JLarge = myalloc2(parallelM, parallelN);
+
+  traceParallelFunction(x, y);
+  fov_forward(parallelTag, parallelM, parallelN, parallelN, x, I, y, J);
+
+  for (int runs = 1; runs <= parallelN + 1; ++runs) {
+    BOOST_TEST(large_jacobian(parallelTag, parallelM, parallelN, runs, x,
+                              yLarge, JLarge) >= 0);
+    for (int j = 0; j < parallelM; ++j) {
+      BOOST_TEST(yLarge[j] == y[j]);
+      for (int i = 0; i < parallelN; ++i)
+        BOOST_TEST(JLarge[j][i] == J[j][i]);
+    }
+  }
+
+  myfree2(J);
+  myfreeI2(parallelN, I);
+  myfree2(JLarge);
+}
+
+BOOST_AUTO_TEST_CASE(FreezeTape_Serial) {
+  double x[parallelN] = {0.5, -0.3, 1.1, -0.9, 0.2, 1.4};
+  double y[parallelM], yFrozen[parallelM];
+  double u[parallelM] = {0.3, -1.0, 2.0};
+  double g[parallelN], gFrozen[parallelN];
+
+  traceParallelFunction(x, y);
+  zos_forward(parallelTag, parallelM, parallelN, 1, x, y);
+  fos_reverse(parallelTag, parallelM, parallelN, u, g);
+
+  BOOST_TEST(freeze_tape(parallelTag) == 0);
+  BOOST_TEST(freeze_tape(parallelTag) == 0);
+  BOOST_TEST(removeTape(parallelTag, ADOLC_REMOVE_COMPLETELY) == -1);
+  BOOST_TEST(optimize_tape(parallelTag, ADOLC_OPT_ALL) == -1);
+
+  /* sweeps of the serial part are not affected */
+  zos_forward(parallelTag, parallelM, parallelN, 1, x, yFrozen);
+  fos_reverse(parallelTag, parallelM, parallelN, u, gFrozen);
+  for (int j = 0; j < parallelM; ++j)
+    BOOST_TEST(yFrozen[j] == y[j]);
+  for (int i = 0; i < parallelN; ++i)
+    BOOST_TEST(gFrozen[i] == g[i]);
+
+  BOOST_TEST(thaw_tape(parallelTag) == 0);
+  BOOST_TEST(thaw_tape(parallelTag) == -1);
+
+  /* tapes on hard disk cannot be shared */
+  adouble ax, ay;
+  trace_on(parallelDiskTag, 0, 64, 64, 64, 64);
+  ax <<= x[0];
+  ay = ax;
+  for (int k = 0; k < 20; ++k)
+    ay = sin(ay) * ax;
+  ay >>= y[0];
+  trace_off();
+  BOOST_TEST(freeze_tape(parallelDiskTag) == -1);
+}
+
+#if defined(_OPENMP)
+BOOST_AUTO_TEST_CASE(FreezeTape_Workers) {
+  const int numPoints = 8;
+  double x[numPoints][parallelN], y[parallelM];
+  double u[parallelM] = {1.0, 0.5, -0.25};
+  double g[numPoints][parallelN], gWorkers[numPoints][parallelN];
+  int rc[numPoints];
+
+  for (int p = 0; p < numPoints; ++p)
+    for (int i = 0; i < parallelN; ++i)
+      x[p][i] = 0.1 * (p + 1) - 0.2 * i;
+
+  traceParallelFunction(x[0], y);
+  for (int p = 0; p < numPoints; ++p) {
+    zos_forward(parallelTag, parallelM, parallelN, 1, x[p], y);
+    fos_reverse(parallelTag, parallelM, parallelN, u, g[p]);
+  }
+
+  BOOST_TEST(freeze_tape(parallelTag) == 0);
+  /* twice, the second region finds the views of the first one */
+  for (int region = 0; region < 2; ++region) {
+#pragma omp parallel ADOLC_OPENMP_NC
+    {
+#pragma omp for
+      for (int p = 0; p < numPoints; ++p) {
+        double yWorker[parallelM];
+        rc[p] = zos_forward(parallelTag, parallelM, parallelN, 1, x[p],
+                            yWorker);
+        fos_reverse(parallelTag, parallelM, parallelN, u, gWorkers[p]);
+      }
+    }
+    for (int p = 0; p < numPoints; ++p) {
+      BOOST_TEST(rc[p] >= 0);
+      for (int i = 0; i < parallelN; ++i)
+        BOOST_TEST(gWorkers[p][i] == g[p][i]);
+    }
+  }
+  BOOST_TEST(thaw_tape(parallelTag) == 0);
+
+  /* the tape can be retaped and removed again */
+  traceParallelFunction(x[0], y);
+  BOOST_TEST(removeTape(parallelTag, ADOLC_REMOVE_COMPLETELY) == 0);
+}
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
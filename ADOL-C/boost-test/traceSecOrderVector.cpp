@@ -329,4 +329,87 @@ BOOST_AUTO_TEST_CASE(customTrigProd_HOV_Reverse) {
   free(nz);
 }
 
+/* The dense Hessian drivers compute blocks of columns by Hessian-matrix
+ * products, or every column by a Hessian-vector product for block size 1
+ * and tapes containing fmin/fmax. All have to agree with hess_vec.
+ */
+static void hessianReference(int n, const double *x, double **H) {
+  double *v = myalloc1(n);
+  double *w = myalloc1(n);
+
+  for (int i = 0; i < n; ++i)
+    v[i] = 0.0;
+  for (int i = 0; i < n; ++i) {
+    v[i] = 1.0;
+    hess_vec(1, n, x, v, w);
+    for (int j = 0; j < n; ++j)
+      H[j][i] = w[j];
+    v[i] = 0.0;
+  }
+  myfree1(v);
+  myfree1(w);
+}
+
+static void checkPackedHessians(int n, const double *x) {
+  double **H = myalloc2(n, n);
+  double **HLower = myalloc2(n, n);
+  double *HPacked = myalloc1(n * (n + 1) / 2);
+
+  hessianReference(n, x, H);
+
+  BOOST_TEST(hessian(1, n, x, HLower) >= 0);
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(HLower[i][j] == H[i][j], tt::tolerance(tol));
+
+  /* automatic, single column, uneven and oversized blocks */
+  const int blocks[] = {0, 1, 2, 4, n, n + 3};
+  for (int block : blocks) {
+    for (int k = 0; k < n * (n + 1) / 2; ++k)
+      HPacked[k] = 0.0;
+    BOOST_TEST(hessian_packed(1, n, x, HPacked, block) >= 0);
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j <= i; ++j)
+        BOOST_TEST(HPacked[i * (i + 1) / 2 + j] == H[i][j],
+                   tt::tolerance(tol));
+  }
+
+  myfree2(H);
+  myfree2(HLower);
+  myfree1(HPacked);
+}
+
+BOOST_AUTO_TEST_CASE(HessianPacked_AllBlockSizes) {
+  const int n = 7;
+  double x[n] = {0.3, -0.8, 1.1, 0.5, -0.2, 0.9, 1.4}, y;
+  adouble ax[n], ay;
+
+  trace_on(1, 1);
+  for (int i = 0; i < n; ++i)
+    ax[i] <<= x[i];
+  ay = sin(ax[0] * ax[n - 1]) + exp(ax[2]) * ax[3];
+  for (int i = 0; i + 1 < n; ++i)
+    ay += ax[i] * ax[i] * ax[i + 1] / (2.0 + cos(ax[i + 1]));
+  ay += pow(ax[6], 3.0) * sqrt(ax[5]);
+  ay >>= y;
+  trace_off();
+
+  checkPackedHessians(n, x);
+}
+
+BOOST_AUTO_TEST_CASE(HessianPacked_MinMax) {
+  const int n = 4;
+  double x[n] = {0.6, -1.3, 0.2, 2.1}, y;
+  adouble ax[n], ay;
+
+  trace_on(1, 1);
+  for (int i = 0; i < n; ++i)
+    ax[i] <<= x[i];
+  ay = fmax(ax[0] * ax[1], ax[2] * ax[3]) + ax[0] * ax[3] * ax[3];
+  ay >>= y;
+  trace_off();
+
+  checkPackedHessians(n, x);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
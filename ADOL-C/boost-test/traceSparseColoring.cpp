@@ -0,0 +1,260 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adolc.h>
+
+#include <cstdlib>
+#include <vector>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(trace_sparse_coloring)
+
+/* The tests in this file compute sparse Jacobians and Hessians by the
+ * complete drivers sparse_jac and sparse_hess for all ways of compression
+ * and recovery and compare them with the dense drivers. The seed matrices
+ * of generate_seed_jac_mt are checked to be valid compressions.
+ */
+
+static const short colorTag = 23;
+static const int colorM = 30;
+static const int colorN = 40;
+
+static void traceJacFunction(const double *x) {
+  std::vector<adouble> ax(colorN), ay(colorM);
+  std::vector<double> y(colorM);
+
+  trace_on(colorTag);
+  for (int i = 0; i < colorN; ++i)
+    ax[i] <<= x[i];
+  for (int i = 0; i < colorM; ++i) {
+    const int j = (3 * i) % colorN;
+    ay[i] = ax[j] * ax[(j + 1) % colorN] + sin(ax[(j + 7) % colorN]);
+    ay[i] += exp(ax[(5 * i + 2) % colorN]) / ax[(j + 2) % colorN];
+  }
+  for (int i = 0; i < colorM; ++i)
+    ay[i] >>= y[i];
+  trace_off();
+}
+
+static void traceHessFunction(const double *x) {
+  std::vector<adouble> ax(colorN);
+  adouble ay;
+  double y;
+
+  trace_on(colorTag);
+  for (int i = 0; i < colorN; ++i)
+    ax[i] <<= x[i];
+  ay = 0.0;
+  for (int i = 0; i + 1 < colorN; ++i)
+    ay += ax[i] * ax[i] * ax[i + 1] + sin(ax[i]) * ax[(7 * i + 3) % colorN];
+  for (int i = 0; i + 4 < colorN; i += 4)
+    ay += exp(ax[i] * ax[i + 4]);
+  ay >>= y;
+  trace_off();
+}
+
+static void checkJacobian(int nnz, const unsigned int *rind,
+                          const unsigned int *cind, const double *values,
+                          const double *x) {
+  double **J = myalloc2(colorM, colorN);
+
+  jacobian(colorTag, colorM, colorN, x, J);
+  for (int k = 0; k < nnz; ++k) {
+    BOOST_TEST(values[k] == J[rind[k]][cind[k]], tt::tolerance(tol));
+    J[rind[k]][cind[k]] = 0.0;
+  }
+  /* all nonzeros are recovered */
+  for (int i = 0; i < colorM; ++i)
+    for (int j = 0; j < colorN; ++j)
+      BOOST_TEST(J[i][j] == 0.0);
+  myfree2(J);
+}
+
+static void checkHessian(int nnz, const unsigned int *rind,
+                         const unsigned int *cind, const double *values,
+                         const double *x) {
+  double **H = myalloc2(colorN, colorN);
+
+  hessian(colorTag, colorN, const_cast<double *>(x), H);
+  for (int k = 0; k < nnz; ++k) {
+    BOOST_TEST(rind[k] <= cind[k]);
+    BOOST_TEST(values[k] == H[cind[k]][rind[k]], tt::tolerance(tol));
+    H[cind[k]][rind[k]] = 0.0;
+  }
+  /* all nonzeros of the lower triangle are recovered */
+  for (int i = 0; i < colorN; ++i)
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(H[i][j] == 0.0);
+  myfree2(H);
+}
+
+BOOST_AUTO_TEST_CASE(SparseJac_Compressions) {
+  std::vector<double> x(colorN);
+
+  for (int i = 0; i < colorN; ++i)
+    x[i] = 1.0 + 0.05 * i;
+  traceJacFunction(x.data());
+
+  for (int rows = 0; rows < 2; ++rows) {
+    int options[4] = {0, 0, 0, rows};
+    unsigned int *rind = NULL, *cind = NULL;
+    double *values = NULL;
+    int nnz;
+
+    BOOST_TEST(sparse_jac(colorTag, colorM, colorN, 0, x.data(), &nnz, &rind,
+                          &cind, &values, options) >= 0);
+    checkJacobian(nnz, rind, cind, values, x.data());
+
+    /* repeated call with the preallocated arrays */
+    for (int i = 0; i < colorN; ++i)
+      x[i] += 0.01;
+    BOOST_TEST(sparse_jac(colorTag, colorM, colorN, 1, x.data(), &nnz, &rind,
+                          &cind, &values, options) >= 0);
+    checkJacobian(nnz, rind, cind, values, x.data());
+
+    free(rind);
+    free(cind);
+    free(values);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SparseHess_Recoveries) {
+  std::vector<double> x(colorN);
+
+  for (int i = 0; i < colorN; ++i)
+    x[i] = 0.5 + 0.03 * i;
+  traceHessFunction(x.data());
+
+  for (int direct = 0; direct < 2; ++direct) {
+    int options[2] = {0, direct};
+    unsigned int *rind = NULL, *cind = NULL;
+    double *values = NULL;
+    int nnz;
+
+    BOOST_TEST(sparse_hess(colorTag, colorN, 0, x.data(), &nnz, &rind, &cind,
+                           &values, options) >= 0);
+    checkHessian(nnz, rind, cind, values, x.data());
+
+    for (int i = 0; i < colorN; ++i)
+      x[i] -= 0.02;
+    BOOST_TEST(sparse_hess(colorTag, colorN, 1, x.data(), &nnz, &rind, &cind,
+                           &values, options) >= 0);
+    checkHessian(nnz, rind, cind, values, x.data());
+
+    free(rind);
+    free(cind);
+    free(values);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SparseHess_EdgePushingFallback) {
+  std::vector<double> x(colorN);
+  std::vector<adouble> ax(colorN);
+  advector av(colorN);
+  adouble ay, ai;
+  double y;
+
+  for (int i = 0; i < colorN; ++i)
+    x[i] = 0.5 + 0.03 * i;
+
+  /* the subscript of an advector is not handled by edge pushing and needs
+   * the tight mode of the sparsity pattern */
+  trace_on(colorTag);
+  for (int i = 0; i < colorN; ++i) {
+    ax[i] <<= x[i];
+    av[i] = ax[i];
+  }
+  ai = 3.0;
+  ay = av[ai] * ax[0];
+  for (int i = 0; i + 1 < colorN; ++i)
+    ay += ax[i] * ax[i] * ax[i + 1];
+  ay >>= y;
+  trace_off();
+
+  int options[2] = {1, 2};
+  unsigned int *rind = NULL, *cind = NULL;
+  double *values = NULL;
+  int nnz = 0;
+
+  BOOST_TEST(edge_push_hess(colorTag, colorN, x.data(), &nnz, &rind, &cind,
+                            &values) == -1);
+  BOOST_TEST(sparse_hess(colorTag, colorN, 0, x.data(), &nnz, &rind, &cind,
+                         &values, options) >= 0);
+  BOOST_TEST(options[1] == 2);
+  checkHessian(nnz, rind, cind, values, x.data());
+
+  for (int i = 0; i < colorN; ++i)
+    x[i] += 0.01;
+  BOOST_TEST(sparse_hess(colorTag, colorN, 1, x.data(), &nnz, &rind, &cind,
+                         &values, options) >= 0);
+  checkHessian(nnz, rind, cind, values, x.data());
+
+  free(rind);
+  free(cind);
+  free(values);
+}
+
+BOOST_AUTO_TEST_CASE(GenerateSeedJac_Parallel) {
+  const int m = 2000, n = 1500;
+  std::vector<unsigned int *> JP(m);
+
+  /* rows with a band and a scattered entry */
+  for (int i = 0; i < m; ++i) {
+    const unsigned int j = i % (n - 3), k = (13 * i + 5) % n;
+    const bool extra = k < j || k > j + 3;
+
+    JP[i] = (unsigned int *)malloc((extra ? 6 : 5) * sizeof(unsigned int));
+    JP[i][0] = extra ? 5 : 4;
+    for (unsigned int l = 0; l < 4; ++l)
+      JP[i][l + 1] = j + l;
+    if (extra)
+      JP[i][5] = k;
+  }
+
+  for (int rows = 0; rows < 2; ++rows) {
+    double **Seed;
+    int p;
+
+    generate_seed_jac_mt(m, n, JP.data(), &Seed, &p, rows, 0);
+    BOOST_TEST(p >= 4);
+
+    /* every vertex has exactly one color */
+    const int k = rows ? m : n;
+    std::vector<int> color(k, -1);
+    for (int v = 0; v < k; ++v)
+      for (int c = 0; c < p; ++c)
+        if ((rows ? Seed[c][v] : Seed[v][c]) != 0.0) {
+          BOOST_TEST(color[v] == -1);
+          color[v] = c;
+        }
+    for (int v = 0; v < k; ++v)
+      BOOST_TEST(color[v] >= 0);
+
+    /* the rows sharing a column, or the columns sharing a row, differ */
+    if (rows) {
+      std::vector<int> owner(n * p, -1);
+      for (int i = 0; i < m; ++i)
+        for (unsigned int l = 1; l <= JP[i][0]; ++l) {
+          int &o = owner[JP[i][l] * p + color[i]];
+          BOOST_TEST((o == -1 || o == i));
+          o = i;
+        }
+    } else
+      for (int i = 0; i < m; ++i)
+        for (unsigned int l = 1; l <= JP[i][0]; ++l)
+          for (unsigned int r = l + 1; r <= JP[i][0]; ++r)
+            BOOST_TEST(color[JP[i][l]] != color[JP[i][r]]);
+
+    for (int r = 0; r < (rows ? p : n); ++r)
+      delete[] Seed[r];
+    delete[] Seed;
+  }
+
+  for (int i = 0; i < m; ++i)
+    free(JP[i]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
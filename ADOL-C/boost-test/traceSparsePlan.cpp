@@ -0,0 +1,227 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adolc.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(trace_sparse_plan)
+
+/* The tests in this file compute sparse Jacobians and Hessians by plans and
+ * compare them with the dense drivers. The plans are computed for one tape
+ * and evaluated for retraced tapes of the same structure at other points.
+ */
+
+static const short planTag = 19;
+static const short otherTag = 20;
+static const int planM = 5;
+static const int planN = 7;
+
+static void traceJacFunction(short tag, const double *x) {
+  adouble ax[planN], ay[planM];
+  double y[planM];
+
+  trace_on(tag);
+  for (int i = 0; i < planN; ++i)
+    ax[i] <<= x[i];
+  ay[0] = ax[0] * ax[1] + sin(ax[6]);
+  ay[1] = exp(ax[1]) - ax[2] / ax[3];
+  ay[2] = ax[3] * ax[3] + ax[4];
+  ay[3] = sqrt(ax[5]) * ax[0];
+  ay[4] = ax[6] - cos(ax[2]);
+  for (int i = 0; i < planM; ++i)
+    ay[i] >>= y[i];
+  trace_off();
+}
+
+static void traceHessFunction(short tag, const double *x) {
+  adouble ax[planN], ay;
+  double y;
+
+  trace_on(tag);
+  for (int i = 0; i < planN; ++i)
+    ax[i] <<= x[i];
+  ay = ax[0] * ax[1] + sin(ax[2]) * ax[3] + exp(ax[4]);
+  for (int i = 0; i + 1 < planN; ++i)
+    ay += ax[i] * ax[i] * ax[i + 1];
+  ay += ax[6] / ax[5];
+  ay >>= y;
+  trace_off();
+}
+
+static void checkJacPlan(const SparsePlan *plan, short tag, const double *x) {
+  const unsigned int *rind, *cind;
+  double **J = myalloc2(planM, planN);
+  const int nnz = sparse_plan_nnz(plan, &rind, &cind);
+  std::vector<double> values(nnz);
+
+  BOOST_TEST(sparse_plan_eval(plan, tag, x, values.data()) >= 0);
+  jacobian(tag, planM, planN, x, J);
+  for (int k = 0; k < nnz; ++k) {
+    BOOST_TEST(values[k] == J[rind[k]][cind[k]], tt::tolerance(tol));
+    J[rind[k]][cind[k]] = 0.0;
+  }
+  /* all nonzeros are part of the plan */
+  for (int i = 0; i < planM; ++i)
+    for (int j = 0; j < planN; ++j)
+      BOOST_TEST(J[i][j] == 0.0);
+
+  myfree2(J);
+}
+
+static void checkHessPlan(const SparsePlan *plan, short tag,
+                          const double *x) {
+  const unsigned int *rind, *cind;
+  double **H = myalloc2(planN, planN);
+  const int nnz = sparse_plan_nnz(plan, &rind, &cind);
+  std::vector<double> values(nnz);
+
+  BOOST_TEST(sparse_plan_eval(plan, tag, x, values.data()) >= 0);
+  hessian(tag, planN, x, H);
+  for (int k = 0; k < nnz; ++k) {
+    BOOST_TEST(rind[k] <= cind[k]);
+    BOOST_TEST(values[k] == H[cind[k]][rind[k]], tt::tolerance(tol));
+    H[cind[k]][rind[k]] = 0.0;
+  }
+  /* all nonzeros of the lower triangle are part of the plan */
+  for (int i = 0; i < planN; ++i)
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(H[i][j] == 0.0);
+
+  myfree2(H);
+}
+
+BOOST_AUTO_TEST_CASE(SparsePlan_JacobianColumns) {
+  double x[planN] = {0.5, 1.2, -0.3, 0.8, 1.5, 2.0, -0.7};
+  int options[4] = {0, 0, 0, 0};
+
+  traceJacFunction(planTag, x);
+  SparsePlan *plan = sparse_jac_plan(planTag, planM, planN, x, options);
+  BOOST_TEST(plan != (SparsePlan *)NULL);
+  checkJacPlan(plan, planTag, x);
+
+  /* a retraced tape of the same structure at another point */
+  for (int i = 0; i < planN; ++i)
+    x[i] += 0.25;
+  traceJacFunction(otherTag, x);
+  checkJacPlan(plan, otherTag, x);
+  sparse_plan_free(plan);
+}
+
+BOOST_AUTO_TEST_CASE(SparsePlan_JacobianRows) {
+  double x[planN] = {0.5, 1.2, -0.3, 0.8, 1.5, 2.0, -0.7};
+  int options[4] = {1, 0, 0, 1};
+
+  traceJacFunction(planTag, x);
+  SparsePlan *plan = sparse_jac_plan(planTag, planM, planN, x, options);
+  BOOST_TEST(plan != (SparsePlan *)NULL);
+  checkJacPlan(plan, planTag, x);
+  x[3] = 1.7;
+  checkJacPlan(plan, planTag, x);
+  sparse_plan_free(plan);
+}
+
+BOOST_AUTO_TEST_CASE(SparsePlan_Hessian) {
+  double x[planN] = {0.5, 1.2, -0.3, 0.8, 1.5, 2.0, -0.7};
+  int options[2] = {0, 0};
+
+  traceHessFunction(planTag, x);
+  SparsePlan *plan = sparse_hess_plan(planTag, planN, x, options);
+  BOOST_TEST(plan != (SparsePlan *)NULL);
+  checkHessPlan(plan, planTag, x);
+
+  for (int i = 0; i < planN; ++i)
+    x[i] *= 1.1;
+  traceHessFunction(otherTag, x);
+  checkHessPlan(plan, otherTag, x);
+  sparse_plan_free(plan);
+}
+
+BOOST_AUTO_TEST_CASE(SparsePlan_WriteRead) {
+  double x[planN] = {0.5, 1.2, -0.3, 0.8, 1.5, 2.0, -0.7};
+  int options[2] = {0, 0};
+  const char *name = "ADOLC-sparse-plan.bin";
+  const unsigned int *rind, *cind, *rindRead, *cindRead;
+
+  traceHessFunction(planTag, x);
+  SparsePlan *plan = sparse_hess_plan(planTag, planN, x, options);
+  BOOST_TEST(sparse_plan_write(plan, name) == 0);
+  SparsePlan *read = sparse_plan_read(name);
+  BOOST_TEST(read != (SparsePlan *)NULL);
+
+  const int nnz = sparse_plan_nnz(plan, &rind, &cind);
+  BOOST_TEST(sparse_plan_nnz(read, &rindRead, &cindRead) == nnz);
+  for (int k = 0; k < nnz; ++k) {
+    BOOST_TEST(rindRead[k] == rind[k]);
+    BOOST_TEST(cindRead[k] == cind[k]);
+  }
+  checkHessPlan(read, planTag, x);
+
+  /* the dimensions of the tape have to match the plan */
+  std::vector<double> values(nnz);
+  traceJacFunction(otherTag, x);
+  BOOST_TEST(sparse_plan_eval(read, otherTag, x, values.data()) == -1);
+
+  sparse_plan_free(plan);
+  sparse_plan_free(read);
+  remove(name);
+  BOOST_TEST(sparse_plan_read(name) == (SparsePlan *)NULL);
+}
+
+static void writeBytes(const char *name, const std::vector<char> &bytes,
+                       size_t size) {
+  FILE *file = fopen(name, "wb");
+  fwrite(bytes.data(), 1, size, file);
+  fclose(file);
+}
+
+BOOST_AUTO_TEST_CASE(SparsePlan_ReadCorrupted) {
+  double x[planN] = {0.5, 1.2, -0.3, 0.8, 1.5, 2.0, -0.7};
+  int options[2] = {0, 0};
+  const char *name = "ADOLC-sparse-plan-corrupted.bin";
+
+  traceHessFunction(planTag, x);
+  SparsePlan *plan = sparse_hess_plan(planTag, planN, x, options);
+  const int nnz = sparse_plan_nnz(plan, NULL, NULL);
+  BOOST_TEST(sparse_plan_write(plan, name) == 0);
+  sparse_plan_free(plan);
+
+  FILE *file = fopen(name, "rb");
+  std::vector<char> bytes(4096);
+  bytes.resize(fread(bytes.data(), 1, bytes.size(), file));
+  fclose(file);
+  /* magic, version, kind, m, n, p and nnz, then the colors, rind, cind,
+   * compRow and compCol */
+  const size_t colorsAt = bytes.size() - (size_t)(4 * nnz) * sizeof(int) -
+                        planN * sizeof(int);
+  const size_t cindAt = colorsAt + (planN + nnz) * sizeof(int);
+  const int bad = 1000;
+
+  writeBytes(name, bytes, bytes.size() - 1);
+  BOOST_TEST(sparse_plan_read(name) == (SparsePlan *)NULL);
+
+  std::vector<char> badColor(bytes);
+  memcpy(&badColor[colorsAt], &bad, sizeof(int));
+  writeBytes(name, badColor, badColor.size());
+  BOOST_TEST(sparse_plan_read(name) == (SparsePlan *)NULL);
+
+  std::vector<char> badIndex(bytes);
+  memcpy(&badIndex[cindAt], &bad, sizeof(int));
+  writeBytes(name, badIndex, badIndex.size());
+  BOOST_TEST(sparse_plan_read(name) == (SparsePlan *)NULL);
+
+  writeBytes(name, bytes, bytes.size());
+  plan = sparse_plan_read(name);
+  BOOST_TEST(plan != (SparsePlan *)NULL);
+  checkHessPlan(plan, planTag, x);
+  sparse_plan_free(plan);
+  remove(name);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
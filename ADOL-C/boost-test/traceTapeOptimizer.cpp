@@ -0,0 +1,176 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adolc.h>
+#include <vector>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(trace_tape_optimizer)
+
+/* The tests in this file trace a function full of copies and temporaries
+ * that never reach a dependent, evaluate the tape, optimize it and evaluate
+ * it again. Since the remaining operations are evaluated in the same order,
+ * both evaluations have to agree exactly.
+ */
+
+static const short optTag = 13;
+static const short optDiskTag = 14;
+static const int optN = 3;
+static const int optM = 2;
+
+static void traceOptFunction(short tag, const double *x, double *y) {
+  adouble scale = 1.5; /* recorded by take_stock */
+  adouble ax[optN], ay[optM];
+
+  /* tiny buffers force the tape onto hard disk */
+  if (tag == optDiskTag)
+    trace_on(tag, 0, 64, 64, 64, 64);
+  else
+    trace_on(tag);
+  for (int i = 0; i < optN; ++i)
+    ax[i] <<= x[i];
+
+  adouble t = ax[0];
+  adouble v = t * ax[1];
+  for (int k = 0; k < 20; ++k) {
+    adouble copy = v;
+    adouble unused = sin(copy) * ax[2];
+    v = copy * 0.99 + cos(ax[2]) / (1.0 + k);
+    unused += exp(v);
+  }
+  v += scale * ax[2];
+  adouble w = fmax(v, ax[1]);
+  condassign(w, ax[2], w, v * v);
+  ay[0] = w * t;
+  ay[1] = t;
+  ay[0] >>= y[0];
+  ay[1] >>= y[1];
+  trace_off();
+}
+
+static void evaluate(short tag, const double *x, double *y, double **J,
+                     double *Hv) {
+  double v[optN] = {0.7, -0.2, 1.1};
+  double u[optM] = {1.0, -0.5};
+
+  zos_forward(tag, optM, optN, 0, x, y);
+  jacobian(tag, optM, optN, x, J);
+  lagra_hess_vec(tag, optM, optN, x, v, u, Hv);
+}
+
+static void checkOptimizedTape(short tag, const double *x) {
+  double y[optM], yOpt[optM];
+  double Hv[optN], HvOpt[optN];
+  double **J = myalloc2(optM, optN);
+  double **JOpt = myalloc2(optM, optN);
+  size_t stats[STAT_SIZE], statsOpt[STAT_SIZE];
+
+  traceOptFunction(tag, x, y);
+  tapestats(tag, stats);
+  evaluate(tag, x, y, J, Hv);
+
+  BOOST_TEST(optimize_tape(tag, ADOLC_OPT_ALL) > 0);
+  tapestats(tag, statsOpt);
+  evaluate(tag, x, yOpt, JOpt, HvOpt);
+
+  BOOST_TEST(statsOpt[NUM_OPERATIONS] < stats[NUM_OPERATIONS]);
+  BOOST_TEST(statsOpt[NUM_MAX_LIVES] < stats[NUM_MAX_LIVES]);
+  BOOST_TEST(statsOpt[NUM_INDEPENDENTS] == stats[NUM_INDEPENDENTS]);
+  BOOST_TEST(statsOpt[NUM_DEPENDENTS] == stats[NUM_DEPENDENTS]);
+  for (int j = 0; j < optM; ++j) {
+    BOOST_TEST(yOpt[j] == y[j]);
+    for (int i = 0; i < optN; ++i)
+      BOOST_TEST(JOpt[j][i] == J[j][i]);
+  }
+  for (int i = 0; i < optN; ++i)
+    BOOST_TEST(HvOpt[i] == Hv[i]);
+
+  /* the second dependent is a copy of the first independent */
+  BOOST_TEST(JOpt[1][0] == 1.0);
+  BOOST_TEST(JOpt[1][1] == 0.0);
+
+  myfree2(J);
+  myfree2(JOpt);
+}
+
+BOOST_AUTO_TEST_CASE(OptimizeTape_InCore) {
+  double x[optN] = {0.8, -0.4, 1.3};
+  checkOptimizedTape(optTag, x);
+}
+
+BOOST_AUTO_TEST_CASE(OptimizeTape_OnDisk) {
+  double x[optN] = {-0.3, 1.7, -0.6};
+  checkOptimizedTape(optDiskTag, x);
+}
+
+BOOST_AUTO_TEST_CASE(OptimizeTape_SinglePasses) {
+  double x[optN] = {1.2, 0.5, 0.4};
+  double y[optM], yOpt[optM];
+  double **J = myalloc2(optM, optN);
+  double **JOpt = myalloc2(optM, optN);
+  double Hv[optN], HvOpt[optN];
+  size_t stats[STAT_SIZE], statsOpt[STAT_SIZE];
+  const int flags[] = {ADOLC_OPT_DEAD_CODE, ADOLC_OPT_COPY_PROP,
+                       ADOLC_OPT_RENUMBER, ADOLC_OPT_LOCALITY};
+
+  for (int f : flags) {
+    traceOptFunction(optTag, x, y);
+    tapestats(optTag, stats);
+    evaluate(optTag, x, y, J, Hv);
+
+    BOOST_TEST(optimize_tape(optTag, f) >= 0);
+    tapestats(optTag, statsOpt);
+    evaluate(optTag, x, yOpt, JOpt, HvOpt);
+
+    BOOST_TEST(statsOpt[NUM_OPERATIONS] <= stats[NUM_OPERATIONS]);
+    for (int j = 0; j < optM; ++j) {
+      BOOST_TEST(yOpt[j] == y[j]);
+      for (int i = 0; i < optN; ++i)
+        BOOST_TEST(JOpt[j][i] == J[j][i]);
+    }
+    for (int i = 0; i < optN; ++i)
+      BOOST_TEST(HvOpt[i] == Hv[i]);
+  }
+
+  myfree2(J);
+  myfree2(JOpt);
+}
+
+BOOST_AUTO_TEST_CASE(OptimizeTape_FirstUseOrder) {
+  double x[optN] = {0.1, -0.9, 2.4};
+  double y[optM], yOpt[optM];
+  double **J = myalloc2(optM, optN);
+  double **JOpt = myalloc2(optM, optN);
+  double Hv[optN], HvOpt[optN];
+  size_t stats[STAT_SIZE], statsOpt[STAT_SIZE];
+
+  {
+    /* occupy many locations, such that the tape uses scattered ones */
+    std::vector<adouble> padding(1000);
+    traceOptFunction(optTag, x, y);
+  }
+  tapestats(optTag, stats);
+  evaluate(optTag, x, y, J, Hv);
+
+  BOOST_TEST(optimize_tape(optTag, ADOLC_OPT_LOCALITY) == 0);
+  tapestats(optTag, statsOpt);
+  evaluate(optTag, x, yOpt, JOpt, HvOpt);
+
+  BOOST_TEST(stats[NUM_MAX_LIVES] > 1000);
+  BOOST_TEST(statsOpt[NUM_MAX_LIVES] < 100);
+  for (int j = 0; j < optM; ++j) {
+    BOOST_TEST(yOpt[j] == y[j]);
+    for (int i = 0; i < optN; ++i)
+      BOOST_TEST(JOpt[j][i] == J[j][i]);
+  }
+  for (int i = 0; i < optN; ++i)
+    BOOST_TEST(HvOpt[i] == Hv[i]);
+
+  myfree2(J);
+  myfree2(JOpt);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,160 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adolc.h>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(trace_tape_storage)
+
+/* The tests in this file trace a function with buffer sizes small enough
+ * to force all tapes onto hard disk. The tape is then evaluated with the
+ * default buffered storage and with one of the other storage types. Both
+ * evaluations have to agree exactly.
+ */
+
+static const short storageTag = 11;
+static const int storageN = 4;
+
+static void traceStorageFunction(const double *x, double *y) {
+  adouble ax[storageN], ay;
+
+  /* tiny buffers, i.e. many blocks per tape */
+  trace_on(storageTag, 1, 64, 64, 64, 64);
+  for (int i = 0; i < storageN; ++i)
+    ax[i] <<= x[i];
+  ay = 0.0;
+  for (int k = 0; k < 200; ++k)
+    for (int i = 0; i < storageN; ++i)
+      ay += sin(ax[i] * (1.0 + 0.001 * k)) * ax[(i + 1) % storageN] + 0.5;
+  ay >>= y[0];
+  trace_off(1);
+}
+
+BOOST_AUTO_TEST_CASE(TapeStorageMmap_ZOS_Forward_Gradient) {
+  double x[storageN] = {0.3, -1.2, 2.5, 0.7};
+  double y, yBuf, yMap;
+  double gBuf[storageN], gMap[storageN];
+
+  traceStorageFunction(x, &y);
+
+  size_t tapeStats[STAT_SIZE];
+  tapestats(storageTag, tapeStats);
+  BOOST_TEST(tapeStats[OP_FILE_ACCESS] == 1);
+  BOOST_TEST(tapeStats[LOC_FILE_ACCESS] == 1);
+  BOOST_TEST(tapeStats[VAL_FILE_ACCESS] == 1);
+
+  set_tape_storage(storageTag, ADOLC_TAPE_STORE_BUFFERED);
+  zos_forward(storageTag, 1, storageN, 1, x, &yBuf);
+  gradient(storageTag, storageN, x, gBuf);
+
+  set_tape_storage(storageTag, ADOLC_TAPE_STORE_MMAP);
+  zos_forward(storageTag, 1, storageN, 1, x, &yMap);
+  gradient(storageTag, storageN, x, gMap);
+
+  BOOST_TEST(yBuf == y, tt::tolerance(tol));
+  BOOST_TEST(yMap == yBuf);
+  for (int i = 0; i < storageN; ++i)
+    BOOST_TEST(gMap[i] == gBuf[i]);
+}
+
+BOOST_AUTO_TEST_CASE(TapeStorageMmap_HOS_Reverse) {
+  double x[storageN] = {-0.4, 0.9, 1.6, -2.1};
+  double y;
+  double **HBuf = myalloc2(storageN, storageN);
+  double **HMap = myalloc2(storageN, storageN);
+
+  traceStorageFunction(x, &y);
+
+  set_tape_storage(storageTag, ADOLC_TAPE_STORE_BUFFERED);
+  hessian(storageTag, storageN, x, HBuf);
+
+  set_tape_storage(storageTag, ADOLC_TAPE_STORE_MMAP);
+  hessian(storageTag, storageN, x, HMap);
+
+  for (int i = 0; i < storageN; ++i)
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(HMap[i][j] == HBuf[i][j]);
+
+  myfree2(HBuf);
+  myfree2(HMap);
+}
+
+BOOST_AUTO_TEST_CASE(TapeStorageAsync_Gradient_Hessian) {
+  double x[storageN] = {1.1, -0.3, 0.8, 2.2};
+  double y, yBuf, yAsync;
+  double gBuf[storageN], gAsync[storageN];
+  double **HBuf = myalloc2(storageN, storageN);
+  double **HAsync = myalloc2(storageN, storageN);
+
+  traceStorageFunction(x, &y);
+  set_tape_storage(storageTag, ADOLC_TAPE_STORE_BUFFERED);
+  zos_forward(storageTag, 1, storageN, 1, x, &yBuf);
+  gradient(storageTag, storageN, x, gBuf);
+  hessian(storageTag, storageN, x, HBuf);
+
+  /* retaping writes the tape in the background as well */
+  set_tape_storage(storageTag, ADOLC_TAPE_STORE_ASYNC);
+  traceStorageFunction(x, &y);
+  zos_forward(storageTag, 1, storageN, 1, x, &yAsync);
+  gradient(storageTag, storageN, x, gAsync);
+  hessian(storageTag, storageN, x, HAsync);
+
+  BOOST_TEST(yAsync == yBuf);
+  for (int i = 0; i < storageN; ++i) {
+    BOOST_TEST(gAsync[i] == gBuf[i]);
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(HAsync[i][j] == HBuf[i][j]);
+  }
+
+  set_tape_storage(storageTag, ADOLC_TAPE_STORE_BUFFERED);
+  myfree2(HBuf);
+  myfree2(HAsync);
+}
+
+BOOST_AUTO_TEST_CASE(TapeCodecBlock_Gradient_Hessian) {
+  double x[storageN] = {0.6, 1.4, -0.9, 0.2};
+  double y, yRaw, yCoded;
+  double gRaw[storageN], gCoded[storageN];
+  double **HRaw = myalloc2(storageN, storageN);
+  double **HCoded = myalloc2(storageN, storageN);
+
+  traceStorageFunction(x, &y);
+  zos_forward(storageTag, 1, storageN, 1, x, &yRaw);
+  gradient(storageTag, storageN, x, gRaw);
+  hessian(storageTag, storageN, x, HRaw);
+
+  set_tape_codec(storageTag, ADOLC_TAPE_CODEC_BLOCK);
+  traceStorageFunction(x, &y);
+
+  size_t tapeStats[STAT_SIZE];
+  tapestats(storageTag, tapeStats);
+  BOOST_TEST(tapeStats[TAPE_CODEC] == ADOLC_TAPE_CODEC_BLOCK);
+  BOOST_TEST(tapeStats[LOC_FILE_ACCESS] == 1);
+
+  zos_forward(storageTag, 1, storageN, 1, x, &yCoded);
+  gradient(storageTag, storageN, x, gCoded);
+  hessian(storageTag, storageN, x, HCoded);
+
+  BOOST_TEST(yCoded == yRaw);
+  for (int i = 0; i < storageN; ++i) {
+    BOOST_TEST(gCoded[i] == gRaw[i]);
+    for (int j = 0; j <= i; ++j)
+      BOOST_TEST(HCoded[i][j] == HRaw[i][j]);
+  }
+
+  /* compressed tapes fall back to synchronous buffered reads */
+  set_tape_storage(storageTag, ADOLC_TAPE_STORE_MMAP);
+  gradient(storageTag, storageN, x, gCoded);
+  for (int i = 0; i < storageN; ++i)
+    BOOST_TEST(gCoded[i] == gRaw[i]);
+
+  set_tape_storage(storageTag, ADOLC_TAPE_STORE_BUFFERED);
+  set_tape_codec(storageTag, ADOLC_TAPE_CODEC_NONE);
+  myfree2(HRaw);
+  myfree2(HCoded);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
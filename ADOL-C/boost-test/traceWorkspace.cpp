@@ -0,0 +1,145 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adolc.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(trace_workspace)
+
+/* The tests in this file call the drivers repeatedly on the same tape, such
+ * that the sweeps reuse the arrays kept by the tape, and after retaping with
+ * more live variables and release_workspace. The results are compared with
+ * the analytic derivatives of
+ *   f(x) = sum_i x_i^2 x_{i+1} + exp(x_0 x_1).
+ */
+
+static const short wsTag = 24;
+
+static void traceChain(int n, const double *x) {
+  std::vector<adouble> ax(n);
+  adouble ay;
+  double y;
+
+  trace_on(wsTag);
+  for (int i = 0; i < n; ++i)
+    ax[i] <<= x[i];
+  ay = exp(ax[0] * ax[1]);
+  for (int i = 0; i + 1 < n; ++i)
+    ay += ax[i] * ax[i] * ax[i + 1];
+  ay >>= y;
+  trace_off();
+}
+
+static void chainGradient(int n, const double *x, double *g) {
+  const double e = std::exp(x[0] * x[1]);
+
+  for (int i = 0; i < n; ++i)
+    g[i] = 0.0;
+  g[0] = x[1] * e;
+  g[1] = x[0] * e;
+  for (int i = 0; i + 1 < n; ++i) {
+    g[i] += 2.0 * x[i] * x[i + 1];
+    g[i + 1] += x[i] * x[i];
+  }
+}
+
+static double chainHessian(int n, const double *x, int i, int j) {
+  const double e = std::exp(x[0] * x[1]);
+  double h = 0.0;
+
+  if (i < j)
+    std::swap(i, j);
+  if (i == 0 && j == 0)
+    h += x[1] * x[1] * e;
+  if (i == 1 && j == 1)
+    h += x[0] * x[0] * e;
+  if (i == 1 && j == 0)
+    h += e + x[0] * x[1] * e;
+  if (i == j && i + 1 < n)
+    h += 2.0 * x[i + 1];
+  if (i == j + 1)
+    h += 2.0 * x[j];
+  return h;
+}
+
+static void checkDrivers(int n, const double *x) {
+  std::vector<double> g(n), gRef(n), v(n), w(n);
+  double **H = myalloc2(n, n);
+
+  chainGradient(n, x, gRef.data());
+  for (int i = 0; i < n; ++i)
+    v[i] = 1.0 + 0.1 * i;
+
+  /* every driver twice, the second call uses the kept arrays */
+  for (int rep = 0; rep < 2; ++rep) {
+    BOOST_TEST(gradient(wsTag, n, x, g.data()) >= 0);
+    for (int i = 0; i < n; ++i)
+      BOOST_TEST(g[i] == gRef[i], tt::tolerance(tol));
+
+    BOOST_TEST(hess_vec(wsTag, n, const_cast<double *>(x), v.data(),
+                        w.data()) >= 0);
+    for (int i = 0; i < n; ++i) {
+      double ref = 0.0;
+      for (int j = 0; j < n; ++j)
+        ref += chainHessian(n, x, i, j) * v[j];
+      BOOST_TEST(w[i] == ref, tt::tolerance(tol));
+    }
+
+    BOOST_TEST(hessian(wsTag, n, const_cast<double *>(x), H) >= 0);
+    for (int i = 0; i < n; ++i)
+      for (int j = 0; j <= i; ++j)
+        BOOST_TEST(H[i][j] == chainHessian(n, x, i, j), tt::tolerance(tol));
+
+    BOOST_TEST(jacobian(wsTag, 1, n, x, H) >= 0);
+    for (int i = 0; i < n; ++i)
+      BOOST_TEST(H[0][i] == gRef[i], tt::tolerance(tol));
+  }
+  myfree2(H);
+}
+
+BOOST_AUTO_TEST_CASE(Workspace_RepeatedDrivers) {
+  std::vector<double> x(6);
+
+  for (int i = 0; i < 6; ++i)
+    x[i] = 0.3 + 0.1 * i;
+  traceChain(6, x.data());
+  checkDrivers(6, x.data());
+
+  /* other points reuse the arrays of the first ones */
+  for (int i = 0; i < 6; ++i)
+    x[i] = -0.2 + 0.15 * i;
+  checkDrivers(6, x.data());
+}
+
+BOOST_AUTO_TEST_CASE(Workspace_RetapeAndRelease) {
+  std::vector<double> x(40);
+
+  for (int i = 0; i < 6; ++i)
+    x[i] = 0.3 + 0.1 * i;
+  traceChain(6, x.data());
+  checkDrivers(6, x.data());
+
+  /* the larger tape needs larger arrays than the ones kept */
+  for (int i = 0; i < 40; ++i)
+    x[i] = 0.5 - 0.02 * i;
+  traceChain(40, x.data());
+  checkDrivers(40, x.data());
+
+  release_workspace(wsTag);
+  checkDrivers(40, x.data());
+
+  /* releasing all tapes twice and a tape without arrays is harmless */
+  release_workspace(-1);
+  release_workspace(-1);
+  release_workspace(wsTag + 100);
+  checkDrivers(40, x.data());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,192 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adtl.h>
+typedef adtl::adouble adouble;
+
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(traceless_arena)
+
+/* Tests for the per-thread arena holding the derivative arrays of the
+ * traceless adoubles: recycling of released arrays, the bulk release of
+ * a scope, and traceless evaluations in several threads at once, also with
+ * a different number of directions in each thread.
+ */
+
+static adouble model(const adouble &x, const adouble &y) {
+  adouble t = adtl::sin(x) * y;
+  return adtl::exp(t) / (1. + x * x);
+}
+
+static void modelDerivative(double x, double y, double *f, double *df) {
+  double t = std::sin(x) * y;
+  double q = 1. + x * x;
+  *f = std::exp(t) / q;
+  df[0] = (std::exp(t) * std::cos(x) * y * q - std::exp(t) * 2. * x) / (q * q);
+  df[1] = std::exp(t) * std::sin(x) / q;
+}
+
+BOOST_AUTO_TEST_CASE(ArenaRecyclesArrays) {
+  {
+    adouble warm = 1.;
+    (void)warm;
+  }
+  const size_t used = adtl::arena::getUsed();
+
+  for (int i = 0; i < 100; ++i) {
+    adouble x = 0.5, y = 2.;
+    x.setADValue(0, 1.);
+    y.setADValue(1, 1.);
+    adouble f = model(x, y);
+    BOOST_TEST(f.getValue() == std::exp(std::sin(0.5) * 2.) / 1.25,
+               tt::tolerance(tol));
+  }
+  /* the arrays of the first iteration are reused by all following ones */
+  BOOST_TEST(adtl::arena::getUsed() - used <= 16 * (adtl::getNumDir() + 2));
+}
+
+BOOST_AUTO_TEST_CASE(ArenaScopeReleasesArrays) {
+  adouble outer = 3.;
+  outer.setADValue(0, 1.);
+  const size_t used = adtl::arena::getUsed();
+
+  {
+    adtl::arena_scope scope;
+    std::vector<adouble> xs(1000);
+    for (size_t i = 0; i < xs.size(); ++i) {
+      xs[i] = outer * (double)i;
+      xs[i] = adtl::sqrt(xs[i] + 1.);
+    }
+    BOOST_TEST(adtl::arena::getUsed() > used);
+    BOOST_TEST(xs[8].getADValue(0) == 8. / (2. * std::sqrt(25.)),
+               tt::tolerance(tol));
+
+    {
+      adtl::arena_scope inner;
+      adouble tmp = adtl::log(outer);
+      BOOST_TEST(tmp.getADValue(0) == 1. / 3., tt::tolerance(tol));
+    }
+  }
+  BOOST_TEST(adtl::arena::getUsed() == used);
+
+  /* adoubles of the enclosing code are unaffected */
+  BOOST_TEST(outer.getValue() == 3.);
+  BOOST_TEST(outer.getADValue(0) == 1.);
+}
+
+BOOST_AUTO_TEST_CASE(ArenaParallelEvaluation) {
+  const int numThreads = 4, perThread = 200;
+  std::vector<double> values(numThreads * perThread);
+  std::vector<double> derivs(2 * numThreads * perThread);
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < numThreads; ++t)
+    threads.push_back(std::thread([&, t]() {
+      adtl::arena_scope scope;
+      for (int i = 0; i < perThread; ++i) {
+        const int k = t * perThread + i;
+        adouble x = 0.01 * k, y = 1. - 0.001 * k;
+        x.setADValue(0, 1.);
+        y.setADValue(1, 1.);
+        adouble f = model(x, y);
+        values[k] = f.getValue();
+        derivs[2 * k] = f.getADValue(0);
+        derivs[2 * k + 1] = f.getADValue(1);
+      }
+    }));
+  for (int t = 0; t < numThreads; ++t)
+    threads[t].join();
+
+  for (int k = 0; k < numThreads * perThread; ++k) {
+    double f, df[2];
+    modelDerivative(0.01 * k, 1. - 0.001 * k, &f, df);
+    BOOST_TEST(values[k] == f, tt::tolerance(tol));
+    BOOST_TEST(derivs[2 * k] == df[0], tt::tolerance(tol));
+    BOOST_TEST(derivs[2 * k + 1] == df[1], tt::tolerance(tol));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ArenaOutlivingThread) {
+  /* adoubles created by a thread stay valid after it has finished */
+  std::vector<adouble> results;
+  std::thread worker([&results]() {
+    for (int i = 0; i < 10; ++i) {
+      adouble x = (double)i;
+      x.setADValue(0, 1.);
+      results.push_back(x * x);
+    }
+  });
+  worker.join();
+
+  for (int i = 0; i < 10; ++i) {
+    BOOST_TEST(results[i].getValue() == (double)(i * i));
+    BOOST_TEST(results[i].getADValue(0) == 2. * i);
+  }
+  results.clear();
+}
+
+BOOST_AUTO_TEST_CASE(NumDirScopeRestores) {
+  const size_t numDir = adtl::getNumDir();
+  {
+    adtl::numdir_scope outer(5);
+    BOOST_TEST(adtl::getNumDir() == 5u);
+    {
+      adtl::numdir_scope inner(3);
+      adouble x = 1.;
+      x.setADValue(2, 1.);
+      BOOST_TEST(adtl::getNumDir() == 3u);
+      BOOST_CHECK_THROW(x.setADValue(3, 1.), std::logic_error);
+    }
+    BOOST_TEST(adtl::getNumDir() == 5u);
+  }
+  BOOST_TEST(adtl::getNumDir() == numDir);
+}
+
+BOOST_AUTO_TEST_CASE(NumDirScopeParallelChunks) {
+  /* each thread computes a chunk of the gradient of sum_j sin(x_j x_{j+1})
+   * with as many directions as its chunk has columns */
+  const int n = 10, numThreads = 4;
+  const int chunks[numThreads + 1] = {0, 1, 3, 6, 10};
+  std::vector<double> x(n), grad(n);
+  for (int j = 0; j < n; ++j)
+    x[j] = 0.1 * (j + 1);
+  std::vector<std::thread> threads;
+
+  for (int t = 0; t < numThreads; ++t)
+    threads.push_back(std::thread([&, t]() {
+      const int first = chunks[t], width = chunks[t + 1] - chunks[t];
+      adtl::numdir_scope scope(width);
+      std::vector<adouble> ax(n);
+      for (int j = 0; j < n; ++j) {
+        ax[j] = x[j];
+        if (j >= first && j < first + width)
+          ax[j].setADValue(j - first, 1.);
+      }
+      adouble f = 0.;
+      for (int j = 0; j + 1 < n; ++j)
+        f += adtl::sin(ax[j] * ax[j + 1]);
+      for (int k = 0; k < width; ++k)
+        grad[first + k] = f.getADValue(k);
+    }));
+  for (int t = 0; t < numThreads; ++t)
+    threads[t].join();
+
+  for (int j = 0; j < n; ++j) {
+    double g = 0.;
+    if (j > 0)
+      g += std::cos(x[j - 1] * x[j]) * x[j - 1];
+    if (j + 1 < n)
+      g += std::cos(x[j] * x[j + 1]) * x[j + 1];
+    BOOST_TEST(grad[j] == g, tt::tolerance(tol));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -6,6 +6,9 @@ namespace tt = boost::test_tools;
 #include <adolc/adtl.h>
 typedef adtl::adouble adouble;
 
+#include <cmath>
+#include <utility>
+
 #include "const.h"
 
 BOOST_AUTO_TEST_SUITE(traceless_composite)
@@ -485,4 +488,98 @@ BOOST_AUTO_TEST_CASE(MultiHyperb_Traceless) {
   BOOST_TEST(ay4.getADValue(1) == y4x2Derivative, tt::tolerance(tol));
 }
 
+/* The arithmetic operators build expressions that are evaluated when they
+ * are assigned. The following tests use expressions as operands of
+ * compound assignments, comparisons and functions, and with the assigned
+ * adouble as an operand.
+ */
+
+BOOST_AUTO_TEST_CASE(CompoundExpression_Traceless) {
+  double x1 = 0.7, x2 = -1.3;
+  adouble ax1 = x1, ax2 = x2;
+
+  ax1.setADValue(0, 1.);
+  ax2.setADValue(1, 1.);
+
+  adouble ay = ax1;
+  ay *= ax1 * ax2 - 3. / ax2;
+  ay += -ax1 / (ax2 + 2.);
+  ay /= 1. - ax1 * ax1;
+  ay -= 0.5 * ax2;
+
+  /* y = (x1 (x1 x2 - 3/x2) - x1/(x2 + 2)) / (1 - x1^2) - x2/2 */
+  double u = x1 * (x1 * x2 - 3. / x2) - x1 / (x2 + 2.);
+  double v = 1. - x1 * x1;
+  double ux1 = 2. * x1 * x2 - 3. / x2 - 1. / (x2 + 2.);
+  double ux2 = x1 * x1 + 3. * x1 / (x2 * x2) + x1 / ((x2 + 2.) * (x2 + 2.));
+  double x1Derivative = (ux1 * v + 2. * x1 * u) / (v * v);
+  double x2Derivative = ux2 / v - 0.5;
+
+  BOOST_TEST(ay.getValue() == u / v - 0.5 * x2, tt::tolerance(tol));
+  BOOST_TEST(ay.getADValue(0) == x1Derivative, tt::tolerance(tol));
+  BOOST_TEST(ay.getADValue(1) == x2Derivative, tt::tolerance(tol));
+}
+
+BOOST_AUTO_TEST_CASE(SelfReferencingExpression_Traceless) {
+  double x1 = 1.5, x2 = 0.4;
+  adouble ax1 = x1, ax2 = x2;
+
+  ax1.setADValue(0, 1.);
+  ax2.setADValue(1, 1.);
+
+  ax1 = ax1 * ax2 + ax1 / ax2 - 2. * ax1;
+  ax1 += ax1 * ax1;
+
+  /* t = x1 (x2 + 1/x2 - 2), y = t + t^2 */
+  double c = x2 + 1. / x2 - 2.;
+  double t = x1 * c;
+  double x1Derivative = (1. + 2. * t) * c;
+  double x2Derivative = (1. + 2. * t) * x1 * (1. - 1. / (x2 * x2));
+
+  BOOST_TEST(ax1.getValue() == t + t * t, tt::tolerance(tol));
+  BOOST_TEST(ax1.getADValue(0) == x1Derivative, tt::tolerance(tol));
+  BOOST_TEST(ax1.getADValue(1) == x2Derivative, tt::tolerance(tol));
+}
+
+BOOST_AUTO_TEST_CASE(ExpressionComparisonAndFunction_Traceless) {
+  adouble ax1 = 2., ax2 = 3.;
+
+  ax1.setADValue(0, 1.);
+  ax2.setADValue(1, 1.);
+
+  BOOST_TEST((ax1 * ax2 > ax2));
+  BOOST_TEST((ax1 + ax2 == 5.));
+  BOOST_TEST((0.5 < ax2 - ax1));
+  BOOST_TEST(!(ax1 * ax1 >= ax2 + ax2));
+
+  adouble ay = adtl::exp(ax1 * ax2);
+  adouble az = adtl::pow(ax1 + ax2, 2.);
+
+  BOOST_TEST(ay.getValue() == std::exp(6.), tt::tolerance(tol));
+  BOOST_TEST(ay.getADValue(0) == 3. * std::exp(6.), tt::tolerance(tol));
+  BOOST_TEST(ay.getADValue(1) == 2. * std::exp(6.), tt::tolerance(tol));
+  BOOST_TEST(az.getADValue(0) == 10., tt::tolerance(tol));
+  BOOST_TEST(az.getADValue(1) == 10., tt::tolerance(tol));
+}
+
+BOOST_AUTO_TEST_CASE(MoveAdouble_Traceless) {
+  adouble ax1 = 2.;
+  ax1.setADValue(0, 1.);
+  ax1.setADValue(1, -1.);
+
+  adouble ay(std::move(ax1));
+  BOOST_TEST(ay.getValue() == 2.);
+  BOOST_TEST(ay.getADValue(1) == -1.);
+
+  /* a moved-from adouble can be assigned to again */
+  ax1 = ay * ay;
+  BOOST_TEST(ax1.getValue() == 4.);
+  BOOST_TEST(ax1.getADValue(0) == 4.);
+
+  adouble az;
+  az = adtl::sin(ax1);
+  BOOST_TEST(az.getValue() == std::sin(4.), tt::tolerance(tol));
+  BOOST_TEST(az.getADValue(1) == -4. * std::cos(4.), tt::tolerance(tol));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
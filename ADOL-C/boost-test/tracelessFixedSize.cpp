@@ -0,0 +1,168 @@
+#define BOOST_TEST_DYN_LINK
+#include <boost/test/unit_test.hpp>
+
+namespace tt = boost::test_tools;
+
+#include <adolc/adtl_hov_n.h>
+#include <adolc/adtl_n.h>
+
+#include <cmath>
+
+#include "const.h"
+
+BOOST_AUTO_TEST_SUITE(traceless_fixed_size)
+
+/* Tests for the traceless types whose number of directions and degree are
+ * template parameters. The first order type is checked against closed form
+ * derivatives, the higher order type against known Taylor series and
+ * against round trips like log(exp(a)) whose coefficients must reproduce
+ * the ones of a.
+ */
+
+typedef adtl::adouble_n<3> adouble3;
+typedef adtl_hov::adouble_n<2, 4> ahov24;
+
+BOOST_AUTO_TEST_CASE(FixedSizeGradient) {
+  const double x = 0.7, y = 1.3, z = -0.4;
+  adouble3 ax(x), ay(y), az(z);
+
+  ax.setADValue(0, 1.0);
+  ay.setADValue(1, 1.0);
+  az.setADValue(2, 1.0);
+
+  adouble3 f = ax * ay + sin(az) / ay - exp(ax * az);
+  f += 2.0;
+  f -= ax;
+
+  BOOST_TEST(f.getValue() == x * y + std::sin(z) / y - std::exp(x * z) + 1.3,
+             tt::tolerance(tol));
+  BOOST_TEST(f.getADValue(0) == y - z * std::exp(x * z) - 1.0,
+             tt::tolerance(tol));
+  BOOST_TEST(f.getADValue(1) == x - std::sin(z) / (y * y), tt::tolerance(tol));
+  BOOST_TEST(f.getADValue(2) == std::cos(z) / y - x * std::exp(x * z),
+             tt::tolerance(tol));
+  BOOST_TEST(adouble3::getNumDir() == 3u);
+}
+
+BOOST_AUTO_TEST_CASE(FixedSizeElementaryDerivatives) {
+  const double a = 0.3;
+  const double dirs[3] = {1.0, -2.0, 0.5};
+  adouble3 ad(a, dirs);
+
+  /* each pair is f(a) and f'(a) */
+  const double expected[][2] = {
+      {std::exp(a), std::exp(a)},
+      {std::log(a), 1.0 / a},
+      {std::sqrt(a), 0.5 / std::sqrt(a)},
+      {std::cbrt(a), 1.0 / (3.0 * std::cbrt(a) * std::cbrt(a))},
+      {std::sin(a), std::cos(a)},
+      {std::cos(a), -std::sin(a)},
+      {std::tan(a), 1.0 + std::tan(a) * std::tan(a)},
+      {std::asin(a), 1.0 / std::sqrt(1.0 - a * a)},
+      {std::acos(a), -1.0 / std::sqrt(1.0 - a * a)},
+      {std::atan(a), 1.0 / (1.0 + a * a)},
+      {std::sinh(a), std::cosh(a)},
+      {std::cosh(a), std::sinh(a)},
+      {std::tanh(a), 1.0 - std::tanh(a) * std::tanh(a)},
+      {std::asinh(a), 1.0 / std::sqrt(a * a + 1.0)},
+      {std::atanh(a), 1.0 / (1.0 - a * a)},
+      {std::erf(a), 2.0 / std::sqrt(M_PI) * std::exp(-a * a)},
+      {std::pow(a, 2.5), 2.5 * std::pow(a, 1.5)},
+      {std::fabs(-a), 1.0}};
+  const adouble3 results[] = {exp(ad),  log(ad),   sqrt(ad),     cbrt(ad),
+                              sin(ad),  cos(ad),   tan(ad),      asin(ad),
+                              acos(ad), atan(ad),  sinh(ad),     cosh(ad),
+                              tanh(ad), asinh(ad), atanh(ad),    erf(ad),
+                              pow(ad, 2.5), fabs(-ad)};
+
+  for (size_t i = 0; i < sizeof(results) / sizeof(results[0]); ++i) {
+    BOOST_TEST(results[i].getValue() == expected[i][0], tt::tolerance(tol));
+    for (unsigned int l = 0; l < 3; ++l)
+      BOOST_TEST(results[i].getADValue(l) == expected[i][1] * dirs[l],
+                 tt::tolerance(tol));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FixedSizeHigherOrderSeries) {
+  const double a = 0.6;
+  const double dirs[2] = {1.0, 0.5};
+  ahov24 ad(a, dirs);
+
+  ahov24 e = exp(ad);
+  ahov24 s = sin(ad);
+  /* coefficients of f(a + t d) are f^(k)(a) d^k / k! */
+  double fact = 1.0;
+  for (int k = 0; k < 4; ++k) {
+    fact *= k + 1;
+    const double sinDeriv[4] = {std::cos(a), -std::sin(a), -std::cos(a),
+                                std::sin(a)};
+    for (int l = 0; l < 2; ++l) {
+      const double dk = std::pow(dirs[l], k + 1);
+      BOOST_TEST(e.getOneADValue(k)[l] == std::exp(a) * dk / fact,
+                 tt::tolerance(tol));
+      BOOST_TEST(s.getOneADValue(k)[l] == sinDeriv[k] * dk / fact,
+                 tt::tolerance(tol));
+    }
+  }
+  BOOST_TEST(e.getADValue(1) == std::exp(a) * dirs[1], tt::tolerance(tol));
+}
+
+BOOST_AUTO_TEST_CASE(FixedSizeHigherOrderRoundTrips) {
+  const double c1[2] = {1.0, -0.3};
+  const double c2[2] = {0.2, 0.7};
+  const double c3[2] = {-0.1, 0.4};
+  const double c4[2] = {0.05, -0.2};
+  const double *hov[4] = {c1, c2, c3, c4};
+  const ahov24 a(0.4, hov), b(1.7, hov);
+
+  const ahov24 trips[] = {log(exp(a)),
+                          sqrt(a) * sqrt(a),
+                          cbrt(a) * cbrt(a) * cbrt(a),
+                          asin(sin(a)),
+                          acos(cos(a)),
+                          atan(tan(a)),
+                          asinh(sinh(a)),
+                          acosh(cosh(a)),
+                          atanh(tanh(a)),
+                          pow(pow(a, 2.5), 0.4),
+                          a / b * b,
+                          atan2(sin(a), cos(a)),
+                          atan2(-2.0 * sin(a), -2.0 * cos(a)) + M_PI,
+                          fabs(-a),
+                          pow(b, a) / exp(a * log(b)) * a,
+                          exp(log10(a) * std::log(10.0))};
+
+  for (const ahov24 &t : trips) {
+    BOOST_TEST(t.getValue() == a.getValue(), tt::tolerance(tol));
+    for (int k = 0; k < 4; ++k)
+      for (int l = 0; l < 2; ++l)
+        BOOST_TEST(t.getOneADValue(k)[l] == hov[k][l], tt::tolerance(tol));
+  }
+
+  /* identities with a constant result */
+  const ahov24 ones[] = {sin(a) * sin(a) + cos(a) * cos(a),
+                         cosh(b) * cosh(b) - sinh(b) * sinh(b),
+                         erf(a) + erfc(a)};
+  for (const ahov24 &t : ones) {
+    BOOST_TEST(t.getValue() == 1.0, tt::tolerance(tol));
+    for (int k = 0; k < 4; ++k)
+      for (int l = 0; l < 2; ++l)
+        BOOST_TEST(t.getOneADValue(k)[l] == 0.0, tt::tolerance(tol));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(FixedSizeHigherOrderIntegerPowerAtZero) {
+  const double dirs[2] = {1.0, -3.0};
+  ahov24 t(0.0, dirs);
+  ahov24 p = pow(t, 2.0);
+
+  /* (t d)^2 has the only nonzero coefficient d^2 at order 2 */
+  BOOST_TEST(p.getValue() == 0.0);
+  for (int k = 0; k < 4; ++k)
+    for (int l = 0; l < 2; ++l)
+      BOOST_TEST(p.getOneADValue(k)[l] ==
+                     (k == 1 ? dirs[l] * dirs[l] : 0.0),
+                 tt::tolerance(tol));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
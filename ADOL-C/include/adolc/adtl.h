@@ -17,14 +17,12 @@
 #ifndef ADOLC_ADTL_H
 #define ADOLC_ADTL_H
 
+#include <adolc/adtl_arena.h>
 #include <adolc/internal/common.h>
 #include <list>
 #include <ostream>
 #include <stdexcept>
-
-#if USE_BOOST_POOL
-#include <boost/pool/pool_alloc.hpp>
-#endif
+#include <type_traits>
 
 using std::istream;
 using std::list;
@@ -52,6 +50,22 @@ public:
 };
 #endif
 
+/* The arithmetic operators +, -, * and / do not compute their result right
+ * away. They return an expression node that holds its operands and the
+ * primal value of the operation. Assigning the node to an adouble
+ * evaluates the derivatives of the whole expression in a single loop over
+ * the directions, so a*b + c*d needs no temporary adoubles. Nodes refer to
+ * their adouble operands and must not outlive the full expression, i.e.
+ * they must not be stored with auto. Every function expecting an adouble
+ * accepts a node, which is then evaluated into a temporary.              */
+struct adexpr {};
+
+template <class E> struct is_adexpr : std::is_base_of<adexpr, E> {};
+
+template <class E>
+using enable_if_adexpr =
+    typename std::enable_if<is_adexpr<E>::value, int>::type;
+
 // class func_ad {
 // public:
 //     virtual int operator() (int n, adouble *x, int m, adouble *y) = 0;
@@ -65,29 +79,10 @@ public:
   inline adouble(const adouble &a);
   inline ~adouble();
 
-  // sign
-  inline adouble operator-() const;
-  inline adouble operator+() const;
-
-  // addition
-  inline adouble operator+(const double v) const;
-  inline adouble operator+(const adouble &a) const;
-  inline friend adouble operator+(const double v, const adouble &a);
-
-  // subtraction
-  inline adouble operator-(const double v) const;
-  inline adouble operator-(const adouble &a) const;
-  inline friend adouble operator-(const double v, const adouble &a);
-
-  // multiplication
-  inline adouble operator*(const double v) const;
-  inline adouble operator*(const adouble &a) const;
-  inline friend adouble operator*(const double v, const adouble &a);
-
-  // division
-  inline adouble operator/(const double v) const;
-  inline adouble operator/(const adouble &a) const;
-  inline friend adouble operator/(const double v, const adouble &a);
+  /* evaluates an expression of the arithmetic operators */
+  template <class E, enable_if_adexpr<E> = 0> inline adouble(const E &e);
+  /* a moved-from adouble may only be assigned to or destroyed */
+  inline adouble(adouble &&a) noexcept;
 
   // inc/dec
   inline adouble operator++();
@@ -148,22 +143,33 @@ public:
   // assignment
   inline adouble &operator=(const double v);
   inline adouble &operator=(const adouble &a);
+  inline adouble &operator=(adouble &&a) noexcept;
+  template <class E, enable_if_adexpr<E> = 0>
+  inline adouble &operator=(const E &e);
 
   // addition
   inline adouble &operator+=(const double v);
   inline adouble &operator+=(const adouble &a);
+  template <class E, enable_if_adexpr<E> = 0>
+  inline adouble &operator+=(const E &e);
 
   // subtraction
   inline adouble &operator-=(const double v);
   inline adouble &operator-=(const adouble &a);
+  template <class E, enable_if_adexpr<E> = 0>
+  inline adouble &operator-=(const E &e);
 
   // multiplication
   inline adouble &operator*=(const double v);
   inline adouble &operator*=(const adouble &a);
+  template <class E, enable_if_adexpr<E> = 0>
+  inline adouble &operator*=(const E &e);
 
   // division
   inline adouble &operator/=(const double v);
   inline adouble &operator/=(const adouble &a);
+  template <class E, enable_if_adexpr<E> = 0>
+  inline adouble &operator/=(const E &e);
 
   // not
   inline bool operator!() const;
@@ -211,17 +217,35 @@ public:
   ADOLC_DLL_EXPORT friend istream &operator>>(istream &, adouble &);
 
 private:
-#if USE_BOOST_POOL
-  ADOLC_DLL_EXPIMP static boost::pool<boost::default_user_allocator_new_delete>
-      *advalpool;
-#endif
+  inline static double *newAdval();
+  friend class adref;
+
   double *adval;
 #ifdef USE_ADTL_REFCOUNTING
   refcounter __rcnt;
 #endif
   ADOLC_DLL_EXPIMP static size_t numDir;
+  inline static size_t &localNumDir();
   inline friend void setNumDir(const size_t p);
   inline friend size_t getNumDir();
+  friend class numdir_scope;
+};
+
+/* Sets the number of directions of the adoubles the calling thread creates
+ * while the scope is alive, overriding the one of setNumDir for this thread
+ * only. Threads can thus evaluate chunks of different widths at the same
+ * time. Adoubles created within the scope must not be mixed with adoubles
+ * of another width. Scopes can be nested.                                */
+class numdir_scope {
+public:
+  inline explicit numdir_scope(const size_t p);
+  inline ~numdir_scope();
+
+private:
+  numdir_scope(const numdir_scope &) = delete;
+  numdir_scope &operator=(const numdir_scope &) = delete;
+
+  size_t prev;
 };
 
 } // namespace adtl
@@ -249,18 +273,30 @@ inline void setNumDir(const size_t p) {
     abort();
   }
   adouble::numDir = p;
-#if USE_BOOST_POOL
-  if (adouble::advalpool != NULL) {
-    delete adouble::advalpool;
-    adouble::advalpool = NULL;
+}
+
+/* the number of directions of a numdir_scope of the calling thread, 0 if
+ * the thread uses the one of setNumDir */
+inline size_t &adouble::localNumDir() {
+  static thread_local size_t p = 0;
+  return p;
+}
+
+inline size_t getNumDir() {
+  const size_t p = adouble::localNumDir();
+  return p != 0 ? p : adouble::numDir;
+}
+
+inline numdir_scope::numdir_scope(const size_t p)
+    : prev(adouble::localNumDir()) {
+  if (p < 1) {
+    fprintf(DIAG_OUT, "ADOL-C Error: Traceless: p < 1 not possible\n");
+    abort();
   }
-  adouble::advalpool =
-      new boost::pool<boost::default_user_allocator_new_delete>(
-          (adouble::numDir + 1) * sizeof(double));
-#endif
+  adouble::localNumDir() = p;
 }
 
-inline size_t getNumDir() { return adouble::numDir; }
+inline numdir_scope::~numdir_scope() { adouble::localNumDir() = prev; }
 
 inline double makeNaN() {
   return ADOLC_MATH_NSP::numeric_limits<double>::quiet_NaN();
@@ -270,160 +306,358 @@ inline double makeInf() {
   return ADOLC_MATH_NSP::numeric_limits<double>::infinity();
 }
 
-#define FOR_I_EQ_0_LTEQ_NUMDIR for (size_t _i = 0; _i <= adouble::numDir; ++_i)
-#define FOR_I_EQ_1_LTEQ_NUMDIR for (size_t _i = 1; _i <= adouble::numDir; ++_i)
+#define FOR_I_EQ_0_LTEQ_NUMDIR                                                 \
+  for (size_t _i = 0, _n = getNumDir(); _i <= _n; ++_i)
+#define FOR_I_EQ_1_LTEQ_NUMDIR                                                 \
+  for (size_t _i = 1, _n = getNumDir(); _i <= _n; ++_i)
 #define ADVAL_I adval[_i]
 #define PRIMAL_VALUE adval[0]
 
 /*******************************  ctors  ************************************/
-inline adouble::adouble() : adval(NULL) {
-#if USE_BOOST_POOL
-  adval = reinterpret_cast<double *>(advalpool->malloc());
-#else
-  adval = new double[adouble::numDir + 1];
-#endif
+inline double *adouble::newAdval() {
+  return arena::allocate(getNumDir() + 1);
+}
+
+inline adouble::adouble() : adval(newAdval()) {
   PRIMAL_VALUE = 0.;
 }
 
-inline adouble::adouble(const double v) : adval(NULL) {
-#if USE_BOOST_POOL
-  adval = reinterpret_cast<double *>(advalpool->malloc());
-#else
-  adval = new double[adouble::numDir + 1];
-#endif
+inline adouble::adouble(const double v) : adval(newAdval()) {
   PRIMAL_VALUE = v;
   FOR_I_EQ_1_LTEQ_NUMDIR
   ADVAL_I = 0.0;
 }
 
-inline adouble::adouble(const double v, const double *adv) : adval(NULL) {
-#if USE_BOOST_POOL
-  adval = reinterpret_cast<double *>(advalpool->malloc());
-#else
-  adval = new double[adouble::numDir + 1];
-#endif
+inline adouble::adouble(const double v, const double *adv)
+    : adval(newAdval()) {
   PRIMAL_VALUE = v;
   FOR_I_EQ_1_LTEQ_NUMDIR
   ADVAL_I = adv[_i - 1];
 }
 
-inline adouble::adouble(const adouble &a) : adval(NULL) {
-#if USE_BOOST_POOL
-  adval = reinterpret_cast<double *>(advalpool->malloc());
-#else
-  adval = new double[adouble::numDir + 1];
-#endif
+inline adouble::adouble(const adouble &a) : adval(newAdval()) {
   FOR_I_EQ_0_LTEQ_NUMDIR
   ADVAL_I = a.ADVAL_I;
 }
 
+inline adouble::adouble(adouble &&a) noexcept : adval(a.adval) {
+  a.adval = NULL;
+}
+
+template <class E, enable_if_adexpr<E>>
+inline adouble::adouble(const E &e) : adval(newAdval()) {
+  PRIMAL_VALUE = e.val;
+  FOR_I_EQ_1_LTEQ_NUMDIR
+  ADVAL_I = e.der(_i);
+}
+
 /*******************************  dtors  ************************************/
 inline adouble::~adouble() {
   if (adval != NULL)
-#if USE_BOOST_POOL
-    advalpool->free(adval);
-#else
-    delete[] adval;
-#endif
+    arena::release(adval);
 }
 
 /*************************  temporary results  ******************************/
+/* Every node provides the primal value val of its operation, computed once
+ * when the node is built, and der(i) for the i-th derivative, 1 <= i <=
+ * numDir, computed from the derivatives of its operands. */
+
+// an adouble operand
+class adref : public adexpr {
+public:
+  inline explicit adref(const adouble &a) : adv(a.adval), val(a.PRIMAL_VALUE) {}
+  inline double der(const size_t i) const { return adv[i]; }
+
+private:
+  const double *adv;
+
+public:
+  const double val;
+};
+
+template <class E> struct adoperand {
+  typedef E type;
+};
+
+template <> struct adoperand<adouble> {
+  typedef adref type;
+};
+
+template <class E>
+struct is_adoperand
+    : std::integral_constant<bool, is_adexpr<E>::value ||
+                                       std::is_same<E, adouble>::value> {};
+
+template <class E>
+using enable_if_adoperand =
+    typename std::enable_if<is_adoperand<E>::value, int>::type;
+
+template <class L, class R>
+using enable_if_adoperands = typename std::enable_if<
+    is_adoperand<L>::value && is_adoperand<R>::value, int>::type;
+
+/* operands of which at least one is a node */
+template <class L, class R>
+using enable_if_adnodes = typename std::enable_if<
+    is_adoperand<L>::value && is_adoperand<R>::value &&
+        (is_adexpr<L>::value || is_adexpr<R>::value),
+    int>::type;
+
+// a + b
+template <class L, class R> class adsum : public adexpr {
+public:
+  inline adsum(const L &l, const R &r) : l(l), r(r), val(l.val + r.val) {}
+  inline double der(const size_t i) const { return l.der(i) + r.der(i); }
+
+private:
+  const L l;
+  const R r;
+
+public:
+  const double val;
+};
+
+// a - b
+template <class L, class R> class addiff : public adexpr {
+public:
+  inline addiff(const L &l, const R &r) : l(l), r(r), val(l.val - r.val) {}
+  inline double der(const size_t i) const { return l.der(i) - r.der(i); }
+
+private:
+  const L l;
+  const R r;
+
+public:
+  const double val;
+};
+
+// a * b
+template <class L, class R> class adprod : public adexpr {
+public:
+  inline adprod(const L &l, const R &r) : l(l), r(r), val(l.val * r.val) {}
+  inline double der(const size_t i) const {
+    return l.der(i) * r.val + l.val * r.der(i);
+  }
+
+private:
+  const L l;
+  const R r;
+
+public:
+  const double val;
+};
+
+// a / b
+template <class L, class R> class adquot : public adexpr {
+public:
+  inline adquot(const L &l, const R &r)
+      : l(l), r(r), rsq(r.val * r.val), val(l.val / r.val) {}
+  inline double der(const size_t i) const {
+    return (l.der(i) * r.val - l.val * r.der(i)) / rsq;
+  }
+
+private:
+  const L l;
+  const R r;
+  const double rsq;
+
+public:
+  const double val;
+};
+
+// a + v, v + a, a - v, +a
+template <class E> class adshift : public adexpr {
+public:
+  inline adshift(const E &e, const double val) : e(e), val(val) {}
+  inline double der(const size_t i) const { return e.der(i); }
+
+private:
+  const E e;
+
+public:
+  const double val;
+};
+
+// v - a, -a
+template <class E> class adneg : public adexpr {
+public:
+  inline adneg(const E &e, const double val) : e(e), val(val) {}
+  inline double der(const size_t i) const { return -e.der(i); }
+
+private:
+  const E e;
+
+public:
+  const double val;
+};
+
+// a * v, v * a
+template <class E> class adscale : public adexpr {
+public:
+  inline adscale(const E &e, const double v) : e(e), v(v), val(e.val * v) {}
+  inline double der(const size_t i) const { return e.der(i) * v; }
+
+private:
+  const E e;
+  const double v;
+
+public:
+  const double val;
+};
+
+// a / v
+template <class E> class adshrink : public adexpr {
+public:
+  inline adshrink(const E &e, const double v) : e(e), v(v), val(e.val / v) {}
+  inline double der(const size_t i) const { return e.der(i) / v; }
+
+private:
+  const E e;
+  const double v;
+
+public:
+  const double val;
+};
+
+// v / a
+template <class E> class adrecip : public adexpr {
+public:
+  inline adrecip(const double v, const E &e)
+      : e(e), v(v), esq(e.val * e.val), val(v / e.val) {}
+  inline double der(const size_t i) const { return (-v * e.der(i)) / esq; }
+
+private:
+  const E e;
+  const double v;
+  const double esq;
+
+public:
+  const double val;
+};
+
 // sign
-inline adouble adouble::operator-() const {
-  adouble tmp;
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  tmp.ADVAL_I = -ADVAL_I;
-  return tmp;
+template <class E, enable_if_adoperand<E> = 0>
+inline adneg<typename adoperand<E>::type> operator-(const E &a) {
+  typename adoperand<E>::type e(a);
+  return adneg<typename adoperand<E>::type>(e, -e.val);
 }
 
-inline adouble adouble::operator+() const { return *this; }
+template <class E, enable_if_adoperand<E> = 0>
+inline adshift<typename adoperand<E>::type> operator+(const E &a) {
+  typename adoperand<E>::type e(a);
+  return adshift<typename adoperand<E>::type>(e, e.val);
+}
 
 // addition
-inline adouble adouble::operator+(const double v) const {
-  adouble tmp(PRIMAL_VALUE + v, adval + 1);
-  return tmp;
+template <class L, class R, enable_if_adoperands<L, R> = 0>
+inline adsum<typename adoperand<L>::type, typename adoperand<R>::type>
+operator+(const L &a, const R &b) {
+  return adsum<typename adoperand<L>::type, typename adoperand<R>::type>(
+      typename adoperand<L>::type(a), typename adoperand<R>::type(b));
 }
 
-inline adouble adouble::operator+(const adouble &a) const {
-  adouble tmp;
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  tmp.ADVAL_I = ADVAL_I + a.ADVAL_I;
-  return tmp;
+template <class E, enable_if_adoperand<E> = 0>
+inline adshift<typename adoperand<E>::type> operator+(const E &a,
+                                                      const double v) {
+  typename adoperand<E>::type e(a);
+  return adshift<typename adoperand<E>::type>(e, e.val + v);
 }
 
-inline adouble operator+(const double v, const adouble &a) {
-  adouble tmp(v + a.PRIMAL_VALUE, a.adval + 1);
-  return tmp;
+template <class E, enable_if_adoperand<E> = 0>
+inline adshift<typename adoperand<E>::type> operator+(const double v,
+                                                      const E &a) {
+  typename adoperand<E>::type e(a);
+  return adshift<typename adoperand<E>::type>(e, v + e.val);
 }
 
 // subtraction
-inline adouble adouble::operator-(const double v) const {
-  adouble tmp(PRIMAL_VALUE - v, adval + 1);
-  return tmp;
+template <class L, class R, enable_if_adoperands<L, R> = 0>
+inline addiff<typename adoperand<L>::type, typename adoperand<R>::type>
+operator-(const L &a, const R &b) {
+  return addiff<typename adoperand<L>::type, typename adoperand<R>::type>(
+      typename adoperand<L>::type(a), typename adoperand<R>::type(b));
 }
 
-inline adouble adouble::operator-(const adouble &a) const {
-  adouble tmp;
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  tmp.ADVAL_I = ADVAL_I - a.ADVAL_I;
-  return tmp;
+template <class E, enable_if_adoperand<E> = 0>
+inline adshift<typename adoperand<E>::type> operator-(const E &a,
+                                                      const double v) {
+  typename adoperand<E>::type e(a);
+  return adshift<typename adoperand<E>::type>(e, e.val - v);
 }
 
-inline adouble operator-(const double v, const adouble &a) {
-  adouble tmp;
-  tmp.PRIMAL_VALUE = v - a.PRIMAL_VALUE;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = -a.ADVAL_I;
-  return tmp;
+template <class E, enable_if_adoperand<E> = 0>
+inline adneg<typename adoperand<E>::type> operator-(const double v,
+                                                    const E &a) {
+  typename adoperand<E>::type e(a);
+  return adneg<typename adoperand<E>::type>(e, v - e.val);
 }
 
 // multiplication
-inline adouble adouble::operator*(const double v) const {
-  adouble tmp;
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  tmp.ADVAL_I = ADVAL_I * v;
-  return tmp;
+template <class L, class R, enable_if_adoperands<L, R> = 0>
+inline adprod<typename adoperand<L>::type, typename adoperand<R>::type>
+operator*(const L &a, const R &b) {
+  return adprod<typename adoperand<L>::type, typename adoperand<R>::type>(
+      typename adoperand<L>::type(a), typename adoperand<R>::type(b));
 }
 
-inline adouble adouble::operator*(const adouble &a) const {
-  adouble tmp;
-  tmp.PRIMAL_VALUE = PRIMAL_VALUE * a.PRIMAL_VALUE;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = ADVAL_I * a.PRIMAL_VALUE + PRIMAL_VALUE * a.ADVAL_I;
-  return tmp;
+template <class E, enable_if_adoperand<E> = 0>
+inline adscale<typename adoperand<E>::type> operator*(const E &a,
+                                                      const double v) {
+  return adscale<typename adoperand<E>::type>(typename adoperand<E>::type(a),
+                                              v);
 }
 
-inline adouble operator*(const double v, const adouble &a) {
-  adouble tmp;
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  tmp.ADVAL_I = v * a.ADVAL_I;
-  return tmp;
+template <class E, enable_if_adoperand<E> = 0>
+inline adscale<typename adoperand<E>::type> operator*(const double v,
+                                                      const E &a) {
+  return adscale<typename adoperand<E>::type>(typename adoperand<E>::type(a),
+                                              v);
 }
 
 // division
-inline adouble adouble::operator/(const double v) const {
-  adouble tmp;
-  FOR_I_EQ_0_LTEQ_NUMDIR
-  tmp.ADVAL_I = ADVAL_I / v;
-  return tmp;
-}
-
-inline adouble adouble::operator/(const adouble &a) const {
-  adouble tmp;
-  tmp.PRIMAL_VALUE = PRIMAL_VALUE / a.PRIMAL_VALUE;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = (ADVAL_I * a.PRIMAL_VALUE - PRIMAL_VALUE * a.ADVAL_I) /
-                (a.PRIMAL_VALUE * a.PRIMAL_VALUE);
-  return tmp;
-}
-
-inline adouble operator/(const double v, const adouble &a) {
-  adouble tmp;
-  tmp.PRIMAL_VALUE = v / a.PRIMAL_VALUE;
-  FOR_I_EQ_1_LTEQ_NUMDIR
-  tmp.ADVAL_I = (-v * a.ADVAL_I) / (a.PRIMAL_VALUE * a.PRIMAL_VALUE);
-  return tmp;
-}
+template <class L, class R, enable_if_adoperands<L, R> = 0>
+inline adquot<typename adoperand<L>::type, typename adoperand<R>::type>
+operator/(const L &a, const R &b) {
+  return adquot<typename adoperand<L>::type, typename adoperand<R>::type>(
+      typename adoperand<L>::type(a), typename adoperand<R>::type(b));
+}
+
+template <class E, enable_if_adoperand<E> = 0>
+inline adshrink<typename adoperand<E>::type> operator/(const E &a,
+                                                       const double v) {
+  return adshrink<typename adoperand<E>::type>(typename adoperand<E>::type(a),
+                                               v);
+}
+
+template <class E, enable_if_adoperand<E> = 0>
+inline adrecip<typename adoperand<E>::type> operator/(const double v,
+                                                      const E &a) {
+  return adrecip<typename adoperand<E>::type>(v,
+                                              typename adoperand<E>::type(a));
+}
+
+// comparison of nodes
+#define ADOLC_ADTL_EXPR_COMPARISON(op)                                         \
+  template <class L, class R, enable_if_adnodes<L, R> = 0>                     \
+  inline bool operator op(const L &a, const R &b) {                            \
+    return typename adoperand<L>::type(a).val op                               \
+        typename adoperand<R>::type(b).val;                                    \
+  }                                                                            \
+  template <class E, enable_if_adexpr<E> = 0>                                  \
+  inline bool operator op(const E &a, const double v) {                        \
+    return a.val op v;                                                         \
+  }                                                                            \
+  template <class E, enable_if_adexpr<E> = 0>                                  \
+  inline bool operator op(const double v, const E &a) {                        \
+    return v op a.val;                                                         \
+  }
+ADOLC_ADTL_EXPR_COMPARISON(!=)
+ADOLC_ADTL_EXPR_COMPARISON(==)
+ADOLC_ADTL_EXPR_COMPARISON(<=)
+ADOLC_ADTL_EXPR_COMPARISON(>=)
+ADOLC_ADTL_EXPR_COMPARISON(>)
+ADOLC_ADTL_EXPR_COMPARISON(<)
+#undef ADOLC_ADTL_EXPR_COMPARISON
 
 // inc/dec
 inline adouble adouble::operator++() {
@@ -920,6 +1154,8 @@ inline void condeqassign(adouble &res, const adouble &cond,
 
 /*******************  nontemporary results  *********************************/
 inline adouble &adouble::operator=(const double v) {
+  if (adval == NULL)
+    adval = newAdval();
   PRIMAL_VALUE = v;
   FOR_I_EQ_1_LTEQ_NUMDIR
   ADVAL_I = 0.0;
@@ -927,11 +1163,66 @@ inline adouble &adouble::operator=(const double v) {
 }
 
 inline adouble &adouble::operator=(const adouble &a) {
+  if (adval == NULL)
+    adval = newAdval();
   FOR_I_EQ_0_LTEQ_NUMDIR
   ADVAL_I = a.ADVAL_I;
   return *this;
 }
 
+inline adouble &adouble::operator=(adouble &&a) noexcept {
+  double *tmp = adval;
+  adval = a.adval;
+  a.adval = tmp;
+  return *this;
+}
+
+/* The derivatives of a node only depend on the same direction of its
+ * operands and the primal values are kept in the node, so the result can
+ * be written in place even if the adouble is an operand itself. */
+template <class E, enable_if_adexpr<E>>
+inline adouble &adouble::operator=(const E &e) {
+  if (adval == NULL)
+    adval = newAdval();
+  FOR_I_EQ_1_LTEQ_NUMDIR
+  ADVAL_I = e.der(_i);
+  PRIMAL_VALUE = e.val;
+  return *this;
+}
+
+template <class E, enable_if_adexpr<E>>
+inline adouble &adouble::operator+=(const E &e) {
+  FOR_I_EQ_1_LTEQ_NUMDIR
+  ADVAL_I += e.der(_i);
+  PRIMAL_VALUE += e.val;
+  return *this;
+}
+
+template <class E, enable_if_adexpr<E>>
+inline adouble &adouble::operator-=(const E &e) {
+  FOR_I_EQ_1_LTEQ_NUMDIR
+  ADVAL_I -= e.der(_i);
+  PRIMAL_VALUE -= e.val;
+  return *this;
+}
+
+template <class E, enable_if_adexpr<E>>
+inline adouble &adouble::operator*=(const E &e) {
+  FOR_I_EQ_1_LTEQ_NUMDIR
+  ADVAL_I = ADVAL_I * e.val + PRIMAL_VALUE * e.der(_i);
+  PRIMAL_VALUE *= e.val;
+  return *this;
+}
+
+template <class E, enable_if_adexpr<E>>
+inline adouble &adouble::operator/=(const E &e) {
+  const double esq = e.val * e.val;
+  FOR_I_EQ_1_LTEQ_NUMDIR
+  ADVAL_I = (ADVAL_I * e.val - PRIMAL_VALUE * e.der(_i)) / esq;
+  PRIMAL_VALUE = PRIMAL_VALUE / e.val;
+  return *this;
+}
+
 inline adouble &adouble::operator+=(const double v) {
   PRIMAL_VALUE += v;
   return *this;
@@ -1076,7 +1367,7 @@ inline void adouble::setADValue(const double *const v) {
 }
 
 inline double adouble::getADValue(const unsigned int p) const {
-  if (p >= adouble::numDir) {
+  if (p >= getNumDir()) {
     fprintf(DIAG_OUT, "Derivative array accessed out of bounds"
                       " while \"getADValue(...)\"!!!\n");
     throw logic_error("incorrect function call, errorcode=-1");
@@ -1085,7 +1376,7 @@ inline double adouble::getADValue(const unsigned int p) const {
 }
 
 inline void adouble::setADValue(const unsigned int p, const double v) {
-  if (p >= adouble::numDir) {
+  if (p >= getNumDir()) {
     fprintf(DIAG_OUT, "Derivative array accessed out of bounds"
                       " while \"setADValue(...)\"!!!\n");
     throw logic_error("incorrect function call, errorcode=-1");
@@ -0,0 +1,230 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     adtl_arena.h
+ Revision: $Id$
+ Contents: adtl_arena.h contains the per-thread arena from which the
+           traceless adoubles allocate their derivative arrays.
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Benjamin Letschert, Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#ifndef ADOLC_ADTL_ARENA_H
+#define ADOLC_ADTL_ARENA_H
+
+#include <cstddef>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace adtl {
+
+/* Every thread allocates the derivative arrays of its traceless adoubles
+ * from its own arena, so no locks are taken and threads can evaluate
+ * traceless code in parallel. The arena cuts the arrays out of large slabs
+ * and recycles freed arrays through one free list per array size. Each
+ * array is preceded by one double holding its size, so arrays allocated
+ * before a setNumDir are still released correctly. Arrays may be released
+ * by any thread. The slabs of a finished thread are handed on to the next
+ * new thread, so arrays outliving their thread stay valid.               */
+class arena {
+public:
+  /* returns an uninitialised array of n doubles */
+  static inline double *allocate(const size_t n);
+  static inline void release(double *p);
+
+  /* number of doubles handed out by the slabs of the calling thread */
+  static inline size_t getUsed();
+
+private:
+  friend class arena_scope;
+
+  struct slab {
+    double *mem;
+    size_t size;
+  };
+  struct freelist {
+    size_t n;
+    double *head;
+  };
+  struct mark {
+    size_t slab;
+    size_t used;
+  };
+
+  /* the default slab holds 1 MB */
+  static constexpr size_t slabSize = (1 << 20) / sizeof(double);
+
+  inline arena() : cur(0), used(0) {}
+  inline double *bump(const size_t n, const size_t scoped);
+
+  static inline arena *&local();
+  static inline bool &finished();
+  static inline arena &get();
+
+  /* arenas of finished threads, they are never freed */
+  struct orphanage {
+    std::mutex lock;
+    std::vector<arena *> arenas;
+  };
+  static inline orphanage &orphans();
+
+  struct keeper {
+    inline ~keeper();
+  };
+
+  std::vector<slab> slabs;
+  size_t cur, used;
+  std::vector<freelist> lists;
+  std::vector<mark> marks;
+};
+
+/* Releases all derivative arrays the calling thread allocates while the
+ * scope is alive at once when it ends, instead of recycling them one by
+ * one. All adoubles created within the scope must be destroyed before the
+ * scope ends, and they must not be moved into adoubles living longer.
+ * Scopes can be nested.                                                  */
+class arena_scope {
+public:
+  inline arena_scope();
+  inline ~arena_scope();
+
+private:
+  arena_scope(const arena_scope &) = delete;
+  arena_scope &operator=(const arena_scope &) = delete;
+};
+
+/* The header of an array holds its size shifted by one, the lowest bit is
+ * set for arrays of a scope. */
+inline double *arena::allocate(const size_t n) {
+  arena &a = get();
+  if (a.marks.empty()) {
+    for (size_t i = 0; i < a.lists.size(); ++i)
+      if (a.lists[i].n == n) {
+        double *p = a.lists[i].head;
+        if (p != NULL) {
+          std::memcpy(&a.lists[i].head, p, sizeof(double *));
+          return p;
+        }
+        break;
+      }
+    return a.bump(n, 0);
+  }
+  /* arrays of a scope are only taken from the end of the used slab memory,
+   * so that the end of the scope can cut them off again */
+  return a.bump(n, 1);
+}
+
+inline double *arena::bump(const size_t n, const size_t scoped) {
+  while (cur < slabs.size() && used + n + 1 > slabs[cur].size) {
+    ++cur;
+    used = 0;
+  }
+  if (cur == slabs.size()) {
+    slab s;
+    s.size = n + 1 > slabSize ? n + 1 : slabSize;
+    s.mem = static_cast<double *>(::operator new(s.size * sizeof(double)));
+    slabs.push_back(s);
+    used = 0;
+  }
+  double *p = slabs[cur].mem + used;
+  const size_t header = (n << 1) | scoped;
+  std::memcpy(p, &header, sizeof(size_t));
+  used += n + 1;
+  return p + 1;
+}
+
+inline void arena::release(double *p) {
+  size_t header;
+  std::memcpy(&header, p - 1, sizeof(size_t));
+  if (header & 1)
+    return;
+  if (finished())
+    return;
+  arena &a = get();
+  const size_t n = header >> 1;
+  for (size_t i = 0; i < a.lists.size(); ++i)
+    if (a.lists[i].n == n) {
+      std::memcpy(p, &a.lists[i].head, sizeof(double *));
+      a.lists[i].head = p;
+      return;
+    }
+  freelist f;
+  f.n = n;
+  f.head = p;
+  double *next = NULL;
+  std::memcpy(p, &next, sizeof next);
+  a.lists.push_back(f);
+}
+
+inline size_t arena::getUsed() {
+  const arena &a = get();
+  size_t total = a.used;
+  for (size_t i = 0; i < a.cur && i < a.slabs.size(); ++i)
+    total += a.slabs[i].size;
+  return total;
+}
+
+inline arena *&arena::local() {
+  static thread_local arena *a = NULL;
+  return a;
+}
+
+inline bool &arena::finished() {
+  static thread_local bool done = false;
+  return done;
+}
+
+inline arena::orphanage &arena::orphans() {
+  static orphanage *o = new orphanage;
+  return *o;
+}
+
+inline arena::keeper::~keeper() {
+  orphanage &o = orphans();
+  std::lock_guard<std::mutex> guard(o.lock);
+  o.arenas.push_back(local());
+  local() = NULL;
+  finished() = true;
+}
+
+inline arena &arena::get() {
+  arena *&a = local();
+  if (a == NULL) {
+    static thread_local keeper k;
+    orphanage &o = orphans();
+    std::lock_guard<std::mutex> guard(o.lock);
+    if (o.arenas.empty())
+      a = new arena;
+    else {
+      a = o.arenas.back();
+      o.arenas.pop_back();
+    }
+    (void)k;
+  }
+  return *a;
+}
+
+inline arena_scope::arena_scope() {
+  arena &a = arena::get();
+  arena::mark m;
+  m.slab = a.cur;
+  m.used = a.used;
+  a.marks.push_back(m);
+}
+
+inline arena_scope::~arena_scope() {
+  arena &a = arena::get();
+  a.cur = a.marks.back().slab;
+  a.used = a.marks.back().used;
+  a.marks.pop_back();
+}
+
+} // namespace adtl
+#endif
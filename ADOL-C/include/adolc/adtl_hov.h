@@ -17,11 +17,13 @@
 #ifndef ADOLC_ADTL_HOV_H
 #define ADOLC_ADTL_HOV_H
 
-#include <adolc/adalloc.h> //for myalloc2
+#include <adolc/adalloc.h>
+#include <adolc/adtl_arena.h>
 #include <adolc/internal/common.h>
 #include <list>
 #include <ostream>
 #include <stdexcept>
+#include <utility>
 
 using std::istream;
 using std::list;
@@ -158,6 +160,7 @@ public:
   // assignment
   inline adouble &operator=(const double v);
   inline adouble &operator=(const adouble &a);
+  inline adouble &operator=(adouble &&a) noexcept;
 
   // addition
   inline adouble &operator+=(const double v);
@@ -250,6 +253,8 @@ private:
 #ifdef USE_ADTL_REFCOUNTING
   refcounter __rcnt;
 #endif
+  inline static double *newAdval();
+  inline static double **newHoDeriv();
   inline static bool _do_val();
   inline static bool _do_adval();
   inline static bool _do_hoval();
@@ -257,9 +262,31 @@ private:
   ADOLC_DLL_EXPIMP static size_t numDir;
   ADOLC_DLL_EXPIMP static size_t degree;
   ADOLC_DLL_EXPIMP static enum Mode forward_mode;
+  inline static size_t &localNumDir();
+  inline static size_t &localDegree();
   inline friend void setNumDir(const size_t p);
   inline friend void setDegree(const size_t p);
   inline friend void setMode(enum Mode newmode);
+  inline friend size_t getNumDir();
+  inline friend size_t getDegree();
+  friend class numdir_scope;
+};
+
+/* Sets the number of directions and the degree of the adoubles the calling
+ * thread creates while the scope is alive, overriding the ones of setNumDir
+ * and setDegree for this thread only. Adoubles created within the scope
+ * must not be mixed with adoubles of another width or degree. Scopes can
+ * be nested.                                                             */
+class numdir_scope {
+public:
+  inline numdir_scope(const size_t p, const size_t d);
+  inline ~numdir_scope();
+
+private:
+  numdir_scope(const numdir_scope &) = delete;
+  numdir_scope &operator=(const numdir_scope &) = delete;
+
+  size_t prevNumDir, prevDegree;
 };
 
 } // namespace adtl_hov
@@ -361,6 +388,43 @@ inline void setMode(enum Mode newmode) {
   adouble::forward_mode = newmode;
 }
 
+/* the number of directions and the degree of a numdir_scope of the calling
+ * thread, 0 if the thread uses the ones of setNumDir and setDegree */
+inline size_t &adouble::localNumDir() {
+  static thread_local size_t p = 0;
+  return p;
+}
+
+inline size_t &adouble::localDegree() {
+  static thread_local size_t d = 0;
+  return d;
+}
+
+inline size_t getNumDir() {
+  const size_t p = adouble::localNumDir();
+  return p != 0 ? p : adouble::numDir;
+}
+
+inline size_t getDegree() {
+  const size_t d = adouble::localDegree();
+  return d != 0 ? d : adouble::degree;
+}
+
+inline numdir_scope::numdir_scope(const size_t p, const size_t d)
+    : prevNumDir(adouble::localNumDir()), prevDegree(adouble::localDegree()) {
+  if (p < 1 || d < 1) {
+    fprintf(DIAG_OUT, "ADOL-C Error: Traceless: p < 1 not possible.\n");
+    abort();
+  }
+  adouble::localNumDir() = p;
+  adouble::localDegree() = d;
+}
+
+inline numdir_scope::~numdir_scope() {
+  adouble::localNumDir() = prevNumDir;
+  adouble::localDegree() = prevDegree;
+}
+
 inline double makeNaN() {
   return ADOLC_MATH_NSP::numeric_limits<double>::quiet_NaN();
 }
@@ -369,22 +433,40 @@ inline double makeInf() {
   return ADOLC_MATH_NSP::numeric_limits<double>::infinity();
 }
 
-#define FOR_I_EQ_0_LT_NUMDIR for (int _i = 0; _i < adouble::numDir; ++_i)
+#define FOR_I_EQ_0_LT_NUMDIR                                                   \
+  for (size_t _i = 0, _n = getNumDir(); _i < _n; ++_i)
 #define FOR_J_EQ_0_LT_DEGREE_FOR_I_EQ_0_LT_NUMDIR                              \
-  for (int _j = 0; _j < adouble::degree; ++_j)                                 \
-    for (int _i = 0; _i < adouble::numDir; ++_i)
+  for (size_t _j = 0, _d = getDegree(), _n = getNumDir(); _j < _d; ++_j)     \
+    for (size_t _i = 0; _i < _n; ++_i)
 #define FOR_I_EQ_0_LT_NUMDIR_FOR_J_EQ_0_LT_DEGREE                              \
-  for (int _i = 0; _i < adouble::numDir; ++_i)                                 \
-    for (int _j = 0; _j < adouble::degree; ++_j)
+  for (size_t _i = 0, _n = getNumDir(), _d = getDegree(); _i < _n; ++_i)     \
+    for (size_t _j = 0; _j < _d; ++_j)
 #define ADVAL_I adval[_i]
 #define ADV_I adv[_i]
 #define V_I v[_i]
 #define HO_DER_I_J ho_deriv[_j][_i]
 
 /*******************************  ctors  ************************************/
-inline adouble::adouble() : val(0), adval(NULL) {
+inline double *adouble::newAdval() {
+  return adtl::arena::allocate(getNumDir());
+}
+
+/* the row pointers and the rows of ho_deriv share one array of the arena,
+ * the pointers take the first degree entries */
+inline double **adouble::newHoDeriv() {
+  static_assert(sizeof(double *) <= sizeof(double),
+                "row pointers must fit into the entries of the array");
+  const size_t n = getNumDir(), d = getDegree();
+  double *p = adtl::arena::allocate(d * (n + 1));
+  double **rows = reinterpret_cast<double **>(p);
+  for (size_t j = 0; j < d; ++j)
+    rows[j] = p + d + j * n;
+  return rows;
+}
+
+inline adouble::adouble() : val(0), adval(NULL), ho_deriv(NULL) {
   if (do_adval())
-    adval = new double[adouble::numDir];
+    adval = newAdval();
 
   //     ho_deriv= new double[adouble::degree][ adouble::numDir];
   // double** ho_deriv= new double*[adouble::degree];
@@ -393,7 +475,7 @@ inline adouble::adouble() : val(0), adval(NULL) {
   //    	std::cout << "constructing adtl:   degree: " << adouble::degree
   //    << "  numDir: " << adouble::numDir << std::endl;
   {
-    ho_deriv = myalloc2(adouble::degree, adouble::numDir);
+    ho_deriv = newHoDeriv();
   }
   /*
       for(int i=0;i< adouble::degree;i++)
@@ -407,15 +489,16 @@ inline adouble::adouble() : val(0), adval(NULL) {
   }
 }
 
-inline adouble::adouble(const double v) : val(v), adval(NULL) {
+inline adouble::adouble(const double v)
+    : val(v), adval(NULL), ho_deriv(NULL) {
   if (do_adval()) {
-    adval = new double[adouble::numDir];
+    adval = newAdval();
     FOR_I_EQ_0_LT_NUMDIR
     ADVAL_I = 0.0;
   }
   if (do_hoval()) // ADTL_HOV
   {
-    ho_deriv = myalloc2(adouble::degree, adouble::numDir);
+    ho_deriv = newHoDeriv();
     FOR_J_EQ_0_LT_DEGREE_FOR_I_EQ_0_LT_NUMDIR
     HO_DER_I_J = 0.0;
   }
@@ -426,9 +509,9 @@ inline adouble::adouble(const double v) : val(v), adval(NULL) {
 }
 
 inline adouble::adouble(const double v, const double *adv)
-    : val(v), adval(NULL) {
+    : val(v), adval(NULL), ho_deriv(NULL) {
   if (do_adval()) {
-    adval = new double[adouble::numDir];
+    adval = newAdval();
     FOR_I_EQ_0_LT_NUMDIR
     ADVAL_I = ADV_I;
   }
@@ -444,10 +527,10 @@ inline adouble::adouble(const double v, const double *adv)
   }
 }
 inline adouble::adouble(const double v, const double **hov)
-    : val(v), ho_deriv(NULL) {
+    : val(v), adval(NULL), ho_deriv(NULL) {
   if (do_hoval()) // ADTL_HOV
   {
-    ho_deriv = myalloc2(adouble::degree, adouble::numDir);
+    ho_deriv = newHoDeriv();
     FOR_J_EQ_0_LT_DEGREE_FOR_I_EQ_0_LT_NUMDIR
     HO_DER_I_J = hov[_j][_i];
   }
@@ -462,15 +545,16 @@ inline adouble::adouble(const double v, const double **hov)
   }
 }
 
-inline adouble::adouble(const adouble &a) : val(a.val), adval(NULL) {
+inline adouble::adouble(const adouble &a)
+    : val(a.val), adval(NULL), ho_deriv(NULL) {
   if (do_adval()) {
-    adval = new double[adouble::numDir];
+    adval = newAdval();
     FOR_I_EQ_0_LT_NUMDIR
     ADVAL_I = a.ADVAL_I;
   }
   if (do_hoval()) // ADTL_HOV
   {
-    ho_deriv = myalloc2(adouble::degree, adouble::numDir);
+    ho_deriv = newHoDeriv();
     FOR_J_EQ_0_LT_DEGREE_FOR_I_EQ_0_LT_NUMDIR
     HO_DER_I_J = a.HO_DER_I_J;
   }
@@ -485,9 +569,9 @@ inline adouble::adouble(const adouble &a) : val(a.val), adval(NULL) {
 /*******************************  dtors  ************************************/
 inline adouble::~adouble() {
   if (adval != NULL)
-    delete[] adval;
-//    if(ho_deriv!=NULL)
-//    	delete[][]  ho_deriv;
+    adtl::arena::release(adval);
+  if (ho_deriv != NULL)
+    adtl::arena::release(reinterpret_cast<double *>(ho_deriv));
 #if 0
     if ( !pattern.empty() )
 	pattern.clear();
@@ -647,8 +731,8 @@ inline adouble adouble::operator*(const adouble &a) const {
   {
     int i;
     double sum = 0.0;
-    for (int l = 0; l < numDir; l++) {
-      for (int k = 0; k < degree; k++) {
+    for (int l = 0; l < getNumDir(); l++) {
+      for (int k = 0; k < getDegree(); k++) {
         sum = val * a.ho_deriv[k][l] + ho_deriv[k][l] * a.val;
         i = k - 1;
         for (int j = 0; j < k; j++) {
@@ -720,8 +804,8 @@ inline adouble adouble::operator/(const adouble &a) const {
   {
     int i;
     double sum = 0.0;
-    for (int l = 0; l < adouble::numDir; l++) {
-      for (int k = 0; k < adouble::degree; k++) {
+    for (int l = 0; l < getNumDir(); l++) {
+      for (int k = 0; k < getDegree(); k++) {
         sum = tmp.val * a.ho_deriv[k][l];
         i = k - 1;
         for (int j = 0; j < k; j++) {
@@ -757,8 +841,8 @@ inline adouble operator/(const double v, const adouble &a) {
   {
     int i;
     double sum = 0.0;
-    for (int l = 0; l < adouble::numDir; l++) {
-      for (int k = 0; k < adouble::degree; k++) {
+    for (int l = 0; l < getNumDir(); l++) {
+      for (int k = 0; k < getDegree(); k++) {
         sum = tmp.val * a.ho_deriv[k][l];
         i = k - 1;
         for (int j = 0; j < k; j++) {
@@ -877,7 +961,7 @@ inline adouble exp(const adouble &a) {
     double sum = 0;
     int i;
     FOR_I_EQ_0_LT_NUMDIR
-    for (int k = 0; k < adouble::degree; k++) {
+    for (int k = 0; k < getDegree(); k++) {
       sum = tmp.val * (k + 1) * a.ho_deriv[k][_i];
       i = k - 1;
       for (int j = 0; j < k; j++)
@@ -915,8 +999,8 @@ inline adouble log(const adouble &a) {
   {
     int i;
     double sum = 0.0;
-    for (int l = 0; l < adouble::numDir; l++) {
-      for (int k = 0; k < adouble::degree; k++) {
+    for (int l = 0; l < getNumDir(); l++) {
+      for (int k = 0; k < getDegree(); k++) {
         //				ho_deriv[i-j][l]
         i = k - 1;
         for (int j = 0; j < k; j++)
@@ -956,8 +1040,8 @@ inline adouble sqrt(const adouble &a) {
   {
     int i;
     double sum = 0.0;
-    for (int l = 0; l < adouble::numDir; l++) {
-      for (int k = 0; k < adouble::degree; k++) {
+    for (int l = 0; l < getNumDir(); l++) {
+      for (int k = 0; k < getDegree(); k++) {
         //				ho_deriv[i-j][l]
         i = k - 1;
         for (int j = 0; j < k; j++)
@@ -999,8 +1083,8 @@ inline adouble sin(const adouble &a) {
   {
     int i, m;
     double sum1 = 0.0, sum2 = 0.0;
-    for (int l = 0; l < adouble::numDir; l++) {
-      for (int k = 0; k < adouble::degree; k++) {
+    for (int l = 0; l < getNumDir(); l++) {
+      for (int k = 0; k < getDegree(); k++) {
         //    				ho_deriv[k][l]
         m = k + 1;
         sum1 = tmp2.val * m * a.ho_deriv[k][l];
@@ -1042,8 +1126,8 @@ inline adouble cos(const adouble &a) {
   {
     int i, m;
     double sum1 = 0.0, sum2 = 0.0;
-    for (int l = 0; l < adouble::numDir; l++) {
-      for (int k = 0; k < adouble::degree; k++) {
+    for (int l = 0; l < getNumDir(); l++) {
+      for (int k = 0; k < getDegree(); k++) {
         //    				ho_deriv[k][l]
         m = k + 1;
         sum1 = tmp2.val * m * a.ho_deriv[k][l];
@@ -1210,9 +1294,9 @@ inline adouble pow(const adouble &a, double v) {
       //  this is different than in GW08. The formula in the table gives a nan
       //  for input zero.
       double factorial_val = tgamma(v + 1.0);
-      for (int k = 0; k < adouble::degree; k++)
-        for (int l = 0; l < adouble::numDir; l++) {
-          for (int k = 0; k < adouble::degree;
+      for (int k = 0; k < getDegree(); k++)
+        for (int l = 0; l < getNumDir(); l++) {
+          for (int k = 0; k < getDegree();
                k++) // unsure if this is needed here. keep it for the moment
                     // TODO: check if tmp.ho_deriv is zero before here
           {
@@ -1227,8 +1311,8 @@ inline adouble pow(const adouble &a, double v) {
     } else {
       int i, m;
       double sum1 = 0.0, sum2 = 0.0;
-      for (int l = 0; l < adouble::numDir; l++) {
-        for (int k = 0; k < adouble::degree; k++) {
+      for (int l = 0; l < getNumDir(); l++) {
+        for (int k = 0; k < getDegree(); k++) {
           //    				ho_deriv[k][l]
           sum1 = tmp.val * (k + 1) * a.ho_deriv[k][l];
           i = k - 1;
@@ -1299,9 +1383,9 @@ inline adouble pow(double v, const adouble &a) {
   {
     int i;
     double sum;
-    for (int l = 0; l < adouble::numDir; l++) {
+    for (int l = 0; l < getNumDir(); l++) {
       sum = 0.0;
-      for (int k = 0; k < adouble::degree; k++) {
+      for (int k = 0; k < getDegree(); k++) {
         //    				ho_deriv[k][l]
         sum = tmp.val * (k + 1) * a.ho_deriv[k][l];
         i = k - 1;
@@ -1366,9 +1450,9 @@ inline adouble sinh(const adouble &a) {
     int i, m;
     double sum;
     double sum1 = 0.0, sum2 = 0.0;
-    for (int l = 0; l < adouble::numDir; l++) {
+    for (int l = 0; l < getNumDir(); l++) {
       sum = 0.0;
-      for (int k = 0; k < adouble::degree; k++) {
+      for (int k = 0; k < getDegree(); k++) {
         //    				ho_deriv[k][l]
         m = k + 1;
         sum1 = tmp2.val * m * a.ho_deriv[k][l];
@@ -1412,9 +1496,9 @@ inline adouble cosh(const adouble &a) {
     double sum;
     double sum1 = 0.0, sum2 = 0.0;
     tmp2 = ADOLC_MATH_NSP::sinh(a.val);
-    for (int l = 0; l < adouble::numDir; l++) {
+    for (int l = 0; l < getNumDir(); l++) {
       sum = 0.0;
-      for (int k = 0; k < adouble::degree; k++) {
+      for (int k = 0; k < getDegree(); k++) {
         //    				ho_deriv[k][l]
         m = k + 1;
         sum1 = tmp2.val * m * a.ho_deriv[k][l];
@@ -1582,15 +1666,15 @@ inline adouble fabs(const adouble &a) {
 
     int i, m;
     double sum;
-    int *leading_sgn = (int *)alloca(sizeof(int) * adouble::degree);
-    for (int l = 0; l < adouble::numDir; l++) // Init
+    int *leading_sgn = (int *)alloca(sizeof(int) * getDegree());
+    for (int l = 0; l < getNumDir(); l++) // Init
     {
       leading_sgn[l] = 1;
     }
     bool found;
 
-    for (int l = 0; l < adouble::numDir; l++) {
-      for (int k = 0; k < adouble::degree; k++) {
+    for (int l = 0; l < getNumDir(); l++) {
+      for (int k = 0; k < getDegree(); k++) {
         if (tmp.ho_deriv[k][l] > 0 && (!found)) {
           leading_sgn[l] = 1;
           found = true;
@@ -1617,8 +1701,8 @@ inline adouble fabs(const adouble &a) {
 
     // assume we found all leading Taylor coefficients
 
-    for (int l = 0; l < adouble::numDir; l++) {
-      for (int k = 0; k < adouble::degree; k++) {
+    for (int l = 0; l < getNumDir(); l++) {
+      for (int k = 0; k < getDegree(); k++) {
         tmp.ho_deriv[k][l] *= leading_sgn[l];
         // TODO do not forget zero-th Taylor coefficient
       }
@@ -2121,6 +2205,16 @@ inline adouble &adouble::operator=(const adouble &a) {
   return *this;
 }
 
+/* takes over the derivative arrays of a temporary instead of copying them,
+ * all adoubles of a mode have arrays of the same size */
+inline adouble &adouble::operator=(adouble &&a) noexcept {
+  val = a.val;
+  std::swap(adval, a.adval);
+  std::swap(ho_deriv, a.ho_deriv);
+  pattern.swap(a.pattern);
+  return *this;
+}
+
 inline adouble &adouble::operator+=(const double v) {
   if (do_val())
     val += v;
@@ -2203,8 +2297,8 @@ inline adouble &adouble::operator*=(const adouble &a) {
     int i, m;
     double sum;
     double sum1 = 0.0, sum2 = 0.0;
-    for (int l = 0; l < adouble::numDir; l++) {
-      for (int k = 0; k < degree; k++) {
+    for (int l = 0; l < getNumDir(); l++) {
+      for (int k = 0; k < getDegree(); k++) {
         sum = val * a.ho_deriv[k][l] + ho_deriv[k][l] * a.val;
         i = k - 1;
         for (int j = 0; j < k; j++)
@@ -2213,7 +2307,7 @@ inline adouble &adouble::operator*=(const adouble &a) {
         sum = 0.0;
       }
       val = tmp.val;
-      for (int k = 0; k < degree; k++)
+      for (int k = 0; k < getDegree(); k++)
         ho_deriv[k][l] = tmp.ho_deriv[k][l];
     }
   }
@@ -2257,8 +2351,8 @@ inline adouble &adouble::operator/=(const adouble &a) {
     int i, m;
     double sum;
     double sum1 = 0.0, sum2 = 0.0;
-    for (int l = 0; l < adouble::numDir; l++) {
-      for (int k = 0; k < degree; k++) {
+    for (int l = 0; l < getNumDir(); l++) {
+      for (int k = 0; k < getDegree(); k++) {
         sum = tmp.val * a.ho_deriv[k][l];
         i = k - 1;
         for (int j = 0; j < k; j++)
@@ -2267,7 +2361,7 @@ inline adouble &adouble::operator/=(const adouble &a) {
         sum = 0.0;
       }
       val = tmp.val;
-      for (int k = 0; k < degree; k++)
+      for (int k = 0; k < getDegree(); k++)
         ho_deriv[k][l] = tmp.ho_deriv[k][l];
     }
   }
@@ -2521,7 +2615,7 @@ inline double adouble::getADValue(const unsigned int p) const {
                       "setMode(enum Mode mode)\n");
     throw logic_error("incorrect function call, errorcode=1");
   }
-  if (p >= adouble::numDir) {
+  if (p >= getNumDir()) {
     fprintf(DIAG_OUT, "Derivative array accessed out of bounds"
                       " while \"getADValue(...)\"!!!\n");
     throw logic_error("incorrect function call, errorcode=-1");
@@ -2535,7 +2629,7 @@ inline void adouble::setADValue(const unsigned int p, const double v) {
                       "setMode(enum Mode mode)\n");
     throw logic_error("incorrect function call, errorcode=1");
   }
-  if (p >= adouble::numDir) {
+  if (p >= getNumDir()) {
     fprintf(DIAG_OUT, "Derivative array accessed out of bounds"
                       " while \"setADValue(...)\"!!!\n");
     throw logic_error("incorrect function call, errorcode=-1");
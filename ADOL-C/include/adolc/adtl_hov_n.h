@@ -0,0 +1,650 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     adtl_hov_n.h
+ Revision: $Id$
+ Contents: adtl_hov_n.h contains the traceless adouble_n<N, D> for higher
+           order vector mode whose number of directions N and degree D are
+           fixed at compile time.
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Benjamin Letschert, Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#ifndef ADOLC_ADTL_HOV_N_H
+#define ADOLC_ADTL_HOV_N_H
+
+#include <adolc/internal/common.h>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace adtl_hov {
+
+/* adouble_n<N, D> propagates the Taylor coefficients of the orders 1..D in
+ * N directions like adtl_hov::adouble in ADTL_HOV mode with setNumDir(N)
+ * and setDegree(D). getOneADValue(k) returns the N coefficients of order
+ * k+1, i.e. the derivatives of order k+1 divided by (k+1)!. The
+ * coefficients are kept in the object itself, so temporaries live on the
+ * stack and all loops have trip counts known to the compiler.
+ * setNumDir and setDegree do not affect adouble_n.                         */
+template <size_t N, size_t D> class adouble_n {
+  static_assert(N >= 1, "adouble_n needs at least one direction");
+  static_assert(D >= 1, "adouble_n needs at least degree one");
+
+  typedef std::array<double, N> Coefficients;
+
+public:
+  inline adouble_n() : val(0.0) { clear(); }
+  inline adouble_n(const double v) : val(v) { clear(); }
+  inline adouble_n(const double v, const double *adv) : val(v) {
+    clear();
+    for (size_t l = 0; l < N; ++l)
+      tay[0][l] = adv[l];
+  }
+  inline adouble_n(const double v, const double *const *hov) : val(v) {
+    for (size_t k = 0; k < D; ++k)
+      for (size_t l = 0; l < N; ++l)
+        tay[k][l] = hov[k][l];
+  }
+
+  /*******************  temporary results  ******************************/
+  // sign
+  inline adouble_n operator-() const { return *this * -1.0; }
+  inline adouble_n operator+() const { return *this; }
+
+  // addition
+  inline friend adouble_n operator+(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp(a);
+    tmp += b;
+    return tmp;
+  }
+  inline friend adouble_n operator+(const adouble_n &a, const double v) {
+    adouble_n tmp(a);
+    tmp.val += v;
+    return tmp;
+  }
+  inline friend adouble_n operator+(const double v, const adouble_n &a) {
+    adouble_n tmp(a);
+    tmp.val = v + a.val;
+    return tmp;
+  }
+
+  // subtraction
+  inline friend adouble_n operator-(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp(a);
+    tmp -= b;
+    return tmp;
+  }
+  inline friend adouble_n operator-(const adouble_n &a, const double v) {
+    adouble_n tmp(a);
+    tmp.val -= v;
+    return tmp;
+  }
+  inline friend adouble_n operator-(const double v, const adouble_n &a) {
+    adouble_n tmp(-a);
+    tmp.val = v - a.val;
+    return tmp;
+  }
+
+  // multiplication
+  inline friend adouble_n operator*(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp;
+    tmp.val = a.val * b.val;
+    for (size_t k = 0; k < D; ++k) {
+      Coefficients s;
+      for (size_t l = 0; l < N; ++l)
+        s[l] = a.val * b.tay[k][l] + a.tay[k][l] * b.val;
+      for (size_t j = 0; j < k; ++j)
+        for (size_t l = 0; l < N; ++l)
+          s[l] += a.tay[j][l] * b.tay[k - 1 - j][l];
+      tmp.tay[k] = s;
+    }
+    return tmp;
+  }
+  inline friend adouble_n operator*(const adouble_n &a, const double v) {
+    adouble_n tmp(a);
+    tmp *= v;
+    return tmp;
+  }
+  inline friend adouble_n operator*(const double v, const adouble_n &a) {
+    adouble_n tmp(a);
+    tmp *= v;
+    return tmp;
+  }
+
+  // division
+  inline friend adouble_n operator/(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp;
+    tmp.val = a.val / b.val;
+    for (size_t k = 0; k < D; ++k) {
+      Coefficients s;
+      for (size_t l = 0; l < N; ++l)
+        s[l] = a.tay[k][l] - tmp.val * b.tay[k][l];
+      for (size_t j = 0; j < k; ++j)
+        for (size_t l = 0; l < N; ++l)
+          s[l] -= tmp.tay[j][l] * b.tay[k - 1 - j][l];
+      for (size_t l = 0; l < N; ++l)
+        tmp.tay[k][l] = s[l] / b.val;
+    }
+    return tmp;
+  }
+  inline friend adouble_n operator/(const adouble_n &a, const double v) {
+    adouble_n tmp(a);
+    tmp /= v;
+    return tmp;
+  }
+  inline friend adouble_n operator/(const double v, const adouble_n &a) {
+    return adouble_n(v) / a;
+  }
+
+  // inc/dec
+  inline adouble_n operator++() {
+    ++val;
+    return *this;
+  }
+  inline adouble_n operator++(int) {
+    adouble_n tmp(*this);
+    ++val;
+    return tmp;
+  }
+  inline adouble_n operator--() {
+    --val;
+    return *this;
+  }
+  inline adouble_n operator--(int) {
+    adouble_n tmp(*this);
+    --val;
+    return tmp;
+  }
+
+  // functions
+  inline friend adouble_n tan(const adouble_n &a) {
+    adouble_n s, c;
+    sincos(a, s, c, -1.0);
+    s = s / c;
+    s.val = ADOLC_MATH_NSP::tan(a.val);
+    return s;
+  }
+  inline friend adouble_n exp(const adouble_n &a) {
+    adouble_n tmp;
+    /* z' = z a' */
+    tmp.val = ADOLC_MATH_NSP::exp(a.val);
+    tmp.integrate(a, tmp);
+    return tmp;
+  }
+  inline friend adouble_n log(const adouble_n &a) {
+    adouble_n tmp;
+    /* a z' = a' */
+    tmp.val = ADOLC_MATH_NSP::log(a.val);
+    for (size_t k = 0; k < D; ++k) {
+      Coefficients s;
+      for (size_t l = 0; l < N; ++l)
+        s[l] = 0.0;
+      for (size_t j = 1; j <= k; ++j)
+        for (size_t l = 0; l < N; ++l)
+          s[l] += j * tmp.tay[j - 1][l] * a.tay[k - j][l];
+      for (size_t l = 0; l < N; ++l)
+        tmp.tay[k][l] = (a.tay[k][l] - s[l] / (k + 1)) / a.val;
+    }
+    return tmp;
+  }
+  inline friend adouble_n sqrt(const adouble_n &a) {
+    adouble_n tmp;
+    /* z z = a */
+    tmp.val = ADOLC_MATH_NSP::sqrt(a.val);
+    for (size_t k = 0; k < D; ++k) {
+      Coefficients s = a.tay[k];
+      for (size_t j = 0; j < k; ++j)
+        for (size_t l = 0; l < N; ++l)
+          s[l] -= tmp.tay[j][l] * tmp.tay[k - 1 - j][l];
+      for (size_t l = 0; l < N; ++l)
+        tmp.tay[k][l] = s[l] / (2 * tmp.val);
+    }
+    return tmp;
+  }
+  inline friend adouble_n cbrt(const adouble_n &a) {
+    return powSeries(a, 1.0 / 3, ADOLC_MATH_NSP::cbrt(a.val));
+  }
+  inline friend adouble_n sin(const adouble_n &a) {
+    adouble_n s, c;
+    sincos(a, s, c, -1.0);
+    return s;
+  }
+  inline friend adouble_n cos(const adouble_n &a) {
+    adouble_n s, c;
+    sincos(a, s, c, -1.0);
+    return c;
+  }
+  inline friend adouble_n asin(const adouble_n &a) {
+    adouble_n tmp;
+    tmp.val = ADOLC_MATH_NSP::asin(a.val);
+    tmp.integrate(a, 1.0 / sqrt(1.0 - a * a));
+    return tmp;
+  }
+  inline friend adouble_n acos(const adouble_n &a) {
+    adouble_n tmp;
+    tmp.val = ADOLC_MATH_NSP::acos(a.val);
+    tmp.integrate(a, -1.0 / sqrt(1.0 - a * a));
+    return tmp;
+  }
+  inline friend adouble_n atan(const adouble_n &a) {
+    adouble_n tmp;
+    tmp.val = ADOLC_MATH_NSP::atan(a.val);
+    tmp.integrate(a, 1.0 / (1.0 + a * a));
+    return tmp;
+  }
+  inline friend adouble_n atan2(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp;
+    /* atan2 differs from atan(a/b) and -atan(b/a) by constants */
+    if (ADOLC_MATH_NSP::fabs(b.val) >= ADOLC_MATH_NSP::fabs(a.val))
+      tmp = atan(a / b);
+    else
+      tmp = -atan(b / a);
+    tmp.val = ADOLC_MATH_NSP::atan2(a.val, b.val);
+    return tmp;
+  }
+  inline friend adouble_n pow(const adouble_n &a, const double v) {
+    return powSeries(a, v, ADOLC_MATH_NSP::pow(a.val, v));
+  }
+  inline friend adouble_n pow(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp = exp(b * log(a));
+    tmp.val = ADOLC_MATH_NSP::pow(a.val, b.val);
+    return tmp;
+  }
+  inline friend adouble_n pow(const double v, const adouble_n &a) {
+    adouble_n tmp = exp(a * ADOLC_MATH_NSP::log(v));
+    tmp.val = ADOLC_MATH_NSP::pow(v, a.val);
+    return tmp;
+  }
+  inline friend adouble_n log10(const adouble_n &a) {
+    adouble_n tmp = log(a) / ADOLC_MATH_NSP::log((double)10);
+    tmp.val = ADOLC_MATH_NSP::log10(a.val);
+    return tmp;
+  }
+
+  inline friend adouble_n sinh(const adouble_n &a) {
+    adouble_n s, c;
+    sincos(a, s, c, 1.0);
+    return s;
+  }
+  inline friend adouble_n cosh(const adouble_n &a) {
+    adouble_n s, c;
+    sincos(a, s, c, 1.0);
+    return c;
+  }
+  inline friend adouble_n tanh(const adouble_n &a) {
+    adouble_n s, c;
+    sincos(a, s, c, 1.0);
+    s = s / c;
+    s.val = ADOLC_MATH_NSP::tanh(a.val);
+    return s;
+  }
+  inline friend adouble_n asinh(const adouble_n &a) {
+    adouble_n tmp;
+    tmp.val = ADOLC_MATH_NSP_ERF::asinh(a.val);
+    tmp.integrate(a, 1.0 / sqrt(a * a + 1.0));
+    return tmp;
+  }
+  inline friend adouble_n acosh(const adouble_n &a) {
+    adouble_n tmp;
+    tmp.val = ADOLC_MATH_NSP_ERF::acosh(a.val);
+    tmp.integrate(a, 1.0 / sqrt(a * a - 1.0));
+    return tmp;
+  }
+  inline friend adouble_n atanh(const adouble_n &a) {
+    adouble_n tmp;
+    tmp.val = ADOLC_MATH_NSP_ERF::atanh(a.val);
+    tmp.integrate(a, 1.0 / (1.0 - a * a));
+    return tmp;
+  }
+  inline friend adouble_n fabs(const adouble_n &a) {
+    adouble_n tmp(a);
+    tmp.val = ADOLC_MATH_NSP::fabs(a.val);
+    for (size_t l = 0; l < N; ++l) {
+      /* at the kink, the leading coefficient of the direction decides */
+      double s = a.val;
+      for (size_t k = 0; k < D && s == 0.0; ++k)
+        s = a.tay[k][l];
+      if (s <= 0.0)
+        for (size_t k = 0; k < D; ++k)
+          tmp.tay[k][l] = -a.tay[k][l];
+    }
+    return tmp;
+  }
+  inline friend adouble_n ceil(const adouble_n &a) {
+    return adouble_n(ADOLC_MATH_NSP::ceil(a.val));
+  }
+  inline friend adouble_n floor(const adouble_n &a) {
+    return adouble_n(ADOLC_MATH_NSP::floor(a.val));
+  }
+  inline friend adouble_n fmax(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp(a);
+    if (a.val < b.val)
+      return b;
+    if (a.val > b.val)
+      return a;
+    for (size_t l = 0; l < N; ++l)
+      if (a.lessIn(l, b))
+        for (size_t k = 0; k < D; ++k)
+          tmp.tay[k][l] = b.tay[k][l];
+    return tmp;
+  }
+  inline friend adouble_n fmax(const double v, const adouble_n &a) {
+    return fmax(adouble_n(v), a);
+  }
+  inline friend adouble_n fmax(const adouble_n &a, const double v) {
+    return fmax(a, adouble_n(v));
+  }
+  inline friend adouble_n fmin(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp(b);
+    if (a.val < b.val)
+      return a;
+    if (a.val > b.val)
+      return b;
+    for (size_t l = 0; l < N; ++l)
+      if (a.lessIn(l, b))
+        for (size_t k = 0; k < D; ++k)
+          tmp.tay[k][l] = a.tay[k][l];
+    return tmp;
+  }
+  inline friend adouble_n fmin(const double v, const adouble_n &a) {
+    return fmin(adouble_n(v), a);
+  }
+  inline friend adouble_n fmin(const adouble_n &a, const double v) {
+    return fmin(a, adouble_n(v));
+  }
+  inline friend adouble_n ldexp(const adouble_n &a, const adouble_n &b) {
+    return a * pow(2., b);
+  }
+  inline friend adouble_n ldexp(const adouble_n &a, const double v) {
+    return a * ADOLC_MATH_NSP::pow(2., v);
+  }
+  inline friend adouble_n ldexp(const double v, const adouble_n &a) {
+    return v * pow(2., a);
+  }
+  inline friend double frexp(const adouble_n &a, int *v) {
+    return ADOLC_MATH_NSP::frexp(a.val, v);
+  }
+  inline friend adouble_n erf(const adouble_n &a) {
+    adouble_n tmp;
+    tmp.val = ADOLC_MATH_NSP_ERF::erf(a.val);
+    tmp.integrate(a, 2.0 /
+                         ADOLC_MATH_NSP_ERF::sqrt(ADOLC_MATH_NSP::acos(-1.0)) *
+                         exp(-a * a));
+    return tmp;
+  }
+  inline friend adouble_n erfc(const adouble_n &a) {
+    adouble_n tmp;
+    tmp.val = ADOLC_MATH_NSP_ERF::erfc(a.val);
+    tmp.integrate(a, -2.0 /
+                         ADOLC_MATH_NSP_ERF::sqrt(ADOLC_MATH_NSP::acos(-1.0)) *
+                         exp(-a * a));
+    return tmp;
+  }
+
+  inline friend void condassign(adouble_n &res, const adouble_n &cond,
+                                const adouble_n &arg1, const adouble_n &arg2) {
+    if (cond.getValue() > 0)
+      res = arg1;
+    else
+      res = arg2;
+  }
+  inline friend void condassign(adouble_n &res, const adouble_n &cond,
+                                const adouble_n &arg) {
+    if (cond.getValue() > 0)
+      res = arg;
+  }
+  inline friend void condeqassign(adouble_n &res, const adouble_n &cond,
+                                  const adouble_n &arg1,
+                                  const adouble_n &arg2) {
+    if (cond.getValue() >= 0)
+      res = arg1;
+    else
+      res = arg2;
+  }
+  inline friend void condeqassign(adouble_n &res, const adouble_n &cond,
+                                  const adouble_n &arg) {
+    if (cond.getValue() >= 0)
+      res = arg;
+  }
+
+  /*******************  nontemporary results  ***************************/
+  // assignment
+  inline adouble_n &operator=(const double v) {
+    val = v;
+    clear();
+    return *this;
+  }
+
+  // addition
+  inline adouble_n &operator+=(const double v) {
+    val += v;
+    return *this;
+  }
+  inline adouble_n &operator+=(const adouble_n &a) {
+    val += a.val;
+    for (size_t k = 0; k < D; ++k)
+      for (size_t l = 0; l < N; ++l)
+        tay[k][l] += a.tay[k][l];
+    return *this;
+  }
+
+  // subtraction
+  inline adouble_n &operator-=(const double v) {
+    val -= v;
+    return *this;
+  }
+  inline adouble_n &operator-=(const adouble_n &a) {
+    val -= a.val;
+    for (size_t k = 0; k < D; ++k)
+      for (size_t l = 0; l < N; ++l)
+        tay[k][l] -= a.tay[k][l];
+    return *this;
+  }
+
+  // multiplication
+  inline adouble_n &operator*=(const double v) {
+    val *= v;
+    for (size_t k = 0; k < D; ++k)
+      for (size_t l = 0; l < N; ++l)
+        tay[k][l] *= v;
+    return *this;
+  }
+  inline adouble_n &operator*=(const adouble_n &a) {
+    *this = *this * a;
+    return *this;
+  }
+
+  // division
+  inline adouble_n &operator/=(const double v) {
+    val /= v;
+    for (size_t k = 0; k < D; ++k)
+      for (size_t l = 0; l < N; ++l)
+        tay[k][l] /= v;
+    return *this;
+  }
+  inline adouble_n &operator/=(const adouble_n &a) {
+    *this = *this / a;
+    return *this;
+  }
+
+  // not
+  inline bool operator!() const { return val == 0.0; }
+
+  // comparison
+#define ADOLC_ADTL_HOV_N_COMPARISON(op)                                        \
+  inline friend bool operator op(const adouble_n &a, const adouble_n &b) {     \
+    return a.val op b.val;                                                     \
+  }                                                                            \
+  inline friend bool operator op(const adouble_n &a, const double v) {         \
+    return a.val op v;                                                         \
+  }                                                                            \
+  inline friend bool operator op(const double v, const adouble_n &a) {         \
+    return v op a.val;                                                         \
+  }
+  ADOLC_ADTL_HOV_N_COMPARISON(!=)
+  ADOLC_ADTL_HOV_N_COMPARISON(==)
+  ADOLC_ADTL_HOV_N_COMPARISON(<=)
+  ADOLC_ADTL_HOV_N_COMPARISON(>=)
+  ADOLC_ADTL_HOV_N_COMPARISON(>)
+  ADOLC_ADTL_HOV_N_COMPARISON(<)
+#undef ADOLC_ADTL_HOV_N_COMPARISON
+
+  /*******************  getter / setter  ********************************/
+  inline double getValue() const { return val; }
+  inline void setValue(const double v) { val = v; }
+  /* first order coefficients */
+  inline const double *getADValue() const { return tay[0].data(); }
+  inline void setADValue(const double *v) {
+    for (size_t l = 0; l < N; ++l)
+      tay[0][l] = v[l];
+  }
+  inline double getADValue(const unsigned int p) const {
+    if (p >= N) {
+      fprintf(DIAG_OUT, "Derivative array accessed out of bounds"
+                        " while \"getADValue(...)\"!!!\n");
+      throw std::logic_error("incorrect function call, errorcode=-1");
+    }
+    return tay[0][p];
+  }
+  inline void setADValue(const unsigned int p, const double v) {
+    if (p >= N) {
+      fprintf(DIAG_OUT, "Derivative array accessed out of bounds"
+                        " while \"setADValue(...)\"!!!\n");
+      throw std::logic_error("incorrect function call, errorcode=-1");
+    }
+    tay[0][p] = v;
+  }
+  /* coefficients of order i+1 */
+  inline const double *getOneADValue(const int i) const {
+    if (i < 0 || (size_t)i >= D) {
+      fprintf(DIAG_OUT, "Taylor coefficients accessed out of bounds"
+                        " while \"getOneADValue(...)\"!!!\n");
+      throw std::logic_error("incorrect function call, errorcode=-1");
+    }
+    return tay[i].data();
+  }
+  inline void setOneADValue(const int i, const double *v) {
+    if (i < 0 || (size_t)i >= D) {
+      fprintf(DIAG_OUT, "Taylor coefficients accessed out of bounds"
+                        " while \"setOneADValue(...)\"!!!\n");
+      throw std::logic_error("incorrect function call, errorcode=-1");
+    }
+    for (size_t l = 0; l < N; ++l)
+      tay[i][l] = v[l];
+  }
+  inline explicit operator double const &() const { return val; }
+  static constexpr size_t getNumDir() { return N; }
+  static constexpr size_t getDegree() { return D; }
+
+  /*******************  i/o operations  *********************************/
+  inline friend std::ostream &operator<<(std::ostream &out,
+                                         const adouble_n &a) {
+    out << "Value: " << a.val;
+    for (size_t k = 0; k < D; ++k) {
+      out << " Order " << k + 1 << " (" << N << "): ";
+      for (size_t l = 0; l < N; ++l)
+        out << a.tay[k][l] << " ";
+    }
+    out << "(a)";
+    return out;
+  }
+
+private:
+  inline void clear() {
+    for (size_t k = 0; k < D; ++k)
+      tay[k].fill(0.0);
+  }
+
+  /* Computes the coefficients of z with z' = g a' from the value of z,
+   * i.e. z_k = 1/k sum_{j=1..k} j a_j g_{k-j}. g may be z itself. */
+  inline void integrate(const adouble_n &a, const adouble_n &g) {
+    for (size_t k = 0; k < D; ++k) {
+      Coefficients s;
+      for (size_t l = 0; l < N; ++l)
+        s[l] = (k + 1) * a.tay[k][l] * g.val;
+      for (size_t j = 1; j <= k; ++j)
+        for (size_t l = 0; l < N; ++l)
+          s[l] += j * a.tay[j - 1][l] * g.tay[k - j][l];
+      for (size_t l = 0; l < N; ++l)
+        tay[k][l] = s[l] / (k + 1);
+    }
+  }
+
+  /* s = sin(a), c = cos(a) for sign = -1, s = sinh(a), c = cosh(a) for
+   * sign = 1, with s' = c a' and c' = sign s a' */
+  static inline void sincos(const adouble_n &a, adouble_n &s, adouble_n &c,
+                            const double sign) {
+    if (sign < 0) {
+      s.val = ADOLC_MATH_NSP::sin(a.val);
+      c.val = ADOLC_MATH_NSP::cos(a.val);
+    } else {
+      s.val = ADOLC_MATH_NSP::sinh(a.val);
+      c.val = ADOLC_MATH_NSP::cosh(a.val);
+    }
+    for (size_t k = 0; k < D; ++k) {
+      Coefficients ss, cs;
+      for (size_t l = 0; l < N; ++l) {
+        ss[l] = (k + 1) * a.tay[k][l] * c.val;
+        cs[l] = (k + 1) * a.tay[k][l] * s.val;
+      }
+      for (size_t j = 1; j <= k; ++j)
+        for (size_t l = 0; l < N; ++l) {
+          ss[l] += j * a.tay[j - 1][l] * c.tay[k - j][l];
+          cs[l] += j * a.tay[j - 1][l] * s.tay[k - j][l];
+        }
+      for (size_t l = 0; l < N; ++l) {
+        s.tay[k][l] = ss[l] / (k + 1);
+        c.tay[k][l] = sign * cs[l] / (k + 1);
+      }
+    }
+  }
+
+  /* z = a^r with the value z0, a z' = r a' z */
+  static inline adouble_n powSeries(const adouble_n &a, const double r,
+                                    const double z0) {
+    adouble_n tmp;
+    if (a.val == 0.0 && r >= 0 && r == ADOLC_MATH_NSP::floor(r) && r <= D) {
+      /* the recurrence divides by a, use products for small powers */
+      tmp = 1.0;
+      for (int i = 0; i < (int)r; ++i)
+        tmp *= a;
+      return tmp;
+    }
+    tmp.val = z0;
+    for (size_t k = 0; k < D; ++k) {
+      Coefficients s;
+      for (size_t l = 0; l < N; ++l)
+        s[l] = r * (k + 1) * a.tay[k][l] * tmp.val;
+      for (size_t j = 1; j <= k; ++j)
+        for (size_t l = 0; l < N; ++l)
+          s[l] += ((r + 1) * j - (k + 1)) * a.tay[j - 1][l] *
+                  tmp.tay[k - j][l];
+      for (size_t l = 0; l < N; ++l)
+        tmp.tay[k][l] = s[l] / ((k + 1) * a.val);
+    }
+    return tmp;
+  }
+
+  /* lexicographic comparison of the coefficients in direction l */
+  inline bool lessIn(const size_t l, const adouble_n &b) const {
+    for (size_t k = 0; k < D; ++k)
+      if (tay[k][l] != b.tay[k][l])
+        return tay[k][l] < b.tay[k][l];
+    return false;
+  }
+
+  double val;
+  /* tay[k][l]: Taylor coefficient of order k+1 in direction l */
+  std::array<Coefficients, D> tay;
+};
+
+} // namespace adtl_hov
+#endif
@@ -0,0 +1,530 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     adtl_n.h
+ Revision: $Id$
+ Contents: adtl_n.h contains the traceless adouble_n<N> whose number of
+           directional derivatives N is fixed at compile time.
+
+ Copyright (c) Andrea Walther, Andreas Griewank, Andreas Kowarz,
+               Hristo Mitev, Sebastian Schlenkrich, Jean Utke, Olaf Vogel,
+               Benjamin Letschert, Kshitij Kulshreshtha
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#ifndef ADOLC_ADTL_N_H
+#define ADOLC_ADTL_N_H
+
+#include <adolc/internal/common.h>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+
+namespace adtl {
+
+/* adouble_n<N> computes the same derivatives as adtl::adouble with
+ * setNumDir(N). The value and the N directional derivatives are kept in
+ * the object itself, so temporaries live on the stack and need no
+ * allocation, and all loops have the trip count N known to the compiler.
+ * setNumDir does not affect adouble_n.                                     */
+template <size_t N> class adouble_n {
+  static_assert(N >= 1, "adouble_n needs at least one direction");
+
+public:
+  inline adouble_n() { adval.fill(0.0); }
+  inline adouble_n(const double v) {
+    adval[0] = v;
+    for (size_t i = 1; i <= N; ++i)
+      adval[i] = 0.0;
+  }
+  inline adouble_n(const double v, const double *adv) {
+    adval[0] = v;
+    for (size_t i = 1; i <= N; ++i)
+      adval[i] = adv[i - 1];
+  }
+
+  /*******************  temporary results  ******************************/
+  // sign
+  inline adouble_n operator-() const {
+    adouble_n tmp;
+    for (size_t i = 0; i <= N; ++i)
+      tmp.adval[i] = -adval[i];
+    return tmp;
+  }
+  inline adouble_n operator+() const { return *this; }
+
+  // addition
+  inline friend adouble_n operator+(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp;
+    for (size_t i = 0; i <= N; ++i)
+      tmp.adval[i] = a.adval[i] + b.adval[i];
+    return tmp;
+  }
+  inline friend adouble_n operator+(const adouble_n &a, const double v) {
+    adouble_n tmp(a);
+    tmp.adval[0] += v;
+    return tmp;
+  }
+  inline friend adouble_n operator+(const double v, const adouble_n &a) {
+    adouble_n tmp(a);
+    tmp.adval[0] = v + a.adval[0];
+    return tmp;
+  }
+
+  // subtraction
+  inline friend adouble_n operator-(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp;
+    for (size_t i = 0; i <= N; ++i)
+      tmp.adval[i] = a.adval[i] - b.adval[i];
+    return tmp;
+  }
+  inline friend adouble_n operator-(const adouble_n &a, const double v) {
+    adouble_n tmp(a);
+    tmp.adval[0] -= v;
+    return tmp;
+  }
+  inline friend adouble_n operator-(const double v, const adouble_n &a) {
+    adouble_n tmp;
+    tmp.adval[0] = v - a.adval[0];
+    for (size_t i = 1; i <= N; ++i)
+      tmp.adval[i] = -a.adval[i];
+    return tmp;
+  }
+
+  // multiplication
+  inline friend adouble_n operator*(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp;
+    tmp.adval[0] = a.adval[0] * b.adval[0];
+    for (size_t i = 1; i <= N; ++i)
+      tmp.adval[i] = a.adval[i] * b.adval[0] + a.adval[0] * b.adval[i];
+    return tmp;
+  }
+  inline friend adouble_n operator*(const adouble_n &a, const double v) {
+    adouble_n tmp;
+    for (size_t i = 0; i <= N; ++i)
+      tmp.adval[i] = a.adval[i] * v;
+    return tmp;
+  }
+  inline friend adouble_n operator*(const double v, const adouble_n &a) {
+    adouble_n tmp;
+    for (size_t i = 0; i <= N; ++i)
+      tmp.adval[i] = v * a.adval[i];
+    return tmp;
+  }
+
+  // division
+  inline friend adouble_n operator/(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp;
+    tmp.adval[0] = a.adval[0] / b.adval[0];
+    for (size_t i = 1; i <= N; ++i)
+      tmp.adval[i] = (a.adval[i] * b.adval[0] - a.adval[0] * b.adval[i]) /
+                     (b.adval[0] * b.adval[0]);
+    return tmp;
+  }
+  inline friend adouble_n operator/(const adouble_n &a, const double v) {
+    adouble_n tmp;
+    for (size_t i = 0; i <= N; ++i)
+      tmp.adval[i] = a.adval[i] / v;
+    return tmp;
+  }
+  inline friend adouble_n operator/(const double v, const adouble_n &a) {
+    adouble_n tmp;
+    tmp.adval[0] = v / a.adval[0];
+    for (size_t i = 1; i <= N; ++i)
+      tmp.adval[i] = (-v * a.adval[i]) / (a.adval[0] * a.adval[0]);
+    return tmp;
+  }
+
+  // inc/dec
+  inline adouble_n operator++() {
+    ++adval[0];
+    return *this;
+  }
+  inline adouble_n operator++(int) {
+    adouble_n tmp(*this);
+    ++adval[0];
+    return tmp;
+  }
+  inline adouble_n operator--() {
+    --adval[0];
+    return *this;
+  }
+  inline adouble_n operator--(int) {
+    adouble_n tmp(*this);
+    --adval[0];
+    return tmp;
+  }
+
+  // functions
+  inline friend adouble_n tan(const adouble_n &a) {
+    double tmp2 = ADOLC_MATH_NSP::cos(a.adval[0]);
+    tmp2 *= tmp2;
+    return a.chain(ADOLC_MATH_NSP::tan(a.adval[0]), 1.0 / tmp2);
+  }
+  inline friend adouble_n exp(const adouble_n &a) {
+    const double tmp2 = ADOLC_MATH_NSP::exp(a.adval[0]);
+    return a.chain(tmp2, tmp2);
+  }
+  inline friend adouble_n log(const adouble_n &a) {
+    adouble_n tmp;
+    tmp.adval[0] = ADOLC_MATH_NSP::log(a.adval[0]);
+    for (size_t i = 1; i <= N; ++i)
+      if (a.adval[0] > 0)
+        tmp.adval[i] = a.adval[i] / a.adval[0];
+      else
+        tmp.adval[i] = singular(a.adval[0], a.adval[i]);
+    return tmp;
+  }
+  inline friend adouble_n sqrt(const adouble_n &a) {
+    adouble_n tmp;
+    tmp.adval[0] = ADOLC_MATH_NSP::sqrt(a.adval[0]);
+    for (size_t i = 1; i <= N; ++i)
+      if (a.adval[0] > 0)
+        tmp.adval[i] = a.adval[i] / (tmp.adval[0] * 2);
+      else
+        tmp.adval[i] = singular(a.adval[0], a.adval[i]);
+    return tmp;
+  }
+  inline friend adouble_n cbrt(const adouble_n &a) {
+    adouble_n tmp;
+    tmp.adval[0] = ADOLC_MATH_NSP::cbrt(a.adval[0]);
+    for (size_t i = 1; i <= N; ++i)
+      if (a.adval[0] != 0.0)
+        tmp.adval[i] = a.adval[i] / (tmp.adval[0] * tmp.adval[0] * 3);
+      else
+        tmp.adval[i] = singular(a.adval[0], a.adval[i]);
+    return tmp;
+  }
+  inline friend adouble_n sin(const adouble_n &a) {
+    return a.chain(ADOLC_MATH_NSP::sin(a.adval[0]),
+                   ADOLC_MATH_NSP::cos(a.adval[0]));
+  }
+  inline friend adouble_n cos(const adouble_n &a) {
+    return a.chain(ADOLC_MATH_NSP::cos(a.adval[0]),
+                   -ADOLC_MATH_NSP::sin(a.adval[0]));
+  }
+  inline friend adouble_n asin(const adouble_n &a) {
+    const double tmp2 =
+        ADOLC_MATH_NSP::sqrt(1 - a.adval[0] * a.adval[0]);
+    return a.chain(ADOLC_MATH_NSP::asin(a.adval[0]), 1.0 / tmp2);
+  }
+  inline friend adouble_n acos(const adouble_n &a) {
+    const double tmp2 =
+        -ADOLC_MATH_NSP::sqrt(1 - a.adval[0] * a.adval[0]);
+    return a.chain(ADOLC_MATH_NSP::acos(a.adval[0]), 1.0 / tmp2);
+  }
+  inline friend adouble_n atan(const adouble_n &a) {
+    const double tmp2 = 1 / (1 + a.adval[0] * a.adval[0]);
+    return a.chain(ADOLC_MATH_NSP::atan(a.adval[0]), tmp2);
+  }
+  inline friend adouble_n atan2(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp;
+    tmp.adval[0] = ADOLC_MATH_NSP::atan2(a.adval[0], b.adval[0]);
+    const double tmp2 = a.adval[0] * a.adval[0];
+    const double tmp3 = b.adval[0] * b.adval[0];
+    const double tmp4 = tmp3 / (tmp2 + tmp3);
+    for (size_t i = 1; i <= N; ++i)
+      if (tmp4 != 0)
+        tmp.adval[i] =
+            (a.adval[i] * b.adval[0] - a.adval[0] * b.adval[i]) / tmp3 * tmp4;
+      else
+        tmp.adval[i] = 0.0;
+    return tmp;
+  }
+  inline friend adouble_n pow(const adouble_n &a, const double v) {
+    return a.chain(ADOLC_MATH_NSP::pow(a.adval[0], v),
+                   v * ADOLC_MATH_NSP::pow(a.adval[0], v - 1));
+  }
+  inline friend adouble_n pow(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp;
+    tmp.adval[0] = ADOLC_MATH_NSP::pow(a.adval[0], b.adval[0]);
+    const double tmp2 =
+        b.adval[0] * ADOLC_MATH_NSP::pow(a.adval[0], b.adval[0] - 1);
+    const double tmp3 = ADOLC_MATH_NSP::log(a.adval[0]) * tmp.adval[0];
+    for (size_t i = 1; i <= N; ++i)
+      tmp.adval[i] = tmp2 * a.adval[i] + tmp3 * b.adval[i];
+    return tmp;
+  }
+  inline friend adouble_n pow(const double v, const adouble_n &a) {
+    const double tmp2 = ADOLC_MATH_NSP::pow(v, a.adval[0]);
+    return a.chain(tmp2, tmp2 * ADOLC_MATH_NSP::log(v));
+  }
+  inline friend adouble_n log10(const adouble_n &a) {
+    const double tmp2 = ADOLC_MATH_NSP::log((double)10) * a.adval[0];
+    return a.chain(ADOLC_MATH_NSP::log10(a.adval[0]), 1.0 / tmp2);
+  }
+
+  inline friend adouble_n sinh(const adouble_n &a) {
+    return a.chain(ADOLC_MATH_NSP::sinh(a.adval[0]),
+                   ADOLC_MATH_NSP::cosh(a.adval[0]));
+  }
+  inline friend adouble_n cosh(const adouble_n &a) {
+    return a.chain(ADOLC_MATH_NSP::cosh(a.adval[0]),
+                   ADOLC_MATH_NSP::sinh(a.adval[0]));
+  }
+  inline friend adouble_n tanh(const adouble_n &a) {
+    double tmp2 = ADOLC_MATH_NSP::cosh(a.adval[0]);
+    tmp2 *= tmp2;
+    return a.chain(ADOLC_MATH_NSP::tanh(a.adval[0]), 1.0 / tmp2);
+  }
+  inline friend adouble_n asinh(const adouble_n &a) {
+    const double tmp2 = ADOLC_MATH_NSP::sqrt(a.adval[0] * a.adval[0] + 1);
+    return a.chain(ADOLC_MATH_NSP_ERF::asinh(a.adval[0]), 1.0 / tmp2);
+  }
+  inline friend adouble_n acosh(const adouble_n &a) {
+    const double tmp2 = ADOLC_MATH_NSP::sqrt(a.adval[0] * a.adval[0] - 1);
+    return a.chain(ADOLC_MATH_NSP_ERF::acosh(a.adval[0]), 1.0 / tmp2);
+  }
+  inline friend adouble_n atanh(const adouble_n &a) {
+    const double tmp2 = 1 - a.adval[0] * a.adval[0];
+    return a.chain(ADOLC_MATH_NSP_ERF::atanh(a.adval[0]), 1.0 / tmp2);
+  }
+  inline friend adouble_n fabs(const adouble_n &a) {
+    adouble_n tmp;
+    tmp.adval[0] = ADOLC_MATH_NSP::fabs(a.adval[0]);
+    for (size_t i = 1; i <= N; ++i) {
+      /* at the kink, the sign of the direction decides */
+      const double s = a.adval[0] != 0.0 ? a.adval[0] : a.adval[i];
+      tmp.adval[i] = s > 0 ? a.adval[i] : (s < 0 ? -a.adval[i] : 0.0);
+    }
+    return tmp;
+  }
+  inline friend adouble_n ceil(const adouble_n &a) {
+    return adouble_n(ADOLC_MATH_NSP::ceil(a.adval[0]));
+  }
+  inline friend adouble_n floor(const adouble_n &a) {
+    return adouble_n(ADOLC_MATH_NSP::floor(a.adval[0]));
+  }
+  inline friend adouble_n fmax(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp;
+    const double tmp2 = a.adval[0] - b.adval[0];
+    if (tmp2 < 0)
+      return b;
+    if (tmp2 > 0)
+      return a;
+    tmp.adval[0] = a.adval[0];
+    for (size_t i = 1; i <= N; ++i)
+      tmp.adval[i] = a.adval[i] < b.adval[i] ? b.adval[i] : a.adval[i];
+    return tmp;
+  }
+  inline friend adouble_n fmax(const double v, const adouble_n &a) {
+    return fmax(adouble_n(v), a);
+  }
+  inline friend adouble_n fmax(const adouble_n &a, const double v) {
+    return fmax(a, adouble_n(v));
+  }
+  inline friend adouble_n fmin(const adouble_n &a, const adouble_n &b) {
+    adouble_n tmp;
+    const double tmp2 = a.adval[0] - b.adval[0];
+    if (tmp2 < 0)
+      return a;
+    if (tmp2 > 0)
+      return b;
+    tmp.adval[0] = b.adval[0];
+    for (size_t i = 1; i <= N; ++i)
+      tmp.adval[i] = a.adval[i] < b.adval[i] ? a.adval[i] : b.adval[i];
+    return tmp;
+  }
+  inline friend adouble_n fmin(const double v, const adouble_n &a) {
+    return fmin(adouble_n(v), a);
+  }
+  inline friend adouble_n fmin(const adouble_n &a, const double v) {
+    return fmin(a, adouble_n(v));
+  }
+  inline friend adouble_n ldexp(const adouble_n &a, const adouble_n &b) {
+    return a * pow(2., b);
+  }
+  inline friend adouble_n ldexp(const adouble_n &a, const double v) {
+    return a * ADOLC_MATH_NSP::pow(2., v);
+  }
+  inline friend adouble_n ldexp(const double v, const adouble_n &a) {
+    return v * pow(2., a);
+  }
+  inline friend double frexp(const adouble_n &a, int *v) {
+    return ADOLC_MATH_NSP::frexp(a.adval[0], v);
+  }
+  inline friend adouble_n erf(const adouble_n &a) {
+    const double tmp2 =
+        2.0 / ADOLC_MATH_NSP_ERF::sqrt(ADOLC_MATH_NSP::acos(-1.0)) *
+        ADOLC_MATH_NSP_ERF::exp(-a.adval[0] * a.adval[0]);
+    return a.chain(ADOLC_MATH_NSP_ERF::erf(a.adval[0]), tmp2);
+  }
+  inline friend adouble_n erfc(const adouble_n &a) {
+    const double tmp2 =
+        -2.0 / ADOLC_MATH_NSP_ERF::sqrt(ADOLC_MATH_NSP::acos(-1.0)) *
+        ADOLC_MATH_NSP_ERF::exp(-a.adval[0] * a.adval[0]);
+    return a.chain(ADOLC_MATH_NSP_ERF::erfc(a.adval[0]), tmp2);
+  }
+
+  inline friend void condassign(adouble_n &res, const adouble_n &cond,
+                                const adouble_n &arg1, const adouble_n &arg2) {
+    if (cond.getValue() > 0)
+      res = arg1;
+    else
+      res = arg2;
+  }
+  inline friend void condassign(adouble_n &res, const adouble_n &cond,
+                                const adouble_n &arg) {
+    if (cond.getValue() > 0)
+      res = arg;
+  }
+  inline friend void condeqassign(adouble_n &res, const adouble_n &cond,
+                                  const adouble_n &arg1,
+                                  const adouble_n &arg2) {
+    if (cond.getValue() >= 0)
+      res = arg1;
+    else
+      res = arg2;
+  }
+  inline friend void condeqassign(adouble_n &res, const adouble_n &cond,
+                                  const adouble_n &arg) {
+    if (cond.getValue() >= 0)
+      res = arg;
+  }
+
+  /*******************  nontemporary results  ***************************/
+  // assignment
+  inline adouble_n &operator=(const double v) {
+    adval[0] = v;
+    for (size_t i = 1; i <= N; ++i)
+      adval[i] = 0.0;
+    return *this;
+  }
+
+  // addition
+  inline adouble_n &operator+=(const double v) {
+    adval[0] += v;
+    return *this;
+  }
+  inline adouble_n &operator+=(const adouble_n &a) {
+    for (size_t i = 0; i <= N; ++i)
+      adval[i] += a.adval[i];
+    return *this;
+  }
+
+  // subtraction
+  inline adouble_n &operator-=(const double v) {
+    adval[0] -= v;
+    return *this;
+  }
+  inline adouble_n &operator-=(const adouble_n &a) {
+    for (size_t i = 0; i <= N; ++i)
+      adval[i] -= a.adval[i];
+    return *this;
+  }
+
+  // multiplication
+  inline adouble_n &operator*=(const double v) {
+    for (size_t i = 0; i <= N; ++i)
+      adval[i] *= v;
+    return *this;
+  }
+  inline adouble_n &operator*=(const adouble_n &a) {
+    for (size_t i = 1; i <= N; ++i)
+      adval[i] = adval[i] * a.adval[0] + adval[0] * a.adval[i];
+    adval[0] *= a.adval[0];
+    return *this;
+  }
+
+  // division
+  inline adouble_n &operator/=(const double v) {
+    for (size_t i = 0; i <= N; ++i)
+      adval[i] /= v;
+    return *this;
+  }
+  inline adouble_n &operator/=(const adouble_n &a) {
+    for (size_t i = 1; i <= N; ++i)
+      adval[i] = (adval[i] * a.adval[0] - adval[0] * a.adval[i]) /
+                 (a.adval[0] * a.adval[0]);
+    adval[0] /= a.adval[0];
+    return *this;
+  }
+
+  // not
+  inline bool operator!() const { return adval[0] == 0.0; }
+
+  // comparison
+#define ADOLC_ADTL_N_COMPARISON(op)                                            \
+  inline friend bool operator op(const adouble_n &a, const adouble_n &b) {     \
+    return a.adval[0] op b.adval[0];                                           \
+  }                                                                            \
+  inline friend bool operator op(const adouble_n &a, const double v) {         \
+    return a.adval[0] op v;                                                    \
+  }                                                                            \
+  inline friend bool operator op(const double v, const adouble_n &a) {         \
+    return v op a.adval[0];                                                    \
+  }
+  ADOLC_ADTL_N_COMPARISON(!=)
+  ADOLC_ADTL_N_COMPARISON(==)
+  ADOLC_ADTL_N_COMPARISON(<=)
+  ADOLC_ADTL_N_COMPARISON(>=)
+  ADOLC_ADTL_N_COMPARISON(>)
+  ADOLC_ADTL_N_COMPARISON(<)
+#undef ADOLC_ADTL_N_COMPARISON
+
+  /*******************  getter / setter  ********************************/
+  inline double getValue() const { return adval[0]; }
+  inline void setValue(const double v) { adval[0] = v; }
+  inline const double *getADValue() const { return adval.data() + 1; }
+  inline void setADValue(const double *v) {
+    for (size_t i = 1; i <= N; ++i)
+      adval[i] = v[i - 1];
+  }
+  inline double getADValue(const unsigned int p) const {
+    if (p >= N) {
+      fprintf(DIAG_OUT, "Derivative array accessed out of bounds"
+                        " while \"getADValue(...)\"!!!\n");
+      throw std::logic_error("incorrect function call, errorcode=-1");
+    }
+    return adval[p + 1];
+  }
+  inline void setADValue(const unsigned int p, const double v) {
+    if (p >= N) {
+      fprintf(DIAG_OUT, "Derivative array accessed out of bounds"
+                        " while \"setADValue(...)\"!!!\n");
+      throw std::logic_error("incorrect function call, errorcode=-1");
+    }
+    adval[p + 1] = v;
+  }
+  inline explicit operator double const &() const { return adval[0]; }
+  static constexpr size_t getNumDir() { return N; }
+
+  /*******************  i/o operations  *********************************/
+  inline friend std::ostream &operator<<(std::ostream &out,
+                                         const adouble_n &a) {
+    out << "Value: " << a.adval[0];
+    out << " ADValues (" << N << "): ";
+    for (size_t i = 1; i <= N; ++i)
+      out << a.adval[i] << " ";
+    out << "(a)";
+    return out;
+  }
+
+private:
+  /* the result of an elemental function with value v and derivative d */
+  inline adouble_n chain(const double v, const double d) const {
+    adouble_n tmp;
+    tmp.adval[0] = v;
+    for (size_t i = 1; i <= N; ++i)
+      tmp.adval[i] = d * adval[i];
+    return tmp;
+  }
+
+  /* derivative of log, sqrt and cbrt where their argument x is not
+   * positive, dx is the direction */
+  static inline double singular(const double x, const double dx) {
+    if (x == 0.0 && dx != 0.0)
+      return (dx < 0 ? -1 : 1) * std::numeric_limits<double>::infinity();
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+
+  /* value and directional derivatives like adouble::adval */
+  std::array<double, N + 1> adval;
+};
+
+} // namespace adtl
+#endif
@@ -27,6 +27,13 @@ typedef int (*ADOLC_TimeStepFuncion_double)(int n, double *x);
 typedef void *(*ADOLC_saveFct)();
 typedef void (*ADOLC_restoreFct)(void *);
 
+/* where the checkpoints of the time steps are kept */
+enum CheckpointStorage {
+  ADOLC_CP_STORE_RAM,        /* arrays in main memory (default) */
+  ADOLC_CP_STORE_COMPRESSED, /* losslessly compressed arrays in main memory */
+  ADOLC_CP_STORE_FILE        /* memory mapped file in the tape directory */
+};
+
 typedef struct CpInfos {
   ADOLC_TimeStepFuncion function;
   ADOLC_TimeStepFuncion_double function_double;
@@ -36,6 +43,11 @@ typedef struct CpInfos {
   int checkpoints;
   int tapeNumber; /* tape number to be used for checkpointing */
   int retaping;   /* != 0 forces retaping before every reverse step */
+  int storage;    /* see enum CheckpointStorage */
+  int ramCheckpoints; /* with storage != ADOLC_CP_STORE_RAM, the topmost
+                         checkpoints are nevertheless kept in main memory */
+  int parallel;   /* != 0 recomputes the states of the reverse steps on a
+                     helper thread */
 
   int n;          /* number of variables in input and output (n=m) */
   adouble *adp_x; /* input of the first step */
@@ -50,7 +62,8 @@ typedef struct CpInfos {
   double *dp_internal_for;
   double *dp_internal_rev;
   double **dpp_internal_rev;
-  locint index; /* please do not change */
+  void *storageFile; /* file of ADOLC_CP_STORE_FILE while in use */
+  locint index;      /* please do not change */
   char modeForward;
   char modeReverse;
   char *allmem; /* this is dummy to get externfcts and checkpointing both use
@@ -81,6 +94,9 @@ public:
   inline void setInput(adouble *x);
   inline void setOutput(adouble *y);
   inline void setAlwaysRetaping(bool state);
+  inline void setStorage(int storage);
+  inline void setNumberOfRamCheckpoints(int number);
+  inline void setParallelReverse(bool state);
 
   inline int checkpointing();
 
@@ -127,6 +143,19 @@ void CP_Context::setAlwaysRetaping(bool state) {
     cpInfos->retaping = 0;
 }
 
+void CP_Context::setStorage(int storage) { cpInfos->storage = storage; }
+
+void CP_Context::setNumberOfRamCheckpoints(int number) {
+  cpInfos->ramCheckpoints = number;
+}
+
+void CP_Context::setParallelReverse(bool state) {
+  if (state)
+    cpInfos->parallel = 1;
+  else
+    cpInfos->parallel = 0;
+}
+
 int CP_Context::checkpointing() { return ::checkpointing(cpInfos); }
 
 #endif /* CPLUSPLUS */
@@ -36,6 +36,10 @@ ADOLC_DLL_EXPORT fint function_(fint *, fint *, fint *, fdouble *, fdouble *);
 ADOLC_DLL_EXPORT int gradient(short, int, const double *, double *);
 ADOLC_DLL_EXPORT fint gradient_(fint *, fint *, fdouble *, fdouble *);
 
+/* gradient_batch(tag, n, npoints, X[npoints][n], G[npoints][n])            */
+/* (defined in batch_sweeps.cpp)                                            */
+ADOLC_DLL_EXPORT int gradient_batch(short, int, int, double **, double **);
+
 /*--------------------------------------------------------------------------*/
 /*                                                                 jacobian */
 /* jacobian(tag, m, n, x[n], J[m][n])                                       */
@@ -69,10 +73,27 @@ ADOLC_DLL_EXPORT fint jac_vec_(fint *, fint *, fint *, fdouble *, fdouble *,
 /*--------------------------------------------------------------------------*/
 /*                                                                  hessian */
 /* hessian(tag, n, x[n], lower triangle of H[n][n])                         */
-/* uses Hessian-vector product                                              */
+/* uses blocks of Hessian-matrix products or Hessian-vector products        */
 ADOLC_DLL_EXPORT int hessian(short, int, const double *, double **);
 ADOLC_DLL_EXPORT fint hessian_(fint *, fint *, fdouble *, fdouble *);
 
+/*--------------------------------------------------------------------------*/
+/*                                                           hessian_packed */
+/* hessian_packed(tag, n, x[n], H[n*(n+1)/2], block)                        */
+/* lower triangle stored row by row, H_ij = H[i*(i+1)/2+j] for j <= i,      */
+/* block Hessian columns per sweep pair (automatic if block <= 0)           */
+ADOLC_DLL_EXPORT int hessian_packed(short, int, const double *, double *,
+                                    int);
+
+/*--------------------------------------------------------------------------*/
+/*                                                           edge_push_hess */
+/* edge_push_hess(tag, n, x[n], &nnz, &rind, &cind, &values)                */
+/* sparse Hessian in coordinate format (upper triangle) by edge pushing,    */
+/* no sparsity pattern and coloring (defined in edge_pushing.cpp)           */
+ADOLC_DLL_EXPORT int edge_push_hess(short, int, const double *, int *,
+                                    unsigned int **, unsigned int **,
+                                    double **);
+
 /*--------------------------------------------------------------------------*/
 /*                                                                 hessian2 */
 /* hessian2(tag, n, x[n], lower triangle of H[n][n])                        */
@@ -28,6 +28,14 @@ BEGIN_C_DECLS
 ADOLC_DLL_EXPORT int tensor_eval(short tag, int m, int n, int d, int p,
                                  double *x, double **tensor, double **S);
 
+/*--------------------------------------------------------------------------*/
+/* tensor_eval_mt(tag,m,n,d,p,x[n],tensor[m][dim],S[n][p],nthreads)
+      as tensor_eval, with the Taylor series propagated by nthreads
+      threads (all available ones if nthreads <= 0) */
+ADOLC_DLL_EXPORT int tensor_eval_mt(short tag, int m, int n, int d, int p,
+                                    double *x, double **tensor, double **S,
+                                    int nthreads);
+
 /*--------------------------------------------------------------------------*/
 /* inverse_tensor_eval(tag,n,d,p,x,tensor[n][dim],S[n][p])
       with dim = ((p+d) over d) */
@@ -22,6 +22,12 @@
                                  hov_reverse.c
                                  hos_ti_reverse.c
                                  hov_ti_reverse.c
+                 parallel_sweeps.cpp for
+                                 fov_forward_mt
+                                 hov_forward_mt
+                                 fov_reverse_mt
+                 batch_sweeps.cpp for
+                                 zos_forward_batch
                  interfacesC.C
                  interfacesf.c
 
@@ -196,6 +202,12 @@ ADOLC_DLL_EXPORT int zos_forward_nk(short, int, int, const double *, double *);
 ADOLC_DLL_EXPORT int zos_forward_partx(short, int, int, int *, double **,
                                        double *);
 
+/* zos_forward_batch(tag, m, n, npoints, X[npoints][n], Y[npoints][m])      */
+/* (no keep, evaluates blocks of points per operation, defined in          */
+/*  batch_sweeps.cpp)                                                       */
+ADOLC_DLL_EXPORT int zos_forward_batch(short, int, int, int, double **,
+                                       double **);
+
 /*--------------------------------------------------------------------------*/
 /*                                                                      FOS */
 /* fos_forward(tag, m, n, keep, x[n], X[n], y[m], Y[m])                     */
@@ -244,6 +256,12 @@ ADOLC_DLL_EXPORT int fov_offset_forward(short, int, int, int, int,
                                         const double *, double **, double *,
                                         double **);
 
+/* fov_forward_mt(tag, m, n, p, x[n], X[n][p], y[m], Y[m][p], nthreads,     */
+/*                chunk)                                                    */
+/* (defined in parallel_sweeps.cpp)                                         */
+ADOLC_DLL_EXPORT int fov_forward_mt(short, int, int, int, const double *,
+                                    double **, double *, double **, int, int);
+
 /* now pack the arrays into vectors for Fortran calling                     */
 ADOLC_DLL_EXPORT fint fov_forward_(fint *, fint *, fint *, fint *, fdouble *,
                                    fdouble *, fdouble *, fdouble *);
@@ -260,6 +278,13 @@ ADOLC_DLL_EXPORT int fov_forward_partx(short, int, int, int *, int, double **,
 ADOLC_DLL_EXPORT int hov_forward(short, int, int, int, int, const double *,
                                  double ***, double *, double ***);
 
+/* hov_forward_mt(tag, m, n, d, p, x[n], X[n][p][d], y[m], Y[m][p][d],      */
+/*                nthreads, chunk)                                          */
+/* (defined in parallel_sweeps.cpp)                                         */
+ADOLC_DLL_EXPORT int hov_forward_mt(short, int, int, int, int, const double *,
+                                    double ***, double *, double ***, int,
+                                    int);
+
 /* now pack the arrays into vectors for Fortran calling                     */
 ADOLC_DLL_EXPORT fint hov_forward_(fint *, fint *, fint *, fint *, fint *,
                                    fdouble *, fdouble *, fdouble *, fdouble *);
@@ -317,6 +342,24 @@ ADOLC_DLL_EXPORT int indopro_forward_safe(short, int, int, const double *,
 ADOLC_DLL_EXPORT int indopro_forward_tight(short, int, int, const double *,
                                            unsigned int **);
 
+/*--------------------------------------------------------------------------*/
+/*                                                    INDOPRO, OFFSET, SAFE */
+/* indopro_offset_forward_safe(tag, m, n, offset, count, x[n], *Y[m])       */
+/* index domains of the independents offset, ..., offset + count - 1 only   */
+
+ADOLC_DLL_EXPORT int indopro_offset_forward_safe(short, int, int, int, int,
+                                                 const double *,
+                                                 unsigned int **);
+
+/*--------------------------------------------------------------------------*/
+/*                                                   INDOPRO, OFFSET, TIGHT */
+/* indopro_offset_forward_tight(tag, m, n, offset, count, x[n], *Y[m])      */
+/* index domains of the independents offset, ..., offset + count - 1 only   */
+
+ADOLC_DLL_EXPORT int indopro_offset_forward_tight(short, int, int, int, int,
+                                                  const double *,
+                                                  unsigned int **);
+
 /****************************************************************************/
 /*                                         NONLINEAR INDEX DOMAIN UTILITIES */
 /*--------------------------------------------------------------------------*/
@@ -346,6 +389,22 @@ ADOLC_DLL_EXPORT int nonl_ind_old_forward_safe(short, int, int, const double *,
 ADOLC_DLL_EXPORT int nonl_ind_old_forward_tight(short, int, int, const double *,
                                                 unsigned int **);
 
+/*--------------------------------------------------------------------------*/
+/*                                                        INDEX GRAPH, SAFE */
+/* nonl_ind_graph_safe(tag, m, n, x[n], *Y[n])                              */
+/* (defined in nonl_ind_graph.cpp)                                          */
+
+ADOLC_DLL_EXPORT int nonl_ind_graph_safe(short, int, int, const double *,
+                                         unsigned int **);
+
+/*--------------------------------------------------------------------------*/
+/*                                                       INDEX GRAPH, TIGHT */
+/* nonl_ind_graph_tight(tag, m, n, x[n], *Y[n])                             */
+/* (defined in nonl_ind_graph.cpp)                                          */
+
+ADOLC_DLL_EXPORT int nonl_ind_graph_tight(short, int, int, const double *,
+                                          unsigned int **);
+
 /****************************************************************************/
 /*                                                             REVERSE MODE */
 
@@ -401,6 +460,13 @@ ADOLC_DLL_EXPORT int fov_reverse(short, int, int, int, double **, double **);
 ADOLC_DLL_EXPORT fint fov_reverse_(fint *, fint *, fint *, fint *, fdouble *,
                                    fdouble *);
 
+/*--------------------------------------------------------------------------*/
+/*                                                                FOV, MULTI */
+/* fov_reverse_mt(tag, m, n, p, U[p][m], Z[p][n], nthreads)                 */
+/* (defined in parallel_sweeps.cpp)                                         */
+ADOLC_DLL_EXPORT int fov_reverse_mt(short, int, int, int, double **,
+                                    double **, int);
+
 /*--------------------------------------------------------------------------*/
 /*                                                                      HOV */
 /* hov_reverse(tag, m, n, d, p, U[p][m], Z[p][n][d+1], nz[p][n])            */
@@ -33,6 +33,11 @@
 /* Number of temporary Taylor stores*/
 #define TBUFNUM 32
 
+/*--------------------------------------------------------------------------*/
+/* Bytes of first order Taylor coefficients (live variables x directions)   */
+/* per chunk of a multithreaded vector sweep, should fit into the L2 cache  */
+#define DIRCHUNKSIZE 262144
+
 /*--------------------------------------------------------------------------*/
 /* Data types used by Fortran callable versions of functions */
 #define fint long
@@ -45,6 +45,16 @@ ADOLC_DLL_EXPORT int absnormal_jac_pat(short, int, int, int, const double *,
 ADOLC_DLL_EXPORT void generate_seed_jac(int, int, unsigned int **, double ***,
                                         int *, int);
 
+/*--------------------------------------------------------------------------*/
+/*                        seed matrix for sparse jacobian, parallel coloring */
+/* generate_seed_jac_mt(m, n, crs, &seed, &p, option, nthreads);            */
+/*                                                                          */
+/*     greedy coloring by nthreads OpenMP threads (all if nthreads <= 0),   */
+/*     the seed has the layout of generate_seed_jac                         */
+
+ADOLC_DLL_EXPORT void generate_seed_jac_mt(int, int, unsigned int **,
+                                           double ***, int *, int, int);
+
 /*--------------------------------------------------------------------------*/
 /*                                                         sparse jacobian  */
 /* int sparse_jac(tag, m, n, repeat, x, &nnz, &row_ind, &col_ind, &values,  */
@@ -87,6 +97,31 @@ ADOLC_DLL_EXPORT void get_HP(short tag, /* tape identification */
                              int indep, /* number of independent variables */
                              unsigned int ***HP);
 
+/*--------------------------------------------------------------------------*/
+/*                                                             sparse plans */
+/* Sparsity pattern, coloring, seed and recovery of a sparse Jacobian or    */
+/* Hessian, computed once and evaluated for any tape of the same structure  */
+/* (defined in sparse_plan.cpp).                                            */
+/*                                                                          */
+/* plan = sparse_jac_plan(tag, m, n, x, options[4]);                        */
+/* plan = sparse_hess_plan(tag, n, x, options[2]);                          */
+/* nnz = sparse_plan_nnz(plan, &rind, &cind);                               */
+/* sparse_plan_eval(plan, tag, x, values[nnz]);                             */
+
+typedef struct SparsePlan SparsePlan;
+
+ADOLC_DLL_EXPORT SparsePlan *sparse_jac_plan(short, int, int, const double *,
+                                             int *);
+ADOLC_DLL_EXPORT SparsePlan *sparse_hess_plan(short, int, const double *,
+                                              int *);
+ADOLC_DLL_EXPORT int sparse_plan_nnz(const SparsePlan *, const unsigned int **,
+                                     const unsigned int **);
+ADOLC_DLL_EXPORT int sparse_plan_eval(const SparsePlan *, short,
+                                      const double *, double *);
+ADOLC_DLL_EXPORT int sparse_plan_write(const SparsePlan *, const char *);
+ADOLC_DLL_EXPORT SparsePlan *sparse_plan_read(const char *);
+ADOLC_DLL_EXPORT void sparse_plan_free(SparsePlan *);
+
 /*--------------------------------------------------------------------------*/
 /*                                                   JACOBIAN BLOCK PATTERN */
 
@@ -96,7 +131,16 @@ ADOLC_DLL_EXPORT void get_HP(short tag, /* tape identification */
    x stays for ( x * sizeof(unsigned long int) * 8 )
    (block) variables at once                                            */
 
-#define PQ_STRIPMINE_MAX 30
+#define PQ_STRIPMINE_MAX 240
+
+/* Min. number of unsigned longs of the strips, which are shortened to
+   PQ_STRIPMINE_BYTES bytes of bit patterns of all live variables of the
+   tape. All strips are multiples of PQ_STRIPMINE_ALIGN unsigned longs,
+   i.e. of 512 bits                                                     */
+
+#define PQ_STRIPMINE_MIN 32
+#define PQ_STRIPMINE_BYTES 33554432
+#define PQ_STRIPMINE_ALIGN 8
 
 ADOLC_DLL_EXPORT int bit_vector_propagation(short, int, int, const double *,
                                             unsigned int **, int *);
@@ -39,7 +39,8 @@ enum StatEntries {
   NO_MIN_MAX,   /* no use of min_op, deferred to abs_op for piecewise stuff */
   NUM_SWITCHES, /* # of abs calls that can switch branch */
   NUM_PARAM, /* no of parameters (doubles) interchangeable without retaping */
-  STAT_SIZE  /* represents the size of the stats vector */
+  TAPE_CODEC, /* codec of the tape files (see enumeration TapeCodecType) */
+  STAT_SIZE   /* represents the size of the stats vector */
 };
 
 enum TapeRemovalType { ADOLC_REMOVE_FROM_CORE, ADOLC_REMOVE_COMPLETELY };
@@ -49,8 +50,58 @@ enum LocationMgrType {
   ADOLC_LOCATION_SINGLETONS /* only singleton locations, no blocks */
 };
 
+enum TapeStorageType {
+  ADOLC_TAPE_STORE_BUFFERED, /* read tape files blockwise into the buffers */
+  ADOLC_TAPE_STORE_MMAP,     /* sweep directly over the mapped tape files */
+  ADOLC_TAPE_STORE_ASYNC     /* read ahead and write behind in background */
+};
+
+enum TapeCodecType {
+  ADOLC_TAPE_CODEC_NONE, /* tape files hold the raw buffers */
+  ADOLC_TAPE_CODEC_BLOCK /* blockwise compressed tape files */
+};
+
+enum TapeOptimizeFlags {
+  ADOLC_OPT_DEAD_CODE = 1, /* remove ops that do not reach a dependent */
+  ADOLC_OPT_COPY_PROP = 2, /* read through assign_a and pos_sign_a copies */
+  ADOLC_OPT_RENUMBER = 4,  /* reuse locations to shrink NUM_MAX_LIVES */
+  ADOLC_OPT_LOCALITY = 8,  /* number locations in the order of first use */
+  ADOLC_OPT_ALL = 15
+};
+
 ADOLC_DLL_EXPORT void skip_tracefile_cleanup(short tnum);
 
+/* Selects how the tape files of tape "tnum" are accessed during taping and
+ * during forward and reverse sweeps (see enumeration TapeStorageType). The
+ * default can be given as "TAPESTORE" in .adolcrc. Tapes kept in core are
+ * not affected. */
+ADOLC_DLL_EXPORT void set_tape_storage(short tnum, int storageType);
+
+/* Selects the codec used for the tape files of tape "tnum" the next time it
+ * is traced (see enumeration TapeCodecType). The default can be given as
+ * "TAPECODEC" in .adolcrc. The codec of a tape is recorded in its stats. */
+ADOLC_DLL_EXPORT void set_tape_codec(short tnum, int codec);
+
+/* Rewrites the finished tape "tag" in place, applying the passes selected
+ * by "flags" (see enumeration TapeOptimizeFlags). Returns the number of
+ * removed operations, or -1 if the tape is frozen or contains operations
+ * the optimizer does not handle (external functions, advectors, AMPI, ...),
+ * in which case the tape is left unchanged. A Taylor stack kept for the old
+ * tape is invalidated. */
+ADOLC_DLL_EXPORT int optimize_tape(short tag, int flags);
+
+/* Freezes the finished tape "tag", which has to reside in main memory and
+ * must not contain external functions. OpenMP workers sweeping a frozen tape
+ * read the operations, locations and values of the serial tape instead of
+ * needing a tape of their own; only the Taylor stack is kept per thread.
+ * A frozen tape cannot be retaped, optimized or removed. Must be called
+ * outside of parallel regions, returns 0 on success and -1 otherwise. */
+ADOLC_DLL_EXPORT int freeze_tape(short tag);
+
+/* Undoes freeze_tape and releases the Taylor stacks the workers kept for
+ * the tape "tag". Returns 0 on success and -1 if the tape is not frozen. */
+ADOLC_DLL_EXPORT int thaw_tape(short tag);
+
 /* Returns statistics on the tape "tag". Use enumeration StatEntries for
  * accessing the individual elements of the vector "tape_stats"! */
 ADOLC_DLL_EXPORT void tapestats(short tag, size_t *tape_stats);
@@ -65,6 +116,12 @@ ADOLC_DLL_EXPORT void cleanUp();
 
 ADOLC_DLL_EXPORT int removeTape(short tapeID, short type);
 
+/* The sweeps and drivers keep their Taylor, adjoint and seed arrays for the
+ * next call on the same tape by the same thread, the arrays only grow.
+ * Frees these arrays of the tape "tag" of the calling thread, of all its
+ * tapes if "tag" is negative. */
+ADOLC_DLL_EXPORT void release_workspace(short tag);
+
 ADOLC_DLL_EXPORT void enableBranchSwitchWarnings();
 ADOLC_DLL_EXPORT void disableBranchSwitchWarnings();
 
@@ -40,16 +40,10 @@ size_t adouble::numDir = 1;
 size_t refcounter::refcnt = 0;
 #endif
 
-#if USE_BOOST_POOL
-boost::pool<boost::default_user_allocator_new_delete> *adouble::advalpool =
-    new boost::pool<boost::default_user_allocator_new_delete>(
-        (adouble::numDir + 1) * sizeof(double), 32, 10000);
-#endif
-
 /*******************  i/o operations  ***************************************/
 ostream &operator<<(ostream &out, const adouble &a) {
   out << "Value: " << a.PRIMAL_VALUE;
-  out << " ADValues (" << adouble::numDir << "): ";
+  out << " ADValues (" << getNumDir() << "): ";
   FOR_I_EQ_1_LTEQ_NUMDIR
   out << a.ADVAL_I << " ";
   out << "(a)";
@@ -67,7 +61,7 @@ istream &operator>>(istream &in, adouble &a) {
     in >> c;
   while (c != '(' && !in.eof());
   in >> num;
-  if (num > adouble::numDir) {
+  if (num > getNumDir()) {
     cout << "ADOL-C error: to many directions in input\n";
     adolc_exit(-1, "", __func__, __FILE__, __LINE__);
   }
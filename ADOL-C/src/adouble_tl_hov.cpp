@@ -50,7 +50,7 @@ sizeof(double), 32, 10000); #endif
 /*******************  i/o operations  ***************************************/
 ostream &operator<<(ostream &out, const adouble &a) {
   out << "Value: " << a.val;
-  out << " ADValues (" << adouble::numDir << "): ";
+  out << " ADValues (" << getNumDir() << "): ";
   FOR_I_EQ_0_LT_NUMDIR
   out << a.ADVAL_I << " ";
   out << "(a)";
@@ -68,7 +68,7 @@ istream &operator>>(istream &in, adouble &a) {
     in >> c;
   while (c != '(' && !in.eof());
   in >> num;
-  if (num > adouble::numDir) {
+  if (num > getNumDir()) {
     cout << "ADOL-C error: to many directions in input\n";
     adolc_exit(-1, "", __func__, __FILE__, __LINE__);
   }
@@ -0,0 +1,706 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     batch_sweeps.cpp
+ Revision: $Id$
+ Contents: zero-order forward and first-order reverse sweeps evaluating one
+           tape at many points at once
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#include "dvlparms.h"
+#include "oplate.h"
+#include "taping_p.h"
+#include <adolc/drivers/drivers.h>
+#include <adolc/interfaces.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/* one operation of the tape, loc[k] belongs to layout[k], parameters are
+ * replaced by their values */
+struct BatchOp {
+  unsigned char op;
+  const char *layout; /* see opLayout */
+  locint loc[3];
+  double val;
+};
+
+struct BatchTape {
+  std::vector<BatchOp> ops;
+  locint numLocs; /* largest location used + 1 */
+  int numInds;
+  int numDeps;
+};
+
+inline bool isWritten(char role) { return role == 'R' || role == 'M'; }
+
+/****************************************************************************/
+/* Operations the batch sweeps evaluate. Those whose result or return code  */
+/* depends on a branch taken at taping time (abs, min, ceil, floor,         */
+/* conditional assignments) and all operations unknown to opLayout are left */
+/* to the sweeps of uni5_for.c and fo_rev.c. numVals is set to the number  */
+/* of values the operation reads from the value tape.                       */
+/****************************************************************************/
+const char *batchLayout(unsigned char op, int *numVals) {
+  bool essential;
+
+  switch (op) {
+  case gen_quad:
+  case min_op:
+  case abs_val:
+  case ceil_op:
+  case floor_op:
+  case cond_assign:
+  case cond_eq_assign:
+  case cond_assign_s:
+  case cond_eq_assign_s:
+    return NULL;
+  default:
+    return opLayout(op, numVals, &essential);
+  }
+}
+
+/****************************************************************************/
+/* Decodes tape "tag" into "tape". Returns false if the tape contains an    */
+/* operation the batch sweeps do not handle.                                */
+/****************************************************************************/
+bool decodeTape(short tag, BatchTape &tape) {
+  unsigned char op;
+  bool handled = true;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  init_for_sweep(tag);
+  tape.numInds = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS];
+  tape.numDeps = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_DEPENDENTS];
+  tape.numLocs = 0;
+
+  op = get_op_f();
+  while (op != end_of_tape && handled) {
+    switch (op) {
+    case end_of_op:
+      get_op_block_f();
+      op = get_op_f();
+      /* Skip next operation, it's another end_of_op */
+      break;
+    case end_of_int:
+      get_loc_block_f();
+      break;
+    case end_of_val:
+      get_val_block_f();
+      break;
+    case start_of_tape:
+      break;
+    case death_not:
+      get_locint_f();
+      get_locint_f();
+      break;
+    case take_stock_op: {
+      locint size = get_locint_f();
+      locint res = get_locint_f();
+      double *d = get_val_v_f(size);
+      for (locint i = 0; i < size; ++i) {
+        BatchOp o = {assign_d, "R", {res + i, 0, 0}, d[i]};
+        tape.ops.push_back(o);
+      }
+      break;
+    }
+    default: {
+      int numVals;
+      BatchOp o = {op, batchLayout(op, &numVals), {0, 0, 0}, 0.0};
+      if (o.layout == NULL) {
+        handled = false;
+        break;
+      }
+      for (size_t k = 0; o.layout[k] != 0; ++k) {
+        o.loc[k] = get_locint_f();
+        if (o.layout[k] == 'P')
+          o.val = ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore[o.loc[k]];
+      }
+      for (int k = 0; k < numVals; ++k) {
+        const double v = get_val_f();
+        if (k == 0)
+          o.val = v;
+      }
+      tape.ops.push_back(o);
+      break;
+    }
+    }
+    op = get_op_f();
+  }
+  end_sweep();
+
+  for (const BatchOp &o : tape.ops)
+    for (size_t k = 0; o.layout[k] != 0; ++k)
+      if (o.layout[k] != 'P' && o.loc[k] >= tape.numLocs)
+        tape.numLocs = o.loc[k] + 1;
+  return handled;
+}
+
+/****************************************************************************/
+/* Number of points evaluated together, such that "arrays" blocks of values */
+/* of all locations take about DIRCHUNKSIZE bytes.                          */
+/****************************************************************************/
+int blockSize(const BatchTape &tape, int npoints, int arrays) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  const size_t bytes =
+      std::max<size_t>(tape.numLocs, 1) * arrays * sizeof(double);
+  const size_t points = ADOLC_GLOBAL_TAPE_VARS.dirChunkSize / bytes;
+  return (int)std::max<size_t>(1, std::min<size_t>(points, npoints));
+}
+
+/****************************************************************************/
+/* Zero-order forward sweep for the np points X[0..np). The values of all   */
+/* locations are stored location major in v, i.e. the np values of one     */
+/* location are contiguous and every operation is one loop over the points. */
+/* If Y is NULL the dependents are not stored. If stack is not NULL, all    */
+/* values about to be overwritten are appended for reverseBlock. Returns    */
+/* the return code of zos_forward, or -1 as soon as a comparison switches   */
+/* for any of the points.                                                   */
+/****************************************************************************/
+int forwardBlock(const BatchTape &tape, int np, double **X, double **Y,
+                 double *v, std::vector<double> *stack) {
+  int rc = 3, indexi = 0, indexd = 0;
+
+  for (const BatchOp &o : tape.ops) {
+    double *const l0 = v + (size_t)o.loc[0] * np;
+    double *const l1 = v + (size_t)o.loc[1] * np;
+    double *const l2 = v + (size_t)o.loc[2] * np;
+    const double c = o.val;
+
+    if (stack != NULL)
+      for (size_t k = 0; o.layout[k] != 0; ++k)
+        if (isWritten(o.layout[k])) {
+          const double *w = v + (size_t)o.loc[k] * np;
+          stack->insert(stack->end(), w, w + np);
+        }
+
+    switch (o.op) {
+    case eq_zero:
+    case neq_zero:
+    case le_zero:
+    case gt_zero:
+    case ge_zero:
+    case lt_zero: {
+      bool switched = false, equal = false;
+      for (int k = 0; k < np; ++k) {
+        switched |= (o.op == eq_zero && l0[k] != 0) ||
+                    (o.op == neq_zero && l0[k] == 0) ||
+                    (o.op == le_zero && l0[k] > 0) ||
+                    (o.op == gt_zero && l0[k] <= 0) ||
+                    (o.op == ge_zero && l0[k] < 0) ||
+                    (o.op == lt_zero && l0[k] >= 0);
+        equal |= l0[k] == 0;
+      }
+      if (switched)
+        return -1;
+      if (equal && o.op != neq_zero && o.op != gt_zero && o.op != lt_zero)
+        rc = 0;
+      break;
+    }
+
+    case assign_ind:
+      for (int k = 0; k < np; ++k)
+        l0[k] = X[k][indexi];
+      ++indexi;
+      break;
+    case assign_dep:
+      if (Y != NULL)
+        for (int k = 0; k < np; ++k)
+          Y[k][indexd] = l0[k];
+      ++indexd;
+      break;
+
+    case assign_a:
+    case pos_sign_a:
+      for (int k = 0; k < np; ++k)
+        l1[k] = l0[k];
+      break;
+    case neg_sign_a:
+      for (int k = 0; k < np; ++k)
+        l1[k] = -l0[k];
+      break;
+    case assign_d:
+      for (int k = 0; k < np; ++k)
+        l0[k] = c;
+      break;
+    case assign_d_zero:
+      for (int k = 0; k < np; ++k)
+        l0[k] = 0.0;
+      break;
+    case assign_d_one:
+      for (int k = 0; k < np; ++k)
+        l0[k] = 1.0;
+      break;
+    case assign_p:
+      for (int k = 0; k < np; ++k)
+        l1[k] = c;
+      break;
+    case neg_sign_p:
+      for (int k = 0; k < np; ++k)
+        l1[k] = -c;
+      break;
+    case recipr_p:
+      for (int k = 0; k < np; ++k)
+        l1[k] = 1.0 / c;
+      break;
+
+    case eq_plus_d:
+      for (int k = 0; k < np; ++k)
+        l0[k] += c;
+      break;
+    case eq_min_d:
+      for (int k = 0; k < np; ++k)
+        l0[k] -= c;
+      break;
+    case eq_mult_d:
+      for (int k = 0; k < np; ++k)
+        l0[k] *= c;
+      break;
+    case eq_plus_p:
+      for (int k = 0; k < np; ++k)
+        l1[k] += c;
+      break;
+    case eq_min_p:
+      for (int k = 0; k < np; ++k)
+        l1[k] -= c;
+      break;
+    case eq_mult_p:
+      for (int k = 0; k < np; ++k)
+        l1[k] *= c;
+      break;
+    case eq_plus_a:
+      for (int k = 0; k < np; ++k)
+        l1[k] += l0[k];
+      break;
+    case eq_min_a:
+      for (int k = 0; k < np; ++k)
+        l1[k] -= l0[k];
+      break;
+    case eq_mult_a:
+      for (int k = 0; k < np; ++k)
+        l1[k] *= l0[k];
+      break;
+    case incr_a:
+      for (int k = 0; k < np; ++k)
+        l0[k]++;
+      break;
+    case decr_a:
+      for (int k = 0; k < np; ++k)
+        l0[k]--;
+      break;
+
+    case plus_a_a:
+      for (int k = 0; k < np; ++k)
+        l2[k] = l0[k] + l1[k];
+      break;
+    case min_a_a:
+      for (int k = 0; k < np; ++k)
+        l2[k] = l0[k] - l1[k];
+      break;
+    case mult_a_a:
+      for (int k = 0; k < np; ++k)
+        l2[k] = l0[k] * l1[k];
+      break;
+    case div_a_a:
+      for (int k = 0; k < np; ++k)
+        l2[k] = l0[k] / l1[k];
+      break;
+    case plus_d_a:
+      for (int k = 0; k < np; ++k)
+        l1[k] = l0[k] + c;
+      break;
+    case plus_a_p:
+      for (int k = 0; k < np; ++k)
+        l2[k] = l0[k] + c;
+      break;
+    case min_d_a:
+      for (int k = 0; k < np; ++k)
+        l1[k] = c - l0[k];
+      break;
+    case min_a_p:
+      for (int k = 0; k < np; ++k)
+        l2[k] = l0[k] - c;
+      break;
+    case mult_d_a:
+      for (int k = 0; k < np; ++k)
+        l1[k] = l0[k] * c;
+      break;
+    case mult_a_p:
+      for (int k = 0; k < np; ++k)
+        l2[k] = l0[k] * c;
+      break;
+    case div_d_a:
+      for (int k = 0; k < np; ++k)
+        l1[k] = c / l0[k];
+      break;
+    case div_p_a:
+      for (int k = 0; k < np; ++k)
+        l2[k] = c / l0[k];
+      break;
+    case pow_op:
+      for (int k = 0; k < np; ++k)
+        l1[k] = pow(l0[k], c);
+      break;
+    case pow_op_p:
+      for (int k = 0; k < np; ++k)
+        l2[k] = pow(l0[k], c);
+      break;
+    case eq_plus_prod:
+      for (int k = 0; k < np; ++k)
+        l2[k] += l0[k] * l1[k];
+      break;
+    case eq_min_prod:
+      for (int k = 0; k < np; ++k)
+        l2[k] -= l0[k] * l1[k];
+      break;
+
+    case exp_op:
+      for (int k = 0; k < np; ++k)
+        l1[k] = exp(l0[k]);
+      break;
+    case log_op:
+      for (int k = 0; k < np; ++k)
+        l1[k] = log(l0[k]);
+      break;
+    case sqrt_op:
+      for (int k = 0; k < np; ++k)
+        l1[k] = sqrt(l0[k]);
+      break;
+    case cbrt_op:
+      for (int k = 0; k < np; ++k)
+        l1[k] = cbrt(l0[k]);
+      break;
+    case sin_op: /* the covalue is stored in the second location */
+      for (int k = 0; k < np; ++k) {
+        const double x = l0[k];
+        l1[k] = cos(x);
+        l2[k] = sin(x);
+      }
+      break;
+    case cos_op:
+      for (int k = 0; k < np; ++k) {
+        const double x = l0[k];
+        l1[k] = sin(x);
+        l2[k] = cos(x);
+      }
+      break;
+    case atan_op: /* the derivative has been recorded before */
+      for (int k = 0; k < np; ++k)
+        l2[k] = atan(l0[k]);
+      break;
+    case asin_op:
+      for (int k = 0; k < np; ++k)
+        l2[k] = asin(l0[k]);
+      break;
+    case acos_op:
+      for (int k = 0; k < np; ++k)
+        l2[k] = acos(l0[k]);
+      break;
+    case asinh_op:
+      for (int k = 0; k < np; ++k)
+        l2[k] = asinh(l0[k]);
+      break;
+    case acosh_op:
+      for (int k = 0; k < np; ++k)
+        l2[k] = acosh(l0[k]);
+      break;
+    case atanh_op:
+      for (int k = 0; k < np; ++k)
+        l2[k] = atanh(l0[k]);
+      break;
+    case erf_op:
+      for (int k = 0; k < np; ++k)
+        l2[k] = erf(l0[k]);
+      break;
+    case erfc_op:
+      for (int k = 0; k < np; ++k)
+        l2[k] = erfc(l0[k]);
+      break;
+    }
+  }
+  return rc;
+}
+
+/****************************************************************************/
+/* First-order reverse sweep with weight 1 for the single dependent, after  */
+/* forwardBlock has been called with "stack". The adjoints are stored like  */
+/* the values in v. Every operation first saves the adjoint and the new     */
+/* values of its result, restores the old values of the locations it wrote */
+/* and then updates the adjoints of its arguments. This way, results may    */
+/* share locations with arguments.                                          */
+/****************************************************************************/
+void reverseBlock(const BatchTape &tape, int np, double **G, double *v,
+                  double *a, std::vector<double> &stack) {
+  std::vector<double> adj(np), out(np), co(np);
+  int indexi = tape.numInds - 1;
+
+  for (size_t i = tape.ops.size(); i-- > 0;) {
+    const BatchOp &o = tape.ops[i];
+    const size_t size = strlen(o.layout);
+    const double c = o.val;
+    size_t res = size - 1;
+
+    while (res > 0 && !isWritten(o.layout[res]))
+      --res;
+    if (isWritten(o.layout[res])) {
+      const double *ares = a + (size_t)o.loc[res] * np;
+      const double *vres = v + (size_t)o.loc[res] * np;
+      std::copy(ares, ares + np, adj.begin());
+      std::copy(vres, vres + np, out.begin());
+      if (o.op == sin_op || o.op == cos_op) {
+        const double *vco = v + (size_t)o.loc[1] * np;
+        std::copy(vco, vco + np, co.begin());
+      }
+      /* restore in the reverse order of forwardBlock */
+      for (size_t k = size; k-- > 0;)
+        if (isWritten(o.layout[k])) {
+          std::copy(stack.end() - np, stack.end(), v + (size_t)o.loc[k] * np);
+          stack.resize(stack.size() - np);
+          if (o.layout[k] == 'R')
+            std::fill_n(a + (size_t)o.loc[k] * np, np, 0.0);
+        }
+    }
+
+    double *const v0 = v + (size_t)o.loc[0] * np;
+    double *const v1 = v + (size_t)o.loc[1] * np;
+    double *const a0 = a + (size_t)o.loc[0] * np;
+    double *const a1 = a + (size_t)o.loc[1] * np;
+    const double *const w = adj.data();
+    const double *const r = out.data();
+
+    switch (o.op) {
+    case assign_ind:
+      for (int k = 0; k < np; ++k)
+        G[k][indexi] = w[k];
+      --indexi;
+      break;
+    case assign_dep:
+      for (int k = 0; k < np; ++k)
+        a0[k] = 1.0;
+      break;
+
+    case assign_a:
+    case pos_sign_a:
+    case plus_d_a:
+      for (int k = 0; k < np; ++k)
+        a0[k] += w[k];
+      break;
+    case neg_sign_a:
+    case min_d_a:
+      for (int k = 0; k < np; ++k)
+        a0[k] -= w[k];
+      break;
+    case eq_mult_d:
+      for (int k = 0; k < np; ++k)
+        a0[k] = w[k] * c;
+      break;
+    case eq_mult_p:
+      for (int k = 0; k < np; ++k)
+        a1[k] = w[k] * c;
+      break;
+    case eq_plus_a:
+      for (int k = 0; k < np; ++k)
+        a0[k] += w[k];
+      break;
+    case eq_min_a:
+      for (int k = 0; k < np; ++k)
+        a0[k] -= w[k];
+      break;
+    case eq_mult_a: /* v1 holds the old value of the result again */
+      for (int k = 0; k < np; ++k) {
+        const double old = v1[k];
+        a1[k] = w[k] * v0[k];
+        a0[k] += w[k] * old;
+      }
+      break;
+
+    case plus_a_a:
+      for (int k = 0; k < np; ++k) {
+        a0[k] += w[k];
+        a1[k] += w[k];
+      }
+      break;
+    case min_a_a:
+      for (int k = 0; k < np; ++k) {
+        a0[k] += w[k];
+        a1[k] -= w[k];
+      }
+      break;
+    case mult_a_a:
+      for (int k = 0; k < np; ++k) {
+        const double x = v0[k], y = v1[k];
+        a0[k] += w[k] * y;
+        a1[k] += w[k] * x;
+      }
+      break;
+    case div_a_a:
+      for (int k = 0; k < np; ++k) {
+        const double d = 1.0 / v1[k];
+        a0[k] += w[k] * d;
+        a1[k] -= w[k] * r[k] * d;
+      }
+      break;
+    case plus_a_p:
+    case min_a_p:
+      for (int k = 0; k < np; ++k)
+        a0[k] += w[k];
+      break;
+    case mult_d_a:
+    case mult_a_p:
+      for (int k = 0; k < np; ++k)
+        a0[k] += w[k] * c;
+      break;
+    case div_d_a:
+    case div_p_a:
+      for (int k = 0; k < np; ++k)
+        a0[k] -= w[k] * r[k] / v0[k];
+      break;
+    case pow_op:
+    case pow_op_p:
+      for (int k = 0; k < np; ++k)
+        a0[k] += v0[k] == 0.0 ? 0.0 : w[k] * r[k] * c / v0[k];
+      break;
+    case eq_plus_prod:
+      for (int k = 0; k < np; ++k) {
+        const double x = v0[k], y = v1[k];
+        a0[k] += w[k] * y;
+        a1[k] += w[k] * x;
+      }
+      break;
+    case eq_min_prod:
+      for (int k = 0; k < np; ++k) {
+        const double x = v0[k], y = v1[k];
+        a0[k] -= w[k] * y;
+        a1[k] -= w[k] * x;
+      }
+      break;
+
+    case exp_op:
+      for (int k = 0; k < np; ++k)
+        a0[k] += w[k] * r[k];
+      break;
+    case log_op:
+      for (int k = 0; k < np; ++k)
+        a0[k] += w[k] / v0[k];
+      break;
+    case sqrt_op:
+      for (int k = 0; k < np; ++k)
+        a0[k] += r[k] == 0.0 ? 0.0 : w[k] * 0.5 / r[k];
+      break;
+    case cbrt_op:
+      for (int k = 0; k < np; ++k)
+        a0[k] += r[k] == 0.0 ? 0.0 : w[k] / (3.0 * r[k] * r[k]);
+      break;
+    case sin_op:
+      for (int k = 0; k < np; ++k)
+        a0[k] += w[k] * co[k];
+      break;
+    case cos_op:
+      for (int k = 0; k < np; ++k)
+        a0[k] -= w[k] * co[k];
+      break;
+    case atan_op:
+    case asin_op:
+    case acos_op:
+    case asinh_op:
+    case acosh_op:
+    case atanh_op:
+    case erf_op:
+    case erfc_op:
+      for (int k = 0; k < np; ++k)
+        a0[k] += w[k] * v1[k];
+      break;
+    }
+  }
+}
+
+} // namespace
+
+BEGIN_C_DECLS
+
+/****************************************************************************/
+/* Zero-order forward mode at the points X[0..npoints), the values of the   */
+/* dependents are stored in Y[0..npoints). The tape is decoded once and     */
+/* every operation is applied to a block of points in a loop the compiler   */
+/* can vectorize. Points whose comparisons do not agree with the tape and   */
+/* tapes with operations the batch sweeps do not handle are evaluated by    */
+/* zos_forward. No Taylor stack is kept.                                    */
+/****************************************************************************/
+int zos_forward_batch(short tag, int m, int n, int npoints, double **X,
+                      double **Y) {
+  BatchTape tape;
+  int rc = 3;
+
+  if (npoints <= 0)
+    return rc;
+  if (!decodeTape(tag, tape) || tape.numInds != n || tape.numDeps != m) {
+    for (int k = 0; k < npoints; ++k)
+      MINDEC(rc, zos_forward(tag, m, n, 0, X[k], Y[k]));
+    return rc;
+  }
+
+  const int block = blockSize(tape, npoints, 1);
+  std::vector<double> v((size_t)tape.numLocs * block);
+  for (int first = 0; first < npoints; first += block) {
+    const int np = std::min(block, npoints - first);
+    const int brc = forwardBlock(tape, np, X + first, Y + first, v.data(),
+                                 NULL);
+    if (brc < 0)
+      for (int k = first; k < first + np; ++k)
+        MINDEC(rc, zos_forward(tag, m, n, 0, X[k], Y[k]));
+    else
+      MINDEC(rc, brc);
+  }
+  return rc;
+}
+
+/****************************************************************************/
+/* Gradients G[0..npoints) of the scalar function on tape "tag" at the      */
+/* points X[0..npoints), evaluated like zos_forward_batch by one forward    */
+/* and one reverse sweep per block of points.                               */
+/****************************************************************************/
+int gradient_batch(short tag, int n, int npoints, double **X, double **G) {
+  BatchTape tape;
+  int rc = 3;
+
+  if (npoints <= 0)
+    return rc;
+  if (!decodeTape(tag, tape) || tape.numInds != n || tape.numDeps != 1) {
+    for (int k = 0; k < npoints; ++k)
+      MINDEC(rc, gradient(tag, n, X[k], G[k]));
+    return rc;
+  }
+
+  const int block = blockSize(tape, npoints, 2);
+  std::vector<double> v((size_t)tape.numLocs * block);
+  std::vector<double> a((size_t)tape.numLocs * block);
+  std::vector<double> stack;
+  for (int first = 0; first < npoints; first += block) {
+    const int np = std::min(block, npoints - first);
+    stack.clear();
+    const int brc =
+        forwardBlock(tape, np, X + first, NULL, v.data(), &stack);
+    if (brc < 0) {
+      for (int k = first; k < first + np; ++k)
+        MINDEC(rc, gradient(tag, n, X[k], G[k]));
+    } else {
+      std::fill(a.begin(), a.end(), 0.0);
+      reverseBlock(tape, np, G + first, v.data(), a.data(), stack);
+      MINDEC(rc, brc);
+    }
+  }
+  return rc;
+}
+
+END_C_DECLS
@@ -21,11 +21,26 @@
 #include <adolc/interfaces.h>
 #include <adolc/revolve.h>
 
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
 
+#include <condition_variable>
+#include <exception>
+#include <mutex>
 #include <stack>
+#include <system_error>
+#include <thread>
+#include <vector>
 using namespace std;
 
+#if !defined(_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define ADOLC_HAVE_MMAP 1
+#endif
+
 ADOLC_BUFFER_TYPE ADOLC_EXT_DIFF_FCTS_BUFFER_DECL;
 
 /* field of pointers to the value fields of a checkpoint */
@@ -45,8 +60,9 @@ ADOLC_ext_fct_hov_reverse cp_hov_reverse;
 void cp_takeshot(CpInfos *cpInfos);
 void cp_restore(CpInfos *cpInfos);
 void cp_release(CpInfos *cpInfos);
-void cp_taping(CpInfos *cpInfos);
+void cp_taping(CpInfos *cpInfos, double *x);
 void revolve_for(CpInfos *cpInfos);
+void revolve_rev(CpInfos *cpInfos, int numDirs);
 void revolveError(CpInfos *cpInfos);
 
 /* we do not really have an ext. diff. function that we want to be called */
@@ -106,25 +122,24 @@ int checkpointing(CpInfos *cpInfos) {
   } else
     oldTraceFlag = 0;
 
-  numVals = ADOLC_GLOBAL_TAPE_VARS.storeSize;
-  vals = new double[numVals];
-  memcpy(vals, ADOLC_GLOBAL_TAPE_VARS.store, numVals * sizeof(double));
-
   cpInfos->dp_internal_for = new double[cpInfos->n];
   // initialize internal arguments
   for (i = 0; i < cpInfos->n; ++i)
     cpInfos->dp_internal_for[i] = cpInfos->adp_x[i].getValue();
-  if (ADOLC_CURRENT_TAPE_INFOS.keepTaylors != 0)
+  if (ADOLC_CURRENT_TAPE_INFOS.keepTaylors != 0) {
+    // only taping the last step creates adoubles, save their store
+    numVals = ADOLC_GLOBAL_TAPE_VARS.storeSize;
+    vals = new double[numVals];
+    memcpy(vals, ADOLC_GLOBAL_TAPE_VARS.store, numVals * sizeof(double));
     // perform all time steps, tape the last, take checkpoints
     revolve_for(cpInfos);
-  else
+    memcpy(ADOLC_GLOBAL_TAPE_VARS.store, vals, numVals * sizeof(double));
+    delete[] vals;
+  } else
     // perform all time steps without taping
     for (i = 0; i < cpInfos->steps; ++i)
       cpInfos->function_double(cpInfos->n, cpInfos->dp_internal_for);
 
-  memcpy(ADOLC_GLOBAL_TAPE_VARS.store, vals, numVals * sizeof(double));
-  delete[] vals;
-
   // update taylor stack; same structure as in adouble.cpp +
   // correction in taping.c
   if (oldTraceFlag != 0) {
@@ -258,7 +273,7 @@ void revolve_for(CpInfos *cpInfos) {
       }
       break;
     case revolve_firsturn:
-      cp_taping(cpInfos);
+      cp_taping(cpInfos, cpInfos->dp_internal_for);
       break;
     case revolve_error:
       revolveError(cpInfos);
@@ -334,49 +349,7 @@ int cp_fos_reverse(int m, double *dp_U, int n, double *dp_Z, double *dp_x,
   old_bsw = ADOLC_GLOBAL_TAPE_VARS.branchSwitchWarning;
   ADOLC_GLOBAL_TAPE_VARS.branchSwitchWarning = 0;
   // checkpointing
-  enum revolve_action whattodo;
-  do {
-    whattodo = revolve(&cpInfos->check, &cpInfos->capo, &cpInfos->fine,
-                       cpInfos->checkpoints, &cpInfos->info);
-    switch (whattodo) {
-    case revolve_terminate:
-      break;
-    case revolve_takeshot:
-      cp_takeshot(cpInfos);
-      cpInfos->currentCP = cpInfos->capo;
-      break;
-    case revolve_advance:
-      for (int i = 0; i < cpInfos->capo - cpInfos->currentCP; ++i)
-        cpInfos->function_double(cpInfos->n, cpInfos->dp_internal_for);
-      break;
-    case revolve_youturn:
-      if (cpInfos->retaping != 0)
-        cp_taping(cpInfos); // retaping forced
-      else {
-        // one forward step with keep and retaping if necessary
-        if (zos_forward(cpInfos->tapeNumber, cpInfos->n, cpInfos->n, 1,
-                        cpInfos->dp_internal_for, cpInfos->dp_internal_for) < 0)
-          cp_taping(cpInfos);
-      }
-      // one reverse step
-      fos_reverse(cpInfos->tapeNumber, cpInfos->n, cpInfos->n,
-                  cpInfos->dp_internal_rev, cpInfos->dp_internal_rev);
-      break;
-    case revolve_restore:
-      if (cpInfos->capo != cpInfos->currentCP)
-        cp_release(cpInfos);
-      cpInfos->currentCP = cpInfos->capo;
-      cp_restore(cpInfos);
-      break;
-    case revolve_error:
-      revolveError(cpInfos);
-      break;
-    default:
-      fail(ADOLC_CHECKPOINTING_UNEXPECTED_REVOLVE_ACTION);
-      break;
-    }
-  } while (whattodo != revolve_terminate && whattodo != revolve_error);
-  cp_release(cpInfos); // release first checkpoint if written
+  revolve_rev(cpInfos, 0);
   ADOLC_GLOBAL_TAPE_VARS.branchSwitchWarning = old_bsw;
 
   // save results
@@ -438,49 +411,7 @@ int cp_fov_reverse(int m, int p, double **dpp_U, int n, double **dpp_Z,
   old_bsw = ADOLC_GLOBAL_TAPE_VARS.branchSwitchWarning;
   ADOLC_GLOBAL_TAPE_VARS.branchSwitchWarning = 0;
   // checkpointing
-  enum revolve_action whattodo;
-  do {
-    whattodo = revolve(&cpInfos->check, &cpInfos->capo, &cpInfos->fine,
-                       cpInfos->checkpoints, &cpInfos->info);
-    switch (whattodo) {
-    case revolve_terminate:
-      break;
-    case revolve_takeshot:
-      cp_takeshot(cpInfos);
-      cpInfos->currentCP = cpInfos->capo;
-      break;
-    case revolve_advance:
-      for (int i = 0; i < cpInfos->capo - cpInfos->currentCP; ++i)
-        cpInfos->function_double(cpInfos->n, cpInfos->dp_internal_for);
-      break;
-    case revolve_youturn:
-      if (cpInfos->retaping != 0)
-        cp_taping(cpInfos); // retaping forced
-      else {
-        // one forward step with keep and retaping if necessary
-        if (zos_forward(cpInfos->tapeNumber, cpInfos->n, cpInfos->n, 1,
-                        cpInfos->dp_internal_for, cpInfos->dp_internal_for) < 0)
-          cp_taping(cpInfos);
-      }
-      // one reverse step
-      fov_reverse(cpInfos->tapeNumber, cpInfos->n, cpInfos->n, numDirs,
-                  cpInfos->dpp_internal_rev, cpInfos->dpp_internal_rev);
-      break;
-    case revolve_restore:
-      if (cpInfos->capo != cpInfos->currentCP)
-        cp_release(cpInfos);
-      cpInfos->currentCP = cpInfos->capo;
-      cp_restore(cpInfos);
-      break;
-    case revolve_error:
-      revolveError(cpInfos);
-      break;
-    default:
-      fail(ADOLC_CHECKPOINTING_UNEXPECTED_REVOLVE_ACTION);
-      break;
-    }
-  } while (whattodo != revolve_terminate && whattodo != revolve_error);
-  cp_release(cpInfos); // release first checkpoint if written
+  revolve_rev(cpInfos, numDirs);
   ADOLC_GLOBAL_TAPE_VARS.branchSwitchWarning = old_bsw;
 
   // save results
@@ -520,17 +451,272 @@ int cp_hov_reverse(int m, int p, double **dpp_U, int n, int d, double ***dppp_Z,
 /****************************************************************************/
 /*                              functions for handling the checkpoint stack */
 /****************************************************************************/
+/* The checkpoints of one revolve run are taken and released in stack       */
+/* order. With storage != ADOLC_CP_STORE_RAM, the checkpoints with revolve  */
+/* numbers below checkpoints - ramCheckpoints go to the slow tier. These    */
+/* are written rarely since revolve replaces the upper ones more often.     */
+
+/* A file of ADOLC_CP_STORE_FILE used as a stack of arrays, owned by the    */
+/* CpInfos and removed with its last checkpoint.                            */
+struct CpFile {
+  char *name;
+  void **owner; /* storageFile of the CpInfos */
+  size_t top;   /* end of the topmost array */
+  size_t size;
+  int count;    /* number of checkpoints in the file */
+#if defined(ADOLC_HAVE_MMAP)
+  int fd;
+  char *map;
+#else
+  FILE *fp;
+#endif
+};
+
+#define CP_FILE_MIN_SIZE (1 << 20)
+
+static void cpFileError(const CpFile *file) {
+  fprintf(DIAG_OUT, "ADOL-C error: cannot write checkpoint file %s\n",
+          file->name);
+  adolc_exit(-1, "", __func__, __FILE__, __LINE__);
+}
+
+static CpFile *cpFileOpen(CpInfos *cpInfos) {
+  CpFile *file;
+  char *tayName;
+
+  if (cpInfos->storageFile != NULL)
+    return static_cast<CpFile *>(cpInfos->storageFile);
+
+  file = new CpFile();
+  /* next to the Taylor file of the checkpointing tape, contexts sharing
+   * the tape are told apart by their index */
+  tayName = createFileName(cpInfos->tapeNumber, TAYLORS_TAPE);
+  file->name = (char *)malloc(strlen(tayName) + 16);
+  if (file->name == NULL)
+    fail(ADOLC_MALLOC_FAILED);
+  sprintf(file->name, "%s.cp%u", tayName, (unsigned int)cpInfos->index);
+  free(tayName);
+#if defined(ADOLC_HAVE_MMAP)
+  file->fd = open(file->name, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  file->map = NULL;
+  if (file->fd == -1)
+    cpFileError(file);
+#else
+  file->fp = fopen(file->name, "w+b");
+  if (file->fp == NULL)
+    cpFileError(file);
+#endif
+  file->owner = &cpInfos->storageFile;
+  cpInfos->storageFile = file;
+  return file;
+}
+
+static void cpFileClose(CpFile *file) {
+#if defined(ADOLC_HAVE_MMAP)
+  if (file->map != NULL)
+    munmap(file->map, file->size);
+  close(file->fd);
+#else
+  fclose(file->fp);
+#endif
+  remove(file->name);
+  free(file->name);
+  *file->owner = NULL;
+  delete file;
+}
+
+/* closes the file with its last checkpoint */
+static void cpFileDrop(CpFile *file) {
+  if (--file->count == 0)
+    cpFileClose(file);
+}
+
+/* appends n doubles to the file, returns their offset */
+static size_t cpFilePush(CpFile *file, const double *values, int n) {
+  const size_t bytes = n * sizeof(double);
+  const size_t offset = file->top;
+
+#if defined(ADOLC_HAVE_MMAP)
+  if (offset + bytes > file->size) {
+    /* grow geometrically, the mapping moves */
+    size_t size = MAX_ADOLC(2 * file->size, (size_t)CP_FILE_MIN_SIZE);
+    size = MAX_ADOLC(size, offset + bytes);
+    if (file->map != NULL)
+      munmap(file->map, file->size);
+    file->map = NULL;
+    if (ftruncate(file->fd, size) != 0)
+      cpFileError(file);
+    void *map =
+        mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, file->fd, 0);
+    if (map == MAP_FAILED)
+      cpFileError(file);
+    file->map = (char *)map;
+    file->size = size;
+  }
+  memcpy(file->map + offset, values, bytes);
+#else
+  if (fseek(file->fp, (long)offset, SEEK_SET) != 0 ||
+      fwrite(values, sizeof(double), n, file->fp) != (size_t)n)
+    cpFileError(file);
+#endif
+  file->top = offset + bytes;
+  ++file->count;
+  return offset;
+}
+
+static void cpFileRead(CpFile *file, size_t offset, double *values, int n) {
+#if defined(ADOLC_HAVE_MMAP)
+  memcpy(values, file->map + offset, n * sizeof(double));
+#else
+  if (fseek(file->fp, (long)offset, SEEK_SET) != 0 ||
+      fread(values, sizeof(double), n, file->fp) != (size_t)n)
+    cpFileError(file);
+#endif
+}
+
+/* ADOLC_CP_STORE_COMPRESSED: the differences (xor) of neighbouring values  */
+/* are split into byte planes, such that the equal sign and exponent bytes  */
+/* of a smooth state are adjacent, and compressed by the LZ coder of the    */
+/* tape files. The first byte tells whether the planes are compressed.      */
+static unsigned char *cpPack(const double *values, int n, size_t *bytes) {
+  const size_t size = n * sizeof(double);
+  unsigned char *planes = (unsigned char *)malloc(size);
+  unsigned char *packed = (unsigned char *)malloc(size + 1);
+  uint64_t prev = 0, word;
+  size_t len;
+
+  if (planes == NULL || packed == NULL)
+    fail(ADOLC_MALLOC_FAILED);
+  for (int i = 0; i < n; ++i) {
+    memcpy(&word, values + i, sizeof(word));
+    for (size_t b = 0; b < sizeof(word); ++b)
+      planes[b * n + i] = (unsigned char)((word ^ prev) >> (8 * b));
+    prev = word;
+  }
+  len = encodeLZ(planes, size, packed + 1, size);
+  packed[0] = len != 0;
+  if (len == 0) {
+    memcpy(packed + 1, planes, size);
+    len = size;
+  } else {
+    unsigned char *shrunk = (unsigned char *)realloc(packed, len + 1);
+    if (shrunk != NULL)
+      packed = shrunk;
+  }
+  free(planes);
+  *bytes = len + 1;
+  return packed;
+}
+
+static void cpUnpack(const unsigned char *packed, size_t bytes,
+                     double *values, int n) {
+  const size_t size = n * sizeof(double);
+  unsigned char *planes = (unsigned char *)malloc(size);
+  uint64_t word = 0;
+
+  if (planes == NULL)
+    fail(ADOLC_MALLOC_FAILED);
+  if (packed[0] == 0)
+    memcpy(planes, packed + 1, size);
+  else if (decodeLZ(packed + 1, bytes - 1, planes, size) != 0) {
+    fprintf(DIAG_OUT, "ADOL-C error: corrupt compressed checkpoint\n");
+    adolc_exit(-1, "", __func__, __FILE__, __LINE__);
+  }
+  for (int i = 0; i < n; ++i) {
+    uint64_t diff = 0;
+    for (size_t b = 0; b < sizeof(word); ++b)
+      diff |= (uint64_t)planes[b * n + i] << (8 * b);
+    word ^= diff;
+    memcpy(values + i, &word, sizeof(word));
+  }
+  free(planes);
+}
+
+/* frees a checkpoint taken from the stack */
+static void cp_free(StackElement se) {
+  switch (se->storage) {
+  case ADOLC_CP_STORE_COMPRESSED:
+    free(se->packed);
+    break;
+  case ADOLC_CP_STORE_FILE:
+    se->file->top = se->offset;
+    cpFileDrop(se->file);
+    break;
+  default:
+    delete[] se->values;
+  }
+  if (se->nonAdoubles != NULL)
+    delete[] static_cast<double *>(se->nonAdoubles);
+  delete se;
+}
 
 void cp_clearStack() {
-  StackElement se;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   while (!ADOLC_CHECKPOINTS_STACK.empty()) {
-    se = ADOLC_CHECKPOINTS_STACK.top();
+    StackElement se = ADOLC_CHECKPOINTS_STACK.top();
     ADOLC_CHECKPOINTS_STACK.pop();
-    delete[] se[0];
-    delete[] se;
+    cp_free(se);
+  }
+}
+
+/* cpTakeshot, cpRestore and cpRelease work on the given stack such that the
+ * helper thread of the parallel reverse sweep may use them */
+static void cpTakeshot(CpInfos *cpInfos, stack<StackElement> &cpStack,
+                       int check) {
+  StackElement se = new CpSnapshot();
+  const int n = cpInfos->n;
+  const int slowCheckpoints =
+      cpInfos->checkpoints - MAX_ADOLC(cpInfos->ramCheckpoints, 0);
+
+  cpStack.push(se);
+  se->n = n;
+  se->storage = ADOLC_CP_STORE_RAM;
+  if (check < slowCheckpoints)
+    se->storage = cpInfos->storage;
+  switch (se->storage) {
+  case ADOLC_CP_STORE_COMPRESSED:
+    se->packed = cpPack(cpInfos->dp_internal_for, n, &se->packedBytes);
+    break;
+  case ADOLC_CP_STORE_FILE:
+    se->file = cpFileOpen(cpInfos);
+    se->offset = cpFilePush(se->file, cpInfos->dp_internal_for, n);
+    break;
+  default:
+    se->storage = ADOLC_CP_STORE_RAM;
+    se->values = new double[n];
+    for (int i = 0; i < n; ++i)
+      se->values[i] = cpInfos->dp_internal_for[i];
+  }
+  if (cpInfos->saveNonAdoubles != NULL)
+    se->nonAdoubles = cpInfos->saveNonAdoubles();
+  else
+    se->nonAdoubles = NULL;
+}
+
+static void cpRestore(CpInfos *cpInfos, stack<StackElement> &cpStack) {
+  StackElement se = cpStack.top();
+  switch (se->storage) {
+  case ADOLC_CP_STORE_COMPRESSED:
+    cpUnpack(se->packed, se->packedBytes, cpInfos->dp_internal_for, se->n);
+    break;
+  case ADOLC_CP_STORE_FILE:
+    cpFileRead(se->file, se->offset, cpInfos->dp_internal_for, se->n);
+    break;
+  default:
+    for (int i = 0; i < se->n; ++i)
+      cpInfos->dp_internal_for[i] = se->values[i];
+  }
+  if (se->nonAdoubles != NULL)
+    cpInfos->restoreNonAdoubles(se->nonAdoubles);
+}
+
+static void cpRelease(stack<StackElement> &cpStack) {
+  if (!cpStack.empty()) {
+    StackElement se = cpStack.top();
+    cpStack.pop();
+    cp_free(se);
   }
 }
 
@@ -538,54 +724,263 @@ void cp_takeshot(CpInfos *cpInfos) {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
-  StackElement se = new double *[2];
-  ADOLC_CHECKPOINTS_STACK.push(se);
-  se[0] = new double[cpInfos->n];
-  for (int i = 0; i < cpInfos->n; ++i)
-    se[0][i] = cpInfos->dp_internal_for[i];
-  if (cpInfos->saveNonAdoubles != NULL)
-    se[1] = static_cast<double *>(cpInfos->saveNonAdoubles());
-  else
-    se[1] = NULL;
+  cpTakeshot(cpInfos, ADOLC_CHECKPOINTS_STACK, cpInfos->check);
 }
 
 void cp_restore(CpInfos *cpInfos) {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
-  StackElement se = ADOLC_CHECKPOINTS_STACK.top();
-  for (int i = 0; i < cpInfos->n; ++i)
-    cpInfos->dp_internal_for[i] = se[0][i];
-  if (se[1] != NULL)
-    cpInfos->restoreNonAdoubles(static_cast<void *>(se[1]));
+  cpRestore(cpInfos, ADOLC_CHECKPOINTS_STACK);
 }
 
 void cp_release(CpInfos *cpInfos) {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
-  if (!ADOLC_CHECKPOINTS_STACK.empty()) {
-    StackElement se = ADOLC_CHECKPOINTS_STACK.top();
-    ADOLC_CHECKPOINTS_STACK.pop();
-    delete[] se[0];
-    if (se[1] != NULL)
-      delete[] se[1];
-    delete[] se;
+  cpRelease(ADOLC_CHECKPOINTS_STACK);
+}
+
+/****************************************************************************/
+/*                                      reverse sweep of the time stepping */
+/****************************************************************************/
+/* The revolve actions of the reverse sweep are planned in advance and then */
+/* executed. With CpInfos::parallel != 0, a helper thread performs the      */
+/* passive actions, i.e. the recomputation of the states from the           */
+/* checkpoints, and hands the states of the reverse steps over to the       */
+/* calling thread in a queue of CP_QUEUE_DEPTH states. Meanwhile, the       */
+/* calling thread tapes and reverses the steps. The helper thread touches   */
+/* neither the tapes nor the per thread data of ADOL-C, revolve itself      */
+/* included, the stack of the checkpoints is passed to it. The time step    */
+/* functions must not share data, thus the schedule is sequential if the    */
+/* non-adoubles are saved with the checkpoints.                             */
+
+#define CP_QUEUE_DEPTH 4
+
+struct CpAction {
+  enum revolve_action action; /* takeshot, advance, restore or youturn */
+  int check;                  /* revolve number of the checkpoint taken */
+  int steps;                  /* time steps to advance */
+  int release;                /* release the topmost checkpoint first */
+};
+
+struct CpQueue {
+  mutex lock;
+  condition_variable changed;
+  double *states; /* CP_QUEUE_DEPTH states of n doubles */
+  int head;       /* oldest state */
+  int count;
+  bool done;      /* all states handed over */
+  bool stop;      /* the calling thread failed */
+  exception_ptr error;
+};
+
+/* calls revolve until the reverse sweep terminates */
+static vector<CpAction> cpPlan(CpInfos *cpInfos) {
+  vector<CpAction> plan;
+  enum revolve_action whattodo;
+
+  do {
+    CpAction a = {revolve_terminate, 0, 0, 0};
+    whattodo = revolve(&cpInfos->check, &cpInfos->capo, &cpInfos->fine,
+                       cpInfos->checkpoints, &cpInfos->info);
+    switch (whattodo) {
+    case revolve_terminate:
+      break;
+    case revolve_takeshot:
+      a.action = whattodo;
+      a.check = cpInfos->check;
+      plan.push_back(a);
+      cpInfos->currentCP = cpInfos->capo;
+      break;
+    case revolve_advance:
+      a.action = whattodo;
+      a.steps = cpInfos->capo - cpInfos->currentCP;
+      plan.push_back(a);
+      break;
+    case revolve_youturn:
+      a.action = whattodo;
+      plan.push_back(a);
+      break;
+    case revolve_restore:
+      a.action = whattodo;
+      a.release = cpInfos->capo != cpInfos->currentCP;
+      plan.push_back(a);
+      cpInfos->currentCP = cpInfos->capo;
+      break;
+    case revolve_error:
+      revolveError(cpInfos);
+      break;
+    default:
+      fail(ADOLC_CHECKPOINTING_UNEXPECTED_REVOLVE_ACTION);
+      break;
+    }
+  } while (whattodo != revolve_terminate && whattodo != revolve_error);
+  return plan;
+}
+
+/* one reverse step of the time stepping from the state x */
+static void cpReverseStep(CpInfos *cpInfos, double *x, int numDirs) {
+  if (cpInfos->retaping != 0)
+    cp_taping(cpInfos, x); // retaping forced
+  else {
+    // one forward step with keep and retaping if necessary
+    if (zos_forward(cpInfos->tapeNumber, cpInfos->n, cpInfos->n, 1, x, x) < 0)
+      cp_taping(cpInfos, x);
+  }
+  // one reverse step
+  if (cpInfos->modeReverse == ADOLC_FOS_REVERSE)
+    fos_reverse(cpInfos->tapeNumber, cpInfos->n, cpInfos->n,
+                cpInfos->dp_internal_rev, cpInfos->dp_internal_rev);
+  else
+    fov_reverse(cpInfos->tapeNumber, cpInfos->n, cpInfos->n, numDirs,
+                cpInfos->dpp_internal_rev, cpInfos->dpp_internal_rev);
+}
+
+/* executes the plan on dp_internal_for, the states of the reverse steps
+ * are reversed directly if queue == NULL */
+static void cpExecute(CpInfos *cpInfos, stack<StackElement> &cpStack,
+                      const vector<CpAction> &plan, CpQueue *queue,
+                      int numDirs) {
+  const int n = cpInfos->n;
+
+  for (size_t k = 0; k < plan.size(); ++k) {
+    const CpAction &a = plan[k];
+    switch (a.action) {
+    case revolve_takeshot:
+      cpTakeshot(cpInfos, cpStack, a.check);
+      break;
+    case revolve_advance:
+      for (int i = 0; i < a.steps; ++i)
+        cpInfos->function_double(n, cpInfos->dp_internal_for);
+      break;
+    case revolve_restore:
+      if (a.release)
+        cpRelease(cpStack);
+      cpRestore(cpInfos, cpStack);
+      break;
+    default:
+      if (queue == NULL) {
+        cpReverseStep(cpInfos, cpInfos->dp_internal_for, numDirs);
+        break;
+      }
+      unique_lock<mutex> guard(queue->lock);
+      queue->changed.wait(guard, [queue] {
+        return queue->count < CP_QUEUE_DEPTH || queue->stop;
+      });
+      if (queue->stop)
+        return;
+      const int slot = (queue->head + queue->count) % CP_QUEUE_DEPTH;
+      memcpy(queue->states + slot * n, cpInfos->dp_internal_for,
+             n * sizeof(double));
+      ++queue->count;
+      queue->changed.notify_all();
+    }
   }
+  cpRelease(cpStack); // release first checkpoint if written
+}
+
+/* body of the helper thread */
+static void cpRecompute(CpInfos *cpInfos, stack<StackElement> *cpStack,
+                        const vector<CpAction> *plan, CpQueue *queue) {
+  try {
+    cpExecute(cpInfos, *cpStack, *plan, queue, 0);
+  } catch (...) {
+    queue->error = current_exception();
+  }
+  lock_guard<mutex> guard(queue->lock);
+  queue->done = true;
+  queue->changed.notify_all();
+}
+
+/* reverses the steps in the order the helper thread hands them over */
+static void cpReverseQueue(CpInfos *cpInfos, CpQueue *queue, int numDirs) {
+  const int n = cpInfos->n;
+
+  for (;;) {
+    unique_lock<mutex> guard(queue->lock);
+    queue->changed.wait(guard,
+                        [queue] { return queue->count > 0 || queue->done; });
+    if (queue->count == 0)
+      return;
+    double *x = queue->states + queue->head * n;
+    guard.unlock();
+
+    cpReverseStep(cpInfos, x, numDirs);
+
+    guard.lock();
+    queue->head = (queue->head + 1) % CP_QUEUE_DEPTH;
+    --queue->count;
+    queue->changed.notify_all();
+  }
+}
+
+static void cpParallelReverse(CpInfos *cpInfos, stack<StackElement> &cpStack,
+                              const vector<CpAction> &plan, int numDirs) {
+  CpQueue queue;
+  CpFile *file = NULL;
+  exception_ptr error;
+  thread helper;
+
+  queue.states = new double[CP_QUEUE_DEPTH * cpInfos->n];
+  queue.head = queue.count = 0;
+  queue.done = queue.stop = false;
+  /* the helper thread must not name a new file */
+  if (cpInfos->storage == ADOLC_CP_STORE_FILE) {
+    file = cpFileOpen(cpInfos);
+    ++file->count;
+  }
+  try {
+    helper = thread(cpRecompute, cpInfos, &cpStack, &plan, &queue);
+  } catch (const system_error &) {
+    /* no thread available => sequential schedule */
+    delete[] queue.states;
+    cpExecute(cpInfos, cpStack, plan, NULL, numDirs);
+    if (file != NULL)
+      cpFileDrop(file);
+    return;
+  }
+  try {
+    cpReverseQueue(cpInfos, &queue, numDirs);
+  } catch (...) {
+    error = current_exception();
+    lock_guard<mutex> guard(queue.lock);
+    queue.stop = true;
+    queue.changed.notify_all();
+  }
+  helper.join();
+  delete[] queue.states;
+  if (file != NULL)
+    cpFileDrop(file);
+  if (!error)
+    error = queue.error;
+  if (error)
+    rethrow_exception(error);
+}
+
+void revolve_rev(CpInfos *cpInfos, int numDirs) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+  const vector<CpAction> plan = cpPlan(cpInfos);
+
+  if (cpInfos->parallel != 0 && cpInfos->saveNonAdoubles == NULL)
+    cpParallelReverse(cpInfos, ADOLC_CHECKPOINTS_STACK, plan, numDirs);
+  else
+    cpExecute(cpInfos, ADOLC_CHECKPOINTS_STACK, plan, NULL, numDirs);
 }
 
-void cp_taping(CpInfos *cpInfos) {
+void cp_taping(CpInfos *cpInfos, double *x) {
   adouble *tapingAdoubles = new adouble[cpInfos->n];
 
   trace_on(cpInfos->tapeNumber, 1);
 
   for (int i = 0; i < cpInfos->n; ++i)
-    tapingAdoubles[i] <<= cpInfos->dp_internal_for[i];
+    tapingAdoubles[i] <<= x[i];
 
   cpInfos->function(cpInfos->n, tapingAdoubles);
 
   for (int i = 0; i < cpInfos->n; ++i)
-    tapingAdoubles[i] >>= cpInfos->dp_internal_for[i];
+    tapingAdoubles[i] >>= x[i];
 
   trace_off();
 
@@ -42,8 +42,18 @@ END_C_DECLS
 #define ADOLC_BUFFER_TYPE Buffer<CpInfos, CP_BLOCK_SIZE>
 extern ADOLC_BUFFER_TYPE ADOLC_EXT_DIFF_FCTS_BUFFER_DECL;
 
-/* field of pointers to the value fields of a checkpoint */
-typedef double **StackElement;
+/* one checkpoint, its values are held as given by storage */
+typedef struct CpSnapshot {
+  int n;
+  int storage;            /* see enum CheckpointStorage */
+  double *values;         /* ADOLC_CP_STORE_RAM */
+  unsigned char *packed;  /* ADOLC_CP_STORE_COMPRESSED, packedBytes bytes */
+  size_t packedBytes;
+  struct CpFile *file;    /* ADOLC_CP_STORE_FILE, n doubles at offset */
+  size_t offset;
+  void *nonAdoubles;      /* result of saveNonAdoubles */
+} CpSnapshot;
+typedef CpSnapshot *StackElement;
 extern stack<StackElement> ADOLC_CHECKPOINTS_STACK_DECL;
 
 /* a cleanup function */
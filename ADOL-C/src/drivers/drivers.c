@@ -13,6 +13,9 @@
  recipient's acceptance of the terms of the accompanying license file.
 
 ----------------------------------------------------------------------------*/
+#include "dvlparms.h"
+#include "oplate.h"
+#include "taping_p.h"
 #include <adolc/adalloc.h>
 #include <adolc/drivers/drivers.h>
 #include <adolc/interfaces.h>
@@ -21,6 +24,68 @@
 
 BEGIN_C_DECLS
 
+/****************************************************************************/
+/*                                                        DRIVER WORKSPACES */
+/* The arrays of a driver are carved from one block kept by the tape, see   */
+/* borrowDriverWorkspace, and laid out as by myalloc2 and myalloc3.         */
+
+static size_t dppBytes(int m, int n) {
+  return m * sizeof(double *) + (size_t)m * n * sizeof(double);
+}
+
+static size_t dpppBytes(int m, int n, int p) {
+  return m * sizeof(double **) + (size_t)m * n * sizeof(double *) +
+         (size_t)m * n * p * sizeof(double);
+}
+
+/* the n x n identity of myallocI2, rows overlapping in 2n-1 doubles */
+static size_t identityBytes(int n) {
+  return n * sizeof(double *) + (2 * (size_t)n - 1) * sizeof(double);
+}
+
+static char *populateIdentity(double ***I, char *memory, int n) {
+  double *diag;
+  int i;
+
+  *I = (double **)memory;
+  diag = (double *)(*I + n) + n - 1;
+  *diag = 1.0;
+  for (i = 0; i < n; i++)
+    (*I)[i] = diag - i;
+  return (char *)(diag + n);
+}
+
+/* the Taylor and adjoint arrays of lagraHessVec */
+static size_t lagraHessVecBytes(int m, int n) {
+  return dppBytes(n, 2) + 2 * (size_t)m * sizeof(double);
+}
+
+/* lagra_hess_vec with the arrays in work of lagraHessVecBytes(m, n) */
+static int lagraHessVec(short tag, int m, int n, const double *argument,
+                        const double *tangent, const double *lagrange,
+                        double *result, char *work) {
+  int rc = -1;
+  int i;
+  int degree = 1;
+  int keep = degree + 1;
+  double **X, *y, *y_tangent;
+
+  y = (double *)populate_dpp(&X, work, n, 2);
+  y_tangent = y + m;
+
+  rc = fos_forward(tag, m, n, keep, argument, tangent, y, y_tangent);
+
+  if (rc < 0)
+    return rc;
+
+  MINDEC(rc, hos_reverse(tag, m, n, degree, lagrange, X));
+
+  for (i = 0; i < n; ++i)
+    result[i] = X[i][1];
+
+  return rc;
+}
+
 /****************************************************************************/
 /*                         DRIVERS FOR OPTIMIZATION AND NONLINEAR EQUATIONS */
 
@@ -58,14 +123,13 @@ int vec_jac(short tag, int m, int n, int repeat, const double *argument,
   double *y = NULL;
 
   if (!repeat) {
-    y = myalloc1(m);
+    y = (double *)borrowDriverWorkspace(tag, m * sizeof(double));
     rc = zos_forward(tag, m, n, 1, argument, y);
+    returnDriverWorkspace(tag, y);
     if (rc < 0)
       return rc;
   }
   MINDEC(rc, fos_reverse(tag, m, n, lagrange, row));
-  if (!repeat)
-    myfree1(y);
   return rc;
 }
 
@@ -76,24 +140,25 @@ int vec_jac(short tag, int m, int n, int repeat, const double *argument,
 int jacobian(short tag, int depen, int indep, const double *argument,
              double **jacobian) {
   int rc;
+  const int forward = indep / 2 < depen;
+  const int dirs = forward ? indep : depen;
   double *result, **I;
+  char *block = (char *)borrowDriverWorkspace(
+      tag, depen * sizeof(double) + identityBytes(dirs));
 
-  result = myalloc1(depen);
+  result = (double *)block;
+  populateIdentity(&I, (char *)(result + depen), dirs);
 
-  if (indep / 2 < depen) {
-    I = myallocI2(indep);
-    rc = fov_forward(tag, depen, indep, indep, argument, I, result, jacobian);
-    myfreeI2(indep, I);
-  } else {
-    I = myallocI2(depen);
+  if (forward)
+    rc = fov_forward_mt(tag, depen, indep, indep, argument, I, result,
+                        jacobian, 0, 0);
+  else {
     rc = zos_forward(tag, depen, indep, 1, argument, result);
-    if (rc < 0)
-      return rc;
-    MINDEC(rc, fov_reverse(tag, depen, indep, depen, I, jacobian));
-    myfreeI2(depen, I);
+    if (rc >= 0)
+      MINDEC(rc, fov_reverse_mt(tag, depen, indep, depen, I, jacobian, 0));
   }
 
-  myfree1(result);
+  returnDriverWorkspace(tag, block);
 
   return rc;
 }
@@ -104,10 +169,11 @@ int jacobian(short tag, int depen, int indep, const double *argument,
 
 int large_jacobian(short tag, int depen, int indep, int runns, double *argument,
                    double *result, double **jacobian) {
-  int rc, dirs, i;
+  int rc, dirs;
   double **I;
+  char *block = (char *)borrowDriverWorkspace(tag, identityBytes(indep));
 
-  I = myallocI2(indep);
+  populateIdentity(&I, block, indep);
   if (runns > indep)
     runns = indep;
   if (runns < 1)
@@ -115,14 +181,9 @@ int large_jacobian(short tag, int depen, int indep, int runns, double *argument,
   dirs = indep / runns;
   if (indep % runns)
     ++dirs;
-  for (i = 0; i < runns - 1; ++i) {
-    rc = fov_offset_forward(tag, depen, indep, dirs, i * dirs, argument, I,
-                            result, jacobian);
-  }
-  dirs = indep - (runns - 1) * dirs;
-  rc = fov_offset_forward(tag, depen, indep, dirs, indep - dirs, argument, I,
-                          result, jacobian);
-  myfreeI2(indep, I);
+  rc = fov_forward_mt(tag, depen, indep, indep, argument, I, result, jacobian,
+                      0, dirs);
+  returnDriverWorkspace(tag, block);
   return rc;
 }
 
@@ -134,10 +195,10 @@ int jac_vec(short tag, int m, int n, const double *argument,
   int rc = -1;
   double *y;
 
-  y = myalloc1(m);
+  y = (double *)borrowDriverWorkspace(tag, m * sizeof(double));
 
   rc = fos_forward(tag, m, n, 0, argument, tangent, y, column);
-  myfree1(y);
+  returnDriverWorkspace(tag, y);
 
   return rc;
 }
@@ -163,11 +224,15 @@ int hess_mat(short tag, int n, int q, const double *argument,
   double ***Yppp;
   double ***Zppp;
   double **Upp;
+  char *block = (char *)borrowDriverWorkspace(
+      tag, dpppBytes(n, q, 1) + dpppBytes(1, q, 1) + dpppBytes(q, n, 2) +
+               dppBytes(1, 2));
+  char *next;
 
-  Xppp = myalloc3(n, q, 1); /* matrix on right-hand side  */
-  Yppp = myalloc3(1, q, 1); /* results of hos_wk_forward  */
-  Zppp = myalloc3(q, n, 2); /* result of Up x H x XPPP */
-  Upp = myalloc2(1, 2);     /* vector on left-hand side */
+  next = populate_dppp(&Xppp, block, n, q, 1); /* matrix on right-hand side */
+  next = populate_dppp(&Yppp, next, 1, q, 1);  /* results of hos_wk_forward */
+  next = populate_dppp(&Zppp, next, q, n, 2);  /* result of Up x H x XPPP */
+  populate_dpp(&Upp, next, 1, 2);              /* vector on left-hand side */
 
   for (i = 0; i < n; ++i)
     for (j = 0; j < q; ++j)
@@ -183,44 +248,129 @@ int hess_mat(short tag, int n, int q, const double *argument,
     for (j = 0; j < n; ++j)
       result[j][i] = Zppp[i][j][1];
 
-  myfree2(Upp);
-  myfree3(Zppp);
-  myfree3(Yppp);
-  myfree3(Xppp);
+  returnDriverWorkspace(tag, block);
 
   return rc;
 }
 
 /*--------------------------------------------------------------------------*/
-/*                                                                  hessian */
-/* hessian(tag, n, x[n], lower triangle of H[n][n])                         */
-/* uses Hessian-vector product                                              */
-int hessian(short tag, int n, const double *argument, double **hess) {
+/*                                                           Hessian engine */
+/* Computes the lower triangle of the Hessian into the rows hess[i][0..i].  */
+/* With block > 1, the columns are computed in blocks of that many unit     */
+/* directions by one hov_wk_forward/hos_ov_reverse pair each, such that the */
+/* tape is read twice per block instead of twice per column. block <= 0     */
+/* chooses the block size such that the Taylor coefficients and adjoints of */
+/* all live variables take about DIRCHUNKSIZE bytes. Block size 1 and tapes */
+/* that hos_ov_reverse cannot handle use one hess_vec per column.           */
+static int hessianEngine(short tag, int n, const double *argument,
+                         double **hess, int block) {
+  static const unsigned char vectorFree[] = {min_op, ext_diff, ext_diff_iArr,
+                                             ext_diff_v2};
   int rc = 3;
-  int i, j;
-  double *v = myalloc1(n);
-  double *w = myalloc1(n);
-  for (i = 0; i < n; i++)
-    v[i] = 0;
-  for (i = 0; i < n; i++) {
-    v[i] = 1;
-    MINDEC(rc, hess_vec(tag, n, argument, v, w));
-    if (rc < 0) {
-      free((char *)v);
-      free((char *)w);
-      return rc;
+  int i, j, col;
+
+  if (block <= 0) {
+    size_t stats[STAT_SIZE];
+    size_t lives;
+    ADOLC_OPENMP_THREAD_NUMBER;
+    ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+    tapestats(tag, stats);
+    /* Taylors of degree 1 and adjoints of degree 2 per direction */
+    lives = stats[NUM_MAX_LIVES] > 0 ? stats[NUM_MAX_LIVES] : 1;
+    block = (int)MIN_ADOLC((size_t)n, ADOLC_GLOBAL_TAPE_VARS.dirChunkSize /
+                                          (5 * lives * sizeof(double)));
+  }
+  if (block > n)
+    block = n;
+  if (block > 1 && tapeContainsOps(tag, vectorFree, sizeof(vectorFree)))
+    block = 1;
+
+  if (block <= 1) {
+    const double one = 1.0;
+    double *v = (double *)borrowDriverWorkspace(
+        tag, 2 * n * sizeof(double) + lagraHessVecBytes(1, n));
+    double *w = v + n;
+    for (i = 0; i < n; i++) {
+      v[i] = 1;
+      MINDEC(rc,
+             lagraHessVec(tag, 1, n, argument, v, &one, w, (char *)(w + n)));
+      if (rc < 0)
+        break;
+      for (j = 0; j <= i; j++)
+        hess[i][j] = w[j];
+      v[i] = 0;
     }
-    for (j = 0; j <= i; j++)
-      hess[i][j] = w[j];
-    v[i] = 0;
+    returnDriverWorkspace(tag, v);
+    return rc;
+  }
+
+  double ***Xppp, ***Yppp, ***Zppp, **Upp;
+  char *work = (char *)borrowDriverWorkspace(
+      tag, dpppBytes(n, block, 1) + dpppBytes(1, block, 1) +
+               dpppBytes(block, n, 2) + dppBytes(1, 2));
+  char *next;
+  double y;
+
+  /* unit directions of the block, results of hov_wk_forward, columns of */
+  /* the Hessian and vector on left-hand side */
+  next = populate_dppp(&Xppp, work, n, block, 1);
+  next = populate_dppp(&Yppp, next, 1, block, 1);
+  next = populate_dppp(&Zppp, next, block, n, 2);
+  populate_dpp(&Upp, next, 1, 2);
+
+  Upp[0][0] = 1;
+  Upp[0][1] = 0;
+
+  for (col = 0; col < n && rc >= 0; col += block) {
+    const int q = MIN_ADOLC(block, n - col);
+
+    for (i = 0; i < n; i++)
+      for (j = 0; j < q; j++)
+        Xppp[i][j][0] = (i == col + j) ? 1.0 : 0.0;
+
+    MINDEC(rc, hov_wk_forward(tag, 1, n, 1, 2, q, argument, Xppp, &y, Yppp));
+    if (rc < 0)
+      break;
+    MINDEC(rc, hos_ov_reverse(tag, 1, n, 1, q, Upp, Zppp));
+
+    /* column col + j of the lower triangle */
+    for (j = 0; j < q; j++)
+      for (i = col + j; i < n; i++)
+        hess[i][col + j] = Zppp[j][i][1];
   }
 
-  free((char *)v);
-  free((char *)w);
+  returnDriverWorkspace(tag, work);
   return rc;
+}
+
+/*--------------------------------------------------------------------------*/
+/*                                                                  hessian */
+/* hessian(tag, n, x[n], lower triangle of H[n][n])                         */
+/* uses blocks of Hessian-matrix products or Hessian-vector products        */
+int hessian(short tag, int n, const double *argument, double **hess) {
+  return hessianEngine(tag, n, argument, hess, 0);
   /* Note that only the lower triangle of hess is filled */
 }
 
+/*--------------------------------------------------------------------------*/
+/*                                                           hessian_packed */
+/* hessian_packed(tag, n, x[n], H[n*(n+1)/2], block)                        */
+/* lower triangle stored row by row, H_ij = H[i*(i+1)/2+j] for j <= i       */
+int hessian_packed(short tag, int n, const double *argument, double *hess,
+                   int block) {
+  int rc, i;
+  double **rows = (double **)malloc(n * sizeof(double *));
+
+  if (rows == NULL)
+    fail(ADOLC_MALLOC_FAILED);
+  for (i = 0; i < n; i++)
+    rows[i] = hess + (size_t)i * (i + 1) / 2;
+  rc = hessianEngine(tag, n, argument, rows, block);
+  free(rows);
+  return rc;
+}
+
 /*--------------------------------------------------------------------------*/
 /*                                                                 hessian2 */
 /* hessian2(tag, n, x[n], lower triangle of H[n][n])                        */
@@ -229,11 +379,16 @@ int hessian2(short tag, int n, double *argument, double **hess) {
   int rc;
   int i, j;
 
-  double ***Xppp = myalloc3(n, n, 1); /* matrix on right-hand side  */
-  double *y = myalloc1(1);            /* results of function evaluation */
-  double ***Yppp = myalloc3(1, n, 1); /* results of hov_wk_forward  */
-  double ***Zppp = myalloc3(n, n, 2); /* result of Up x H x XPPP */
-  double **Upp = myalloc2(1, 2);      /* vector on left-hand side */
+  double ***Xppp, ***Yppp, ***Zppp, **Upp, *y;
+  char *block = (char *)borrowDriverWorkspace(
+      tag, dpppBytes(n, n, 1) + dpppBytes(1, n, 1) + dpppBytes(n, n, 2) +
+               dppBytes(1, 2) + sizeof(double));
+  char *next;
+
+  next = populate_dppp(&Xppp, block, n, n, 1); /* matrix on right-hand side */
+  next = populate_dppp(&Yppp, next, 1, n, 1);  /* results of hov_wk_forward */
+  next = populate_dppp(&Zppp, next, n, n, 2);  /* result of Up x H x XPPP */
+  y = (double *)populate_dpp(&Upp, next, 1, 2); /* vector on left-hand side */
 
   for (i = 0; i < n; i++) {
     for (j = 0; j < n; j++)
@@ -251,11 +406,7 @@ int hessian2(short tag, int n, double *argument, double **hess) {
     for (j = 0; j <= i; j++)
       hess[i][j] = Zppp[i][j][1];
 
-  myfree2(Upp);
-  myfree3(Zppp);
-  myfree3(Yppp);
-  myfree1(y);
-  myfree3(Xppp);
+  returnDriverWorkspace(tag, block);
   return rc;
   /* Note that only the lower triangle of hess is filled */
 }
@@ -266,29 +417,11 @@ int hessian2(short tag, int n, double *argument, double **hess) {
 int lagra_hess_vec(short tag, int m, int n, const double *argument,
                    const double *tangent, const double *lagrange,
                    double *result) {
-  int rc = -1;
-  int i;
-  int degree = 1;
-  int keep = degree + 1;
-  double **X, *y, *y_tangent;
-
-  X = myalloc2(n, 2);
-  y = myalloc1(m);
-  y_tangent = myalloc1(m);
-
-  rc = fos_forward(tag, m, n, keep, argument, tangent, y, y_tangent);
-
-  if (rc < 0)
-    return rc;
-
-  MINDEC(rc, hos_reverse(tag, m, n, degree, lagrange, X));
-
-  for (i = 0; i < n; ++i)
-    result[i] = X[i][1];
+  int rc;
+  char *work = (char *)borrowDriverWorkspace(tag, lagraHessVecBytes(m, n));
 
-  myfree1(y_tangent);
-  myfree1(y);
-  myfree2(X);
+  rc = lagraHessVec(tag, m, n, argument, tangent, lagrange, result, work);
+  returnDriverWorkspace(tag, work);
 
   return rc;
 }
@@ -737,19 +737,96 @@ int inverse_tensor_eval(short tag, int n, int d, int p, double *x,
 }
 
 /****************************************************************************/
-int tensor_eval(short tag, int m, int n, int d, int p, double *x,
-                double **tensor, double **S) {
-  static int bd, dim;
-  static int dold, pold;
-  static struct item *coeff_list;
-  int i, j, k, dimten, ctr;
-  int **jm, jmbd = 0;
-  int *it = (int *)malloc(d * sizeof(int));
-  double *y = (double *)malloc(m * sizeof(double));
-  double ***X;
-  double ***Y;
-  struct item *ptr[10];
+/*                                                            TENSOR ENGINE */
+
+static size_t dpppBytes(int m, int n, int p) {
+  return m * sizeof(double **) + (size_t)m * n * sizeof(double *) +
+         (size_t)m * n * p * sizeof(double);
+}
+
+/* The coefficient list of degree d and p directions, kept as driver cache
+ * of the tape (see borrowDriverCache). The items of the i-th multiindex jm
+ * with |jm| = d are items[start[i]], ..., items[start[i+1]-1]. */
+typedef struct TensorCoeffs {
+  int d, p, dim;
+  struct item *items;
+  int *start;
+} TensorCoeffs;
+
+/* takes the coefficient list of tape tag, it is computed only if the tape
+ * does not keep one for d and p */
+static TensorCoeffs *borrowTensorCoeffs(short tag, int d, int p) {
+  TensorCoeffs *coeffs = (TensorCoeffs *)borrowDriverCache(tag);
+  struct item *list, *ptr;
+  int i, size, dim;
+
+  if (coeffs != NULL && coeffs->d == d && coeffs->p == p)
+    return coeffs;
+  free(coeffs);
+
+  dim = binomi(p + d - 1, d);
+  list = (struct item *)malloc(sizeof(struct item) * dim);
+  coeff(p, d, list);
+  size = 0;
+  for (i = 0; i < dim; i++)
+    for (ptr = &list[i]; ptr != NULL; ptr = ptr->next)
+      size++;
+
+  /* one block, the items stored contiguously in the order of the lists */
+  coeffs = (TensorCoeffs *)malloc(sizeof(TensorCoeffs) +
+                                  size * sizeof(struct item) +
+                                  (dim + 1) * sizeof(int));
+  coeffs->d = d;
+  coeffs->p = p;
+  coeffs->dim = dim;
+  coeffs->items = (struct item *)(coeffs + 1);
+  coeffs->start = (int *)(coeffs->items + size);
+  size = 0;
+  for (i = 0; i < dim; i++) {
+    coeffs->start[i] = size;
+    for (ptr = &list[i]; ptr != NULL; ptr = ptr->next) {
+      coeffs->items[size] = *ptr;
+      coeffs->items[size++].next = NULL;
+    }
+  }
+  coeffs->start[dim] = size;
+  freecoefflist(dim, list);
+  free((char *)list);
+  return coeffs;
+}
+
+/* the next multiindex it of the enumeration of tensor_eval */
+static void nextMultiindex(int p, int d, int *it) {
+  int j;
+
+  it[d - 1] = it[d - 1] + 1;
+  for (j = d - 2; j >= 0; j--)
+    it[j] = it[j] + it[j + 1] / (p + 1);
+  for (j = 1; j < d; j++)
+    if (it[j] > p)
+      it[j] = it[j - 1];
+}
+
+/*--------------------------------------------------------------------------*/
+/* tensor_eval_mt(tag, m, n, d, p, x[n], tensor[m][dim], S[n][p], nthreads)
+ * The univariate Taylor series of the dim multiindices are propagated in
+ * blocks, such that the d Taylor coefficients of all live variables take
+ * about DIRCHUNKSIZE bytes per block. The blocks are distributed among
+ * nthreads OpenMP threads by hov_forward_mt, all available ones if
+ * nthreads <= 0. */
+int tensor_eval_mt(short tag, int m, int n, int d, int p, double *x,
+                   double **tensor, double **S, int nthreads) {
+  int i, j, k, l, dimten, dim, bd, batch, first, cnt;
+  size_t stats[STAT_SIZE];
+  size_t lives;
+  TensorCoeffs *coeffs;
+  const struct item *ptr;
+  double ***X, ***Y, *y;
+  int *jm, *it;
+  char *block, *next;
   int rc = 3;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   dimten = binomi(p + d, d);
   for (i = 0; i < m; i++)
@@ -757,104 +834,77 @@ int tensor_eval(short tag, int m, int n, int d, int p, double *x,
       tensor[i][j] = 0;
 
   if (d == 0) {
+    y = (double *)borrowDriverWorkspace(tag, m * sizeof(double));
     MINDEC(rc, zos_forward(tag, m, n, 0, x, y));
-  } else {
-    if ((d != dold) || (p != pold)) {
-      if (pold) {
-        dim = binomi(pold + dold - 1, dold);
-        freecoefflist(dim, coeff_list);
-        free((char *)coeff_list);
-      }
-      dim = binomi(p + d - 1, d);
-      if (dim < 10)
-        bd = dim;
-      else
-        bd = 10;
-      coeff_list = (struct item *)malloc(sizeof(struct item) * dim);
-      coeff(p, d, coeff_list);
-      dold = d;
-      pold = p;
+    for (i = 0; i < m; i++)
+      tensor[i][0] = y[i];
+    returnDriverWorkspace(tag, y);
+    return rc;
+  }
+
+  coeffs = borrowTensorCoeffs(tag, d, p);
+  dim = coeffs->dim;
+
+  /* Taylors of degree d per direction */
+  tapestats(tag, stats);
+  lives = stats[NUM_MAX_LIVES] > 0 ? stats[NUM_MAX_LIVES] : 1;
+  bd = (int)MIN_ADOLC((size_t)dim, ADOLC_GLOBAL_TAPE_VARS.dirChunkSize /
+                                       (d * lives * sizeof(double)));
+  if (bd < 1)
+    bd = 1;
+  /* one block per thread and hov_forward_mt */
+  batch = MIN_ADOLC(dim, bd * sweepWorkers(nthreads, dim));
+
+  block = (char *)borrowDriverWorkspace(
+      tag, dpppBytes(n, batch, d) + dpppBytes(m, batch, d) +
+               m * sizeof(double) + ((size_t)batch * p + d) * sizeof(int));
+  next = populate_dppp(&X, block, n, batch, d);
+  next = populate_dppp(&Y, next, m, batch, d);
+  y = (double *)next;
+  jm = (int *)(y + m);
+  it = jm + (size_t)batch * p;
+
+  for (i = 0; i < d - 1; i++)
+    it[i] = 1;
+  it[d - 1] = 0;
+  for (first = 0; first < dim; first += batch) {
+    cnt = MIN_ADOLC(batch, dim - first);
+    for (k = 0; k < cnt; k++) { /* multiindices jm of the batch */
+      nextMultiindex(p, d, it);
+      convert(p, d, it, jm + k * p);
     }
-    jmbd = bd;
-    jm = (int **)malloc(jmbd * sizeof(int *));
-    for (i = 0; i < jmbd; i++)
-      jm[i] = (int *)malloc(p * sizeof(int));
-    if (d == 1) {
-      X = myalloc3(1, n, bd);
-      Y = myalloc3(1, m, bd);
-      ctr = 0;
-      it[0] = 0;
-      for (i = 0; i < dim; i++) /* sum over all multiindices jm with |jm| = d */
-      {
-        it[0] = it[0] + 1;
-        convert(p, d, it, jm[ctr]);
-        ptr[ctr] = &coeff_list[i];
-        if (ctr < bd - 1)
-          ctr += 1;
-        else {
-          multma2vec2(n, p, bd, X[0], S, jm);
-          MINDEC(rc, fov_forward(tag, m, n, bd, x, X[0], y, Y[0]));
-          for (k = 0; k < bd; k++)
-            do {
-              for (j = 0; j < m; j++) {
-                tensor[j][ptr[k]->a] += Y[0][j][k] * ptr[k]->c;
-              }
-              ptr[k] = ptr[k]->next;
-            } while (ptr[k] != NULL);
-          if (dim - i <= bd)
-            bd = dim - i - 1;
-          ctr = 0;
-        }
-      }
-    } else {
-      X = myalloc3(n, bd, d);
-      Y = myalloc3(m, bd, d);
-      ctr = 0;
-      for (i = 0; i < d - 1; i++)
-        it[i] = 1;
-      it[d - 1] = 0;
-      for (i = 0; i < dim; i++) /* sum over all multiindices jm with |jm| = d */
-      {
-        it[d - 1] = it[d - 1] + 1;
-        for (j = d - 2; j >= 0; j--)
-          it[j] = it[j] + it[j + 1] / (p + 1);
+    for (i = 0; i < n; i++) /* Store S*jm in X */
+      for (k = 0; k < cnt; k++) {
+        double sum = 0;
+        for (j = 0; j < p; j++)
+          sum += S[i][j] * jm[k * p + j];
+        X[i][k][0] = sum;
         for (j = 1; j < d; j++)
-          if (it[j] > p)
-            it[j] = it[j - 1];
-        convert(p, d, it, jm[ctr]);
-        ptr[ctr] = &coeff_list[i];
-        if (ctr < bd - 1)
-          ctr += 1;
-        else {
-          multma3vec2(n, p, d, bd, X, S, jm);
-          MINDEC(rc, hov_forward(tag, m, n, d, bd, x, X, y, Y));
-          for (k = 0; k < bd; k++)
-            do {
-              for (j = 0; j < m; j++)
-                tensor[j][ptr[k]->a] += Y[j][k][ptr[k]->b - 1] * ptr[k]->c;
-              ptr[k] = ptr[k]->next;
-            } while (ptr[k] != NULL);
-          if (dim - i <= bd)
-            bd = dim - i - 1;
-          ctr = 0;
-        }
+          X[i][k][j] = 0;
+      }
+    MINDEC(rc, hov_forward_mt(tag, m, n, d, cnt, x, X, y, Y, nthreads, bd));
+    for (k = 0; k < cnt; k++)
+      for (l = coeffs->start[first + k]; l < coeffs->start[first + k + 1];
+           l++) {
+        ptr = &coeffs->items[l];
+        for (j = 0; j < m; j++)
+          tensor[j][ptr->a] += Y[j][k][ptr->b - 1] * ptr->c;
       }
-    }
-
-    for (i = 0; i < jmbd; i++)
-      free((char *)*(jm + i));
-    free((char *)jm);
-    myfree3(X);
-    myfree3(Y);
   }
   for (i = 0; i < m; i++)
     tensor[i][0] = y[i];
-  bd = jmbd;
-  free((char *)y);
-  free((char *)it);
+
+  returnDriverWorkspace(tag, block);
+  returnDriverCache(tag, coeffs);
   return rc;
 }
 
+/****************************************************************************/
+int tensor_eval(short tag, int m, int n, int d, int p, double *x,
+                double **tensor, double **S) {
+  return tensor_eval_mt(tag, m, n, d, p, x, tensor, S, 1);
+}
+
 /****************************************************************************/
 void tensor_value(int d, int m, double *y, double **tensor, int *multi) {
   int i, j, max, ind, add;
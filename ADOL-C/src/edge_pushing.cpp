@@ -0,0 +1,577 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     edge_pushing.cpp
+ Revision: $Id$
+ Contents: sparse Hessian of a scalar function by the edge pushing
+           algorithm, i.e. one reverse sweep without sparsity pattern
+           and coloring
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#include "dvlparms.h"
+#include "oplate.h"
+#include "taping_p.h"
+#include <adolc/adalloc.h>
+#include <adolc/drivers/drivers.h>
+#include <adolc/interfaces.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+/****************************************************************************/
+/* The tape is turned into a computational graph in single assignment form: */
+/* every value computed from the independents is a node with at most two    */
+/* arguments, the local partial derivatives d and the local second          */
+/* derivatives h[0] = d2/da0da0, h[1] = d2/da0da1, h[2] = d2/da1da1 at the  */
+/* current point. Copies (assign_a, min_op, conditional assignments) only   */
+/* rename nodes. Values that do not depend on the independents are not part */
+/* of the graph. "nonlin" flags the second derivatives that are nonzero in  */
+/* general, bit k for h[k], such that the pattern does not depend on values */
+/* that happen to vanish at the current point.                              */
+/****************************************************************************/
+struct EpNode {
+  int arg[2]; /* -1 if unused */
+  double d[2];
+  double h[3];
+  unsigned char nonlin;
+};
+
+enum { hNone = 0, hFirst = 1, hMixed = 2, hSecond = 4 };
+
+const double twoBySqrtPi = 1.12837916709551257390; /* 2 / sqrt(pi) */
+
+class EpGraph {
+public:
+  std::vector<EpNode> nodes;
+  std::vector<double> val;     /* value of every node */
+  std::vector<bool> active;    /* depends on the independents */
+  std::vector<int> indepNodes; /* node of each independent */
+  int depNode = -1;
+
+  int constant(double v) {
+    const EpNode n = {{-1, -1}, {0.0, 0.0}, {0.0, 0.0, 0.0}, hNone};
+    return append(n, v, false);
+  }
+
+  int independent(double v) {
+    const EpNode n = {{-1, -1}, {0.0, 0.0}, {0.0, 0.0, 0.0}, hNone};
+    indepNodes.push_back((int)nodes.size());
+    return append(n, v, true);
+  }
+
+  int unary(int x, double v, double d, double h, bool nonlin) {
+    if (!active[x])
+      return constant(v);
+    const EpNode n = {
+        {x, -1}, {d, 0.0}, {h, 0.0, 0.0}, nonlin ? hFirst : hNone};
+    return append(n, v, true);
+  }
+
+  int binary(int x, int y, double v, double dx, double dy, double hxx,
+             double hxy, double hyy, unsigned char nonlin) {
+    if (!active[y])
+      return unary(x, v, dx, hxx, nonlin & hFirst);
+    if (!active[x])
+      return unary(y, v, dy, hyy, nonlin & hSecond);
+    const EpNode n = {{x, y}, {dx, dy}, {hxx, hxy, hyy}, nonlin};
+    return append(n, v, true);
+  }
+
+private:
+  int append(const EpNode &n, double v, bool act) {
+    nodes.push_back(n);
+    val.push_back(v);
+    active.push_back(act);
+    return (int)nodes.size() - 1;
+  }
+};
+
+/****************************************************************************/
+/* Builds the graph of tape "tag" at the point x by a zero-order forward    */
+/* sweep. Returns false if the tape contains an operation the edge pushing  */
+/* sweep does not handle, e.g. external functions or vector operations.     */
+/****************************************************************************/
+bool buildGraph(short tag, const double *x, EpGraph &g) {
+  unsigned char op;
+  const char *layout;
+  int numVals;
+  bool essential, handled = true;
+  std::vector<int> cur; /* node currently held by every location */
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  init_for_sweep(tag);
+  cur.resize(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES], -1);
+  const int zero = g.constant(0.0);
+  std::fill(cur.begin(), cur.end(), zero);
+
+  op = get_op_f();
+  while (op != end_of_tape && handled) {
+    switch (op) {
+    case end_of_op:
+      get_op_block_f();
+      op = get_op_f();
+      /* Skip next operation, it's another end_of_op */
+      break;
+    case end_of_int:
+      get_loc_block_f();
+      break;
+    case end_of_val:
+      get_val_block_f();
+      break;
+    case start_of_tape:
+      break;
+    case death_not:
+      get_locint_f();
+      get_locint_f();
+      break;
+    case take_stock_op: {
+      locint size = get_locint_f();
+      locint res = get_locint_f();
+      double *d = get_val_v_f(size);
+      for (locint i = 0; i < size; ++i)
+        cur[res + i] = g.constant(d[i]);
+      break;
+    }
+    default: {
+      layout = opLayout(op, &numVals, &essential);
+      if (layout == NULL || op == gen_quad) {
+        handled = false;
+        break;
+      }
+      /* locations of the arguments and results, parameters excluded */
+      locint l[4] = {0, 0, 0, 0};
+      int numLocs = 0;
+      double c = 0.0;
+      for (size_t k = 0; layout[k] != 0; ++k) {
+        const locint loc = get_locint_f();
+        if (layout[k] == 'P')
+          c = ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore[loc];
+        else
+          l[numLocs++] = loc;
+      }
+      for (int k = 0; k < numVals; ++k) {
+        const double v = get_val_f();
+        if (k == 0)
+          c = v;
+      }
+
+      const locint l0 = l[0], l1 = l[1], l2 = l[2], l3 = l[3];
+      const int n0 = cur[l0];
+      const double v0 = g.val[n0];
+      const double v1 = numLocs > 1 ? g.val[cur[l1]] : 0.0;
+
+      switch (op) {
+      case eq_zero:
+      case neq_zero:
+      case le_zero:
+      case gt_zero:
+      case ge_zero:
+      case lt_zero:
+        break;
+      case assign_ind:
+        cur[l0] = g.independent(x[g.indepNodes.size()]);
+        break;
+      case assign_dep:
+        g.depNode = n0;
+        break;
+
+      case assign_a:
+      case pos_sign_a:
+        cur[l1] = n0;
+        break;
+      case neg_sign_a:
+        cur[l1] = g.unary(n0, -v0, -1.0, 0.0, false);
+        break;
+      case assign_d:
+        cur[l0] = g.constant(c);
+        break;
+      case assign_d_zero:
+        cur[l0] = g.constant(0.0);
+        break;
+      case assign_d_one:
+        cur[l0] = g.constant(1.0);
+        break;
+      case assign_p:
+        cur[l0] = g.constant(c);
+        break;
+      case neg_sign_p:
+        cur[l0] = g.constant(-c);
+        break;
+      case recipr_p:
+        cur[l0] = g.constant(1.0 / c);
+        break;
+
+      case eq_plus_d:
+      case eq_plus_p:
+        cur[l0] = g.unary(n0, v0 + c, 1.0, 0.0, false);
+        break;
+      case eq_min_d:
+      case eq_min_p:
+        cur[l0] = g.unary(n0, v0 - c, 1.0, 0.0, false);
+        break;
+      case eq_mult_d:
+      case eq_mult_p:
+        cur[l0] = g.unary(n0, v0 * c, c, 0.0, false);
+        break;
+      case incr_a:
+        cur[l0] = g.unary(n0, v0 + 1.0, 1.0, 0.0, false);
+        break;
+      case decr_a:
+        cur[l0] = g.unary(n0, v0 - 1.0, 1.0, 0.0, false);
+        break;
+      case eq_plus_a:
+        cur[l1] = g.binary(cur[l1], n0, v1 + v0, 1.0, 1.0, 0.0, 0.0, 0.0,
+                           hNone);
+        break;
+      case eq_min_a:
+        cur[l1] = g.binary(cur[l1], n0, v1 - v0, 1.0, -1.0, 0.0, 0.0, 0.0,
+                           hNone);
+        break;
+      case eq_mult_a:
+        cur[l1] = g.binary(cur[l1], n0, v1 * v0, v0, v1, 0.0, 1.0, 0.0,
+                           hMixed);
+        break;
+
+      case plus_a_a:
+        cur[l2] = g.binary(n0, cur[l1], v0 + v1, 1.0, 1.0, 0.0, 0.0, 0.0,
+                           hNone);
+        break;
+      case min_a_a:
+        cur[l2] = g.binary(n0, cur[l1], v0 - v1, 1.0, -1.0, 0.0, 0.0, 0.0,
+                           hNone);
+        break;
+      case mult_a_a:
+        cur[l2] = g.binary(n0, cur[l1], v0 * v1, v1, v0, 0.0, 1.0, 0.0,
+                           hMixed);
+        break;
+      case div_a_a: {
+        const double r = 1.0 / v1;
+        cur[l2] = g.binary(n0, cur[l1], v0 * r, r, -v0 * r * r, 0.0, -r * r,
+                           2.0 * v0 * r * r * r, hMixed | hSecond);
+        break;
+      }
+      case plus_d_a:
+      case plus_a_p:
+        cur[l1] = g.unary(n0, v0 + c, 1.0, 0.0, false);
+        break;
+      case min_d_a:
+        cur[l1] = g.unary(n0, c - v0, -1.0, 0.0, false);
+        break;
+      case min_a_p:
+        cur[l1] = g.unary(n0, v0 - c, 1.0, 0.0, false);
+        break;
+      case mult_d_a:
+      case mult_a_p:
+        cur[l1] = g.unary(n0, v0 * c, c, 0.0, false);
+        break;
+      case div_d_a:
+      case div_p_a: {
+        const double r = 1.0 / v0;
+        cur[l1] = g.unary(n0, c * r, -c * r * r, 2.0 * c * r * r * r, true);
+        break;
+      }
+      case pow_op:
+      case pow_op_p:
+        cur[l1] = g.unary(n0, pow(v0, c), c * pow(v0, c - 1.0),
+                          c * (c - 1.0) * pow(v0, c - 2.0), true);
+        break;
+      case eq_plus_prod:
+      case eq_min_prod: {
+        const double s = op == eq_plus_prod ? 1.0 : -1.0;
+        const int t = g.binary(n0, cur[l1], v0 * v1, v1, v0, 0.0, 1.0, 0.0,
+                               hMixed);
+        cur[l2] = g.binary(cur[l2], t, g.val[cur[l2]] + s * g.val[t], 1.0, s,
+                           0.0, 0.0, 0.0, hNone);
+        break;
+      }
+
+      case exp_op: {
+        const double e = exp(v0);
+        cur[l1] = g.unary(n0, e, e, e, true);
+        break;
+      }
+      case log_op:
+        cur[l1] = g.unary(n0, log(v0), 1.0 / v0, -1.0 / (v0 * v0), true);
+        break;
+      case sqrt_op: {
+        const double s = sqrt(v0);
+        cur[l1] = g.unary(n0, s, 0.5 / s, -0.25 / (s * v0), true);
+        break;
+      }
+      case cbrt_op: {
+        const double r = cbrt(v0);
+        cur[l1] = g.unary(n0, r, 1.0 / (3.0 * r * r),
+                          -2.0 / (9.0 * r * r * r * r * r), true);
+        break;
+      }
+      case sin_op: /* the covalue is stored in the second location */
+      case cos_op: {
+        const double s = sin(v0), co = cos(v0);
+        const int sn = g.unary(n0, s, co, -s, true);
+        const int cn = g.unary(n0, co, -s, -co, true);
+        cur[l2] = op == sin_op ? sn : cn;
+        cur[l1] = op == sin_op ? cn : sn;
+        break;
+      }
+      case atan_op: { /* the derivative recorded before is not used */
+        const double q = 1.0 / (1.0 + v0 * v0);
+        cur[l2] = g.unary(n0, atan(v0), q, -2.0 * v0 * q * q, true);
+        break;
+      }
+      case asin_op:
+      case acos_op: {
+        const double q = 1.0 / sqrt(1.0 - v0 * v0);
+        const double s = op == asin_op ? 1.0 : -1.0;
+        cur[l2] = g.unary(n0, op == asin_op ? asin(v0) : acos(v0), s * q,
+                          s * v0 * q * q * q, true);
+        break;
+      }
+      case asinh_op: {
+        const double q = 1.0 / sqrt(1.0 + v0 * v0);
+        cur[l2] = g.unary(n0, asinh(v0), q, -v0 * q * q * q, true);
+        break;
+      }
+      case acosh_op: {
+        const double q = 1.0 / sqrt(v0 * v0 - 1.0);
+        cur[l2] = g.unary(n0, acosh(v0), q, -v0 * q * q * q, true);
+        break;
+      }
+      case atanh_op: {
+        const double q = 1.0 / (1.0 - v0 * v0);
+        cur[l2] = g.unary(n0, atanh(v0), q, 2.0 * v0 * q * q, true);
+        break;
+      }
+      case erf_op:
+      case erfc_op: {
+        const double s = op == erf_op ? 1.0 : -1.0;
+        const double q = s * twoBySqrtPi * exp(-v0 * v0);
+        cur[l2] = g.unary(n0, op == erf_op ? erf(v0) : erfc(v0), q,
+                          -2.0 * v0 * q, true);
+        break;
+      }
+
+      case min_op:
+        cur[l2] = v0 > v1 ? cur[l1] : n0;
+        break;
+      case abs_val:
+        cur[l1] = g.unary(n0, fabs(v0), v0 < 0.0 ? -1.0 : 1.0, 0.0, false);
+        break;
+      case ceil_op:
+        cur[l1] = g.constant(ceil(v0));
+        break;
+      case floor_op:
+        cur[l1] = g.constant(floor(v0));
+        break;
+      case cond_assign:
+        cur[l3] = v0 > 0.0 ? cur[l1] : cur[l2];
+        break;
+      case cond_eq_assign:
+        cur[l3] = v0 >= 0.0 ? cur[l1] : cur[l2];
+        break;
+      case cond_assign_s:
+        if (v0 > 0.0)
+          cur[l2] = cur[l1];
+        break;
+      case cond_eq_assign_s:
+        if (v0 >= 0.0)
+          cur[l2] = cur[l1];
+        break;
+      default:
+        handled = false;
+        break;
+      }
+      break;
+    }
+    }
+    op = get_op_f();
+  }
+  end_sweep();
+  return handled;
+}
+
+/****************************************************************************/
+/* Symmetric sparse matrix W of the nonlinear interactions between nodes,   */
+/* both (i,j) and (j,i) are stored.                                         */
+/****************************************************************************/
+typedef std::vector<std::unordered_map<int, double>> EpMatrix;
+
+inline void addSym(EpMatrix &w, int i, int j, double v) {
+  w[i][j] += v;
+  if (i != j)
+    w[j][i] += v;
+}
+
+/****************************************************************************/
+/* Edge pushing sweep of Gower and Mello. The nodes are processed in        */
+/* reverse order; every node first pushes its interactions to its arguments */
+/* (the second-order part of the chain rule), then creates the interactions */
+/* of its own second derivatives weighted with its adjoint and finally      */
+/* passes its adjoint on. At the end W holds the Hessian restricted to the  */
+/* independents. Only nodes the dependent depends on are processed.         */
+/****************************************************************************/
+void pushEdges(const EpGraph &g, EpMatrix &w) {
+  const int size = (int)g.nodes.size();
+  std::vector<double> adj(size, 0.0);
+  std::vector<bool> needed(size, false);
+
+  needed[g.depNode] = true;
+  for (int i = size; i-- > 0;)
+    if (needed[i])
+      for (int k = 0; k < 2; ++k)
+        if (g.nodes[i].arg[k] >= 0)
+          needed[g.nodes[i].arg[k]] = true;
+
+  w.assign(size, std::unordered_map<int, double>());
+  adj[g.depNode] = 1.0;
+  for (int i = size; i-- > 0;) {
+    const EpNode &n = g.nodes[i];
+    if (!needed[i] || n.arg[0] < 0)
+      continue;
+    const int numArgs = n.arg[1] < 0 ? 1 : 2;
+
+    /* pushing */
+    std::unordered_map<int, double> row;
+    row.swap(w[i]);
+    for (const auto &e : row) {
+      const int j = e.first;
+      if (j != i)
+        w[j].erase(i);
+    }
+    for (const auto &e : row) {
+      const int j = e.first;
+      const double v = e.second;
+      if (j == i) {
+        for (int k = 0; k < numArgs; ++k)
+          for (int l = k; l < numArgs; ++l) {
+            const int pk = n.arg[k], pl = n.arg[l];
+            const double f = k != l && pk == pl ? 2.0 : 1.0;
+            addSym(w, pk, pl, f * n.d[k] * n.d[l] * v);
+          }
+      } else {
+        for (int k = 0; k < numArgs; ++k)
+          addSym(w, n.arg[k], j, (n.arg[k] == j ? 2.0 : 1.0) * n.d[k] * v);
+      }
+    }
+
+    /* creating */
+    const double a = adj[i];
+    if (n.nonlin & hFirst)
+      addSym(w, n.arg[0], n.arg[0], a * n.h[0]);
+    if (numArgs == 2) {
+      if (n.nonlin & hMixed)
+        addSym(w, n.arg[0], n.arg[1],
+               (n.arg[0] == n.arg[1] ? 2.0 : 1.0) * a * n.h[1]);
+      if (n.nonlin & hSecond)
+        addSym(w, n.arg[1], n.arg[1], a * n.h[2]);
+    }
+
+    /* adjoints */
+    for (int k = 0; k < numArgs; ++k)
+      adj[n.arg[k]] += a * n.d[k];
+  }
+}
+
+} // namespace
+
+BEGIN_C_DECLS
+
+/****************************************************************************/
+/* Sparse Hessian of the scalar function on tape "tag" at x in coordinate   */
+/* format, upper triangle rind[k] <= cind[k] sorted by rows. The entries    */
+/* are those the computational graph may make nonzero for the branches      */
+/* taken at x. If *rind, *cind and *values are all not NULL they have to    */
+/* hold *nnz entries and are reused if the number of nonzeros agrees,       */
+/* otherwise they are released by free() and allocated anew. Returns the    */
+/* return code of zos_forward at x, or -1 if the tape contains operations   */
+/* the edge pushing sweep does not handle.                                  */
+/****************************************************************************/
+int edge_push_hess(short tag, int n, const double *x, int *nnz,
+                   unsigned int **rind, unsigned int **cind,
+                   double **values) {
+  return edgePushHess(tag, n, x, nnz, rind, cind, values, 0);
+}
+
+/****************************************************************************/
+/* As edge_push_hess, but if fallback is set a tape with operations the     */
+/* edge pushing sweep does not handle returns -2 without an error message,  */
+/* such that the caller can use another method.                             */
+/****************************************************************************/
+int edgePushHess(short tag, int n, const double *x, int *nnz,
+                 unsigned int **rind, unsigned int **cind, double **values,
+                 int fallback) {
+  EpGraph g;
+  EpMatrix w;
+  std::vector<double> y;
+  size_t stats[STAT_SIZE];
+  int rc;
+
+  tapestats(tag, stats);
+  if (stats[NUM_INDEPENDENTS] != (size_t)n || stats[NUM_DEPENDENTS] != 1) {
+    fprintf(DIAG_OUT, "ADOL-C error in edge_push_hess(): tape %d is not a "
+                      "scalar function of %d independents\n",
+            tag, n);
+    return -1;
+  }
+  y.resize(1);
+  rc = zos_forward(tag, 1, n, 0, x, y.data());
+  if (rc < 0)
+    return rc;
+  if (!buildGraph(tag, x, g) || g.depNode < 0) {
+    if (fallback)
+      return -2;
+    fprintf(DIAG_OUT, "ADOL-C error in edge_push_hess(): tape %d contains "
+                      "operations not supported by edge pushing\n",
+            tag);
+    return -1;
+  }
+
+  pushEdges(g, w);
+
+  std::vector<int> indepOf(g.nodes.size(), -1);
+  for (int i = 0; i < n; ++i)
+    indepOf[g.indepNodes[i]] = i;
+  std::vector<std::pair<int, int>> entries;
+  std::vector<double> vals;
+  for (int i = 0; i < n; ++i) {
+    std::vector<std::pair<int, double>> row;
+    for (const auto &e : w[g.indepNodes[i]])
+      if (indepOf[e.first] >= i)
+        row.push_back(std::make_pair(indepOf[e.first], e.second));
+    std::sort(row.begin(), row.end());
+    for (const auto &e : row) {
+      entries.push_back(std::make_pair(i, e.first));
+      vals.push_back(e.second);
+    }
+  }
+
+  const int count = (int)entries.size();
+  if (*rind == NULL || *cind == NULL || *values == NULL || *nnz != count) {
+    free(*rind);
+    free(*cind);
+    free(*values);
+    *rind = (unsigned int *)malloc(std::max(count, 1) * sizeof(unsigned int));
+    *cind = (unsigned int *)malloc(std::max(count, 1) * sizeof(unsigned int));
+    *values = (double *)malloc(std::max(count, 1) * sizeof(double));
+    if (*rind == NULL || *cind == NULL || *values == NULL)
+      fail(ADOLC_MALLOC_FAILED);
+  }
+  *nnz = count;
+  for (int k = 0; k < count; ++k) {
+    (*rind)[k] = entries[k].first;
+    (*cind)[k] = entries[k].second;
+    (*values)[k] = vals[k];
+  }
+  return rc;
+}
+
+END_C_DECLS
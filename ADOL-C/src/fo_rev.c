@@ -188,6 +188,7 @@ results   Taylor-Jacobians       ------------          Taylor Jacobians
 #include "externfcts_p.h"
 #include "oplate.h"
 #include "taping_p.h"
+#include "vec_kernels.h"
 #include <adolc/adalloc.h>
 #include <adolc/externfcts.h>
 #include <adolc/interfaces.h>
@@ -452,15 +453,13 @@ int int_reverse_safe(
 
   /*--------------------------------------------------------------------------*/
 #ifdef _FOS_ /* FOS */
-  rp_A = (revreal *)calloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES],
-                           sizeof(revreal));
-  if (rp_A == NULL)
-    fail(ADOLC_MALLOC_FAILED);
+  rp_A = (revreal *)borrowWorkspace(
+      &ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_ADJOINT,
+      ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * sizeof(revreal), 1);
   ADOLC_CURRENT_TAPE_INFOS.rp_A = rp_A;
-  rp_T = (revreal *)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] *
-                           sizeof(revreal));
-  if (rp_T == NULL)
-    fail(ADOLC_MALLOC_FAILED);
+  rp_T = (revreal *)borrowWorkspace(
+      &ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TAYLOR,
+      ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * sizeof(revreal), 0);
   ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_FOS_REVERSE;
 #ifdef _ABS_NORM_
   memset(results, 0, sizeof(double) * (indep + swchk));
@@ -480,22 +479,20 @@ int int_reverse_safe(
   /*--------------------------------------------------------------------------*/
 #else
 #if defined _FOV_ /* FOV */
-  rpp_A = (revreal **)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] *
-                             sizeof(revreal *));
-  if (rpp_A == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  Aqo = (revreal *)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * p *
-                          sizeof(revreal));
-  if (Aqo == NULL)
-    fail(ADOLC_MALLOC_FAILED);
+  /* row pointers and adjoints in one block of the pool */
+  rpp_A = (revreal **)borrowWorkspace(
+      &ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_ADJOINT,
+      ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] *
+          (sizeof(revreal *) + p * sizeof(revreal)),
+      0);
+  Aqo = (revreal *)(rpp_A + ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES]);
   for (j = 0; j < ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES]; j++) {
     rpp_A[j] = Aqo + j * p;
   }
   ADOLC_CURRENT_TAPE_INFOS.rpp_A = rpp_A;
-  rp_T = (revreal *)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] *
-                           sizeof(revreal));
-  if (rp_T == NULL)
-    fail(ADOLC_MALLOC_FAILED);
+  rp_T = (revreal *)borrowWorkspace(
+      &ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TAYLOR,
+      ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * sizeof(revreal), 0);
   ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_FOV_REVERSE;
 #define ADJOINT_BUFFER rpp_A
 #define ADJOINT_BUFFER_ARG_L rpp_A[arg][l]
@@ -510,13 +507,20 @@ int int_reverse_safe(
 #define ADOLC_EXT_FCT_COPY_ADJOINTS_BACK(dest, src)
 #else
 #if defined _INT_REV_
-  upp_A = myalloc2_ulong(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES], p);
+  upp_A = (unsigned long int **)borrowWorkspace(
+      &ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_ADJOINT,
+      ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] *
+          (sizeof(unsigned long int *) + p * sizeof(unsigned long int)),
+      1);
+  for (size_t i = 0; i < ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES]; i++)
+    upp_A[i] = (unsigned long int *)(upp_A + ADOLC_CURRENT_TAPE_INFOS
+                                                 .stats[NUM_MAX_LIVES]) +
+               i * p;
 #if defined _TIGHT_
   ADOLC_CURRENT_TAPE_INFOS.upp_A = upp_A;
-  rp_T = (revreal *)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] *
-                           sizeof(revreal));
-  if (rp_T == NULL)
-    fail(ADOLC_MALLOC_FAILED);
+  rp_T = (revreal *)borrowWorkspace(
+      &ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TAYLOR,
+      ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * sizeof(revreal), 0);
 #endif
 #define ADJOINT_BUFFER upp_A
 #define ADJOINT_BUFFER_ARG_L upp_A[arg][l]
@@ -625,15 +629,14 @@ int int_reverse_safe(
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        AARG_INC |= *Ares;
-        ARES_INC = 0;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         AARG_INC += *Ares;
         ARES_INC = 0.0;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -784,11 +787,10 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg]);
 
-      FOR_0_LE_l_LT_p
 #if defined(_INT_REV_)
-          AARG_INC |= ARES_INC;
+      vec_bit_or(p, Aarg, Ares, Aarg);
 #else
-          AARG_INC += ARES_INC;
+      FOR_0_LE_l_LT_p AARG_INC += ARES_INC;
 #endif
 
 #if !defined(_NTIGHT_)
@@ -828,11 +830,10 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
-      FOR_0_LE_l_LT_p
 #if defined(_INT_REV_)
-          AARG_INC |= ARES_INC;
+      vec_bit_or(p, Aarg, Ares, Aarg);
 #else
-          AARG_INC -= ARES_INC;
+      FOR_0_LE_l_LT_p AARG_INC -= ARES_INC;
 #endif
 
 #if !defined(_NTIGHT_)
@@ -928,19 +929,18 @@ int int_reverse_safe(
       ASSIGN_A(Aarg1, ADJOINT_BUFFER[arg1])
       ASSIGN_A(Aarg2, ADJOINT_BUFFER[arg2])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG1_INC |= aTmp;
-        AARG2_INC |= aTmp;
+      vec_bit_push2(p, Ares, Aarg1, Aarg2);
+#elif defined(_FOV_)
+      vec_rev_push2(p, 1.0, 1.0, Ares, Aarg1, Aarg2);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG1_INC += aTmp;
         AARG2_INC += aTmp;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -959,17 +959,15 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += aTmp;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -990,17 +988,15 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += aTmp;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1018,19 +1014,18 @@ int int_reverse_safe(
       ASSIGN_A(Aarg1, ADJOINT_BUFFER[arg1])
       ASSIGN_A(Aarg2, ADJOINT_BUFFER[arg2])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG1_INC |= aTmp;
-        AARG2_INC |= aTmp;
+      vec_bit_push2(p, Ares, Aarg1, Aarg2);
+#elif defined(_FOV_)
+      vec_rev_push2(p, 1.0, -1.0, Ares, Aarg1, Aarg2);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG1_INC += aTmp;
         AARG2_INC -= aTmp;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1049,17 +1044,15 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC -= aTmp;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1080,19 +1073,18 @@ int int_reverse_safe(
       ASSIGN_A(Aarg2, ADJOINT_BUFFER[arg2])
       ASSIGN_A(Aarg1, ADJOINT_BUFFER[arg1])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG2_INC |= aTmp;
-        AARG1_INC |= aTmp;
+      vec_bit_push2(p, Ares, Aarg2, Aarg1);
+#elif defined(_FOV_)
+      vec_rev_push2(p, TARG2, TARG1, Ares, Aarg1, Aarg2);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG2_INC += aTmp * TARG1;
         AARG1_INC += aTmp * TARG2;
-#endif
       }
+#endif
       break;
 
       /*--------------------------------------------------------------------------*/
@@ -1112,15 +1104,16 @@ int int_reverse_safe(
       TRES -= TARG1 * TARG2;
 #endif /* !_NTIGHT_ */
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        AARG2_INC |= *Ares;
-        AARG1_INC |= ARES_INC;
+      vec_bit_add2(p, Ares, Aarg1, Aarg2);
+#elif defined(_FOV_)
+      vec_rev_add2(p, TARG2, TARG1, Ares, Aarg1, Aarg2);
 #else
+      FOR_0_LE_l_LT_p {
         AARG2_INC += (*Ares) * TARG1;
         AARG1_INC += ARES_INC * TARG2;
-#endif
       }
+#endif
       break;
 
       /*--------------------------------------------------------------------------*/
@@ -1140,15 +1133,16 @@ int int_reverse_safe(
       TRES += TARG1 * TARG2;
 #endif /* !_NTIGHT_ */
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        AARG2_INC |= *Ares;
-        AARG1_INC |= ARES_INC;
+      vec_bit_add2(p, Ares, Aarg1, Aarg2);
+#elif defined(_FOV_)
+      vec_rev_add2(p, -TARG2, -TARG1, Ares, Aarg1, Aarg2);
 #else
+      FOR_0_LE_l_LT_p {
         AARG2_INC -= (*Ares) * TARG1;
         AARG1_INC -= ARES_INC * TARG2;
-#endif
       }
+#endif
       break;
 
       /*--------------------------------------------------------------------------*/
@@ -1163,17 +1157,15 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += coval * aTmp;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1193,17 +1185,15 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += coval * aTmp;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1229,19 +1219,16 @@ int int_reverse_safe(
       r_0 *= r0;
 #endif /* !_NTIGHT_ */
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG1_INC |= aTmp;
-        AARG2_INC |= aTmp;
+      vec_bit_push2(p, Ares, Aarg1, Aarg2);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG1_INC += aTmp * r0;
         AARG2_INC += aTmp * r_0;
-#endif
       }
+#endif
 
       break;
 
@@ -1265,17 +1252,15 @@ int int_reverse_safe(
       r0 /= TARG;
 #endif /* !_NTIGHT_ */
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += aTmp * r0;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       if (arg != res)
@@ -1304,17 +1289,15 @@ int int_reverse_safe(
       r0 /= TARG;
 #endif /* !_NTIGHT_ */
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += aTmp * r0;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       if (arg != res)
@@ -1334,17 +1317,15 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += aTmp;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1359,17 +1340,15 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC -= aTmp;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1388,17 +1367,17 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
+#elif defined(_FOV_)
+      vec_rev_push1(p, TRES, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += aTmp * TRES;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1414,17 +1393,17 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg1, ADJOINT_BUFFER[arg1])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG1_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg1);
+#elif defined(_FOV_)
+      vec_rev_push1(p, TARG2, Ares, Aarg1);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG1_INC += aTmp * TARG2;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1442,17 +1421,17 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg1, ADJOINT_BUFFER[arg1])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG1_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg1);
+#elif defined(_FOV_)
+      vec_rev_push1(p, -TARG2, Ares, Aarg1);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG1_INC -= aTmp * TARG2;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1510,17 +1489,15 @@ int int_reverse_safe(
       r0 = 1.0 / TARG;
 #endif
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += aTmp * r0;
-#endif
       }
+#endif
       break;
 
       /*--------------------------------------------------------------------------*/
@@ -1545,17 +1522,15 @@ int int_reverse_safe(
         r0 *= coval / TARG;
 #endif /* !_NTIGHT_ */
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += aTmp * r0;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1585,17 +1560,15 @@ int int_reverse_safe(
         r0 *= coval / TARG;
 #endif /* !_NTIGHT_ */
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += aTmp * r0;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1617,17 +1590,15 @@ int int_reverse_safe(
         r0 = 0.5 / TRES;
 #endif /* !_NTIGHT_ */
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += aTmp * r0;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -1649,17 +1620,15 @@ int int_reverse_safe(
         r0 = 1.0 / (3.0 * TRES * TRES);
 #endif /* !_NTIGHT_ */
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        unsigned long int aTmp = *Ares;
-        ARES_INC = 0;
-        AARG_INC |= aTmp;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         revreal aTmp = *Ares;
         ARES_INC = 0.0;
         AARG_INC += aTmp * r0;
-#endif
       }
+#endif
 
 #if !defined(_NTIGHT_)
       ADOLC_GET_TAYLOR(res);
@@ -2369,15 +2338,14 @@ int int_reverse_safe(
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
 
-      FOR_0_LE_l_LT_p {
 #if defined(_INT_REV_)
-        AARG_INC |= *Ares;
-        ARES_INC = 0;
+      vec_bit_push1(p, Ares, Aarg);
 #else
+      FOR_0_LE_l_LT_p {
         AARG_INC += *Ares;
         ARES_INC = 0.0;
-#endif
       }
+#endif
 
       ADOLC_GET_TAYLOR(res);
 #else
@@ -2449,11 +2417,10 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg]);
 
-      FOR_0_LE_l_LT_p
 #if defined(_INT_REV_)
-          AARG_INC |= ARES_INC;
+      vec_bit_or(p, Aarg, Ares, Aarg);
 #else
-          AARG_INC += ARES_INC;
+      FOR_0_LE_l_LT_p AARG_INC += ARES_INC;
 #endif
 
       ADOLC_GET_TAYLOR(res);
@@ -2505,11 +2472,10 @@ int int_reverse_safe(
       ASSIGN_A(Ares, ADJOINT_BUFFER[res])
       ASSIGN_A(Aarg, ADJOINT_BUFFER[arg])
 
-      FOR_0_LE_l_LT_p
 #if defined(_INT_REV_)
-          AARG_INC |= ARES_INC;
+      vec_bit_or(p, Aarg, Ares, Aarg);
 #else
-          AARG_INC -= ARES_INC;
+      FOR_0_LE_l_LT_p AARG_INC -= ARES_INC;
 #endif
 
       ADOLC_GET_TAYLOR(res);
@@ -3263,19 +3229,18 @@ int int_reverse_safe(
     operation = get_op_r();
   } /* endwhile */
 
-  /* clean up */
-#if !defined(_INT_REV_)
-  free(rp_T);
+  /* clean up, the arrays are kept for the next sweep */
+#if !defined(_INT_REV_) || defined(_TIGHT_)
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TAYLOR, rp_T);
 #endif
 #ifdef _FOS_
-  free(rp_A);
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_ADJOINT, rp_A);
 #endif
 #ifdef _FOV_
-  free(Aqo);
-  myfree2(rpp_A);
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_ADJOINT, rpp_A);
 #endif
 #ifdef _INT_REV_
-  free(upp_A);
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_ADJOINT, upp_A);
 #endif
 
   ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_NO_MODE;
@@ -443,33 +443,7 @@ int hov_ti_reverse(short tnum,         /* tape id */
 
   /*----------------------------------------------------------------------*/
 #ifdef _HOS_ /* HOS */
-  rpp_A = (revreal **)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] *
-                             sizeof(revreal *));
-  if (rpp_A == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  Aqo = (revreal *)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * k1 *
-                          sizeof(revreal));
-  if (Aqo == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  for (int i = 0; i < ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES]; i++) {
-    rpp_A[i] = Aqo;
-    Aqo += k1;
-  }
-  rpp_T = (revreal **)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] *
-                             sizeof(revreal *));
-  if (rpp_T == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  Tqo = (revreal *)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * k *
-                          sizeof(revreal));
-  if (Tqo == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  for (int i = 0; i < ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES]; i++) {
-    rpp_T[i] = Tqo;
-    Tqo += k;
-  }
-  rp_Atemp = (revreal *)malloc(k1 * sizeof(revreal));
-  rp_Atemp2 = (revreal *)malloc(k1 * sizeof(revreal));
-  rp_Ttemp2 = (revreal *)malloc(k * sizeof(revreal));
+  const size_t adjWidth = k1, tayWidth = k;
   ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_HOS_REVERSE;
 
   locint n, m;
@@ -477,74 +451,50 @@ int hov_ti_reverse(short tnum,         /* tape id */
   int oldTraceFlag;
   /*----------------------------------------------------------------------*/
 #elif _HOV_    /* HOV */
-  rpp_A = (revreal **)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] *
-                             sizeof(revreal *));
-  if (rpp_A == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  Aqo = (revreal *)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * pk1 *
-                          sizeof(revreal));
-  if (Aqo == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  for (int i = 0; i < ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES]; i++) {
-    rpp_A[i] = Aqo;
-    Aqo += pk1;
-  }
-  rpp_T = (revreal **)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] *
-                             sizeof(revreal *));
-  if (rpp_T == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  Tqo = (revreal *)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * k *
-                          sizeof(revreal));
-  if (Tqo == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  for (int i = 0; i < ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES]; i++) {
-    rpp_T[i] = Tqo;
-    Tqo += k;
-  }
-  rp_Atemp = (revreal *)malloc(pk1 * sizeof(revreal));
-  rp_Atemp2 = (revreal *)malloc(pk1 * sizeof(revreal));
-  rp_Ttemp2 = (revreal *)malloc(k * sizeof(revreal));
+  const size_t adjWidth = pk1, tayWidth = k;
   ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_HOV_REVERSE;
   /*----------------------------------------------------------------------*/
 #elif _HOS_OV_ /* HOS_OV */
-  rpp_A = (revreal **)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] *
-                             sizeof(revreal *));
-  if (rpp_A == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  Aqo = (revreal *)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * pk1 *
-                          sizeof(revreal));
-  if (Aqo == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  for (int i = 0; i < ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES]; i++) {
-    rpp_A[i] = Aqo;
-    Aqo += pk1;
-  }
-  rpp_T = (revreal **)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] *
-                             sizeof(revreal *));
-  if (rpp_T == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  Tqo = (revreal *)malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * p *
-                          k * sizeof(revreal));
-  if (Tqo == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  for (int i = 0; i < ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES]; i++) {
-    rpp_T[i] = Tqo;
-    Tqo += p * k;
-  }
-  rp_Atemp = (revreal *)malloc(pk1 * sizeof(revreal));
-  rp_Atemp2 = (revreal *)malloc(pk1 * sizeof(revreal));
-  rp_Ttemp2 = (revreal *)malloc(p * k * sizeof(revreal));
+  const size_t adjWidth = pk1, tayWidth = p * k;
   ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_HOV_REVERSE;
 #endif
-  rp_Ttemp = (revreal *)malloc(k * sizeof(revreal));
-  if (rp_Ttemp == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  if (rp_Ttemp2 == NULL)
-    fail(ADOLC_MALLOC_FAILED);
-  x = myalloc1(q);
-  jj = (int *)malloc(q * sizeof(int));
-  if (jj == NULL)
-    fail(ADOLC_MALLOC_FAILED);
+  {
+    const size_t lives = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES];
+    char *tmp;
+
+    /* row pointers followed by the rows, the blocks are kept for the next
+     * sweep on this tape */
+    rpp_A = (revreal **)borrowWorkspace(
+        &ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_ADJOINT,
+        lives * (sizeof(revreal *) + adjWidth * sizeof(revreal)), 0);
+    Aqo = (revreal *)(rpp_A + lives);
+    for (size_t i = 0; i < lives; i++) {
+      rpp_A[i] = Aqo;
+      Aqo += adjWidth;
+    }
+    rpp_T = (revreal **)borrowWorkspace(
+        &ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TAYLOR,
+        lives * (sizeof(revreal *) + tayWidth * sizeof(revreal)), 0);
+    Tqo = (revreal *)(rpp_T + lives);
+    for (size_t i = 0; i < lives; i++) {
+      rpp_T[i] = Tqo;
+      Tqo += tayWidth;
+    }
+
+    /* x, rp_Atemp, rp_Atemp2, rp_Ttemp2, rp_Ttemp and jj share one block */
+    tmp = (char *)borrowWorkspace(
+        &ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TEMP,
+        q * sizeof(double) +
+            (2 * adjWidth + tayWidth + k) * sizeof(revreal) +
+            q * sizeof(int),
+        1);
+    x = (double *)tmp;
+    rp_Atemp = (revreal *)(x + q);
+    rp_Atemp2 = rp_Atemp + adjWidth;
+    rp_Ttemp2 = rp_Atemp2 + adjWidth;
+    rp_Ttemp = rp_Ttemp2 + tayWidth;
+    jj = (int *)(rp_Ttemp + k);
+  }
 
   /************************************************************************/
   /*                                                TAYLOR INITIALIZATION */
@@ -3378,18 +3328,10 @@ int hov_ti_reverse(short tnum,         /* tape id */
   printf("\n");
 #endif /* ADOLC_DEBUG */
 
-  /* clean up */
-  free((char *)*rpp_T);
-  free((char *)rpp_T);
-  free(*rpp_A);
-  free(rpp_A);
-  free(rp_Ttemp);
-  free(rp_Ttemp2);
-  free(rp_Atemp);
-  free(rp_Atemp2);
-
-  free((char *)jj);
-  free((char *)x);
+  /* clean up, the arrays are kept for the next sweep */
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TAYLOR, rpp_T);
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_ADJOINT, rpp_A);
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TEMP, x);
 
   ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_NO_MODE;
   end_sweep();
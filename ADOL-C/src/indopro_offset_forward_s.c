@@ -0,0 +1,21 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     indopro_offset_forward_s.c
+ Revision: $Id$
+ Contents: indopro_offset_forward_safe (propagation of index domains
+           restricted to a range of independents, safe mode)
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#define _INDO_ 1
+#define _INDOPRO_ 1
+#define _NTIGHT_ 1
+#define _CHUNKED_
+#include <uni5_for.c>
+#undef _CHUNKED_
+#undef _INDO_
+#undef _INDOPRO_
+#undef _NTIGHT_
@@ -0,0 +1,434 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     nonl_ind_graph.cpp
+ Revision: $Id$
+ Contents: sparsity pattern of the Hessian by nonlinear interaction domains
+           that are stored as sorted index vectors in one arena instead of
+           the IndexElement trees of nonl_ind_forward_*
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#include "dvlparms.h"
+#include "oplate.h"
+#include "taping_p.h"
+#include <adolc/interfaces.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/****************************************************************************/
+/* The index domain of every value is a node of a graph in single           */
+/* assignment form: an independent, or the union of the domains of at most  */
+/* two other nodes. Linear operations and unary functions only rename or    */
+/* join nodes, which costs O(1) per operation however large the domains     */
+/* are. A nonlinear operation records the pair (a, b) of nodes, meaning     */
+/* that every independent of domain a interacts nonlinearly with every      */
+/* independent of domain b. Only the nodes of recorded pairs are expanded   */
+/* into sorted index vectors at the end of the sweep, each one exactly      */
+/* once, and the rows of the pattern are merged from them.                  */
+/****************************************************************************/
+struct IndexNode {
+  int arg[2]; /* arg[0] < 0: independent number arg[1] */
+};
+
+class IndexGraph {
+public:
+  std::vector<IndexNode> nodes;
+  std::vector<std::pair<int, int>> pairs;
+  bool hasBranches = false; /* min_op or conditional assignment seen */
+
+  int independent(int k) {
+    const IndexNode node = {{-1, k}};
+    nodes.push_back(node);
+    return (int)nodes.size() - 1;
+  }
+
+  /* node of the union of the domains a and b, -1 is the empty domain */
+  int join(int a, int b) {
+    if (a < 0)
+      return b;
+    if (b < 0 || a == b)
+      return a;
+    const IndexNode node = {{a, b}};
+    nodes.push_back(node);
+    return (int)nodes.size() - 1;
+  }
+
+  void interact(int a, int b) {
+    if (a < 0 || b < 0)
+      return;
+    if (pairs.empty() || pairs.back() != std::make_pair(a, b))
+      pairs.push_back(std::make_pair(a, b));
+  }
+
+  void pattern(int n, unsigned int **crs);
+
+private:
+  std::vector<unsigned int> arena; /* expanded domains, sorted */
+  std::vector<size_t> first;       /* per node, position in arena */
+  std::vector<unsigned int> count; /* per node, size of the domain */
+  std::vector<int> nodeMark, indexMark;
+  std::vector<int> stack;
+  int generation = 0;
+
+  void expand(int v);
+};
+
+const size_t notExpanded = (size_t)-1;
+
+/****************************************************************************/
+/* Expands the domain of node v into the arena by a depth first search that */
+/* visits every node and independent once and stops at expanded nodes.      */
+/****************************************************************************/
+void IndexGraph::expand(int v) {
+  if (first[v] != notExpanded)
+    return;
+
+  const size_t start = arena.size();
+  ++generation;
+  stack.clear();
+  stack.push_back(v);
+  while (!stack.empty()) {
+    const int u = stack.back();
+    stack.pop_back();
+    if (nodeMark[u] == generation)
+      continue;
+    nodeMark[u] = generation;
+    if (first[u] != notExpanded) {
+      for (size_t k = first[u]; k < first[u] + count[u]; ++k) {
+        const unsigned int i = arena[k];
+        if (indexMark[i] != generation) {
+          indexMark[i] = generation;
+          arena.push_back(i);
+        }
+      }
+    } else if (nodes[u].arg[0] < 0) {
+      const unsigned int i = nodes[u].arg[1];
+      if (indexMark[i] != generation) {
+        indexMark[i] = generation;
+        arena.push_back(i);
+      }
+    } else {
+      stack.push_back(nodes[u].arg[1]);
+      stack.push_back(nodes[u].arg[0]);
+    }
+  }
+  std::sort(arena.begin() + start, arena.end());
+  first[v] = start;
+  count[v] = (unsigned int)(arena.size() - start);
+}
+
+/****************************************************************************/
+/* Row i of the pattern is the union of the domains b of all pairs (a, b)   */
+/* with i in domain a. The pairs are grouped by row in compressed row       */
+/* storage, the rows are merged with marks, which drops repeated pairs,     */
+/* and sorted.                                                              */
+/****************************************************************************/
+void IndexGraph::pattern(int n, unsigned int **crs) {
+  first.assign(nodes.size(), notExpanded);
+  count.assign(nodes.size(), 0);
+  nodeMark.assign(nodes.size(), 0);
+  indexMark.assign(n, 0);
+  for (size_t k = 0; k < pairs.size(); ++k) {
+    expand(pairs[k].first);
+    expand(pairs[k].second);
+  }
+
+  std::vector<size_t> rowStart(n + 1, 0);
+  for (size_t k = 0; k < pairs.size(); ++k) {
+    const int a = pairs[k].first;
+    for (size_t l = first[a]; l < first[a] + count[a]; ++l)
+      ++rowStart[arena[l] + 1];
+  }
+  for (int i = 0; i < n; ++i)
+    rowStart[i + 1] += rowStart[i];
+  std::vector<int> rowNodes(rowStart[n]);
+  std::vector<size_t> fill(rowStart.begin(), rowStart.end() - 1);
+  for (size_t k = 0; k < pairs.size(); ++k) {
+    const int a = pairs[k].first;
+    for (size_t l = first[a]; l < first[a] + count[a]; ++l)
+      rowNodes[fill[arena[l]]++] = pairs[k].second;
+  }
+
+  std::vector<unsigned int> row;
+  for (int i = 0; i < n; ++i) {
+    ++generation;
+    row.clear();
+    for (size_t k = rowStart[i]; k < rowStart[i + 1]; ++k) {
+      const int b = rowNodes[k];
+      for (size_t l = first[b]; l < first[b] + count[b]; ++l) {
+        const unsigned int j = arena[l];
+        if (indexMark[j] != generation) {
+          indexMark[j] = generation;
+          row.push_back(j);
+        }
+      }
+    }
+    std::sort(row.begin(), row.end());
+    crs[i] = (unsigned int *)malloc(sizeof(unsigned int) * (row.size() + 1));
+    crs[i][0] = (unsigned int)row.size();
+    std::copy(row.begin(), row.end(), crs[i] + 1);
+  }
+}
+
+/****************************************************************************/
+/* Builds the index graph of tape "tag". The interactions are those of the  */
+/* safe mode of nonl_ind_forward_safe: min_op and conditional assignments   */
+/* join the domains of all branches. Returns false if the tape contains an  */
+/* operation that is not handled, e.g. external functions or vector ops.    */
+/****************************************************************************/
+bool buildIndexGraph(short tag, int depen, int indep, IndexGraph &g) {
+  unsigned char op;
+  const char *layout;
+  int numVals, numIndeps = 0;
+  bool essential, handled = true;
+  std::vector<int> cur; /* node currently held by every location */
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  init_for_sweep(tag);
+  if (((size_t)depen != ADOLC_CURRENT_TAPE_INFOS.stats[NUM_DEPENDENTS]) ||
+      ((size_t)indep != ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS])) {
+    fprintf(DIAG_OUT,
+            "ADOL-C error: forward sweep on tape %d  aborted!\n"
+            "Number of dependent(%d) and/or independent(%d) variables passed"
+            " to forward is\ninconsistent with number "
+            "recorded on tape (%zu, %zu) \n",
+            tag, depen, indep,
+            ADOLC_CURRENT_TAPE_INFOS.stats[NUM_DEPENDENTS],
+            ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS]);
+    adolc_exit(-1, "", __func__, __FILE__, __LINE__);
+  }
+  cur.assign(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES], -1);
+
+  op = get_op_f();
+  while (op != end_of_tape && handled) {
+    switch (op) {
+    case end_of_op:
+      get_op_block_f();
+      op = get_op_f();
+      /* Skip next operation, it's another end_of_op */
+      break;
+    case end_of_int:
+      get_loc_block_f();
+      break;
+    case end_of_val:
+      get_val_block_f();
+      break;
+    case start_of_tape:
+      break;
+    case death_not:
+      get_locint_f();
+      get_locint_f();
+      break;
+    case take_stock_op: {
+      locint size = get_locint_f();
+      locint res = get_locint_f();
+      get_val_v_f(size);
+      std::fill(cur.begin() + res, cur.begin() + res + size, -1);
+      break;
+    }
+    default: {
+      layout = opLayout(op, &numVals, &essential);
+      if (layout == NULL) {
+        handled = false;
+        break;
+      }
+      /* locations of the arguments and results, parameters excluded */
+      locint l[4] = {0, 0, 0, 0};
+      int numLocs = 0;
+      for (size_t k = 0; layout[k] != 0; ++k) {
+        const locint loc = get_locint_f();
+        if (layout[k] != 'P')
+          l[numLocs++] = loc;
+      }
+      for (int k = 0; k < numVals; ++k)
+        get_val_f();
+
+      const int a = cur[l[0]];
+      const int b = numLocs > 1 ? cur[l[1]] : -1;
+
+      switch (op) {
+      case eq_zero:
+      case neq_zero:
+      case le_zero:
+      case gt_zero:
+      case ge_zero:
+      case lt_zero:
+      case assign_dep:
+        break;
+      case assign_ind:
+        cur[l[0]] = g.independent(numIndeps++);
+        break;
+
+      case assign_d:
+      case assign_d_zero:
+      case assign_d_one:
+      case assign_p:
+      case neg_sign_p:
+      case recipr_p:
+        cur[l[0]] = -1;
+        break;
+
+      /* the domain of the result is the one of the argument */
+      case eq_plus_d:
+      case eq_plus_p:
+      case eq_min_d:
+      case eq_min_p:
+      case eq_mult_d:
+      case eq_mult_p:
+      case incr_a:
+      case decr_a:
+        break;
+      case assign_a:
+      case pos_sign_a:
+      case neg_sign_a:
+      case plus_d_a:
+      case plus_a_p:
+      case min_d_a:
+      case min_a_p:
+      case mult_d_a:
+      case mult_a_p:
+      case abs_val:
+      case ceil_op:
+      case floor_op:
+        cur[l[1]] = a;
+        break;
+
+      /* linear combinations */
+      case eq_plus_a:
+      case eq_min_a:
+        cur[l[1]] = g.join(b, a);
+        break;
+      case plus_a_a:
+      case min_a_a:
+        cur[l[2]] = g.join(a, b);
+        break;
+
+      /* nonlinear operations */
+      case eq_mult_a:
+        g.interact(a, b);
+        g.interact(b, a);
+        cur[l[1]] = g.join(b, a);
+        break;
+      case mult_a_a:
+        g.interact(a, b);
+        g.interact(b, a);
+        cur[l[2]] = g.join(a, b);
+        break;
+      case div_a_a:
+        cur[l[2]] = g.join(a, b);
+        g.interact(a, b);
+        g.interact(b, cur[l[2]]);
+        break;
+      case eq_plus_prod:
+      case eq_min_prod:
+        g.interact(a, b);
+        g.interact(b, a);
+        cur[l[2]] = g.join(cur[l[2]], g.join(a, b));
+        break;
+      case div_d_a:
+      case div_p_a:
+      case pow_op:
+      case pow_op_p:
+      case exp_op:
+      case log_op:
+      case sqrt_op:
+      case cbrt_op:
+        g.interact(a, a);
+        cur[l[1]] = a;
+        break;
+      case sin_op: /* the second location receives the covalue */
+      case cos_op:
+        g.interact(a, a);
+        cur[l[1]] = a;
+        cur[l[2]] = a;
+        break;
+      case atan_op: /* the second location holds the derivative */
+      case asin_op:
+      case acos_op:
+      case asinh_op:
+      case acosh_op:
+      case atanh_op:
+      case erf_op:
+      case erfc_op:
+      case gen_quad:
+        g.interact(a, a);
+        cur[l[2]] = a;
+        break;
+
+      /* all branches in safe mode */
+      case min_op:
+        g.hasBranches = true;
+        cur[l[2]] = g.join(a, b);
+        break;
+      case cond_assign:
+      case cond_eq_assign:
+        g.hasBranches = true;
+        cur[l[3]] = g.join(b, cur[l[2]]);
+        break;
+      case cond_assign_s:
+      case cond_eq_assign_s:
+        g.hasBranches = true;
+        cur[l[2]] = g.join(cur[l[2]], b);
+        break;
+      default:
+        handled = false;
+        break;
+      }
+      break;
+    }
+    }
+    op = get_op_f();
+  }
+  end_sweep();
+  return handled;
+}
+
+} // namespace
+
+BEGIN_C_DECLS
+
+/****************************************************************************/
+/* Sparsity pattern of the Hessian in the format of nonl_ind_forward_safe,  */
+/* i.e. crs[i][0] entries crs[i][1..] in increasing order for every         */
+/* independent i. Tapes with operations the index graph does not handle are */
+/* passed to nonl_ind_forward_safe.                                         */
+/****************************************************************************/
+int nonl_ind_graph_safe(short tag, int depen, int indep,
+                        const double *basepoint, unsigned int **crs) {
+  IndexGraph g;
+
+  if (!buildIndexGraph(tag, depen, indep, g))
+    return nonl_ind_forward_safe(tag, depen, indep, basepoint, crs);
+  g.pattern(indep, crs);
+  return 3;
+}
+
+/****************************************************************************/
+/* Tight mode: the pattern is the one of the safe mode unless the tape      */
+/* contains min_op or conditional assignments, whose branches are chosen    */
+/* at basepoint by nonl_ind_forward_tight.                                  */
+/****************************************************************************/
+int nonl_ind_graph_tight(short tag, int depen, int indep,
+                         const double *basepoint, unsigned int **crs) {
+  IndexGraph g;
+
+  if (!buildIndexGraph(tag, depen, indep, g) || g.hasBranches)
+    return nonl_ind_forward_tight(tag, depen, indep, basepoint, crs);
+
+  std::vector<double> y(depen);
+  const int rc = zos_forward(tag, depen, indep, 0, basepoint, y.data());
+  g.pattern(indep, crs);
+  return rc;
+}
+
+END_C_DECLS
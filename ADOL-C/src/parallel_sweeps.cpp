@@ -0,0 +1,234 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     parallel_sweeps.cpp
+ Revision: $Id$
+ Contents: vector sweeps whose directions are distributed among OpenMP
+           threads
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#include "dvlparms.h"
+#include "taping_p.h"
+#include <adolc/interfaces.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <adolc/adolc_openmp.h>
+#endif
+
+BEGIN_C_DECLS
+
+/****************************************************************************/
+/* Number of workers for numDirs directions, 1 means serial evaluation.     */
+/****************************************************************************/
+int sweepWorkers(int nthreads, int numDirs) {
+#if defined(_OPENMP)
+  if (omp_in_parallel())
+    return 1;
+  if (nthreads <= 0)
+    nthreads = omp_get_max_threads();
+  return std::max(1, std::min(std::min(nthreads, numDirs),
+                              maxParallelThreads()));
+#else
+  (void)nthreads;
+  (void)numDirs;
+  return 1;
+#endif
+}
+
+/****************************************************************************/
+/* First-order vector reverse mode with the q weight vectors distributed    */
+/* among nthreads OpenMP threads (all available ones if nthreads <= 0).     */
+/* Every thread sweeps the shared tape for a contiguous block of rows of U  */
+/* and writes the same rows of Z. Tapes on hard disk, calls from within a   */
+/* parallel region and builds without OpenMP use a single fov_reverse.      */
+/****************************************************************************/
+int fov_reverse_mt(short tag, int m, int n, int q, double **U, double **Z,
+                   int nthreads) {
+#if defined(_OPENMP)
+  const TapeInfos *tapeInfos = NULL;
+
+  nthreads = sweepWorkers(nthreads, q);
+  if (nthreads > 1)
+    tapeInfos = sharedReverseTape(tag, m, n);
+
+  if (tapeInfos != NULL) {
+    int rc = std::numeric_limits<int>::max();
+
+    ADOLC_parallel_doCopy = 0;
+#pragma omp parallel num_threads(nthreads) reduction(min : rc)
+    {
+      beginParallel();
+      TapeInfos *hidden;
+      TapeInfos *view = attachSharedTape(tapeInfos, &hidden);
+
+      /* the team may be smaller than requested */
+      const int numThreads = omp_get_num_threads();
+      const int chunk = (q + numThreads - 1) / numThreads;
+      const int first = omp_get_thread_num() * chunk;
+      const int dirs = std::min(chunk, q - first);
+      if (dirs > 0)
+        rc = fov_reverse(tag, m, n, dirs, U + first, Z + first);
+
+      detachSharedTape(view, hidden);
+      endParallel();
+    }
+    return rc;
+  }
+#else
+  (void)nthreads;
+#endif
+  return fov_reverse(tag, m, n, q, U, Z);
+}
+
+/****************************************************************************/
+/* First-order vector forward mode with the p directions split into chunks  */
+/* that are distributed among nthreads OpenMP threads (all available ones   */
+/* if nthreads <= 0). Every chunk is one fov_offset_forward sweep over the  */
+/* shared tape. If chunk <= 0, the chunk size is chosen such that the       */
+/* Taylor coefficients of all live variables take about DIRCHUNKSIZE bytes, */
+/* but every thread gets one chunk at least. Tapes on hard disk, calls from */
+/* within a parallel region and builds without OpenMP evaluate the chunks   */
+/* one after the other, or use a single fov_forward if chunk <= 0.          */
+/****************************************************************************/
+int fov_forward_mt(short tag, int m, int n, int p, const double *x,
+                   double **X, double *y, double **Y, int nthreads,
+                   int chunk) {
+#if defined(_OPENMP)
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+  const TapeInfos *tapeInfos = NULL;
+
+  nthreads = sweepWorkers(nthreads, p);
+  if (nthreads > 1)
+    tapeInfos = shareableTape(tag);
+
+  if (tapeInfos != NULL) {
+    if (chunk <= 0) {
+      const size_t lives =
+          std::max<size_t>(tapeInfos->stats[NUM_MAX_LIVES], 1);
+      chunk = (int)std::min<size_t>(
+          ADOLC_GLOBAL_TAPE_VARS.dirChunkSize / (lives * sizeof(double)),
+          (p + nthreads - 1) / nthreads);
+      chunk = std::max(chunk, 1);
+    }
+    const int numChunks = (p + chunk - 1) / chunk;
+    int rc = std::numeric_limits<int>::max();
+
+    ADOLC_parallel_doCopy = 0;
+#pragma omp parallel num_threads(nthreads) reduction(min : rc)
+    {
+      beginParallel();
+      TapeInfos *hidden;
+      TapeInfos *view = attachSharedTape(tapeInfos, &hidden);
+      /* all chunks compute y, only the first one stores it */
+      std::vector<double> result(m);
+
+#pragma omp for schedule(dynamic)
+      for (int c = 0; c < numChunks; ++c) {
+        const int offset = c * chunk;
+        MINDEC(rc, fov_offset_forward(tag, m, n, std::min(chunk, p - offset),
+                                      offset, x, X,
+                                      offset == 0 ? y : result.data(), Y));
+      }
+
+      detachSharedTape(view, hidden);
+      endParallel();
+    }
+    return rc;
+  }
+#else
+  (void)nthreads;
+#endif
+  if (chunk <= 0 || chunk >= p)
+    return fov_forward(tag, m, n, p, x, X, y, Y);
+  int rc = fov_offset_forward(tag, m, n, chunk, 0, x, X, y, Y);
+  for (int offset = chunk; offset < p; offset += chunk)
+    MINDEC(rc, fov_offset_forward(tag, m, n, std::min(chunk, p - offset),
+                                  offset, x, X, y, Y));
+  return rc;
+}
+
+/****************************************************************************/
+/* Higher-order vector forward mode with the p directions split into chunks */
+/* like in fov_forward_mt. Every chunk is one hov_forward sweep on the rows */
+/* of X and Y of its directions. If chunk <= 0, the chunk size is chosen    */
+/* such that the d Taylor coefficients of all live variables take about     */
+/* DIRCHUNKSIZE bytes, but every thread gets one chunk at least.            */
+/****************************************************************************/
+int hov_forward_mt(short tag, int m, int n, int d, int p, const double *x,
+                   double ***X, double *y, double ***Y, int nthreads,
+                   int chunk) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+  const TapeInfos *tapeInfos = NULL;
+
+  nthreads = sweepWorkers(nthreads, p);
+  if (nthreads > 1)
+    tapeInfos = shareableTape(tag);
+  if (chunk <= 0) {
+    if (tapeInfos == NULL)
+      return hov_forward(tag, m, n, d, p, x, X, y, Y);
+    const size_t lives =
+        std::max<size_t>(tapeInfos->stats[NUM_MAX_LIVES], 1);
+    chunk = (int)std::min<size_t>(ADOLC_GLOBAL_TAPE_VARS.dirChunkSize /
+                                      (lives * d * sizeof(double)),
+                                  (p + nthreads - 1) / nthreads);
+    chunk = std::max(chunk, 1);
+  }
+  if (chunk >= p)
+    return hov_forward(tag, m, n, d, p, x, X, y, Y);
+  int rc = std::numeric_limits<int>::max();
+
+#if defined(_OPENMP)
+  if (tapeInfos != NULL) {
+    const int numChunks = (p + chunk - 1) / chunk;
+
+    ADOLC_parallel_doCopy = 0;
+#pragma omp parallel num_threads(nthreads) reduction(min : rc)
+    {
+      beginParallel();
+      TapeInfos *hidden;
+      TapeInfos *view = attachSharedTape(tapeInfos, &hidden);
+      /* rows of X and Y of a chunk, all chunks compute y */
+      std::vector<double **> rows(n + m);
+      std::vector<double> result(m);
+
+#pragma omp for schedule(dynamic)
+      for (int c = 0; c < numChunks; ++c) {
+        const int offset = c * chunk;
+        for (int i = 0; i < n; ++i)
+          rows[i] = X[i] + offset;
+        for (int j = 0; j < m; ++j)
+          rows[n + j] = Y[j] + offset;
+        MINDEC(rc, hov_forward(tag, m, n, d, std::min(chunk, p - offset), x,
+                               rows.data(), offset == 0 ? y : result.data(),
+                               rows.data() + n));
+      }
+
+      detachSharedTape(view, hidden);
+      endParallel();
+    }
+    return rc;
+  }
+#endif
+  std::vector<double **> rows(n + m);
+  for (int offset = 0; offset < p; offset += chunk) {
+    for (int i = 0; i < n; ++i)
+      rows[i] = X[i] + offset;
+    for (int j = 0; j < m; ++j)
+      rows[n + j] = Y[j] + offset;
+    MINDEC(rc, hov_forward(tag, m, n, d, std::min(chunk, p - offset), x,
+                           rows.data(), y, rows.data() + n));
+  }
+  return rc;
+}
+
+END_C_DECLS
@@ -0,0 +1,605 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     sparse/coloring.cpp
+ Revision: $Id$
+ Contents: graph colorings of sparse Jacobians and Hessians and the recovery
+           of their nonzeros from the compressed matrices, operating on the
+           compressed row storage of the sparsity patterns (used without
+           ColPack)
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#include "coloring.h"
+
+#include <adolc/adalloc.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+#if defined(_OPENMP)
+#include "taping_p.h"
+#include <omp.h>
+#endif
+
+namespace {
+
+/* a pattern in compressed storage, the indices of row i are             */
+/* idx[start[i]], ..., idx[start[i+1]-1]                                  */
+struct Pattern {
+  std::vector<unsigned int> start, idx;
+};
+
+/*--------------------------------------------------------------------------*/
+/* column-wise storage of the m x n pattern JP */
+Pattern transposed(int m, int n, unsigned int **JP) {
+  Pattern t;
+
+  t.start.assign(n + 1, 0);
+  for (int i = 0; i < m; ++i)
+    for (unsigned int k = 1; k <= JP[i][0]; ++k)
+      ++t.start[JP[i][k] + 1];
+  for (int j = 0; j < n; ++j)
+    t.start[j + 1] += t.start[j];
+
+  std::vector<unsigned int> pos(t.start.begin(), t.start.end() - 1);
+  t.idx.resize(t.start[n]);
+  for (int i = 0; i < m; ++i)
+    for (unsigned int k = 1; k <= JP[i][0]; ++k)
+      t.idx[pos[JP[i][k]]++] = i;
+  return t;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Neighbours of the vertices of the colored graphs, neighbours(v, f)       */
+/* calls f(u) for every neighbour u of v, possibly several times and for    */
+/* u == v.                                                                  */
+
+/* columns sharing a row with column j */
+struct ColumnNeighbours {
+  unsigned int **JP;
+  const Pattern &cols;
+
+  template <class F> void operator()(int j, F &&f) const {
+    for (unsigned int k = cols.start[j]; k < cols.start[j + 1]; ++k) {
+      const unsigned int *row = JP[cols.idx[k]];
+      for (unsigned int l = 1; l <= row[0]; ++l)
+        f((int)row[l]);
+    }
+  }
+};
+
+/* rows sharing a column with row i */
+struct RowNeighbours {
+  unsigned int **JP;
+  const Pattern &cols;
+
+  template <class F> void operator()(int i, F &&f) const {
+    for (unsigned int l = 1; l <= JP[i][0]; ++l) {
+      const unsigned int j = JP[i][l];
+      for (unsigned int k = cols.start[j]; k < cols.start[j + 1]; ++k)
+        f((int)cols.idx[k]);
+    }
+  }
+};
+
+/* adjacent variables of a symmetric pattern */
+struct AdjacentVariables {
+  unsigned int **HP;
+
+  template <class F> void operator()(int v, F &&f) const {
+    for (unsigned int l = 1; l <= HP[v][0]; ++l)
+      f((int)HP[v][l]);
+  }
+};
+
+/****************************************************************************/
+/* Smallest-last ordering: the vertex of minimal degree in the remaining    */
+/* graph is removed repeatedly and placed in front of the vertices removed  */
+/* before. The degrees are kept in buckets of doubly linked lists.          */
+/****************************************************************************/
+template <class Neighbours>
+std::vector<int> smallestLastOrder(int n, const Neighbours &neighbours) {
+  std::vector<int> deg(n, 0), mark(n, -1);
+  int maxDeg = 0;
+
+  for (int v = 0; v < n; ++v) {
+    neighbours(v, [&](int u) {
+      if (u != v && mark[u] != v) {
+        mark[u] = v;
+        ++deg[v];
+      }
+    });
+    maxDeg = std::max(maxDeg, deg[v]);
+  }
+
+  std::vector<int> head(maxDeg + 1, -1), next(n), prev(n);
+  auto link = [&](int v) {
+    next[v] = head[deg[v]];
+    prev[v] = -1;
+    if (head[deg[v]] >= 0)
+      prev[head[deg[v]]] = v;
+    head[deg[v]] = v;
+  };
+  auto unlink = [&](int v) {
+    if (prev[v] >= 0)
+      next[prev[v]] = next[v];
+    else
+      head[deg[v]] = next[v];
+    if (next[v] >= 0)
+      prev[next[v]] = prev[v];
+  };
+  for (int v = 0; v < n; ++v)
+    link(v);
+
+  std::vector<char> removed(n, 0);
+  std::vector<int> order(n);
+  int minDeg = 0;
+  for (int k = n - 1; k >= 0; --k) {
+    while (head[minDeg] < 0)
+      ++minDeg;
+    const int v = head[minDeg];
+    unlink(v);
+    removed[v] = 1;
+    order[k] = v;
+    /* the marks n + k differ from the vertex marks above */
+    neighbours(v, [&](int u) {
+      if (u != v && !removed[u] && mark[u] != n + k) {
+        mark[u] = n + k;
+        unlink(u);
+        --deg[u];
+        link(u);
+        minDeg = std::min(minDeg, deg[u]);
+      }
+    });
+  }
+  return order;
+}
+
+/*--------------------------------------------------------------------------*/
+/* greedy coloring in the given order, every vertex gets the smallest color */
+/* none of its neighbours has                                               */
+template <class Neighbours>
+int greedyColoring(int n, const std::vector<int> &order,
+                   const Neighbours &neighbours, std::vector<int> &color) {
+  std::vector<int> forbidden;
+
+  color.assign(n, -1);
+  for (int v : order) {
+    neighbours(v, [&](int u) {
+      if (color[u] >= 0)
+        forbidden[color[u]] = v;
+    });
+    int c = 0;
+    while (c < (int)forbidden.size() && forbidden[c] == v)
+      ++c;
+    if (c == (int)forbidden.size())
+      forbidden.push_back(-1);
+    color[v] = c;
+  }
+  return (int)forbidden.size();
+}
+
+/****************************************************************************/
+/* Disjoint sets of the two-colored subgraphs of an acyclic coloring. The   */
+/* set of vertex v in the subgraph of the colors color[v] and d is kept     */
+/* under the key (v, d), keys without a set denote single vertices.         */
+/****************************************************************************/
+class TwoColoredForest {
+public:
+  /* root of the set of (v, d), or -1 for a single vertex */
+  int find(int v, int d) {
+    const auto it = node_.find(key(v, d));
+    return it == node_.end() ? -1 : root(it->second);
+  }
+
+  /* joins the sets of (v, d) and (w, c) by the edge v - w */
+  void join(int v, int d, int w, int c) {
+    const int a = root(node(v, d)), b = root(node(w, c));
+    if (a != b)
+      parent_[a] = b;
+  }
+
+private:
+  static uint64_t key(int v, int d) {
+    return ((uint64_t)(unsigned int)v << 32) | (unsigned int)d;
+  }
+  int node(int v, int d) {
+    const auto ins = node_.emplace(key(v, d), (int)parent_.size());
+    if (ins.second)
+      parent_.push_back(ins.first->second);
+    return ins.first->second;
+  }
+  int root(int x) {
+    while (parent_[x] != x)
+      x = parent_[x] = parent_[parent_[x]];
+    return x;
+  }
+
+  std::unordered_map<uint64_t, int> node_;
+  std::vector<int> parent_;
+};
+
+#if defined(_OPENMP)
+/*--------------------------------------------------------------------------*/
+/* speculative greedy coloring of n vertices by nthreads OpenMP threads */
+template <class Neighbours>
+int speculativeColoring(int n, const Neighbours &neighbours,
+                        std::vector<int> &color, int nthreads) {
+  std::vector<int> pending(n), conflicts;
+  int p = 0;
+
+  color.assign(n, -1);
+  for (int v = 0; v < n; ++v)
+    pending[v] = v;
+
+  while (!pending.empty()) {
+    const int numPending = (int)pending.size();
+    std::vector<char> recolor(numPending, 0);
+
+#pragma omp parallel num_threads(nthreads)
+    {
+      std::vector<int> forbidden;
+
+#pragma omp for schedule(dynamic, 64)
+      for (int k = 0; k < numPending; ++k) {
+        const int v = pending[k];
+        neighbours(v, [&](int u) {
+          int cu;
+#pragma omp atomic read
+          cu = color[u];
+          if (u != v && cu >= 0) {
+            if (cu >= (int)forbidden.size())
+              forbidden.resize(cu + 1, -1);
+            forbidden[cu] = v;
+          }
+        });
+        int c = 0;
+        while (c < (int)forbidden.size() && forbidden[c] == v)
+          ++c;
+#pragma omp atomic write
+        color[v] = c;
+      }
+
+#pragma omp for schedule(dynamic, 64)
+      for (int k = 0; k < numPending; ++k) {
+        const int v = pending[k];
+        neighbours(v, [&](int u) {
+          if (u < v && color[u] == color[v])
+            recolor[k] = 1;
+        });
+      }
+    }
+
+    conflicts.clear();
+    for (int k = 0; k < numPending; ++k)
+      if (recolor[k]) {
+        conflicts.push_back(pending[k]);
+        color[pending[k]] = -1;
+      }
+    pending.swap(conflicts);
+  }
+
+  for (int v = 0; v < n; ++v)
+    p = std::max(p, color[v] + 1);
+  return p;
+}
+#endif
+
+/*--------------------------------------------------------------------------*/
+/* position of the upper triangle entries of HP in the recovered values */
+template <class Store>
+void forUpperTriangle(int n, unsigned int **HP, Store &&store) {
+  int k = 0;
+  for (int i = 0; i < n; ++i)
+    for (unsigned int l = 1; l <= HP[i][0]; ++l)
+      if ((int)HP[i][l] >= i)
+        store(k++, i, (int)HP[i][l]);
+}
+
+} // namespace
+
+/****************************************************************************/
+/*                                                       JACOBIAN COLORINGS */
+
+/*--------------------------------------------------------------------------*/
+int colorJacColumns(int m, int n, unsigned int **JP, std::vector<int> &color) {
+  const Pattern cols = transposed(m, n, JP);
+  const ColumnNeighbours neighbours{JP, cols};
+
+  return greedyColoring(n, smallestLastOrder(n, neighbours), neighbours,
+                        color);
+}
+
+/*--------------------------------------------------------------------------*/
+int colorJacRows(int m, int n, unsigned int **JP, std::vector<int> &color) {
+  const Pattern cols = transposed(m, n, JP);
+  const RowNeighbours neighbours{JP, cols};
+
+  return greedyColoring(m, smallestLastOrder(m, neighbours), neighbours,
+                        color);
+}
+
+/*--------------------------------------------------------------------------*/
+/* Every round colors the remaining vertices concurrently with the colors   */
+/* of the others known so far. Neighbours of equal color are found          */
+/* afterwards, the one of larger index is colored again in the next round.  */
+int colorJacParallel(int m, int n, unsigned int **JP, bool rows,
+                     std::vector<int> &color, int nthreads) {
+#if defined(_OPENMP)
+  if (nthreads <= 0)
+    nthreads = std::min(omp_get_max_threads(), maxParallelThreads());
+  if (nthreads > 1 && !omp_in_parallel()) {
+    const Pattern cols = transposed(m, n, JP);
+    if (rows)
+      return speculativeColoring(m, RowNeighbours{JP, cols}, color, nthreads);
+    return speculativeColoring(n, ColumnNeighbours{JP, cols}, color,
+                               nthreads);
+  }
+#else
+  (void)nthreads;
+#endif
+  return rows ? colorJacRows(m, n, JP, color)
+              : colorJacColumns(m, n, JP, color);
+}
+
+/****************************************************************************/
+/*                                                        HESSIAN COLORINGS */
+
+/*--------------------------------------------------------------------------*/
+/* Star coloring of Gebremedhin, Manne and Pothen (SIAM Review 47, 2005,    */
+/* Algorithm 4.1): besides the colors of the neighbours w of v, the color   */
+/* of a vertex x at distance two is forbidden if w is not colored yet or    */
+/* if x has another neighbour of the color of w. Then every path on four    */
+/* vertices has three colors at least.                                      */
+int colorHessStar(int n, unsigned int **HP, std::vector<int> &color) {
+  const AdjacentVariables neighbours{HP};
+  const std::vector<int> order = smallestLastOrder(n, neighbours);
+  std::vector<int> forbidden;
+
+  color.assign(n, -1);
+  for (int v : order) {
+    auto forbid = [&](int c) {
+      if (c >= (int)forbidden.size())
+        forbidden.resize(c + 1, -1);
+      forbidden[c] = v;
+    };
+    neighbours(v, [&](int w) {
+      if (w == v)
+        return;
+      if (color[w] >= 0)
+        forbid(color[w]);
+      neighbours(w, [&](int x) {
+        if (x == w || x == v || color[x] < 0)
+          return;
+        if (color[w] < 0) {
+          forbid(color[x]);
+          return;
+        }
+        bool bicolored = false;
+        neighbours(x, [&](int y) {
+          bicolored |= y != x && y != w && color[y] == color[w];
+        });
+        if (bicolored)
+          forbid(color[x]);
+      });
+    });
+    int c = 0;
+    while (c < (int)forbidden.size() && forbidden[c] == v)
+      ++c;
+    color[v] = c;
+  }
+
+  int p = 0;
+  for (int v = 0; v < n; ++v)
+    p = std::max(p, color[v] + 1);
+  return p;
+}
+
+/*--------------------------------------------------------------------------*/
+/* Acyclic coloring: v gets the smallest color c none of its neighbours     */
+/* has and for which no two neighbours of the same color d are connected    */
+/* in the subgraph of the colors c and d, otherwise v would close a cycle   */
+/* of two colors. The subgraphs are forests kept as disjoint sets.          */
+int colorHessAcyclic(int n, unsigned int **HP, std::vector<int> &color) {
+  const AdjacentVariables neighbours{HP};
+  const std::vector<int> order = smallestLastOrder(n, neighbours);
+  TwoColoredForest forest;
+  std::vector<int> forbidden, seen, coloredNeighbours;
+  std::vector<int> roots;
+  int p = 0;
+
+  color.assign(n, -1);
+  for (int v : order) {
+    coloredNeighbours.clear();
+    neighbours(v, [&](int w) {
+      if (w != v && color[w] >= 0) {
+        coloredNeighbours.push_back(w);
+        if (color[w] >= (int)forbidden.size())
+          forbidden.resize(color[w] + 1, -1);
+        forbidden[color[w]] = v;
+      }
+    });
+
+    int c = 0;
+    for (;; ++c) {
+      if (c < (int)forbidden.size() && forbidden[c] == v)
+        continue;
+      /* neighbours of equal color in the same tree of colors c, d */
+      roots.clear();
+      for (int w : coloredNeighbours) {
+        const int r = forest.find(w, c);
+        if (r >= 0)
+          roots.push_back(r);
+      }
+      std::sort(roots.begin(), roots.end());
+      if (std::adjacent_find(roots.begin(), roots.end()) == roots.end())
+        break;
+    }
+    color[v] = c;
+    p = std::max(p, c + 1);
+    for (int w : coloredNeighbours)
+      forest.join(v, color[w], w, c);
+  }
+  return p;
+}
+
+/****************************************************************************/
+/*                                                                 RECOVERY */
+
+/*--------------------------------------------------------------------------*/
+void recoverJac(int m, unsigned int **JP, const std::vector<int> &color,
+                bool rows, double **B, unsigned int *rind, unsigned int *cind,
+                double *values) {
+  int k = 0;
+
+  for (int i = 0; i < m; ++i)
+    for (unsigned int l = 1; l <= JP[i][0]; ++l, ++k) {
+      const unsigned int j = JP[i][l];
+      values[k] = rows ? B[color[i]][j] : B[i][color[j]];
+      if (rind != nullptr)
+        rind[k] = i;
+      if (cind != nullptr)
+        cind[k] = j;
+    }
+}
+
+/*--------------------------------------------------------------------------*/
+/* With a star coloring, H_ij is the only entry of color[j] in row i, or    */
+/* H_ji the only entry of color[i] in row j.                                */
+void recoverHessStar(int n, unsigned int **HP, const std::vector<int> &color,
+                     double **Hcomp, unsigned int *rind, unsigned int *cind,
+                     double *values) {
+  forUpperTriangle(n, HP, [&](int k, int i, int j) {
+    int count = 0;
+    for (unsigned int l = 1; l <= HP[i][0]; ++l)
+      count += color[HP[i][l]] == color[j];
+    values[k] = count == 1 ? Hcomp[i][color[j]] : Hcomp[j][color[i]];
+    if (rind != nullptr)
+      rind[k] = i;
+    if (cind != nullptr)
+      cind[k] = j;
+  });
+}
+
+/*--------------------------------------------------------------------------*/
+/* With an acyclic coloring, the edges between the vertices of two colors a */
+/* and b form a forest. Hcomp[i][b] is the sum of H_ij over the neighbours  */
+/* j of color b, hence the entry of a leaf i is its residual, which is then */
+/* subtracted from the residual of its neighbour before the leaf is         */
+/* removed.                                                                 */
+void recoverHessAcyclic(int n, unsigned int **HP,
+                        const std::vector<int> &color, double **Hcomp,
+                        unsigned int *rind, unsigned int *cind,
+                        double *values) {
+  struct Edge {
+    int pair, i, j, k;
+  };
+  std::unordered_map<uint64_t, int> pairs;
+  std::vector<Edge> edges;
+
+  forUpperTriangle(n, HP, [&](int k, int i, int j) {
+    if (rind != nullptr)
+      rind[k] = i;
+    if (cind != nullptr)
+      cind[k] = j;
+    if (i == j) {
+      values[k] = Hcomp[i][color[i]];
+      return;
+    }
+    const unsigned int a = std::min(color[i], color[j]);
+    const unsigned int b = std::max(color[i], color[j]);
+    const auto ins =
+        pairs.emplace(((uint64_t)a << 32) | b, (int)pairs.size());
+    edges.push_back({ins.first->second, i, j, k});
+  });
+
+  /* the edges of every pair of colors, one forest after the other */
+  std::vector<int> start(pairs.size() + 1, 0), byPair(edges.size());
+  for (const Edge &e : edges)
+    ++start[e.pair + 1];
+  for (size_t q = 0; q < pairs.size(); ++q)
+    start[q + 1] += start[q];
+  {
+    std::vector<int> pos(start.begin(), start.end() - 1);
+    for (int e = 0; e < (int)edges.size(); ++e)
+      byPair[pos[edges[e].pair]++] = e;
+  }
+
+  std::unordered_map<int, int> local;
+  std::vector<int> degree, adjStart, adj, leaves;
+  std::vector<double> residual;
+  std::vector<char> done;
+  for (size_t q = 0; q < pairs.size(); ++q) {
+    const int first = start[q], last = start[q + 1];
+
+    local.clear();
+    for (int s = first; s < last; ++s) {
+      const Edge &e = edges[byPair[s]];
+      local.emplace(e.i, (int)local.size());
+      local.emplace(e.j, (int)local.size());
+    }
+    const int nv = (int)local.size();
+    std::vector<int> vertex(nv);
+    for (const auto &lv : local)
+      vertex[lv.second] = lv.first;
+
+    degree.assign(nv, 0);
+    for (int s = first; s < last; ++s) {
+      const Edge &e = edges[byPair[s]];
+      ++degree[local[e.i]];
+      ++degree[local[e.j]];
+    }
+    adjStart.assign(nv + 1, 0);
+    for (int v = 0; v < nv; ++v)
+      adjStart[v + 1] = adjStart[v] + degree[v];
+    adj.resize(adjStart[nv]);
+    {
+      std::vector<int> pos(adjStart.begin(), adjStart.end() - 1);
+      for (int s = first; s < last; ++s) {
+        const Edge &e = edges[byPair[s]];
+        adj[pos[local[e.i]]++] = s;
+        adj[pos[local[e.j]]++] = s;
+      }
+    }
+
+    residual.resize(nv);
+    for (int v = 0; v < nv; ++v) {
+      const int x = vertex[v];
+      const Edge &e = edges[byPair[adj[adjStart[v]]]];
+      residual[v] = Hcomp[x][color[e.i == x ? e.j : e.i]];
+    }
+
+    done.assign(last - first, 0);
+    leaves.clear();
+    for (int v = 0; v < nv; ++v)
+      if (degree[v] == 1)
+        leaves.push_back(v);
+    while (!leaves.empty()) {
+      const int v = leaves.back();
+      leaves.pop_back();
+      if (degree[v] != 1)
+        continue;
+      int s = adjStart[v];
+      while (done[adj[s] - first])
+        ++s;
+      const Edge &e = edges[byPair[adj[s]]];
+      const int u = local[e.i == vertex[v] ? e.j : e.i];
+      done[adj[s] - first] = 1;
+      values[e.k] = residual[v];
+      residual[u] -= residual[v];
+      degree[v] = 0;
+      if (--degree[u] == 1)
+        leaves.push_back(u);
+    }
+  }
+}
+
+/*--------------------------------------------------------------------------*/
+SparseColoring::~SparseColoring() {
+  if (Seed != nullptr)
+    myfree2(Seed);
+}
@@ -0,0 +1,80 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     sparse/coloring.h
+ Revision: $Id$
+ Contents: graph colorings of sparse Jacobians and Hessians and the recovery
+           of their nonzeros from the compressed matrices, operating on the
+           compressed row storage of the sparsity patterns (used without
+           ColPack)
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#if !defined(ADOLC_SPARSE_COLORING_H)
+#define ADOLC_SPARSE_COLORING_H 1
+
+#include <vector>
+
+/****************************************************************************/
+/* All patterns are given as in jac_pat and hess_pat, row i holds the       */
+/* indices crs[i][1], ..., crs[i][crs[i][0]]. The colorings return the      */
+/* number of colors p, color[j] is the color 0 <= color[j] < p of column    */
+/* (row) j. The sequential colorings visit the vertices in smallest-last    */
+/* order.                                                                   */
+
+/* partial distance-2 coloring of the columns of the m x n pattern JP, two  */
+/* columns get different colors if they have a nonzero in the same row      */
+int colorJacColumns(int m, int n, unsigned int **JP, std::vector<int> &color);
+/* partial distance-2 coloring of the rows of the m x n pattern JP */
+int colorJacRows(int m, int n, unsigned int **JP, std::vector<int> &color);
+/* the coloring of the columns (rows if rows is set) computed by nthreads   */
+/* OpenMP threads (all available ones if nthreads <= 0) by speculative      */
+/* greedy coloring in natural order                                         */
+int colorJacParallel(int m, int n, unsigned int **JP, bool rows,
+                     std::vector<int> &color, int nthreads);
+
+/* star coloring of the adjacency graph of the symmetric pattern HP, the    */
+/* nonzeros can be read directly from the compressed Hessian                */
+int colorHessStar(int n, unsigned int **HP, std::vector<int> &color);
+/* acyclic coloring of the adjacency graph of HP, the nonzeros are          */
+/* recovered by substitution                                                */
+int colorHessAcyclic(int n, unsigned int **HP, std::vector<int> &color);
+
+/****************************************************************************/
+/* The recovery stores the nonzeros in the order of the pattern in values,  */
+/* for Hessians only the upper triangle HP[i][k] >= i. If rind and cind are */
+/* not NULL, they are set to the row and column indices.                    */
+
+/* B is the m x p compressed Jacobian of a column coloring, or the p x n    */
+/* compressed Jacobian of a row coloring if rows is set                     */
+void recoverJac(int m, unsigned int **JP, const std::vector<int> &color,
+                bool rows, double **B, unsigned int *rind, unsigned int *cind,
+                double *values);
+/* Hcomp is the n x p compressed Hessian of a star coloring */
+void recoverHessStar(int n, unsigned int **HP, const std::vector<int> &color,
+                     double **Hcomp, unsigned int *rind, unsigned int *cind,
+                     double *values);
+/* Hcomp is the n x p compressed Hessian of an acyclic coloring */
+void recoverHessAcyclic(int n, unsigned int **HP,
+                        const std::vector<int> &color, double **Hcomp,
+                        unsigned int *rind, unsigned int *cind,
+                        double *values);
+
+/****************************************************************************/
+/* Coloring of sparse_jac and sparse_hess kept in the void pointer "g" of   */
+/* SparseJacInfos and SparseHessInfos if ADOL-C is built without ColPack.   */
+/* The seed matrix is allocated by myalloc2 and owned by the coloring.      */
+struct SparseColoring {
+  std::vector<int> color;
+  int p;
+  double **Seed;
+
+  SparseColoring() : p(0), Seed(nullptr) {}
+  ~SparseColoring();
+  SparseColoring(const SparseColoring &) = delete;
+  SparseColoring &operator=(const SparseColoring &) = delete;
+};
+
+#endif /* ADOLC_SPARSE_COLORING_H */
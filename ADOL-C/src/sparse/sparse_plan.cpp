@@ -0,0 +1,460 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     sparse/sparse_plan.cpp
+ Revision: $Id$
+ Contents: reusable plans of sparse Jacobians and Hessians (sparsity
+           pattern, coloring, seed matrix and recovery), independent of the
+           tape they were computed for
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+#include "dvlparms.h"
+#include "taping_p.h"
+
+#include <adolc/adalloc.h>
+#include <adolc/interfaces.h>
+#include <adolc/sparse/sparsedrivers.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+enum { planJacColumns = 0, planJacRows = 1, planHess = 2 };
+
+/****************************************************************************/
+/* The plan stores the nonzeros in coordinate format, the color of every    */
+/* column (Jacobian, column compression), row (Jacobian, row compression)   */
+/* or variable (Hessian) and for every nonzero the entry of the compressed  */
+/* matrix it is read from. The seed matrix and the compressed matrix are    */
+/* allocated once and reused by every evaluation.                           */
+/****************************************************************************/
+struct SparsePlan {
+  int kind;
+  int m, n, p;
+  std::vector<unsigned int> rind, cind;
+  std::vector<int> color;
+  std::vector<unsigned int> compRow, compCol;
+
+  /* workspace of sparse_plan_eval */
+  double **seed;
+  double **comp; /* Jacobian times seed or seed times Jacobian */
+  double *y;
+  double ***Xppp, ***Yppp, ***Zppp; /* Hessian */
+  double **Upp;
+};
+
+namespace {
+
+const char planMagic[8] = {'A', 'D', 'O', 'L', 'C', 'S', 'P', 'P'};
+const int planVersion = 1;
+
+struct PlanHeader {
+  char magic[8];
+  int version;
+  int kind, m, n, p, nnz;
+};
+
+/* the entry of row "row" whose column has color "c" is unique */
+bool uniqueColor(unsigned int **pattern, const std::vector<int> &color,
+                 unsigned int row, int c) {
+  int count = 0;
+  for (unsigned int k = 1; k <= pattern[row][0]; ++k)
+    count += color[pattern[row][k]] == c;
+  return count <= 1;
+}
+
+void freePattern(unsigned int **pattern, int rows) {
+  for (int i = 0; i < rows; ++i)
+    free(pattern[i]);
+  free(pattern);
+}
+
+/* seed matrix and workspace for the colors of the plan */
+void allocWorkspace(SparsePlan *plan) {
+  const int p = plan->p > 0 ? plan->p : 1;
+
+  plan->y = myalloc1(plan->m);
+  plan->comp = NULL;
+  plan->Xppp = plan->Yppp = plan->Zppp = NULL;
+  plan->Upp = NULL;
+  switch (plan->kind) {
+  case planJacColumns:
+    plan->seed = myalloc2(plan->n, p);
+    plan->comp = myalloc2(plan->m, p);
+    for (int j = 0; j < plan->n; ++j)
+      for (int c = 0; c < p; ++c)
+        plan->seed[j][c] = plan->color[j] == c ? 1.0 : 0.0;
+    break;
+  case planJacRows:
+    plan->seed = myalloc2(p, plan->m);
+    plan->comp = myalloc2(p, plan->n);
+    for (int c = 0; c < p; ++c)
+      for (int i = 0; i < plan->m; ++i)
+        plan->seed[c][i] = plan->color[i] == c ? 1.0 : 0.0;
+    break;
+  default:
+    plan->seed = NULL;
+    plan->Xppp = myalloc3(plan->n, p, 1);
+    plan->Yppp = myalloc3(1, p, 1);
+    plan->Zppp = myalloc3(p, plan->n, 2);
+    plan->Upp = myalloc2(1, 2);
+    plan->Upp[0][0] = 1;
+    plan->Upp[0][1] = 0;
+    for (int j = 0; j < plan->n; ++j)
+      for (int c = 0; c < p; ++c)
+        plan->Xppp[j][c][0] = plan->color[j] == c ? 1.0 : 0.0;
+    break;
+  }
+}
+
+/* all colors and indices read from a file lie within the dimensions of the
+ * plan, such that sparse_plan_eval stays within the workspace */
+bool validPlan(const SparsePlan *plan) {
+  const unsigned int m = plan->m, n = plan->n, p = plan->p;
+  const unsigned int rows = plan->kind == planHess ? n : m;
+
+  if (plan->kind == planHess && m != 1)
+    return false;
+  if (p > plan->color.size())
+    return false;
+  for (size_t i = 0; i < plan->color.size(); ++i)
+    if (plan->color[i] < 0 || (unsigned int)plan->color[i] >= (p > 0 ? p : 1))
+      return false;
+  for (size_t k = 0; k < plan->rind.size(); ++k) {
+    if (plan->rind[k] >= rows || plan->cind[k] >= n)
+      return false;
+    if (p == 0)
+      continue;
+    switch (plan->kind) {
+    case planJacColumns:
+      if (plan->compRow[k] >= m || plan->compCol[k] >= p)
+        return false;
+      break;
+    case planJacRows:
+      if (plan->compRow[k] >= p || plan->compCol[k] >= n)
+        return false;
+      break;
+    default:
+      if (plan->compRow[k] >= n || plan->compCol[k] >= p)
+        return false;
+      break;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+BEGIN_C_DECLS
+
+/****************************************************************************/
+/* Plan of the sparse Jacobian of tape "tag" at x: the pattern is computed  */
+/* by jac_pat with options[0..2], the coloring by generate_seed_jac with    */
+/* options[3] (0 - column compression, 1 - row compression). Returns NULL   */
+/* if the pattern cannot be computed.                                       */
+/****************************************************************************/
+SparsePlan *sparse_jac_plan(short tag, int m, int n, const double *x,
+                            int *options) {
+  unsigned int **JP;
+  double **Seed;
+  int p;
+
+  JP = (unsigned int **)malloc(m * sizeof(unsigned int *));
+  if (JP == NULL)
+    fail(ADOLC_MALLOC_FAILED);
+  if (jac_pat(tag, m, n, x, JP, options) < 0) {
+    fprintf(DIAG_OUT, "ADOL-C error in sparse_jac_plan(): no sparsity "
+                      "pattern\n");
+    free(JP);
+    return NULL;
+  }
+  const bool rows = options[3] == 1;
+  generate_seed_jac(m, n, JP, &Seed, &p, rows ? 1 : 0);
+
+  SparsePlan *plan = new SparsePlan;
+  plan->kind = rows ? planJacRows : planJacColumns;
+  plan->m = m;
+  plan->n = n;
+  plan->p = p;
+  plan->color.assign(rows ? m : n, 0);
+  for (int i = 0; i < (rows ? p : n); ++i)
+    for (int j = 0; j < (rows ? m : p); ++j)
+      if (Seed[i][j] != 0.0)
+        plan->color[rows ? j : i] = rows ? i : j;
+
+  /* every column (row) of a color group intersects the pattern of a row
+   * (column) at most once, the compressed entry is the nonzero itself */
+  for (int i = 0; i < m; ++i)
+    for (unsigned int k = 1; k <= JP[i][0]; ++k) {
+      const unsigned int j = JP[i][k];
+      plan->rind.push_back(i);
+      plan->cind.push_back(j);
+      plan->compRow.push_back(rows ? plan->color[i] : i);
+      plan->compCol.push_back(rows ? j : plan->color[j]);
+    }
+
+  for (int i = 0; i < (rows ? p : n); ++i)
+    delete[] Seed[i];
+  delete[] Seed;
+  freePattern(JP, m);
+  allocWorkspace(plan);
+  return plan;
+}
+
+/****************************************************************************/
+/* Plan of the sparse Hessian of tape "tag" at x: the pattern is computed   */
+/* by hess_pat with options[0], the coloring by generate_seed_hess. The     */
+/* plan recovers the entries directly, hence it always uses the star        */
+/* coloring of direct recovery and ignores options[1]. The upper triangle   */
+/* is stored, rind[k] <= cind[k].                                           */
+/****************************************************************************/
+SparsePlan *sparse_hess_plan(short tag, int n, const double *x,
+                             int *options) {
+  unsigned int **HP;
+  double **Seed;
+  int p;
+
+  HP = (unsigned int **)malloc(n * sizeof(unsigned int *));
+  if (HP == NULL)
+    fail(ADOLC_MALLOC_FAILED);
+  if (hess_pat(tag, n, x, HP, options[0]) < 0) {
+    fprintf(DIAG_OUT, "ADOL-C error in sparse_hess_plan(): no sparsity "
+                      "pattern\n");
+    free(HP);
+    return NULL;
+  }
+  generate_seed_hess(n, HP, &Seed, &p, 1);
+
+  SparsePlan *plan = new SparsePlan;
+  plan->kind = planHess;
+  plan->m = 1;
+  plan->n = n;
+  plan->p = p;
+  plan->color.assign(n, 0);
+  for (int i = 0; i < n; ++i)
+    for (int c = 0; c < p; ++c)
+      if (Seed[i][c] != 0.0)
+        plan->color[i] = c;
+
+  /* with a star coloring, H_ij can be read from row i or from row j */
+  for (int i = 0; i < n; ++i)
+    for (unsigned int k = 1; k <= HP[i][0]; ++k) {
+      const unsigned int j = HP[i][k];
+      if ((int)j < i)
+        continue;
+      plan->rind.push_back(i);
+      plan->cind.push_back(j);
+      if (uniqueColor(HP, plan->color, i, plan->color[j])) {
+        plan->compRow.push_back(i);
+        plan->compCol.push_back(plan->color[j]);
+      } else {
+        plan->compRow.push_back(j);
+        plan->compCol.push_back(plan->color[i]);
+      }
+    }
+
+  for (int i = 0; i < n; ++i)
+    delete[] Seed[i];
+  delete[] Seed;
+  freePattern(HP, n);
+  allocWorkspace(plan);
+  return plan;
+}
+
+/****************************************************************************/
+/* Number of nonzeros of the plan, rind and cind (if not NULL) are set to   */
+/* the row and column indices owned by the plan.                            */
+/****************************************************************************/
+int sparse_plan_nnz(const SparsePlan *plan, const unsigned int **rind,
+                    const unsigned int **cind) {
+  if (rind != NULL)
+    *rind = plan->rind.data();
+  if (cind != NULL)
+    *cind = plan->cind.data();
+  return (int)plan->rind.size();
+}
+
+/****************************************************************************/
+/* Values of the nonzeros of the plan for tape "tag" at x, which may be any */
+/* tape of the same structure as the one the plan was computed for. The    */
+/* workspace of the plan is reused, hence a plan must not be evaluated by   */
+/* several threads at once. Returns the return code of the sweeps.          */
+/****************************************************************************/
+int sparse_plan_eval(const SparsePlan *plan, short tag, const double *x,
+                     double *values) {
+  size_t stats[STAT_SIZE];
+  const size_t nnz = plan->rind.size();
+  int rc;
+
+  tapestats(tag, stats);
+  if (stats[NUM_INDEPENDENTS] != (size_t)plan->n ||
+      stats[NUM_DEPENDENTS] != (size_t)plan->m) {
+    fprintf(DIAG_OUT, "ADOL-C error in sparse_plan_eval(): tape %d does not "
+                      "match the dimensions of the plan\n",
+            tag);
+    return -1;
+  }
+  if (plan->p == 0) {
+    for (size_t k = 0; k < nnz; ++k)
+      values[k] = 0.0;
+    return zos_forward(tag, plan->m, plan->n, 0, x, plan->y);
+  }
+
+  switch (plan->kind) {
+  case planJacColumns:
+    rc = fov_forward(tag, plan->m, plan->n, plan->p, x, plan->seed, plan->y,
+                     plan->comp);
+    for (size_t k = 0; k < nnz; ++k)
+      values[k] = plan->comp[plan->compRow[k]][plan->compCol[k]];
+    break;
+  case planJacRows:
+    rc = zos_forward(tag, plan->m, plan->n, 1, x, plan->y);
+    if (rc < 0)
+      return rc;
+    MINDEC(rc, fov_reverse(tag, plan->m, plan->n, plan->p, plan->seed,
+                           plan->comp));
+    for (size_t k = 0; k < nnz; ++k)
+      values[k] = plan->comp[plan->compRow[k]][plan->compCol[k]];
+    break;
+  default:
+    rc = hov_wk_forward(tag, 1, plan->n, 1, 2, plan->p, x, plan->Xppp,
+                        plan->y, plan->Yppp);
+    MINDEC(rc, hos_ov_reverse(tag, 1, plan->n, 1, plan->p, plan->Upp,
+                              plan->Zppp));
+    for (size_t k = 0; k < nnz; ++k)
+      values[k] = plan->Zppp[plan->compCol[k]][plan->compRow[k]][1];
+    break;
+  }
+  return rc;
+}
+
+/****************************************************************************/
+/* Writes the plan to file "name", returns 0 on success and -1 otherwise.  */
+/* The file is in the binary format of the machine it was written on.      */
+/****************************************************************************/
+int sparse_plan_write(const SparsePlan *plan, const char *name) {
+  PlanHeader header;
+  FILE *file = fopen(name, "wb");
+  bool error;
+
+  if (file == NULL)
+    return -1;
+  memcpy(header.magic, planMagic, sizeof(planMagic));
+  header.version = planVersion;
+  header.kind = plan->kind;
+  header.m = plan->m;
+  header.n = plan->n;
+  header.p = plan->p;
+  header.nnz = (int)plan->rind.size();
+  const size_t nnz = plan->rind.size();
+  error = fwrite(&header, sizeof(header), 1, file) != 1 ||
+          fwrite(plan->color.data(), sizeof(int), plan->color.size(), file) !=
+              plan->color.size() ||
+          fwrite(plan->rind.data(), sizeof(unsigned int), nnz, file) != nnz ||
+          fwrite(plan->cind.data(), sizeof(unsigned int), nnz, file) != nnz ||
+          fwrite(plan->compRow.data(), sizeof(unsigned int), nnz, file) !=
+              nnz ||
+          fwrite(plan->compCol.data(), sizeof(unsigned int), nnz, file) != nnz;
+  error |= fclose(file) != 0;
+  return error ? -1 : 0;
+}
+
+/****************************************************************************/
+/* Reads a plan written by sparse_plan_write, returns NULL if the file      */
+/* cannot be read, was not written by sparse_plan_write or holds colors and */
+/* indices outside the dimensions of the plan.                              */
+/****************************************************************************/
+SparsePlan *sparse_plan_read(const char *name) {
+  PlanHeader header;
+  FILE *file = fopen(name, "rb");
+  long start, end = -1;
+
+  if (file == NULL)
+    return NULL;
+  if (fread(&header, sizeof(header), 1, file) != 1 ||
+      memcmp(header.magic, planMagic, sizeof(planMagic)) != 0 ||
+      header.version != planVersion || header.kind < planJacColumns ||
+      header.kind > planHess || header.m < 0 || header.n < 0 ||
+      header.p < 0 || header.nnz < 0) {
+    fclose(file);
+    fprintf(DIAG_OUT, "ADOL-C error in sparse_plan_read(): %s is not a "
+                      "sparse plan\n",
+            name);
+    return NULL;
+  }
+
+  /* the size of the file has to match the header before anything is
+   * allocated for it */
+  const size_t nnz = header.nnz;
+  const size_t colors = header.kind == planJacRows ? header.m : header.n;
+  start = ftell(file);
+  if (start >= 0 && fseek(file, 0, SEEK_END) == 0)
+    end = ftell(file);
+  if (end < 0 || fseek(file, start, SEEK_SET) != 0 ||
+      (size_t)(end - start) !=
+          colors * sizeof(int) + 4 * nnz * sizeof(unsigned int)) {
+    fclose(file);
+    fprintf(DIAG_OUT, "ADOL-C error in sparse_plan_read(): %s is truncated\n",
+            name);
+    return NULL;
+  }
+
+  SparsePlan *plan = new SparsePlan;
+  plan->kind = header.kind;
+  plan->m = header.m;
+  plan->n = header.n;
+  plan->p = header.p;
+  plan->color.resize(colors);
+  plan->rind.resize(nnz);
+  plan->cind.resize(nnz);
+  plan->compRow.resize(nnz);
+  plan->compCol.resize(nnz);
+  const bool error =
+      fread(plan->color.data(), sizeof(int), plan->color.size(), file) !=
+          plan->color.size() ||
+      fread(plan->rind.data(), sizeof(unsigned int), nnz, file) != nnz ||
+      fread(plan->cind.data(), sizeof(unsigned int), nnz, file) != nnz ||
+      fread(plan->compRow.data(), sizeof(unsigned int), nnz, file) != nnz ||
+      fread(plan->compCol.data(), sizeof(unsigned int), nnz, file) != nnz;
+  fclose(file);
+  if (error) {
+    fprintf(DIAG_OUT, "ADOL-C error in sparse_plan_read(): %s is truncated\n",
+            name);
+    delete plan;
+    return NULL;
+  }
+  if (!validPlan(plan)) {
+    fprintf(DIAG_OUT, "ADOL-C error in sparse_plan_read(): %s holds indices "
+                      "outside the dimensions of the plan\n",
+            name);
+    delete plan;
+    return NULL;
+  }
+  allocWorkspace(plan);
+  return plan;
+}
+
+/****************************************************************************/
+/* Releases the plan and its workspace.                                     */
+/****************************************************************************/
+void sparse_plan_free(SparsePlan *plan) {
+  if (plan == NULL)
+    return;
+  myfree1(plan->y);
+  if (plan->seed != NULL)
+    myfree2(plan->seed);
+  if (plan->comp != NULL)
+    myfree2(plan->comp);
+  if (plan->Xppp != NULL) {
+    myfree3(plan->Xppp);
+    myfree3(plan->Yppp);
+    myfree3(plan->Zppp);
+    myfree2(plan->Upp);
+  }
+  delete plan;
+}
+
+END_C_DECLS
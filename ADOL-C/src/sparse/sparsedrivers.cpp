@@ -17,9 +17,12 @@
 #include "taping_p.h"
 
 #include <adolc/adalloc.h>
+#include <adolc/drivers/drivers.h>
 #include <adolc/interfaces.h>
 #include <adolc/sparse/sparsedrivers.h>
 
+#include "coloring.h"
+
 #if defined(ADOLC_INTERNAL)
 #if HAVE_CONFIG_H
 #include "config.h"
@@ -30,8 +33,15 @@
 #include <ColPack/ColPackHeaders.h>
 #endif
 
+#include <algorithm>
 #include <cstring>
+#include <limits>
 #include <math.h>
+#include <vector>
+
+#if defined(_OPENMP)
+#include <adolc/adolc_openmp.h>
+#endif
 
 #if HAVE_LIBCOLPACK
 using namespace ColPack;
@@ -39,6 +49,275 @@ using namespace ColPack;
 
 using namespace std;
 
+namespace {
+
+/****************************************************************************/
+/* Number of OpenMP threads that propagate numStrips independent strips of  */
+/* a sparsity pattern, 1 means serial propagation. The strips are swept     */
+/* over the shared tape, see shareableTape.                                 */
+/****************************************************************************/
+int patternWorkers(int numStrips) {
+#if defined(_OPENMP)
+  if (numStrips < 2 || omp_in_parallel())
+    return 1;
+  return std::max(1, std::min(std::min(omp_get_max_threads(), numStrips),
+                              maxParallelThreads()));
+#else
+  (void)numStrips;
+  return 1;
+#endif
+}
+
+/****************************************************************************/
+/* Number of unsigned longs of the strips that split the words of a seed    */
+/* or Jacobian bit pattern. The bit patterns of all live variables take     */
+/* about PQ_STRIPMINE_BYTES per strip, but a strip has PQ_STRIPMINE_MIN to  */
+/* PQ_STRIPMINE_MAX words and every thread gets one strip at least. The     */
+/* strips are multiples of PQ_STRIPMINE_ALIGN words, i.e. of the vector     */
+/* registers the kernels of int_forward_* and int_reverse_* use.            */
+/****************************************************************************/
+int stripWords(short tag, int words) {
+  size_t stats[STAT_SIZE];
+
+  tapestats(tag, stats);
+  const size_t lives = std::max<size_t>(stats[NUM_MAX_LIVES], 1);
+  const int workers = patternWorkers(words);
+  size_t strip = PQ_STRIPMINE_BYTES / (lives * sizeof(unsigned long int));
+
+  strip = std::min<size_t>(strip, (words + workers - 1) / workers);
+  strip = std::max<size_t>(strip, PQ_STRIPMINE_MIN);
+  strip = std::min<size_t>(strip, PQ_STRIPMINE_MAX);
+  if (strip > PQ_STRIPMINE_ALIGN)
+    strip -= strip % PQ_STRIPMINE_ALIGN;
+  return (size_t)words <= strip ? words : (int)strip;
+}
+
+/* the indices of row j of a strip are idx[start[j]], ..., idx[start[j+1]-1] */
+struct StripPattern {
+  std::vector<size_t> start;
+  std::vector<unsigned int> idx;
+};
+
+/****************************************************************************/
+/* Index domains of the independents split into one contiguous range per    */
+/* thread. Every range is propagated by indopro_offset_forward_* over the   */
+/* shared tape, the rows of the ranges are concatenated in crs.             */
+/****************************************************************************/
+int indexDomainPattern(short tag, int depen, int indep,
+                       const double *basepoint, unsigned int **crs,
+                       int tight_mode) {
+  const int bits_per_long = 8 * sizeof(unsigned long int);
+  const int workers = patternWorkers(indep / bits_per_long);
+  const TapeInfos *tapeInfos = NULL;
+
+  if (workers > 1)
+    tapeInfos = shareableTape(tag);
+  if (tapeInfos == NULL) {
+    if (tight_mode)
+      return indopro_forward_tight(tag, depen, indep, basepoint, crs);
+    return indopro_forward_safe(tag, depen, indep, basepoint, crs);
+  }
+
+  int rc = std::numeric_limits<int>::max();
+#if defined(_OPENMP)
+  const int chunk = (indep + workers - 1) / workers;
+  std::vector<std::vector<unsigned int *>> parts(
+      workers, std::vector<unsigned int *>(depen, (unsigned int *)NULL));
+
+  ADOLC_parallel_doCopy = 0;
+#pragma omp parallel num_threads(workers) reduction(min : rc)
+  {
+    beginParallel();
+    TapeInfos *hidden;
+    TapeInfos *view = attachSharedTape(tapeInfos, &hidden);
+
+    /* the team may be smaller than requested */
+#pragma omp for schedule(dynamic)
+    for (int c = 0; c < workers; ++c) {
+      const int offset = c * chunk;
+      const int count = std::min(chunk, indep - offset);
+      if (count <= 0)
+        continue;
+      if (tight_mode)
+        MINDEC(rc, indopro_offset_forward_tight(tag, depen, indep, offset,
+                                                count, basepoint,
+                                                parts[c].data()));
+      else
+        MINDEC(rc, indopro_offset_forward_safe(tag, depen, indep, offset,
+                                               count, basepoint,
+                                               parts[c].data()));
+    }
+
+    detachSharedTape(view, hidden);
+    endParallel();
+  }
+
+  for (int j = 0; j < depen; ++j) {
+    unsigned int k = 0;
+    for (int c = 0; c < workers; ++c)
+      if (parts[c][j] != NULL)
+        k += parts[c][j][0];
+    crs[j] = (unsigned int *)malloc((k + 1) * sizeof(unsigned int));
+    crs[j][0] = k;
+    k = 1;
+    for (int c = 0; c < workers; ++c)
+      if (parts[c][j] != NULL) {
+        memcpy(crs[j] + k, parts[c][j] + 1,
+               parts[c][j][0] * sizeof(unsigned int));
+        k += parts[c][j][0];
+        free(parts[c][j]);
+      }
+  }
+#endif
+  return rc;
+}
+
+/****************************************************************************/
+/* Forward bit pattern propagation of the independents of strip strip_idx,  */
+/* i.e. p_stripmine unsigned longs of bits, the pattern is stored in strip. */
+/****************************************************************************/
+int forwardStrip(short tag, int depen, int indep, int p_stripmine,
+                 int strip_idx, char tight_mode, const double *basepoint,
+                 unsigned long int **seed, unsigned long int **jac_bit_pat,
+                 StripPattern &strip) {
+  const int bits_per_long = 8 * sizeof(unsigned long int);
+  const unsigned long int value1 = (unsigned long int)1
+                                   << (bits_per_long - 1); /* 10000....0 */
+  const int i_blocks_per_strip = p_stripmine * bits_per_long;
+  const int this_strip_i_bl_idx = strip_idx * i_blocks_per_strip;
+  const int next_strip_i_bl_idx =
+      std::min(this_strip_i_bl_idx + i_blocks_per_strip, indep);
+  int rc;
+
+  /* build a partition of the seed matrix (indep x indep_blocks) */
+  memset(seed[0], 0, (size_t)indep * p_stripmine * sizeof(unsigned long int));
+  for (int i = this_strip_i_bl_idx; i < next_strip_i_bl_idx; i++) {
+    const int ii = (i - this_strip_i_bl_idx) / bits_per_long;
+    seed[i][ii] = value1 >> ((i - this_strip_i_bl_idx) % bits_per_long);
+  }
+
+  if (tight_mode)
+    rc = int_forward_tight(tag, depen, indep, p_stripmine, basepoint, seed,
+                           NULL, jac_bit_pat);
+  else
+    rc = int_forward_safe(tag, depen, indep, p_stripmine, seed, jac_bit_pat);
+
+  /* extract pattern from bit patterns */
+  strip.start.assign(1, 0);
+  strip.idx.clear();
+  for (int j = 0; j < depen; j++) {
+    for (int ii = 0; ii < p_stripmine; ii++) {
+      const unsigned long int word = jac_bit_pat[j][ii];
+      if (word == 0)
+        continue;
+      for (int b = 0; b < bits_per_long; b++)
+        if (word & (value1 >> b))
+          strip.idx.push_back(this_strip_i_bl_idx + ii * bits_per_long + b);
+    }
+    strip.start.push_back(strip.idx.size());
+  }
+  return rc;
+}
+
+/****************************************************************************/
+/* Reverse bit pattern propagation of the dependents of strip strip_idx,    */
+/* i.e. q_stripmine unsigned longs of bits, writes the rows of the strip.   */
+/****************************************************************************/
+int reverseStrip(short tag, int depen, int indep, int q_stripmine,
+                 int strip_idx, char tight_mode, unsigned long int **seed,
+                 unsigned long int **jac_bit_pat, unsigned int **crs) {
+  const int bits_per_long = 8 * sizeof(unsigned long int);
+  const unsigned long int value1 = (unsigned long int)1
+                                   << (bits_per_long - 1); /* 10000....0 */
+  const int d_blocks_per_strip = q_stripmine * bits_per_long;
+  const int this_strip_d_bl_idx = strip_idx * d_blocks_per_strip;
+  const int next_strip_d_bl_idx =
+      std::min(this_strip_d_bl_idx + d_blocks_per_strip, depen);
+  int rc;
+
+  /* build a partition of the seed matrix (depen_blocks x depen) */
+  memset(seed[0], 0, (size_t)q_stripmine * depen * sizeof(unsigned long int));
+  for (int j = this_strip_d_bl_idx; j < next_strip_d_bl_idx; j++) {
+    const int jj = (j - this_strip_d_bl_idx) / bits_per_long;
+    seed[jj][j] = value1 >> ((j - this_strip_d_bl_idx) % bits_per_long);
+  }
+
+  if (tight_mode)
+    rc = int_reverse_tight(tag, depen, indep, q_stripmine, seed, jac_bit_pat);
+  else
+    rc = int_reverse_safe(tag, depen, indep, q_stripmine, seed, jac_bit_pat);
+
+  /* extract pattern from bit patterns */
+  for (int d_bl_idx = this_strip_d_bl_idx; d_bl_idx < next_strip_d_bl_idx;
+       d_bl_idx++) {
+    const int jj = (d_bl_idx - this_strip_d_bl_idx) / bits_per_long;
+    const unsigned long int v =
+        value1 >> ((d_bl_idx - this_strip_d_bl_idx) % bits_per_long);
+    const unsigned long int *jac = jac_bit_pat[jj];
+    int k = 0;
+
+    for (int i = 0; i < indep; i++)
+      k += (v & jac[i]) != 0;
+    if (!(crs[d_bl_idx] =
+              (unsigned int *)malloc((k + 1) * sizeof(unsigned int)))) {
+      fprintf(DIAG_OUT,
+              "ADOL-C error, " __FILE__
+              ":%i : \njac_pat(...) unable to allocate %i bytes !\n",
+              __LINE__, (int)((k + 1) * sizeof(unsigned int)));
+      adolc_exit(-1, "", __func__, __FILE__, __LINE__);
+    }
+    crs[d_bl_idx][0] = k; /* number of non-zero indep. blocks */
+    k = 1;
+    for (int i = 0; i < indep; i++)
+      if (v & jac[i])
+        crs[d_bl_idx][k++] = i;
+  }
+  return rc;
+}
+
+/****************************************************************************/
+/* Sets the rows of Seed, which have to be allocated, to the seed matrix of */
+/* a coloring with p colors. For rows the seed is p x color.size(),         */
+/* otherwise color.size() x p.                                              */
+/****************************************************************************/
+void setSeed(double **Seed, const vector<int> &color, int p, bool rows) {
+  const int k = (int)color.size();
+
+  for (int i = 0; i < (rows ? p : k); ++i)
+    std::fill(Seed[i], Seed[i] + (rows ? k : p), 0.0);
+  for (int i = 0; i < k; ++i)
+    if (rows)
+      Seed[color[i]][i] = 1.0;
+    else
+      Seed[i][color[i]] = 1.0;
+}
+
+/* seed matrix as returned by generate_seed_jac and generate_seed_hess, the
+ * rows are allocated by new[] */
+double **newSeed(const vector<int> &color, int p, bool rows) {
+  const int k = (int)color.size();
+  double **Seed = new double *[rows ? p : k];
+
+  for (int i = 0; i < (rows ? p : k); ++i)
+    Seed[i] = new double[rows ? k : p];
+  setSeed(Seed, color, p, rows);
+  return Seed;
+}
+
+#if !HAVE_LIBCOLPACK
+/* seed matrix of the drivers, allocated by myalloc2 such that it can be
+ * owned by a SparseColoring */
+double **allocSeed(const vector<int> &color, int p, bool rows) {
+  const int k = (int)color.size();
+  double **Seed = rows ? myalloc2(p, k) : myalloc2(k, p);
+
+  setSeed(Seed, color, p, rows);
+  return Seed;
+}
+#endif
+
+} // namespace
+
 /****************************************************************************/
 /*******       sparse Jacobains, separate drivers             ***************/
 /****************************************************************************/
@@ -86,13 +365,9 @@ int jac_pat(
   if ((options[2] < -1) || (options[2] > 2))
     options[2] = 0; /* default */
 
-  if (options[0] == 0) {
-    if (options[1] == 1)
-      rc = indopro_forward_tight(tag, depen, indep, basepoint, crs);
-    else {
-      rc = indopro_forward_safe(tag, depen, indep, basepoint, crs);
-    }
-  } else {
+  if (options[0] == 0)
+    rc = indexDomainPattern(tag, depen, indep, basepoint, crs, options[1]);
+  else {
     ctrl_options[0] = options[1];
     ctrl_options[1] = options[2];
     rc =
@@ -148,13 +423,28 @@ void generate_seed_jac(int m, int n, unsigned int **JP, double ***Seed, int *p,
 }
 #else
 {
-  fprintf(DIAG_OUT,
-          "ADOL-C error: function %s can only be used if linked with ColPack\n",
-          __FUNCTION__);
-  adolc_exit(-1, "", __func__, __FILE__, __LINE__);
+  vector<int> color;
+
+  if (option == 1)
+    *p = colorJacRows(m, n, JP, color);
+  else
+    *p = colorJacColumns(m, n, JP, color);
+  *Seed = newSeed(color, *p, option == 1);
 }
 #endif
 
+/*--------------------------------------------------------------------------*/
+/*                              seed matrix for Jacobian, parallel coloring */
+/*--------------------------------------------------------------------------*/
+
+void generate_seed_jac_mt(int m, int n, unsigned int **JP, double ***Seed,
+                          int *p, int option, int nthreads) {
+  vector<int> color;
+
+  *p = colorJacParallel(m, n, JP, option == 1, color, nthreads);
+  *Seed = newSeed(color, *p, option == 1);
+}
+
 /****************************************************************************/
 /*******        sparse Hessians, separate drivers             ***************/
 /****************************************************************************/
@@ -174,7 +464,9 @@ int hess_pat(short tag, /* tape identification                        */
                                         0 - safe mode (default)
                                         1 - tight mode
                                         2 - old safe mode
-                                        3 - old tight mode */
+                                        3 - old tight mode
+                                        4 - safe mode, index graph
+                                        5 - tight mode, index graph */
 
 ) {
   int rc = -1;
@@ -188,10 +480,14 @@ int hess_pat(short tag, /* tape identification                        */
     for (i = 0; i < indep; i++)
       crs[i] = NULL;
 
-  if ((option < 0) || (option > 3))
+  if ((option < 0) || (option > 5))
     option = 0; /* default */
 
-  if (option == 3)
+  if (option == 5)
+    rc = nonl_ind_graph_tight(tag, 1, indep, basepoint, crs);
+  else if (option == 4)
+    rc = nonl_ind_graph_safe(tag, 1, indep, basepoint, crs);
+  else if (option == 3)
     rc = nonl_ind_old_forward_tight(tag, 1, indep, basepoint, crs);
   else if (option == 2)
     rc = nonl_ind_old_forward_safe(tag, 1, indep, basepoint, crs);
@@ -230,10 +526,13 @@ void generate_seed_hess(int n, unsigned int **HP, double ***Seed, int *p,
 }
 #else
 {
-  fprintf(DIAG_OUT,
-          "ADOL-C error: function %s can only be used if linked with ColPack\n",
-          __FUNCTION__);
-  adolc_exit(-1, "", __func__, __FILE__, __LINE__);
+  vector<int> color;
+
+  if (option == 0)
+    *p = colorHessAcyclic(n, HP, color);
+  else
+    *p = colorHessStar(n, HP, color);
+  *Seed = newSeed(color, *p, false);
 }
 #endif
 
@@ -271,17 +570,19 @@ int sparse_jac(short tag,  /* tape identification                     */
                   automatic detection (default) 1 - forward mode 2 - reverse
                   mode options[3] : way of compression 0 - column compression
                   (default) 1 - row compression                         */
-)
-#if HAVE_LIBCOLPACK
-{
+) {
   int i;
   unsigned int j;
   SparseJacInfos sJinfos;
   int ret_val = 0;
-  BipartiteGraphPartialColoringInterface *g;
   TapeInfos *tapeInfos;
+#if HAVE_LIBCOLPACK
+  BipartiteGraphPartialColoringInterface *g;
   JacobianRecovery1D *jr1d;
   JacobianRecovery1D jr1d_loc;
+#else
+  SparseColoring *g;
+#endif
 
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
@@ -325,6 +626,7 @@ int sparse_jac(short tag,  /* tape identification                     */
         }
     }
 
+#if HAVE_LIBCOLPACK
     /* sJinfos.Seed is memory managed by ColPack and will be deleted
      * along with g. We only keep it in sJinfos for the repeat != 0 case */
 
@@ -345,12 +647,36 @@ int sparse_jac(short tag,  /* tape identification                     */
       sJinfos.seed_rows = depen;
       ret_val = sJinfos.seed_clms;
     }
+#else
+    /* sJinfos.Seed is owned by the coloring g, the seed has no duplicate
+     * in the format of generate_seed_jac here */
+
+    g = new SparseColoring;
+
+    if (options[3] == 1) {
+      g->p = colorJacRows(depen, indep, sJinfos.JP, g->color);
+      g->Seed = allocSeed(g->color, g->p, true);
+      sJinfos.seed_rows = g->p;
+      sJinfos.seed_clms = indep;
+    } else {
+      g->p = colorJacColumns(depen, indep, sJinfos.JP, g->color);
+      g->Seed = allocSeed(g->color, g->p, false);
+      sJinfos.seed_rows = depen;
+      sJinfos.seed_clms = g->p;
+    }
+    sJinfos.Seed = g->Seed;
+    ret_val = g->p;
+#endif
 
     sJinfos.B = myalloc2(sJinfos.seed_rows, sJinfos.seed_clms);
     sJinfos.y = myalloc1(depen);
 
     sJinfos.g = (void *)g;
+#if HAVE_LIBCOLPACK
     sJinfos.jr1d = (void *)jr1d;
+#else
+    sJinfos.jr1d = NULL;
+#endif
     setTapeInfoJacSparse(tag, sJinfos);
     tapeInfos = getTapeInfos(tag);
     ADOLC_CURRENT_TAPE_INFOS.copy(*tapeInfos);
@@ -365,10 +691,14 @@ int sparse_jac(short tag,  /* tape identification                     */
     sJinfos.Seed = ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.sJinfos.Seed;
     sJinfos.seed_rows = ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.sJinfos.seed_rows;
     sJinfos.seed_clms = ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.sJinfos.seed_clms;
+#if HAVE_LIBCOLPACK
     g = (BipartiteGraphPartialColoringInterface *)
             ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.sJinfos.g;
     jr1d =
         (JacobianRecovery1D *)ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.sJinfos.jr1d;
+#else
+    g = (SparseColoring *)ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.sJinfos.g;
+#endif
   }
 
   if (sJinfos.nnz_in != *nnz) {
@@ -387,12 +717,13 @@ int sparse_jac(short tag,  /* tape identification                     */
     ret_val = zos_forward(tag, depen, indep, 1, basepoint, sJinfos.y);
     if (ret_val < 0)
       return ret_val;
-    MINDEC(ret_val, fov_reverse(tag, depen, indep, sJinfos.seed_rows,
-                                sJinfos.Seed, sJinfos.B));
+    MINDEC(ret_val, fov_reverse_mt(tag, depen, indep, sJinfos.seed_rows,
+                                   sJinfos.Seed, sJinfos.B, 0));
   } else
     ret_val = fov_forward(tag, depen, indep, sJinfos.seed_clms, basepoint,
                           sJinfos.Seed, sJinfos.y, sJinfos.B);
 
+#if HAVE_LIBCOLPACK
   /* recover compressed Jacobian => ColPack library */
 
   if (*values != NULL && *rind != NULL && *cind != NULL) {
@@ -420,52 +751,50 @@ int sparse_jac(short tag,  /* tape identification                     */
       jr1d->RecoverD2Cln_CoordinateFormat_unmanaged(g, sJinfos.B, sJinfos.JP,
                                                     rind, cind, values);
   }
+#else
+  /* recover compressed Jacobian */
+
+  if (*values == NULL || *rind == NULL || *cind == NULL) {
+    // at least one of rind cind values is not allocated, deallocate others
+    if (*values != NULL)
+      free(*values);
+    if (*rind != NULL)
+      free(*rind);
+    if (*cind != NULL)
+      free(*cind);
+    *rind = (unsigned int *)malloc(sJinfos.nnz_in * sizeof(unsigned int));
+    *cind = (unsigned int *)malloc(sJinfos.nnz_in * sizeof(unsigned int));
+    *values = (double *)malloc(sJinfos.nnz_in * sizeof(double));
+  }
+  recoverJac(sJinfos.depen, sJinfos.JP, g->color, options[3] == 1, sJinfos.B,
+             *rind, *cind, *values);
+#endif
 
   return ret_val;
 }
-#else
-{
-  fprintf(DIAG_OUT,
-          "ADOL-C error: function %s can only be used if linked with ColPack\n",
-          __FUNCTION__);
-  adolc_exit(-1, "", __func__, __FILE__, __LINE__);
-  return -1;
-}
-#endif
 
 /****************************************************************************/
 /*******        sparse Hessians, complete driver              ***************/
 /****************************************************************************/
 
-int sparse_hess(short tag,  /* tape identification                     */
-                int indep,  /* number of independent variables         */
-                int repeat, /* indicated repeated call with same seed  */
-                const double *basepoint, /* independent variable values */
-                int *nnz, /* number of nonzeros                      */
-                unsigned int **rind, /* row index */
-                unsigned int **cind, /* column index */
-                double **values, /* non-zero values                         */
-                int *options
-                /* control options
-                                options[0] :test the computational graph control
-                   flow 0 - safe mode (default) 1 - tight mode 2 - old safe mode
-                                           3 - old tight mode
-                                options[1] : way of recovery
-                                           0 - indirect recovery
-                                           1 - direct recovery */
-)
-#if HAVE_LIBCOLPACK
-{
+static int sparse_hess_colored(short tag, int indep, int repeat,
+                               const double *basepoint, int *nnz,
+                               unsigned int **rind, unsigned int **cind,
+                               double **values, int *options) {
   int i, l;
   unsigned int j;
   SparseHessInfos sHinfos;
-  double **Seed;
-  int dummy;
   double y;
   int ret_val = -1;
-  GraphColoringInterface *g;
   TapeInfos *tapeInfos;
+#if HAVE_LIBCOLPACK
+  double **Seed;
+  int dummy;
+  GraphColoringInterface *g;
   HessianRecovery *hr;
+#else
+  SparseColoring *g;
+#endif
 
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
@@ -510,6 +839,7 @@ int sparse_hess(short tag,  /* tape identification                     */
 
     *nnz = sHinfos.nnz_in;
 
+#if HAVE_LIBCOLPACK
     /* compute seed matrix => ColPack library */
 
     Seed = NULL;
@@ -533,6 +863,24 @@ int sparse_hess(short tag,  /* tape identification                     */
 
     /* Seed will be freed by ColPack when g is freed */
     Seed = NULL;
+#else
+    /* compute coloring, the seed is stored in Xppp only */
+
+    g = new SparseColoring;
+
+    if (options[1] == 0)
+      sHinfos.p = colorHessAcyclic(indep, sHinfos.HP, g->color);
+    else
+      sHinfos.p = colorHessStar(indep, sHinfos.HP, g->color);
+    g->p = sHinfos.p;
+
+    sHinfos.Hcomp = myalloc2(indep, sHinfos.p);
+    sHinfos.Xppp = myalloc3(indep, sHinfos.p, 1);
+
+    for (i = 0; i < indep; i++)
+      for (l = 0; l < sHinfos.p; l++)
+        sHinfos.Xppp[i][l][0] = (l == g->color[i]) ? 1.0 : 0.0;
+#endif
 
     sHinfos.Yppp = myalloc3(1, sHinfos.p, 1);
 
@@ -543,7 +891,11 @@ int sparse_hess(short tag,  /* tape identification                     */
     sHinfos.Upp[0][1] = 0;
 
     sHinfos.g = (void *)g;
+#if HAVE_LIBCOLPACK
     sHinfos.hr = (void *)hr;
+#else
+    sHinfos.hr = NULL;
+#endif
 
     setTapeInfoHessSparse(tag, sHinfos);
 
@@ -561,8 +913,12 @@ int sparse_hess(short tag,  /* tape identification                     */
     sHinfos.Zppp = ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.sHinfos.Zppp;
     sHinfos.Upp = ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.sHinfos.Upp;
     sHinfos.p = ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.sHinfos.p;
+#if HAVE_LIBCOLPACK
     g = (GraphColoringInterface *)ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.sHinfos.g;
     hr = (HessianRecovery *)ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.sHinfos.hr;
+#else
+    g = (SparseColoring *)ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.sHinfos.g;
+#endif
   }
 
   if (sHinfos.Upp == NULL) {
@@ -592,6 +948,7 @@ int sparse_hess(short tag,  /* tape identification                     */
     for (l = 0; l < indep; ++l)
       sHinfos.Hcomp[l][i] = sHinfos.Zppp[i][l][1];
 
+#if HAVE_LIBCOLPACK
   if (*values != NULL && *rind != NULL && *cind != NULL) {
     // everything is preallocated, we assume correctly
     // call usermem versions
@@ -617,17 +974,67 @@ int sparse_hess(short tag,  /* tape identification                     */
       hr->DirectRecover_CoordinateFormat_unmanaged(g, sHinfos.Hcomp, sHinfos.HP,
                                                    rind, cind, values);
   }
+#else
+  if (*values == NULL || *rind == NULL || *cind == NULL) {
+    // at least one of rind cind values is not allocated, deallocate others
+    if (*values != NULL)
+      free(*values);
+    if (*rind != NULL)
+      free(*rind);
+    if (*cind != NULL)
+      free(*cind);
+    *rind = (unsigned int *)malloc(sHinfos.nnz_in * sizeof(unsigned int));
+    *cind = (unsigned int *)malloc(sHinfos.nnz_in * sizeof(unsigned int));
+    *values = (double *)malloc(sHinfos.nnz_in * sizeof(double));
+  }
+  if (options[1] == 0)
+    recoverHessAcyclic(indep, sHinfos.HP, g->color, sHinfos.Hcomp, *rind,
+                       *cind, *values);
+  else
+    recoverHessStar(indep, sHinfos.HP, g->color, sHinfos.Hcomp, *rind, *cind,
+                    *values);
+#endif
   return ret_val;
 }
-#else
-{
-  fprintf(DIAG_OUT,
-          "ADOL-C error: function %s can only be used if linked with ColPack\n",
-          __FUNCTION__);
-  adolc_exit(-1, "", __func__, __FILE__, __LINE__);
-  return -1;
+
+int sparse_hess(short tag,  /* tape identification                     */
+                int indep,  /* number of independent variables         */
+                int repeat, /* indicated repeated call with same seed  */
+                const double *basepoint, /* independent variable values */
+                int *nnz, /* number of nonzeros                      */
+                unsigned int **rind, /* row index */
+                unsigned int **cind, /* column index */
+                double **values, /* non-zero values                         */
+                int *options
+                /* control options
+                                options[0] :test the computational graph control
+                   flow 0 - safe mode (default) 1 - tight mode 2 - old safe mode
+                                           3 - old tight mode
+                                options[1] : way of recovery
+                                           0 - indirect recovery
+                                           1 - direct recovery
+                                           2 - edge pushing, no sparsity
+                                               pattern and coloring,
+                                               repeat and options[0] are
+                                               not used; tapes edge
+                                               pushing does not handle
+                                               use indirect recovery */
+) {
+  if (options[1] == 2) {
+    const int rc =
+        edgePushHess(tag, indep, basepoint, nnz, rind, cind, values, 1);
+    if (rc != -2)
+      return rc;
+    /* reuse the coloring of an earlier fallback if asked to */
+    int colorOptions[2] = {options[0], 0};
+    if (repeat != 1 || getTapeInfos(tag)->pTapeInfos.sHinfos.Upp == NULL)
+      repeat = 0;
+    return sparse_hess_colored(tag, indep, repeat, basepoint, nnz, rind, cind,
+                               values, colorOptions);
+  }
+  return sparse_hess_colored(tag, indep, repeat, basepoint, nnz, rind, cind,
+                             values, options);
 }
-#endif
 
 /****************************************************************************/
 /*******      sparse Hessians, set and get sparsity pattern   ***************/
@@ -716,16 +1123,10 @@ int bit_vector_propagation(
 
   int rc = 3;
   char forward_mode, tight_mode;
-  int i, ii, j, jj, k, k_old, bits_per_long, i_blocks_per_strip,
-      d_blocks_per_strip;
-  int this_strip_i_bl_idx, next_strip_i_bl_idx, this_strip_d_bl_idx,
-      next_strip_d_bl_idx;
-  int stripmined_calls, strip_idx;
-  int p_stripmine, q_stripmine, p_ind_bl_bp, q_dep_bl_bp, i_bl_idx, d_bl_idx;
-  unsigned long int value1, v;
-  unsigned long int **seed = NULL, *s, **jac_bit_pat = NULL, *jac;
-  unsigned char *indep_blocks_flags = NULL, *i_b_flags;
+  int bits_per_long, stripmined_calls, workers;
+  int p_stripmine, q_stripmine, p_ind_bl_bp, q_dep_bl_bp;
   double *valuepoint = NULL;
+  const TapeInfos *tapeInfos = NULL;
 
   if (options[1] == 0) {
     if (depen >= indep / 2)
@@ -744,15 +1145,8 @@ int bit_vector_propagation(
   else
     tight_mode = 0;
 
-  if (!forward_mode)
-    valuepoint = myalloc1(depen);
-
-  /* bit pattern parameters */
-
   /* number of bits in an unsigned long int variable */
   bits_per_long = 8 * sizeof(unsigned long int);
-  /* olvo 20000214 nl: inserted explicit cast to unsigned long int */
-  value1 = (unsigned long int)1 << (bits_per_long - 1); /* 10000....0 */
 
   /* =================================================== forward propagation */
   if (forward_mode) {
@@ -763,162 +1157,92 @@ int bit_vector_propagation(
       adolc_exit(-1, "", __func__, __FILE__, __LINE__);
     }
 
-    /* indep partial derivatives for the whole Jacobian */
-
     /* number of unsigned longs to store the whole seed / Jacobian matrice */
     p_ind_bl_bp = indep / bits_per_long + ((indep % bits_per_long) != 0);
 
     /* number of unsigned longs to store the seed / Jacobian strips */
-    if (p_ind_bl_bp <= PQ_STRIPMINE_MAX) {
-      p_stripmine = p_ind_bl_bp;
-      stripmined_calls = 1;
+    p_stripmine = stripWords(tag, p_ind_bl_bp);
+    stripmined_calls = p_ind_bl_bp / p_stripmine +
+                       ((p_ind_bl_bp % p_stripmine) != 0);
+
+    /* strip-mining : repeated forward calls, distributed among threads -- */
+    std::vector<StripPattern> strips(stripmined_calls);
+
+    workers = patternWorkers(stripmined_calls);
+    if (workers > 1)
+      tapeInfos = shareableTape(tag);
+
+    if (tapeInfos != NULL) {
+#if defined(_OPENMP)
+      rc = std::numeric_limits<int>::max();
+      ADOLC_parallel_doCopy = 0;
+#pragma omp parallel num_threads(workers) reduction(min : rc)
+      {
+        beginParallel();
+        TapeInfos *hidden;
+        TapeInfos *view = attachSharedTape(tapeInfos, &hidden);
+        unsigned long int **seed = myalloc2_ulong(indep, p_stripmine);
+        unsigned long int **jac_bit_pat = myalloc2_ulong(depen, p_stripmine);
+
+#pragma omp for schedule(dynamic)
+        for (int strip_idx = 0; strip_idx < stripmined_calls; strip_idx++)
+          MINDEC(rc, forwardStrip(tag, depen, indep, p_stripmine, strip_idx,
+                                  tight_mode, basepoint, seed, jac_bit_pat,
+                                  strips[strip_idx]));
+
+        myfree2_ulong(seed);
+        myfree2_ulong(jac_bit_pat);
+        detachSharedTape(view, hidden);
+        endParallel();
+      }
+#endif
     } else {
-      p_stripmine = PQ_STRIPMINE_MAX;
-      stripmined_calls = p_ind_bl_bp / PQ_STRIPMINE_MAX +
-                         ((p_ind_bl_bp % PQ_STRIPMINE_MAX) != 0);
-    }
-
-    /* number of independent blocks per seed / Jacobian strip */
-    i_blocks_per_strip = p_stripmine * bits_per_long;
+      unsigned long int **seed = myalloc2_ulong(indep, p_stripmine);
+      unsigned long int **jac_bit_pat = myalloc2_ulong(depen, p_stripmine);
 
-    /* allocate memory --------------------------------------------------- */
+      for (int strip_idx = 0; strip_idx < stripmined_calls; strip_idx++)
+        rc = forwardStrip(tag, depen, indep, p_stripmine, strip_idx,
+                          tight_mode, basepoint, seed, jac_bit_pat,
+                          strips[strip_idx]);
 
-    if (!(indep_blocks_flags =
-              (unsigned char *)calloc(i_blocks_per_strip, sizeof(char)))) {
-      fprintf(DIAG_OUT,
-              "ADOL-C error, " __FILE__
-              ":%i : \njac_pat(...) unable to allocate %i bytes !\n",
-              __LINE__, (int)(i_blocks_per_strip * sizeof(char)));
-      adolc_exit(-1, "", __func__, __FILE__, __LINE__);
+      myfree2_ulong(seed);
+      myfree2_ulong(jac_bit_pat);
     }
 
-    seed = myalloc2_ulong(indep, p_stripmine);
-    jac_bit_pat = myalloc2_ulong(depen, p_stripmine);
-
-    /* strip-mining : repeated forward calls ----------------------------- */
-
-    for (strip_idx = 0; strip_idx < stripmined_calls; strip_idx++) {
-      /* build a partition of the seed matrix (indep x indep_blocks) --- */
-      /* (indep x i_blocks_per_strip) as a bit pattern                   */
-      s = seed[0];
-      for (i = 0; i < indep; i++)
-        for (ii = 0; ii < p_stripmine; ii++) /* 2 loops if short -> int !!! */
-          *s++ = 0;                          /* set old seed matrix to 0 */
-
-      this_strip_i_bl_idx = strip_idx * i_blocks_per_strip;
-      next_strip_i_bl_idx = (strip_idx + 1) * i_blocks_per_strip;
-      if (next_strip_i_bl_idx > indep)
-        next_strip_i_bl_idx = indep;
-      v = value1; /* 10000....0 */
-
-      for (i = 0; i < indep; i++)
-        if ((this_strip_i_bl_idx <= i) && (i < next_strip_i_bl_idx)) {
-          ii = (i - this_strip_i_bl_idx) / bits_per_long;
-          seed[i][ii] = v >> ((i - this_strip_i_bl_idx) % bits_per_long);
-        }
-
-      /* bit pattern propagation by forward ---------------------------- */
-
-      if (tight_mode) {
-        rc = int_forward_tight(tag, depen, indep, p_stripmine, basepoint, seed,
-                               valuepoint, jac_bit_pat);
-      } else {
-        rc =
-            int_forward_safe(tag, depen, indep, p_stripmine, seed, jac_bit_pat);
+    /* the strips hold increasing ranges of independents --------------- */
+    for (int j = 0; j < depen; j++) {
+      size_t k = 0;
+      for (int strip_idx = 0; strip_idx < stripmined_calls; strip_idx++)
+        k += strips[strip_idx].start[j + 1] - strips[strip_idx].start[j];
+      if (!(crs[j] = (unsigned int *)malloc((k + 1) * sizeof(unsigned int)))) {
+        fprintf(DIAG_OUT,
+                "ADOL-C error, " __FILE__
+                ":%i : \njac_pat(...) unable to allocate %i bytes !\n",
+                __LINE__, (int)((k + 1) * sizeof(unsigned int)));
+        adolc_exit(-1, "", __func__, __FILE__, __LINE__);
       }
-
-      /* extract  pattern from bit patterns --------------------- */
-
-      for (j = 0; j < depen; j++) {
-        ii = -1;
-        v = 0;
-
-        jac = jac_bit_pat[j];
-        i_b_flags = indep_blocks_flags;
-        for (i_bl_idx = 0; i_bl_idx < i_blocks_per_strip; i_bl_idx++) {
-          if (!v) {
-            v = value1; /* 10000....0 */
-            ii++;
-          }
-          if (v & jac[ii])
-            *i_b_flags = 1;
-          i_b_flags++;
-
-          v = v >> 1;
-        }
-
-        if (strip_idx == 0)
-          k_old = 0;
-        else
-          k_old = crs[j][0];
-        k = 0;
-        i_b_flags = indep_blocks_flags;
-        for (i = 0; i < i_blocks_per_strip; i++)
-          k += *i_b_flags++;
-
-        if ((k > 0) || (strip_idx == 0)) {
-          if (!(crs[j] = (unsigned int *)realloc(
-                    crs[j], (k_old + k + 1) * sizeof(unsigned int)))) {
-            fprintf(DIAG_OUT,
-                    "ADOL-C error, " __FILE__
-                    ":%i : \njac_pat(...) unable to allocate %i bytes !\n",
-                    __LINE__, (int)((k_old + k + 1) * sizeof(unsigned int)));
-            adolc_exit(-1, "", __func__, __FILE__, __LINE__);
-          }
-          if (strip_idx == 0)
-            crs[j][0] = 0;
-          if (k > 0) {
-            k = crs[j][0] + 1;
-            i_b_flags = indep_blocks_flags;
-            for (i = 0; i < i_blocks_per_strip; i++) {
-              if (*i_b_flags) {
-                crs[j][k++] = this_strip_i_bl_idx + i;
-                *i_b_flags = 0;
-              }
-              i_b_flags++;
-            }
-            /* current/total number of non-zero blocks of indep. vars. */
-            crs[j][0] = k - 1;
-          }
-        }
+      /* current/total number of non-zero blocks of indep. vars. */
+      crs[j][0] = (unsigned int)k;
+      k = 1;
+      for (int strip_idx = 0; strip_idx < stripmined_calls; strip_idx++) {
+        const StripPattern &strip = strips[strip_idx];
+        for (size_t l = strip.start[j]; l < strip.start[j + 1]; l++)
+          crs[j][k++] = strip.idx[l];
       }
-    } /* strip_idx */
+    }
 
   } /* forward */
 
   /* =================================================== reverse propagation */
   else {
 
-    /* depen weight vectors for the whole Jacobian */
-
     /* number of unsigned longs to store the whole seed / Jacobian matrice */
     q_dep_bl_bp = depen / bits_per_long + ((depen % bits_per_long) != 0);
 
     /* number of unsigned longs to store the seed / Jacobian strips */
-    if (q_dep_bl_bp <= PQ_STRIPMINE_MAX) {
-      q_stripmine = q_dep_bl_bp;
-      stripmined_calls = 1;
-    } else {
-      q_stripmine = PQ_STRIPMINE_MAX;
-      stripmined_calls = q_dep_bl_bp / PQ_STRIPMINE_MAX +
-                         ((q_dep_bl_bp % PQ_STRIPMINE_MAX) != 0);
-    }
-
-    /* number of dependent blocks per seed / Jacobian strip */
-    d_blocks_per_strip = q_stripmine * bits_per_long;
-
-    /* allocate memory --------------------------------------------------- */
-    if (!(indep_blocks_flags =
-              (unsigned char *)calloc(indep, sizeof(unsigned char)))) {
-      fprintf(DIAG_OUT,
-              "ADOL-C error, " __FILE__
-              ":%i : \njac_pat(...) unable to allocate %i bytes !\n",
-              __LINE__, (int)(indep * sizeof(unsigned char)));
-      adolc_exit(-1, "", __func__, __FILE__, __LINE__);
-    }
-
-    seed = myalloc2_ulong(q_stripmine, depen);
-    jac_bit_pat = myalloc2_ulong(q_stripmine, indep);
+    q_stripmine = stripWords(tag, q_dep_bl_bp);
+    stripmined_calls = q_dep_bl_bp / q_stripmine +
+                       ((q_dep_bl_bp % q_stripmine) != 0);
 
     /* olvo 20000214: call to forward required in tight mode only,
        in safe mode no basepoint available! */
@@ -929,100 +1253,56 @@ int bit_vector_propagation(
         adolc_exit(-1, "", __func__, __FILE__, __LINE__);
       }
 
+      valuepoint = myalloc1(depen);
       rc = zos_forward(tag, depen, indep, 1, basepoint, valuepoint);
+      free((char *)valuepoint);
+      valuepoint = NULL;
     }
 
-    /* strip-mining : repeated reverse calls ----------------------------- */
-
-    for (strip_idx = 0; strip_idx < stripmined_calls; strip_idx++) {
-      /* build a partition of the seed matrix (depen_blocks x depen)     */
-      /* (d_blocks_per_strip x depen) as a bit pattern                   */
-      s = seed[0];
-      for (jj = 0; jj < q_stripmine; jj++) /* 2 loops if short -> int !!! */
-        for (j = 0; j < depen; j++)
-          *s++ = 0; /* set old seed matrix to 0 */
-
-      this_strip_d_bl_idx = strip_idx * d_blocks_per_strip;
-      next_strip_d_bl_idx = (strip_idx + 1) * d_blocks_per_strip;
-      if (next_strip_d_bl_idx > depen)
-        next_strip_d_bl_idx = depen;
-      v = value1; /* 10000....0 */
-
-      for (j = 0; j < depen; j++)
-        if ((this_strip_d_bl_idx <= j) && (j < next_strip_d_bl_idx)) {
-          jj = (j - this_strip_d_bl_idx) / bits_per_long;
-          seed[jj][j] = v >> ((j - this_strip_d_bl_idx) % bits_per_long);
-        }
-
-      /* bit pattern propagation by reverse ---------------------------- */
-
-      if (tight_mode)
-        rc = int_reverse_tight(tag, depen, indep, q_stripmine, seed,
-                               jac_bit_pat);
-      else
-        rc =
-            int_reverse_safe(tag, depen, indep, q_stripmine, seed, jac_bit_pat);
-
-      /* extract pattern from bit patterns --------------------- */
-
-      jj = -1;
-      v = 0;
-      for (d_bl_idx = this_strip_d_bl_idx; d_bl_idx < next_strip_d_bl_idx;
-           d_bl_idx++) {
-        if (!v) {
-          v = value1; /* 10000....0 */
-          jj++;
-        }
-        jac = jac_bit_pat[jj];
-        for (i = 0; i < indep; i++) {
-          if (v & *jac++) {
-            indep_blocks_flags[i] = 1;
-          }
-        }
-
-        v = v >> 1;
-
-        k = 0;
-        i_b_flags = indep_blocks_flags;
-        for (i = 0; i < indep; i++)
-          k += *i_b_flags++;
-
-        if (!(crs[d_bl_idx] =
-                  (unsigned int *)malloc((k + 1) * sizeof(unsigned int)))) {
-          fprintf(DIAG_OUT,
-                  "ADOL-C error, " __FILE__
-                  ":%i : \njac_pat(...) unable to allocate %i bytes !\n",
-                  __LINE__, (int)((k + 1) * sizeof(unsigned int)));
-          adolc_exit(-1, "", __func__, __FILE__, __LINE__);
-        }
-        crs[d_bl_idx][0] = k; /* number of non-zero indep. blocks */
-        k = 1;
-        i_b_flags = indep_blocks_flags;
-        for (i = 0; i < indep; i++) {
-          if (*i_b_flags) {
-            crs[d_bl_idx][k++] = i;
-            *i_b_flags = 0;
-          }
-          i_b_flags++;
-        }
+    /* strip-mining : repeated reverse calls, distributed among threads -- */
+    workers = patternWorkers(stripmined_calls);
+    if (workers > 1)
+      tapeInfos = tight_mode ? sharedReverseTape(tag, depen, indep)
+                             : shareableTape(tag);
+
+    if (tapeInfos != NULL) {
+#if defined(_OPENMP)
+      int rcStrips = std::numeric_limits<int>::max();
+      ADOLC_parallel_doCopy = 0;
+#pragma omp parallel num_threads(workers) reduction(min : rcStrips)
+      {
+        beginParallel();
+        TapeInfos *hidden;
+        TapeInfos *view = attachSharedTape(tapeInfos, &hidden);
+        unsigned long int **seed = myalloc2_ulong(q_stripmine, depen);
+        unsigned long int **jac_bit_pat = myalloc2_ulong(q_stripmine, indep);
+
+#pragma omp for schedule(dynamic)
+        for (int strip_idx = 0; strip_idx < stripmined_calls; strip_idx++)
+          MINDEC(rcStrips,
+                 reverseStrip(tag, depen, indep, q_stripmine, strip_idx,
+                              tight_mode, seed, jac_bit_pat, crs));
+
+        myfree2_ulong(seed);
+        myfree2_ulong(jac_bit_pat);
+        detachSharedTape(view, hidden);
+        endParallel();
       }
+      rc = rcStrips;
+#endif
+    } else {
+      unsigned long int **seed = myalloc2_ulong(q_stripmine, depen);
+      unsigned long int **jac_bit_pat = myalloc2_ulong(q_stripmine, indep);
 
-    } /* strip_idx */
+      for (int strip_idx = 0; strip_idx < stripmined_calls; strip_idx++)
+        rc = reverseStrip(tag, depen, indep, q_stripmine, strip_idx,
+                          tight_mode, seed, jac_bit_pat, crs);
 
-  } /* reverse */
+      myfree2_ulong(seed);
+      myfree2_ulong(jac_bit_pat);
+    }
 
-  if (!forward_mode) {
-    free((char *)valuepoint);
-    valuepoint = NULL;
-  }
-  free((char *)*seed);
-  free((char *)seed);
-  seed = NULL;
-  free((char *)*jac_bit_pat);
-  free((char *)jac_bit_pat);
-  jac_bit_pat = NULL;
-  free((char *)indep_blocks_flags);
-  indep_blocks_flags = NULL;
+  } /* reverse */
 
   return (rc);
 }
@@ -1052,6 +1332,10 @@ void freeSparseJacInfos(double *y, double **B, unsigned int **JP, void *g,
 
   if (jr1d)
     delete (JacobianRecovery1D *)jr1d;
+#else
+  (void)jr1d;
+  if (g)
+    delete (SparseColoring *)g;
 #endif
 }
 /*****************************************************************************/
@@ -1087,6 +1371,11 @@ void freeSparseHessInfos(double **Hcomp, double ***Xppp, double ***Yppp,
     delete (GraphColoringInterface *)g;
   if (hr)
     delete (HessianRecovery *)hr;
+#else
+  (void)hr;
+  (void)p;
+  if (g)
+    delete (SparseColoring *)g;
 #endif
 }
 
@@ -1104,9 +1393,7 @@ int ADOLC_get_sparse_jacobian(func_ad<adtl::adouble> *const fun,
                               func_ad<adtl_indo::adouble> *const fun_indo,
                               int n, int m, int repeat, double *basepoints,
                               int *nnz, unsigned int **rind,
-                              unsigned int **cind, double **values)
-#if HAVE_LIBCOLPACK
-{
+                              unsigned int **cind, double **values) {
   int i;
   unsigned int j;
   int ret_val = -1;
@@ -1144,6 +1431,7 @@ int ADOLC_get_sparse_jacobian(func_ad<adtl::adouble> *const fun,
         sJinfos.nnz_in++;
     }
     *nnz = sJinfos.nnz_in;
+#if HAVE_LIBCOLPACK
     /* sJinfos.Seed is memory managed by ColPack and will be deleted
      * along with g. We only keep it in sJinfos for the repeat != 0 case */
     BipartiteGraphPartialColoringInterface *g;
@@ -1157,6 +1445,16 @@ int ADOLC_get_sparse_jacobian(func_ad<adtl::adouble> *const fun,
                             &(sJinfos.seed_clms), "SMALLEST_LAST",
                             "COLUMN_PARTIAL_DISTANCE_TWO");
     sJinfos.seed_rows = m;
+#else
+    SparseColoring *g = new SparseColoring;
+
+    g->p = colorJacColumns(m, n, sJinfos.JP, g->color);
+    g->Seed = allocSeed(g->color, g->p, false);
+    sJinfos.Seed = g->Seed;
+    sJinfos.seed_rows = m;
+    sJinfos.seed_clms = g->p;
+    void *jr1d = NULL;
+#endif
 
     sJinfos.B = myalloc2(sJinfos.seed_rows, sJinfos.seed_clms);
     sJinfos.y = myalloc1(m);
@@ -1195,14 +1493,15 @@ int ADOLC_get_sparse_jacobian(func_ad<adtl::adouble> *const fun,
     delete[] x;
     delete[] y;
   }
-  /* recover compressed Jacobian => ColPack library */
-
   if (*values != NULL)
     free(*values);
   if (*rind != NULL)
     free(*rind);
   if (*cind != NULL)
     free(*cind);
+#if HAVE_LIBCOLPACK
+  /* recover compressed Jacobian => ColPack library */
+
   BipartiteGraphPartialColoringInterface *g;
   JacobianRecovery1D *jr1d;
   g = (BipartiteGraphPartialColoringInterface *)sJinfos.g;
@@ -1212,18 +1511,18 @@ int ADOLC_get_sparse_jacobian(func_ad<adtl::adouble> *const fun,
 
   // delete g;
   // delete jr1d;
+#else
+  /* recover compressed Jacobian */
+
+  *rind = (unsigned int *)malloc(sJinfos.nnz_in * sizeof(unsigned int));
+  *cind = (unsigned int *)malloc(sJinfos.nnz_in * sizeof(unsigned int));
+  *values = (double *)malloc(sJinfos.nnz_in * sizeof(double));
+  recoverJac(m, sJinfos.JP, ((SparseColoring *)sJinfos.g)->color, false,
+             sJinfos.B, *rind, *cind, *values);
+#endif
 
   return ret_val;
 }
-#else
-{
-  fprintf(DIAG_OUT,
-          "ADOL-C error: function %s can only be used if linked with ColPack\n",
-          __FUNCTION__);
-  adolc_exit(-1, "", __func__, __FILE__, __LINE__);
-  return -1;
-}
-#endif
 
 //}
 
@@ -14,6 +14,7 @@
 ---------------------------------------------------------------------------*/
 #include "checkpointing_p.h"
 #include "dvlparms.h"
+#include "oplate.h"
 #include "taping_p.h"
 #include <adolc/adalloc.h>
 #include <adolc/revolve.h>
@@ -23,6 +24,7 @@
 #endif
 
 #include <algorithm>
+#include <cstddef>
 #include <cstring>
 #include <iostream>
 #ifdef HAVE_UNISTD_H
@@ -87,6 +89,9 @@ GlobalTapeVarsCL::operator=(const GlobalTapeVarsCL &gtv) {
   valueBufferSize = gtv.valueBufferSize;
   taylorBufferSize = gtv.taylorBufferSize;
   maxNumberTaylorBuffers = gtv.maxNumberTaylorBuffers;
+  tapeStorage = gtv.tapeStorage;
+  tapeCodec = gtv.tapeCodec;
+  dirChunkSize = gtv.dirChunkSize;
   inParallelRegion = gtv.inParallelRegion;
   newTape = gtv.newTape;
   branchSwitchWarning = gtv.branchSwitchWarning;
@@ -142,6 +147,9 @@ static GlobalTapeVars *globalTapeVars_p;
 static ADOLC_BUFFER_TYPE *ADOLC_extDiffFctsBuffer_p;
 static stack<StackElement> *ADOLC_checkpointsStack_p;
 static revolve_nums *revolve_numbers_p;
+
+static bool openFrozenTape(short tapeID);
+static void deleteTapeView(TapeInfos *view);
 #endif
 
 /*--------------------------------------------------------------------------*/
@@ -168,6 +176,8 @@ void initTapeInfos(TapeInfos *newTapeInfos) {
 
 /* as above but keep allocated buffers if possible */
 void initTapeInfos_keep(TapeInfos *newTapeInfos) {
+  unmapTapeFiles(newTapeInfos);
+  releaseTapeIO(newTapeInfos);
   unsigned char *opBuffer = newTapeInfos->opBuffer;
   locint *locBuffer = newTapeInfos->locBuffer;
   double *valBuffer = newTapeInfos->valBuffer;
@@ -201,8 +211,22 @@ int initNewTape(short tapeID) {
       ADOLC_TAPE_INFOS_BUFFER.begin(), ADOLC_TAPE_INFOS_BUFFER.end(),
       [&tapeID](auto &&ti) { return ti->tapeID == tapeID; });
 
+#if defined(_OPENMP)
+  /* a worker retaping a frozen tape gets a tape of its own */
+  if (tiIter != ADOLC_TAPE_INFOS_BUFFER.end() &&
+      (*tiIter)->frozenTape != NULL) {
+    deleteTapeView(*tiIter);
+    ADOLC_TAPE_INFOS_BUFFER.erase(tiIter);
+    tiIter = ADOLC_TAPE_INFOS_BUFFER.end();
+  }
+#endif
+
   if (tiIter != ADOLC_TAPE_INFOS_BUFFER.end()) {
     newTapeInfos = *tiIter;
+    if ((*tiIter)->pTapeInfos.frozen != 0) {
+      failAdditionalInfo1 = tapeID;
+      fail(ADOLC_TAPING_TAPE_FROZEN);
+    }
     if ((*tiIter)->inUse != 0) {
       if ((*tiIter)->tapingComplete == 0)
         fail(ADOLC_TAPING_TAPE_STILL_IN_USE);
@@ -267,6 +291,8 @@ int initNewTape(short tapeID) {
   /* create new info struct and initialize it */
   if (newTapeInfos == NULL) {
     newTapeInfos = new TapeInfos(tapeID);
+    newTapeInfos->pTapeInfos.tapeStorage = ADOLC_GLOBAL_TAPE_VARS.tapeStorage;
+    newTapeInfos->pTapeInfos.tapeCodec = ADOLC_GLOBAL_TAPE_VARS.tapeCodec;
     newTI = true;
   }
   newTapeInfos->traceFlag = 1;
@@ -279,6 +305,7 @@ int initNewTape(short tapeID) {
   newTapeInfos->stats[VAL_BUFFER_SIZE] = ADOLC_GLOBAL_TAPE_VARS.valueBufferSize;
   newTapeInfos->stats[TAY_BUFFER_SIZE] =
       ADOLC_GLOBAL_TAPE_VARS.taylorBufferSize;
+  newTapeInfos->stats[TAPE_CODEC] = newTapeInfos->pTapeInfos.tapeCodec;
 
   /* update tapeStack and save tapeInfos */
   if (ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr != NULL) {
@@ -312,6 +339,10 @@ void openTape(short tapeID, char mode) {
   vector<TapeInfos *>::iterator tiIter = std::find_if(
       ADOLC_TAPE_INFOS_BUFFER.begin(), ADOLC_TAPE_INFOS_BUFFER.end(),
       [&tapeID](auto &&ti) { return ti->tapeID == tapeID; });
+#if defined(_OPENMP)
+  if (tiIter == ADOLC_TAPE_INFOS_BUFFER.end() && openFrozenTape(tapeID))
+    tiIter = ADOLC_TAPE_INFOS_BUFFER.end() - 1;
+#endif
 
   if (tiIter != ADOLC_TAPE_INFOS_BUFFER.end()) {
     /* tape has been used before (in the current program) */
@@ -400,6 +431,10 @@ TapeInfos *getTapeInfos(short tapeID) {
   auto tiIter = std::find_if(
       ADOLC_TAPE_INFOS_BUFFER.begin(), ADOLC_TAPE_INFOS_BUFFER.end(),
       [&tapeID](auto &&ti) { return ti->tapeID == tapeID; });
+#if defined(_OPENMP)
+  if (tiIter == ADOLC_TAPE_INFOS_BUFFER.end() && openFrozenTape(tapeID))
+    tiIter = ADOLC_TAPE_INFOS_BUFFER.end() - 1;
+#endif
 
   // Return the tapeInfos pointer if it has been found.
   if (tiIter != ADOLC_TAPE_INFOS_BUFFER.end()) {
@@ -411,6 +446,8 @@ TapeInfos *getTapeInfos(short tapeID) {
 
   /* create new TapeInfos, initialize and update tapeInfosBuffer */
   TapeInfos *tapeInfos = new TapeInfos(tapeID);
+  tapeInfos->pTapeInfos.tapeStorage = ADOLC_GLOBAL_TAPE_VARS.tapeStorage;
+  tapeInfos->pTapeInfos.tapeCodec = ADOLC_GLOBAL_TAPE_VARS.tapeCodec;
   ADOLC_TAPE_INFOS_BUFFER.push_back(tapeInfos);
   tapeInfos->traceFlag = 1;
   tapeInfos->inUse = 0;
@@ -449,6 +486,50 @@ void cachedTraceTags(std::vector<short> &result) {
   }
 }
 
+/****************************************************************************/
+/* Returns the TapeInfos of tapeID if the tape resides in main memory and   */
+/* can be swept by several threads at once, NULL otherwise. External        */
+/* functions (checkpoints included) are registered with the serial          */
+/* environment only and exclude a tape as well.                             */
+/****************************************************************************/
+const TapeInfos *shareableTape(short tapeID) {
+  const TapeInfos *tapeInfos = getTapeInfos(tapeID);
+
+  /* checked by freeze_tape already */
+  if (tapeInfos->pTapeInfos.frozen != 0)
+    return tapeInfos;
+  if (tapeInfos->inUse == 0 || tapeInfos->tapingComplete == 0)
+    return NULL;
+  if (tapeInfos->stats[OP_FILE_ACCESS] != 0 ||
+      tapeInfos->stats[LOC_FILE_ACCESS] != 0 ||
+      tapeInfos->stats[VAL_FILE_ACCESS] != 0)
+    return NULL;
+  for (size_t i = 0; i < tapeInfos->stats[NUM_OPERATIONS]; ++i) {
+    const unsigned char op = tapeInfos->opBuffer[i];
+    if (op == ext_diff || op == ext_diff_iArr || op == ext_diff_v2 ||
+        (op >= ampi_send && op <= medi_call))
+      return NULL;
+  }
+  return tapeInfos;
+}
+
+/****************************************************************************/
+/* As shareableTape, but the Taylor stack has to reside in main memory as   */
+/* well and fit a reverse sweep of dimension m x n.                         */
+/****************************************************************************/
+const TapeInfos *sharedReverseTape(short tapeID, int m, int n) {
+  const TapeInfos *tapeInfos = shareableTape(tapeID);
+
+  if (tapeInfos == NULL)
+    return NULL;
+  if (tapeInfos->tayBuffer == NULL || tapeInfos->tay_file != NULL ||
+      tapeInfos->deg_save == (uint)-1)
+    return NULL;
+  if (tapeInfos->tay_numDeps != (uint)m || tapeInfos->tay_numInds != (uint)n)
+    return NULL;
+  return tapeInfos;
+}
+
 #ifdef SPARSE
 /* updates the tape infos on sparse Jac for the given ID  */
 void setTapeInfoJacSparse(short tapeID, SparseJacInfos sJinfos) {
@@ -584,6 +665,8 @@ void cleanUp() {
     tiIter = &ADOLC_TAPE_INFOS_BUFFER.back();
     ADOLC_TAPE_INFOS_BUFFER.pop_back();
     {
+      /* finish background transfers before their files get closed */
+      releaseTapeIO(*tiIter);
       /* close open files though they may be incomplete */
       if ((*tiIter)->op_file != NULL) {
         fclose((*tiIter)->op_file);
@@ -603,6 +686,7 @@ void cleanUp() {
         (*tiIter)->tay_file = NULL;
         remove((*tiIter)->pTapeInfos.tay_fileName);
       }
+      unmapTapeFiles(*tiIter);
       if ((*tiIter)->opBuffer != NULL) {
         free((*tiIter)->opBuffer);
         (*tiIter)->opBuffer = NULL;
@@ -721,7 +805,7 @@ int removeTape(short tapeID, short type) {
 
   if (tiIter != ADOLC_TAPE_INFOS_BUFFER.end()) {
     tapeInfos = *tiIter;
-    if (tapeInfos->tapingComplete == 0)
+    if (tapeInfos->tapingComplete == 0 || tapeInfos->pTapeInfos.frozen != 0)
       return -1;
     ADOLC_TAPE_INFOS_BUFFER.erase(tiIter);
   }
@@ -888,6 +972,7 @@ int ADOLC_parallel_doCopy;
 static bool waitForMaster_begin = true;
 static bool waitForMaster_end = true;
 static bool firstParallel = true;
+static int numParallelThreads = 0;
 
 /****************************************************************************/
 /* Used by OpenMP to create a separate environment for every worker thread. */
@@ -912,14 +997,17 @@ void beginParallel() {
     revolve_numbers_s = revolve_numbers;
 
     if (firstParallel) {
-      tapeInfosBuffer = new vector<TapeInfos *>[numThreads];
-      tapeStack = new stack<TapeInfos *>[numThreads];
-      currentTapeInfos = new TapeInfos[numThreads];
-      currentTapeInfos_fallBack = new TapeInfos[numThreads];
-      globalTapeVars = new GlobalTapeVars[numThreads];
-      ADOLC_extDiffFctsBuffer = new ADOLC_BUFFER_TYPE[numThreads];
-      ADOLC_checkpointsStack = new stack<StackElement>[numThreads];
-      revolve_numbers = new revolve_nums[numThreads];
+      /* later parallel regions reuse these environments and must not have
+       * more workers than the default team size or the first region */
+      numParallelThreads = max(numThreads, omp_get_max_threads());
+      tapeInfosBuffer = new vector<TapeInfos *>[numParallelThreads];
+      tapeStack = new stack<TapeInfos *>[numParallelThreads];
+      currentTapeInfos = new TapeInfos[numParallelThreads];
+      currentTapeInfos_fallBack = new TapeInfos[numParallelThreads];
+      globalTapeVars = new GlobalTapeVars[numParallelThreads];
+      ADOLC_extDiffFctsBuffer = new ADOLC_BUFFER_TYPE[numParallelThreads];
+      ADOLC_checkpointsStack = new stack<StackElement>[numParallelThreads];
+      revolve_numbers = new revolve_nums[numParallelThreads];
     } else {
       tapeInfosBuffer = tapeInfosBuffer_p;
       tapeStack = tapeStack_p;
@@ -1042,8 +1130,368 @@ void endParallel() {
     }
 }
 
+/****************************************************************************/
+/* Number of workers a parallel region may have without exceeding the      */
+/* environments created in beginParallel.                                   */
+/****************************************************************************/
+int maxParallelThreads() {
+  return firstParallel ? omp_get_max_threads() : numParallelThreads;
+}
+
+/****************************************************************************/
+/* Lets the calling worker sweep an in-core tape of the serial part. The    */
+/* worker gets its own TapeInfos pointing to the buffers of the serial      */
+/* tape, such that sweeps only move private cursors. A TapeInfos of the     */
+/* worker for the same tape is hidden until detachSharedTape is called.     */
+/****************************************************************************/
+TapeInfos *attachSharedTape(const TapeInfos *tapeInfos, TapeInfos **hidden) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  TapeInfos *view = new TapeInfos();
+  view->copy(*tapeInfos);
+  view->op_io = view->loc_io = view->val_io = view->tay_io = NULL;
+  view->signature = NULL;
+  for (int kind = 0; kind < ADOLC_NUM_WORKSPACES; ++kind)
+    view->pTapeInfos.workspace[kind] = NULL;
+  view->pTapeInfos.driverCache = NULL;
+
+  const short tapeID = view->tapeID;
+  vector<TapeInfos *>::iterator tiIter = std::find_if(
+      ADOLC_TAPE_INFOS_BUFFER.begin(), ADOLC_TAPE_INFOS_BUFFER.end(),
+      [&tapeID](auto &&ti) { return ti->tapeID == tapeID; });
+  if (tiIter != ADOLC_TAPE_INFOS_BUFFER.end()) {
+    *hidden = *tiIter;
+    *tiIter = view;
+  } else {
+    *hidden = NULL;
+    ADOLC_TAPE_INFOS_BUFFER.push_back(view);
+  }
+  return view;
+}
+
+/****************************************************************************/
+/* Undoes attachSharedTape without releasing any of the shared resources.   */
+/****************************************************************************/
+void detachSharedTape(TapeInfos *view, TapeInfos *hidden) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  vector<TapeInfos *>::iterator tiIter = std::find(
+      ADOLC_TAPE_INFOS_BUFFER.begin(), ADOLC_TAPE_INFOS_BUFFER.end(), view);
+  if (hidden != NULL)
+    *tiIter = hidden;
+  else
+    ADOLC_TAPE_INFOS_BUFFER.erase(tiIter);
+
+  /* the persistent part (parameters, file names) belongs to the serial tape */
+  freeWorkspaces(&view->pTapeInfos);
+  view->pTapeInfos = PersistantTapeInfos();
+  if (view->signature != NULL)
+    myfree1(view->signature);
+  delete view;
+}
+
+/****************************************************************************/
+/* Makes a tape frozen in the serial part available to the calling worker,  */
+/* see freeze_tape. The worker gets its own TapeInfos pointing to the       */
+/* buffers of the frozen tape. The Taylor stack and the caches of the       */
+/* drivers are private to the worker. Returns false if the worker is not in */
+/* a parallel region or there is no frozen tape tapeID.                     */
+/****************************************************************************/
+static bool openFrozenTape(short tapeID) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (ADOLC_GLOBAL_TAPE_VARS.inParallelRegion == 0)
+    return false;
+
+  vector<TapeInfos *>::const_iterator tiIter = std::find_if(
+      tapeInfosBuffer_s->begin(), tapeInfosBuffer_s->end(),
+      [&tapeID](auto &&ti) { return ti->tapeID == tapeID; });
+  if (tiIter == tapeInfosBuffer_s->end() || (*tiIter)->pTapeInfos.frozen == 0)
+    return false;
+
+  TapeInfos *view = new TapeInfos();
+  view->copy(**tiIter);
+  view->op_io = view->loc_io = view->val_io = view->tay_io = NULL;
+  view->signature = NULL;
+  view->frozenTape = *tiIter;
+
+  view->tay_file = NULL;
+  view->tayBuffer = NULL;
+  view->currTay = view->lastTayP1 = NULL;
+  view->numTays_Tape = 0;
+  view->nextBufferNumber = 0;
+  view->lastTayBlockInCore = 0;
+  view->keepTaylors = 0;
+  view->deg_save = 0;
+  view->tay_numInds = view->tay_numDeps = 0;
+
+  /* only the file names and the parameters are shared */
+  const PersistantTapeInfos &shared = (*tiIter)->pTapeInfos;
+  view->pTapeInfos = PersistantTapeInfos();
+  view->pTapeInfos.op_fileName = shared.op_fileName;
+  view->pTapeInfos.loc_fileName = shared.loc_fileName;
+  view->pTapeInfos.val_fileName = shared.val_fileName;
+  view->pTapeInfos.keepTape = shared.keepTape;
+  view->pTapeInfos.skipFileCleanup = shared.skipFileCleanup;
+  view->pTapeInfos.tapeStorage = shared.tapeStorage;
+  view->pTapeInfos.tapeCodec = shared.tapeCodec;
+  view->pTapeInfos.frozen = shared.frozen;
+  view->pTapeInfos.paramstore = shared.paramstore;
+
+  ADOLC_TAPE_INFOS_BUFFER.push_back(view);
+  return true;
+}
+
+/****************************************************************************/
+/* Releases a TapeInfos created by openFrozenTape and its private data.     */
+/****************************************************************************/
+static void deleteTapeView(TapeInfos *view) {
+  freeTaylorStack(view);
+#ifdef SPARSE
+  freeSparseJacInfos(
+      view->pTapeInfos.sJinfos.y, view->pTapeInfos.sJinfos.B,
+      view->pTapeInfos.sJinfos.JP, view->pTapeInfos.sJinfos.g,
+      view->pTapeInfos.sJinfos.jr1d, view->pTapeInfos.sJinfos.seed_rows,
+      view->pTapeInfos.sJinfos.seed_clms, view->pTapeInfos.sJinfos.depen);
+  freeSparseHessInfos(
+      view->pTapeInfos.sHinfos.Hcomp, view->pTapeInfos.sHinfos.Xppp,
+      view->pTapeInfos.sHinfos.Yppp, view->pTapeInfos.sHinfos.Zppp,
+      view->pTapeInfos.sHinfos.Upp, view->pTapeInfos.sHinfos.HP,
+      view->pTapeInfos.sHinfos.g, view->pTapeInfos.sHinfos.hr,
+      view->pTapeInfos.sHinfos.p, view->pTapeInfos.sHinfos.indep);
+#endif
+  if (view->pTapeInfos.tay_fileName != NULL)
+    free(view->pTapeInfos.tay_fileName);
+  if (view->signature != NULL)
+    free(view->signature);
+
+  view->pTapeInfos.op_fileName = NULL;
+  view->pTapeInfos.loc_fileName = NULL;
+  view->pTapeInfos.val_fileName = NULL;
+  view->pTapeInfos.tay_fileName = NULL;
+  view->pTapeInfos.paramstore = NULL;
+  delete view;
+}
+
 #endif /* _OPENMP */
 
+/****************************************************************************/
+/* Freezes the in-core tape tag, see taping.h.                              */
+/****************************************************************************/
+int freeze_tape(short tag) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (ADOLC_GLOBAL_TAPE_VARS.inParallelRegion != 0)
+    return -1;
+  TapeInfos *tapeInfos = const_cast<TapeInfos *>(shareableTape(tag));
+  if (tapeInfos == NULL)
+    return -1;
+  tapeInfos->pTapeInfos.frozen = 1;
+  return 0;
+}
+
+/****************************************************************************/
+/* Thaws the tape tag and releases the views of all workers, see taping.h.  */
+/****************************************************************************/
+int thaw_tape(short tag) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (ADOLC_GLOBAL_TAPE_VARS.inParallelRegion != 0)
+    return -1;
+  vector<TapeInfos *>::iterator tiIter = std::find_if(
+      ADOLC_TAPE_INFOS_BUFFER.begin(), ADOLC_TAPE_INFOS_BUFFER.end(),
+      [&tag](auto &&ti) { return ti->tapeID == tag; });
+  if (tiIter == ADOLC_TAPE_INFOS_BUFFER.end() ||
+      (*tiIter)->pTapeInfos.frozen == 0)
+    return -1;
+  (*tiIter)->pTapeInfos.frozen = 0;
+
+#if defined(_OPENMP)
+  if (!firstParallel)
+    for (int i = 0; i < numParallelThreads; ++i) {
+      vector<TapeInfos *> &workerBuffer = tapeInfosBuffer_p[i];
+      for (vector<TapeInfos *>::iterator view = workerBuffer.begin();
+           view != workerBuffer.end();)
+        if ((*view)->frozenTape == *tiIter) {
+          deleteTapeView(*view);
+          view = workerBuffer.erase(view);
+        } else
+          ++view;
+    }
+#endif
+  return 0;
+}
+
+/****************************************************************************/
+/*                                                               WORKSPACES */
+/* The Taylor and adjoint arrays of the sweeps and the seeds of the drivers */
+/* are kept in the persistent part of the tape of the calling thread. A     */
+/* sweep takes the array out of the tape and gives it back when it ends, so */
+/* that a nested sweep on the same tape gets an array of its own. Of two    */
+/* arrays given back, the larger one is kept. The driver cache is handled   */
+/* the same way, but it keeps the block given back last.                    */
+
+namespace {
+
+/* precedes every kept array, aligned for all element types */
+union WorkspaceHeader {
+  size_t capacity;
+  max_align_t align;
+};
+
+WorkspaceHeader *workspaceHeader(void *block) {
+  return (WorkspaceHeader *)block - 1;
+}
+
+/* takes the array kept in slot or allocates a larger one */
+void *takeWorkspace(void *&slot, size_t bytes, int clear) {
+  void *block = slot;
+
+  if (block == NULL || workspaceHeader(block)->capacity < bytes) {
+    if (block != NULL)
+      free(workspaceHeader(block));
+    WorkspaceHeader *header =
+        (WorkspaceHeader *)malloc(sizeof(WorkspaceHeader) + bytes);
+    if (header == NULL)
+      fail(ADOLC_MALLOC_FAILED);
+    header->capacity = bytes;
+    block = header + 1;
+  }
+  slot = NULL;
+  if (clear)
+    memset(block, 0, bytes);
+  return block;
+}
+
+/* keeps the larger one of block and the array in slot */
+void giveWorkspace(void *&slot, void *block) {
+  if (block == NULL)
+    return;
+  if (slot != NULL) {
+    if (workspaceHeader(slot)->capacity >= workspaceHeader(block)->capacity) {
+      free(workspaceHeader(block));
+      return;
+    }
+    free(workspaceHeader(slot));
+  }
+  slot = block;
+}
+
+/* While a tape is swept, the copy in ADOLC_CURRENT_TAPE_INFOS holds its
+ * arrays, the stored TapeInfos only gets them back by releaseTape. */
+TapeInfos *workspaceTape(short tag) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr != NULL &&
+      ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr->tapeID == tag)
+    return &ADOLC_CURRENT_TAPE_INFOS;
+  for (TapeInfos *tapeInfos : ADOLC_TAPE_INFOS_BUFFER)
+    if (tapeInfos->tapeID == tag)
+      return tapeInfos;
+  return NULL;
+}
+
+} // namespace
+
+void *borrowWorkspace(TapeInfos *tapeInfos, int kind, size_t bytes,
+                      int clear) {
+  return takeWorkspace(tapeInfos->pTapeInfos.workspace[kind], bytes, clear);
+}
+
+double **borrowWorkspace2(TapeInfos *tapeInfos, int kind, size_t m,
+                          size_t n) {
+  double **A = NULL;
+
+  if (m > 0 && n > 0)
+    populate_dpp(&A,
+                 (char *)borrowWorkspace(tapeInfos, kind,
+                                         m * sizeof(double *) +
+                                             m * n * sizeof(double),
+                                         1),
+                 m, n);
+  return A;
+}
+
+void returnWorkspace(TapeInfos *tapeInfos, int kind, void *block) {
+  giveWorkspace(tapeInfos->pTapeInfos.workspace[kind], block);
+}
+
+void *borrowDriverWorkspace(short tag, size_t bytes) {
+  TapeInfos *tapeInfos = workspaceTape(tag);
+  void *none = NULL;
+
+  if (tapeInfos == NULL)
+    return takeWorkspace(none, bytes, 1);
+  return borrowWorkspace(tapeInfos, ADOLC_WS_DRIVER, bytes, 1);
+}
+
+void returnDriverWorkspace(short tag, void *block) {
+  TapeInfos *tapeInfos = workspaceTape(tag);
+
+  if (tapeInfos != NULL)
+    returnWorkspace(tapeInfos, ADOLC_WS_DRIVER, block);
+  else if (block != NULL)
+    free(workspaceHeader(block));
+}
+
+void *borrowDriverCache(short tag) {
+  TapeInfos *tapeInfos = workspaceTape(tag);
+  void *cache = NULL;
+
+  if (tapeInfos != NULL) {
+    cache = tapeInfos->pTapeInfos.driverCache;
+    tapeInfos->pTapeInfos.driverCache = NULL;
+  }
+  return cache;
+}
+
+void returnDriverCache(short tag, void *cache) {
+  TapeInfos *tapeInfos = workspaceTape(tag);
+
+  if (tapeInfos == NULL) {
+    free(cache);
+    return;
+  }
+  free(tapeInfos->pTapeInfos.driverCache);
+  tapeInfos->pTapeInfos.driverCache = cache;
+}
+
+void freeWorkspaces(PersistantTapeInfos *pTapeInfos) {
+  for (int kind = 0; kind < ADOLC_NUM_WORKSPACES; ++kind)
+    if (pTapeInfos->workspace[kind] != NULL) {
+      free(workspaceHeader(pTapeInfos->workspace[kind]));
+      pTapeInfos->workspace[kind] = NULL;
+    }
+  free(pTapeInfos->driverCache);
+  pTapeInfos->driverCache = NULL;
+}
+
+/****************************************************************************/
+/* Frees the workspaces of tape tag or all tapes, see taping.h.             */
+/****************************************************************************/
+void release_workspace(short tag) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  for (TapeInfos *tapeInfos : ADOLC_TAPE_INFOS_BUFFER) {
+    if (tag >= 0 && tapeInfos->tapeID != tag)
+      continue;
+    if (tapeInfos == ADOLC_GLOBAL_TAPE_VARS.currentTapeInfosPtr) {
+      /* the stored pointers are stale copies of the current ones */
+      freeWorkspaces(&ADOLC_CURRENT_TAPE_INFOS.pTapeInfos);
+      for (int kind = 0; kind < ADOLC_NUM_WORKSPACES; ++kind)
+        tapeInfos->pTapeInfos.workspace[kind] = NULL;
+    } else
+      freeWorkspaces(&tapeInfos->pTapeInfos);
+  }
+}
+
 TapeInfos::TapeInfos() : pTapeInfos() { initTapeInfos(this); }
 
 TapeInfos::TapeInfos(short _tapeID) : pTapeInfos() {
@@ -1114,6 +1562,23 @@ void TapeInfos::copy(const TapeInfos &tInfos) {
   lowestXLoc_ext_v2 = tInfos.lowestXLoc_ext_v2;
   lowestYLoc_ext_v2 = tInfos.lowestYLoc_ext_v2;
 
+  /* mapped tape files */
+  op_map = tInfos.op_map;
+  op_mapSize = tInfos.op_mapSize;
+  loc_map = tInfos.loc_map;
+  loc_mapSize = tInfos.loc_mapSize;
+  val_map = tInfos.val_map;
+  val_mapSize = tInfos.val_mapSize;
+
+  op_io = tInfos.op_io;
+  loc_io = tInfos.loc_io;
+  val_io = tInfos.val_io;
+  tay_io = tInfos.tay_io;
+
+  op_revPos = tInfos.op_revPos;
+  loc_revPos = tInfos.loc_revPos;
+  val_revPos = tInfos.val_revPos;
+
   /* evaluation forward */
   dp_T0 = tInfos.dp_T0;
   gDegree = tInfos.gDegree;
@@ -1137,6 +1602,8 @@ void TapeInfos::copy(const TapeInfos &tInfos) {
   switchlocs = tInfos.switchlocs;
   signature = tInfos.signature;
 
+  frozenTape = tInfos.frozenTape;
+
   pTapeInfos = tInfos.pTapeInfos;
 }
 
@@ -1162,6 +1629,7 @@ PersistantTapeInfos::~PersistantTapeInfos() {
     myfree2(forodec_Z);
     forodec_nax = 0;
   }
+  freeWorkspaces(this);
   if (paramstore != NULL) {
     free(paramstore);
     paramstore = NULL;
@@ -0,0 +1,515 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     tape_optimizer.cpp
+ Revision: $Id$
+ Contents: optimization of finished tapes: dead code elimination, copy
+           propagation, renumbering and reordering of locations
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#include "dvlparms.h"
+#include "oplate.h"
+#include "taping_p.h"
+
+#include <cstring>
+#include <limits>
+#include <set>
+#include <vector>
+
+/****************************************************************************/
+/* Layout of the locations an operation writes to the tape, one character   */
+/* per location (in the order of uni5_for.c):                               */
+/*   'L' location read, 'R' location written,                               */
+/*   'M' location read and written in place, 'P' index of a parameter.      */
+/* Returns NULL for operations the optimizer does not handle.               */
+/****************************************************************************/
+const char *opLayout(unsigned char op, int *numVals, bool *essential) {
+  *numVals = 0;
+  *essential = false;
+  switch (op) {
+  case eq_zero:
+  case neq_zero:
+  case le_zero:
+  case gt_zero:
+  case ge_zero:
+  case lt_zero:
+  case assign_dep:
+    *essential = true;
+    return "L";
+  case assign_ind:
+    *essential = true;
+    return "R";
+  case assign_a:
+  case pos_sign_a:
+  case neg_sign_a:
+  case exp_op:
+  case log_op:
+  case sqrt_op:
+  case cbrt_op:
+    return "LR";
+  case assign_d:
+    *numVals = 1;
+    return "R";
+  case assign_d_zero:
+  case assign_d_one:
+    return "R";
+  case assign_p:
+  case neg_sign_p:
+  case recipr_p:
+    return "PR";
+  case eq_plus_d:
+  case eq_min_d:
+  case eq_mult_d:
+    *numVals = 1;
+    return "M";
+  case eq_plus_p:
+  case eq_min_p:
+  case eq_mult_p:
+    return "PM";
+  case eq_plus_a:
+  case eq_min_a:
+  case eq_mult_a:
+    return "LM";
+  case incr_a:
+  case decr_a:
+    return "M";
+  case plus_a_a:
+  case min_a_a:
+  case mult_a_a:
+  case div_a_a:
+    return "LLR";
+  case plus_d_a:
+  case min_d_a:
+  case mult_d_a:
+  case div_d_a:
+  case pow_op:
+    *numVals = 1;
+    return "LR";
+  case plus_a_p:
+  case min_a_p:
+  case mult_a_p:
+  case div_p_a:
+  case pow_op_p:
+    return "LPR";
+  case eq_plus_prod:
+  case eq_min_prod:
+    return "LLM";
+  case sin_op: /* the second location receives the covalue */
+  case cos_op:
+    return "LRR";
+  case atan_op: /* the second location holds the derivative */
+  case asin_op:
+  case acos_op:
+  case asinh_op:
+  case acosh_op:
+  case atanh_op:
+  case erf_op:
+  case erfc_op:
+    return "LLR";
+  case gen_quad:
+    *numVals = 2;
+    return "LLR";
+  case min_op:
+    *numVals = 1;
+    return "LLR";
+  case abs_val: /* switches are numbered in the order of the abs_val ops */
+    *numVals = 1;
+    *essential = true;
+    return "LR";
+  case ceil_op:
+  case floor_op:
+    *numVals = 1;
+    return "LR";
+  case cond_assign:
+  case cond_eq_assign:
+    *numVals = 1;
+    return "LLLR";
+  case cond_assign_s:
+  case cond_eq_assign_s:
+    *numVals = 1;
+    return "LLM";
+  default:
+    return NULL;
+  }
+}
+
+namespace {
+
+const locint noLoc = std::numeric_limits<locint>::max();
+
+/* one operation of the tape, its operands are stored in OptTape */
+struct TapeOp {
+  unsigned char op;
+  const char *layout; /* role of each location, see opLayout */
+  size_t firstLoc;    /* first location in OptTape::locs */
+  size_t firstVal;    /* first value in OptTape::vals */
+  int numVals;
+  bool essential; /* kept even if no result reaches a dependent */
+  bool fromStock; /* initialization recorded by take_stock */
+  bool removed;
+};
+
+struct OptTape {
+  std::vector<TapeOp> ops;
+  std::vector<locint> locs;
+  std::vector<double> vals;
+  std::vector<char> dies; /* per location: value not used after the op */
+  locint numLocs;         /* largest location used + 1 */
+};
+
+inline bool isRead(char role) { return role == 'L' || role == 'M'; }
+inline bool isWritten(char role) { return role == 'R' || role == 'M'; }
+
+void appendOp(OptTape &tape, unsigned char op, const char *layout,
+              int numVals, bool essential) {
+  TapeOp o;
+  o.op = op;
+  o.layout = layout;
+  o.firstLoc = tape.locs.size();
+  o.firstVal = tape.vals.size();
+  o.numVals = numVals;
+  o.essential = essential;
+  o.fromStock = false;
+  o.removed = false;
+  tape.ops.push_back(o);
+}
+
+/****************************************************************************/
+/* Reads tape "tag" into "tape". The values recorded by take_stock become   */
+/* single assign_d operations, only those that are used survive. Returns    */
+/* false if the tape contains an operation the optimizer does not handle.   */
+/****************************************************************************/
+bool readTape(short tag, OptTape &tape, size_t *stats, bool *deathNot) {
+  unsigned char op;
+  const char *layout;
+  int numVals;
+  bool essential, handled = true;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  init_for_sweep(tag);
+  memcpy(stats, ADOLC_CURRENT_TAPE_INFOS.stats, STAT_SIZE * sizeof(size_t));
+  *deathNot = false;
+
+  op = get_op_f();
+  while (op != end_of_tape && handled) {
+    switch (op) {
+    case end_of_op:
+      get_op_block_f();
+      op = get_op_f();
+      /* Skip next operation, it's another end_of_op */
+      break;
+    case end_of_int:
+      get_loc_block_f();
+      break;
+    case end_of_val:
+      get_val_block_f();
+      break;
+    case start_of_tape:
+      break;
+    case death_not:
+      /* rewritten for the new locations at the end of the tape */
+      get_locint_f();
+      get_locint_f();
+      *deathNot = true;
+      break;
+    case take_stock_op: {
+      locint size = get_locint_f();
+      locint res = get_locint_f();
+      double *d = get_val_v_f(size);
+      for (locint i = 0; i < size; ++i) {
+        appendOp(tape, assign_d, "R", 1, false);
+        tape.ops.back().fromStock = true;
+        tape.locs.push_back(res + i);
+        tape.vals.push_back(d[i]);
+      }
+      break;
+    }
+    default:
+      layout = opLayout(op, &numVals, &essential);
+      if (layout == NULL) {
+        handled = false;
+        break;
+      }
+      appendOp(tape, op, layout, numVals, essential);
+      for (size_t k = 0; layout[k] != 0; ++k)
+        tape.locs.push_back(get_locint_f());
+      for (int k = 0; k < numVals; ++k)
+        tape.vals.push_back(get_val_f());
+      break;
+    }
+    op = get_op_f();
+  }
+  end_sweep();
+
+  tape.numLocs = 0;
+  for (const TapeOp &o : tape.ops)
+    for (size_t k = 0; o.layout[k] != 0; ++k)
+      if (o.layout[k] != 'P' && tape.locs[o.firstLoc + k] >= tape.numLocs)
+        tape.numLocs = tape.locs[o.firstLoc + k] + 1;
+  return handled;
+}
+
+/****************************************************************************/
+/* Lets reads of a location copied by assign_a or pos_sign_a refer to the   */
+/* source of the copy as long as neither location has been overwritten.     */
+/* The copies themselves become dead and are left to the dead code pass.    */
+/****************************************************************************/
+void propagateCopies(OptTape &tape) {
+  std::vector<locint> copyOf(tape.numLocs, noLoc);
+  std::vector<size_t> copyVersion(tape.numLocs, 0);
+  std::vector<size_t> version(tape.numLocs, 0);
+
+  for (TapeOp &o : tape.ops) {
+    locint *loc = &tape.locs[o.firstLoc];
+    const char *layout = o.layout;
+    /* assign_dep sets the adjoint of its location during reverse sweeps,
+     * so a location must never serve as two dependents */
+    if (o.op != assign_dep)
+      for (size_t k = 0; layout[k] != 0; ++k) {
+        locint src = copyOf[loc[k]];
+        if (layout[k] != 'L' || src == noLoc ||
+            version[src] != copyVersion[loc[k]])
+          continue;
+        bool overwritten = false;
+        for (size_t j = 0; layout[j] != 0; ++j)
+          if (isWritten(layout[j]) && loc[j] == src)
+            overwritten = true;
+        if (!overwritten)
+          loc[k] = src;
+      }
+    for (size_t k = 0; layout[k] != 0; ++k)
+      if (isWritten(layout[k])) {
+        ++version[loc[k]];
+        copyOf[loc[k]] = noLoc;
+      }
+    if ((o.op == assign_a || o.op == pos_sign_a) && loc[0] != loc[1]) {
+      copyOf[loc[1]] = loc[0];
+      copyVersion[loc[1]] = version[loc[0]];
+    }
+  }
+}
+
+/****************************************************************************/
+/* Backward liveness starting from the dependents. Marks for each location  */
+/* of an operation whether its value is still used afterwards and, if       */
+/* "removeDead" is set, removes the operations none of whose results is     */
+/* used. Unused values recorded by take_stock are dropped in any case.      */
+/* Returns the number of removed operations of the original tape.           */
+/****************************************************************************/
+size_t analyzeLiveness(OptTape &tape, bool removeDead) {
+  std::vector<char> usedLater(tape.numLocs, 0);
+  size_t removed = 0;
+
+  tape.dies.assign(tape.locs.size(), 0);
+  for (size_t i = tape.ops.size(); i-- > 0;) {
+    TapeOp &o = tape.ops[i];
+    const locint *loc = &tape.locs[o.firstLoc];
+    char *dies = &tape.dies[o.firstLoc];
+    size_t n = strlen(o.layout);
+
+    if ((removeDead || o.fromStock) && !o.essential) {
+      bool live = false;
+      for (size_t k = 0; k < n; ++k)
+        if (isWritten(o.layout[k]) && usedLater[loc[k]])
+          live = true;
+      if (!live) {
+        o.removed = true;
+        if (!o.fromStock)
+          ++removed;
+        continue;
+      }
+    }
+    /* locations are read before the results are written */
+    for (size_t k = n; k-- > 0;)
+      if (o.layout[k] == 'R') {
+        dies[k] = !usedLater[loc[k]];
+        usedLater[loc[k]] = 0;
+      }
+    for (size_t k = n; k-- > 0;)
+      if (isRead(o.layout[k])) {
+        dies[k] = !usedLater[loc[k]];
+        usedLater[loc[k]] = 1;
+      }
+  }
+  return removed;
+}
+
+/****************************************************************************/
+/* Assigns new locations, always taking the lowest free one. A location     */
+/* becomes free after the operation that uses its value for the last time,  */
+/* so results never share a location with the arguments of their operation. */
+/* Returns the number of locations needed.                                  */
+/****************************************************************************/
+locint renumberLocations(OptTape &tape) {
+  std::vector<locint> newLoc(tape.numLocs, noLoc);
+  std::set<locint> freeLocs;
+  std::vector<locint> released;
+  locint numLives = 0;
+
+  auto nextLoc = [&]() {
+    if (freeLocs.empty())
+      return numLives++;
+    locint l = *freeLocs.begin();
+    freeLocs.erase(freeLocs.begin());
+    return l;
+  };
+
+  for (TapeOp &o : tape.ops) {
+    if (o.removed)
+      continue;
+    locint *loc = &tape.locs[o.firstLoc];
+    const char *dies = &tape.dies[o.firstLoc];
+    const char *layout = o.layout;
+
+    released.clear();
+    for (size_t k = 0; layout[k] != 0; ++k)
+      if (isRead(layout[k])) {
+        /* values read before being written get a location of their own */
+        if (newLoc[loc[k]] == noLoc)
+          newLoc[loc[k]] = nextLoc();
+        if (dies[k])
+          released.push_back(newLoc[loc[k]]);
+      }
+    for (size_t k = 0; layout[k] != 0; ++k)
+      if (layout[k] == 'R') {
+        newLoc[loc[k]] = nextLoc();
+        if (dies[k])
+          released.push_back(newLoc[loc[k]]);
+      }
+    for (size_t k = 0; layout[k] != 0; ++k)
+      if (layout[k] != 'P')
+        loc[k] = newLoc[loc[k]];
+    freeLocs.insert(released.begin(), released.end());
+  }
+  return numLives;
+}
+
+/****************************************************************************/
+/* Numbers the locations in the order of their first use on the tape. The   */
+/* operations of a sweep then touch neighbouring entries of the Taylor and  */
+/* adjoint arrays, and locations never used drop out. Returns the number    */
+/* of locations needed.                                                     */
+/****************************************************************************/
+locint orderByFirstUse(OptTape &tape) {
+  std::vector<locint> newLoc(tape.numLocs, noLoc);
+  locint numLives = 0;
+
+  for (TapeOp &o : tape.ops) {
+    if (o.removed)
+      continue;
+    locint *loc = &tape.locs[o.firstLoc];
+    for (size_t k = 0; o.layout[k] != 0; ++k)
+      if (o.layout[k] != 'P') {
+        if (newLoc[loc[k]] == noLoc)
+          newLoc[loc[k]] = numLives++;
+        loc[k] = newLoc[loc[k]];
+      }
+  }
+  return numLives;
+}
+
+/****************************************************************************/
+/* Overwrites tape "tag" with the remaining operations of "tape".           */
+/****************************************************************************/
+void writeTape(short tag, const OptTape &tape, const size_t *stats,
+               locint numLives, bool deathNot) {
+  size_t numEqProd = 0, numTays = 0;
+  int flag;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  initNewTape(tag);
+  freeTapeResources(&ADOLC_CURRENT_TAPE_INFOS);
+  ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE] = stats[OP_BUFFER_SIZE];
+  ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE] = stats[LOC_BUFFER_SIZE];
+  ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE] = stats[VAL_BUFFER_SIZE];
+  ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE] = stats[TAY_BUFFER_SIZE];
+  ADOLC_CURRENT_TAPE_INFOS.stats[NO_MIN_MAX] = stats[NO_MIN_MAX];
+  ADOLC_CURRENT_TAPE_INFOS.keepTaylors = 0;
+  start_trace();
+
+  for (const TapeOp &o : tape.ops) {
+    if (o.removed)
+      continue;
+    put_op(o.op);
+    for (size_t k = 0; o.layout[k] != 0; ++k) {
+      ADOLC_PUT_LOCINT(tape.locs[o.firstLoc + k]);
+      if (isWritten(o.layout[k]))
+        ++numTays;
+    }
+    for (int k = 0; k < o.numVals; ++k)
+      ADOLC_PUT_VAL(tape.vals[o.firstVal + k]);
+    if (o.op == eq_plus_prod || o.op == eq_min_prod)
+      ++numEqProd;
+  }
+  if (deathNot) {
+    put_op(death_not);
+    ADOLC_PUT_LOCINT(0);
+    ADOLC_PUT_LOCINT(numLives - 1);
+    numTays += numLives;
+  }
+  ADOLC_CURRENT_TAPE_INFOS.traceFlag = 0;
+
+  ADOLC_CURRENT_TAPE_INFOS.numInds = stats[NUM_INDEPENDENTS];
+  ADOLC_CURRENT_TAPE_INFOS.numDeps = stats[NUM_DEPENDENTS];
+  ADOLC_CURRENT_TAPE_INFOS.num_eq_prod = numEqProd;
+  ADOLC_CURRENT_TAPE_INFOS.numSwitches = stats[NUM_SWITCHES];
+  ADOLC_CURRENT_TAPE_INFOS.numTays_Tape = numTays;
+  ADOLC_CURRENT_TAPE_INFOS.stats[NUM_INDEPENDENTS] = stats[NUM_INDEPENDENTS];
+  ADOLC_CURRENT_TAPE_INFOS.stats[NUM_DEPENDENTS] = stats[NUM_DEPENDENTS];
+  ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] = numLives;
+  ADOLC_CURRENT_TAPE_INFOS.stats[TAY_STACK_SIZE] = numTays;
+  ADOLC_CURRENT_TAPE_INFOS.stats[NUM_EQ_PROD] = numEqProd;
+  ADOLC_CURRENT_TAPE_INFOS.stats[NUM_SWITCHES] = stats[NUM_SWITCHES];
+  ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM] = stats[NUM_PARAM];
+
+  /* a tape that has been on disk stays there */
+  flag = stats[OP_FILE_ACCESS] || stats[LOC_FILE_ACCESS] ||
+         stats[VAL_FILE_ACCESS];
+  stop_retrace(flag);
+  ADOLC_CURRENT_TAPE_INFOS.tapingComplete = 1;
+  ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_NO_MODE;
+  releaseTape();
+}
+
+} // namespace
+
+/****************************************************************************/
+/* Rewrites the finished tape "tag" applying the passes selected by flags.  */
+/****************************************************************************/
+int optimize_tape(short tag, int flags) {
+  OptTape tape;
+  size_t stats[STAT_SIZE];
+  size_t removed;
+  locint numLives;
+  bool deathNot;
+
+  /* workers may be sweeping the tape */
+  if (getTapeInfos(tag)->pTapeInfos.frozen != 0)
+    return -1;
+  if (!readTape(tag, tape, stats, &deathNot))
+    return -1;
+
+  if (flags & ADOLC_OPT_COPY_PROP)
+    propagateCopies(tape);
+  removed = analyzeLiveness(tape, (flags & ADOLC_OPT_DEAD_CODE) != 0);
+  if (flags & ADOLC_OPT_RENUMBER)
+    tape.numLocs = renumberLocations(tape);
+  if (flags & ADOLC_OPT_LOCALITY)
+    tape.numLocs = orderByFirstUse(tape);
+  if (flags & (ADOLC_OPT_RENUMBER | ADOLC_OPT_LOCALITY))
+    numLives = tape.numLocs;
+  else
+    numLives = stats[NUM_MAX_LIVES] > tape.numLocs ? stats[NUM_MAX_LIVES]
+                                                    : tape.numLocs;
+  if (numLives == 0)
+    numLives = 1;
+
+  writeTape(tag, tape, stats, numLives, deathNot);
+  return (int)removed;
+}
@@ -25,6 +25,15 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 
+#if !defined(_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define ADOLC_HAVE_MMAP 1
+#include <pthread.h>
+#define ADOLC_HAVE_PTHREAD 1
+#endif
+
 #ifdef ADOLC_AMPI_SUPPORT
 #include "ampi/ampi.h"
 #include "ampi/tape/support.h"
@@ -311,6 +320,12 @@ void fail(int error) {
                       "ensureContiguousLocations(size_t) to reserve  "
                       "contiguous blocks prior to allocation of the arrays.\n");
     break;
+  case ADOLC_TAPING_TAPE_FROZEN:
+    fprintf(DIAG_OUT,
+            "ADOL-C error: Tape %d is frozen and cannot be retaped before "
+            "thaw_tape is called!\n",
+            failAdditionalInfo1);
+    break;
 
   default:
     fprintf(DIAG_OUT, "ADOL-C error => unknown error type!\n");
@@ -488,6 +503,9 @@ void readConfigFile() {
   ADOLC_GLOBAL_TAPE_VARS.valueBufferSize = VBUFSIZE;
   ADOLC_GLOBAL_TAPE_VARS.taylorBufferSize = TBUFSIZE;
   ADOLC_GLOBAL_TAPE_VARS.maxNumberTaylorBuffers = TBUFNUM;
+  ADOLC_GLOBAL_TAPE_VARS.tapeStorage = ADOLC_TAPE_STORE_BUFFERED;
+  ADOLC_GLOBAL_TAPE_VARS.tapeCodec = ADOLC_TAPE_CODEC_NONE;
+  ADOLC_GLOBAL_TAPE_VARS.dirChunkSize = DIRCHUNKSIZE;
   if ((configFile = fopen(".adolcrc", "r")) != NULL) {
     fprintf(DIAG_OUT, "\nFile .adolcrc found! => Try to parse it!\n");
     fprintf(DIAG_OUT, "****************************************\n");
@@ -618,6 +636,16 @@ void readConfigFile() {
             fprintf(DIAG_OUT, "Found initial live variable store size : %u\n",
                     (locint)number);
             checkInitialStoreSize(&ADOLC_GLOBAL_TAPE_VARS);
+          } else if (strcmp(pos1 + 1, "TAPESTORE") == 0) {
+            ADOLC_GLOBAL_TAPE_VARS.tapeStorage = (int)number;
+            fprintf(DIAG_OUT, "Found tape storage type: %d\n", (int)number);
+          } else if (strcmp(pos1 + 1, "TAPECODEC") == 0) {
+            ADOLC_GLOBAL_TAPE_VARS.tapeCodec = (int)number;
+            fprintf(DIAG_OUT, "Found tape codec: %d\n", (int)number);
+          } else if (strcmp(pos1 + 1, "DIRCHUNKSIZE") == 0) {
+            ADOLC_GLOBAL_TAPE_VARS.dirChunkSize = (size_t)number;
+            fprintf(DIAG_OUT, "Found direction chunk size: %zu\n",
+                    (size_t)number);
           } else {
             fprintf(DIAG_OUT, "ADOL-C warning: Unable to parse "
                               "parameter name in .adolcrc!\n");
@@ -707,6 +735,427 @@ locint keep_stock() {
   return ADOLC_GLOBAL_TAPE_VARS.storeSize;
 }
 
+/****************************************************************************/
+/* Asynchronous tape I/O (ADOLC_TAPE_STORE_ASYNC). Every tape file gets a   */
+/* second buffer of the same size. During taping, full blocks are handed    */
+/* over to a background thread for writing while taping continues in the    */
+/* other buffer. During sweeps, the block needed next is read into the      */
+/* second buffer while the current one is evaluated and both are swapped    */
+/* at the block switch. At most one transfer per file is outstanding.       */
+/****************************************************************************/
+typedef struct TapeIOJob {
+#if defined(ADOLC_HAVE_PTHREAD)
+  pthread_t thread;
+#endif
+  FILE *file;
+  char *buffer;  /* second buffer, swapped with the tape buffer */
+  size_t offset; /* file position of the transfer in bytes */
+  size_t bytes;  /* length of the transfer in bytes */
+  int writing;   /* append buffer instead of reading into it */
+  int pending;   /* transfer started, thread not joined yet */
+  int valid;     /* buffer holds the block read from offset */
+  int failed;    /* transfer did not complete */
+} TapeIOJob;
+
+/* does the current tape use background transfers ? */
+static int useTapeIO(void) {
+#if defined(ADOLC_HAVE_PTHREAD)
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+  /* compressed blocks have no fixed position in the files */
+  return ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeStorage ==
+             ADOLC_TAPE_STORE_ASYNC &&
+         ADOLC_CURRENT_TAPE_INFOS.stats[TAPE_CODEC] == ADOLC_TAPE_CODEC_NONE;
+#else
+  return 0;
+#endif
+}
+
+static void *tapeIOThread(void *arg) {
+  TapeIOJob *job = (TapeIOJob *)arg;
+  size_t done = 0, chunk, count;
+
+  /* blocks are appended, reads may go anywhere */
+  if (!job->writing && fseek(job->file, job->offset, SEEK_SET) != 0) {
+    job->failed = 1;
+    return NULL;
+  }
+  while (done < job->bytes) {
+    chunk = MIN_ADOLC(job->bytes - done, ADOLC_IO_CHUNK_SIZE);
+    if (job->writing)
+      count = fwrite(job->buffer + done, chunk, 1, job->file);
+    else
+      count = fread(job->buffer + done, chunk, 1, job->file);
+    if (count != 1) {
+      job->failed = 1;
+      break;
+    }
+    done += chunk;
+  }
+  return NULL;
+}
+
+/* waits for the outstanding transfer of job, returns 1 if it failed */
+static int waitTapeIO(TapeIOJob *job) {
+  int failed;
+
+  if (job == NULL)
+    return 0;
+#if defined(ADOLC_HAVE_PTHREAD)
+  if (job->pending)
+    pthread_join(job->thread, NULL);
+#endif
+  job->pending = 0;
+  failed = job->failed;
+  job->failed = 0;
+  if (failed)
+    job->valid = 0;
+  return failed;
+}
+
+/* waits for an outstanding write of job and reports a failure */
+static void syncTapeIO(TapeIOJob *job) {
+  if (job != NULL && job->writing && waitTapeIO(job))
+    fail(ADOLC_TAPING_FATAL_IO_ERROR);
+}
+
+/* returns the job of a tape file with an idle second buffer of bufferBytes,
+ * NULL if memory is short => synchronous I/O is used instead */
+static TapeIOJob *idleTapeIO(TapeIOJob **job, size_t bufferBytes, int error) {
+  if (*job == NULL) {
+    *job = (TapeIOJob *)calloc(1, sizeof(TapeIOJob));
+    if (*job == NULL)
+      return NULL;
+  }
+  if (waitTapeIO(*job))
+    fail(error);
+  (*job)->valid = 0;
+  if ((*job)->buffer == NULL)
+    (*job)->buffer = (char *)malloc(bufferBytes);
+  if ((*job)->buffer == NULL)
+    return NULL;
+  return *job;
+}
+
+static void startTapeIO(TapeIOJob *job, FILE *file, size_t offset,
+                        size_t bytes, int writing) {
+  job->file = file;
+  job->offset = offset;
+  job->bytes = bytes;
+  job->writing = writing;
+  job->valid = !writing;
+#if defined(ADOLC_HAVE_PTHREAD)
+  if (pthread_create(&job->thread, NULL, tapeIOThread, job) == 0) {
+    job->pending = 1;
+    return;
+  }
+#endif
+  /* no thread available => transfer now */
+  tapeIOThread(job);
+}
+
+/* starts reading bytes at offset of file into the second buffer */
+static void prefetchTapeBlock(TapeIOJob **job, FILE *file, size_t offset,
+                              size_t bytes, size_t bufferBytes, int error) {
+  TapeIOJob *idle;
+
+  if (file == NULL || bytes == 0)
+    return;
+  idle = idleTapeIO(job, bufferBytes, error);
+  if (idle != NULL)
+    startTapeIO(idle, file, offset, bytes, 0);
+}
+
+/* if the block at offset has been read ahead, its buffer is returned and
+ * buffer is kept as second buffer, otherwise NULL is returned */
+static void *takePrefetchedBlock(TapeIOJob *job, void *buffer, size_t offset,
+                                 size_t bytes, int error) {
+  char *block;
+
+  if (job == NULL)
+    return NULL;
+  if (waitTapeIO(job))
+    fail(error);
+  if (!job->valid || job->offset != offset || job->bytes != bytes)
+    return NULL;
+  block = job->buffer;
+  job->buffer = (char *)buffer;
+  job->valid = 0;
+  return block;
+}
+
+/* hands buffer over for appending bytes to file, returns the second buffer
+ * to continue in or NULL if the block has to be written directly */
+static void *writeBehindTapeBlock(TapeIOJob **job, FILE *file, void *buffer,
+                                  size_t bytes, size_t bufferBytes) {
+  TapeIOJob *idle;
+  char *spare;
+
+  idle = idleTapeIO(job, bufferBytes, ADOLC_TAPING_FATAL_IO_ERROR);
+  if (idle == NULL)
+    return NULL;
+  spare = idle->buffer;
+  idle->buffer = (char *)buffer;
+  startTapeIO(idle, file, 0, bytes, 1);
+  return spare;
+}
+
+static void releaseTapeIOJob(TapeIOJob **job) {
+  if (*job == NULL)
+    return;
+  waitTapeIO(*job);
+  free((*job)->buffer);
+  free(*job);
+  *job = NULL;
+}
+
+void releaseTapeIO(TapeInfos *tapeInfos) {
+  releaseTapeIOJob(&tapeInfos->op_io);
+  releaseTapeIOJob(&tapeInfos->loc_io);
+  releaseTapeIOJob(&tapeInfos->val_io);
+  releaseTapeIOJob(&tapeInfos->tay_io);
+}
+
+/****************************************************************************/
+/* Compressed tape files (ADOLC_TAPE_CODEC_BLOCK). Every buffer written to  */
+/* hard disk becomes one self-contained block:                              */
+/*   TapeBlockHeader | payload | size_t payload bytes                       */
+/* The trailing size allows reading the blocks back to front. Locations are */
+/* stored as zigzag coded differences in variable length integers, opcodes */
+/* and values are compressed with a small LZ77 scheme. Blocks which do not  */
+/* shrink are stored raw. The location file starts with a raw region of     */
+/* statSpace locints that receives the tape stats in close_tape.            */
+/****************************************************************************/
+enum TapeBlockMethod { TAPE_BLOCK_RAW, TAPE_BLOCK_LZ, TAPE_BLOCK_DELTA };
+
+typedef struct TapeBlockHeader {
+  size_t bytes;  /* size of the payload */
+  size_t count;  /* number of elements in the block */
+  size_t method; /* see TapeBlockMethod */
+} TapeBlockHeader;
+
+#define TAPE_LZ_MIN_MATCH 4
+#define TAPE_LZ_HASH_BITS 12
+#define TAPE_VARINT_MAX 10
+
+/* are the tape files of the current tape compressed ? */
+static int useTapeCodec(void) {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+  return ADOLC_CURRENT_TAPE_INFOS.stats[TAPE_CODEC] != ADOLC_TAPE_CODEC_NONE;
+}
+
+static size_t putVarint(unsigned char *out, size_t value) {
+  size_t n = 0;
+  while (value >= 0x80) {
+    out[n++] = (unsigned char)(value | 0x80);
+    value >>= 7;
+  }
+  out[n++] = (unsigned char)value;
+  return n;
+}
+
+/* returns 1 if the input ends within the integer */
+static int getVarint(const unsigned char *in, size_t size, size_t *pos,
+                     size_t *value) {
+  size_t shift = 0;
+  *value = 0;
+  while (*pos < size && shift < 8 * sizeof(size_t)) {
+    unsigned char byte = in[(*pos)++];
+    *value |= (size_t)(byte & 0x7f) << shift;
+    if (!(byte & 0x80))
+      return 0;
+    shift += 7;
+  }
+  return 1;
+}
+
+/* Encodes the differences of consecutive locations. Returns the size of the
+ * encoding or 0 if it would not be smaller than capacity. */
+static size_t encodeLocDeltas(const locint *in, size_t count,
+                              unsigned char *out, size_t capacity) {
+  const int signBit = 8 * sizeof(locint) - 1;
+  size_t i, n = 0;
+  locint prev = 0, diff;
+  for (i = 0; i < count; ++i) {
+    if (n + TAPE_VARINT_MAX > capacity)
+      return 0;
+    diff = in[i] - prev;
+    prev = in[i];
+    n += putVarint(out + n, (size_t)((locint)(diff << 1) ^
+                                     (locint)(0 - (diff >> signBit))));
+  }
+  return n;
+}
+
+static int decodeLocDeltas(const unsigned char *in, size_t size, locint *out,
+                           size_t count) {
+  size_t i, pos = 0, value;
+  locint prev = 0, zigzag;
+  for (i = 0; i < count; ++i) {
+    if (getVarint(in, size, &pos, &value))
+      return 1;
+    zigzag = (locint)value;
+    prev += (locint)(zigzag >> 1) ^ (locint)(0 - (zigzag & 1));
+    out[i] = prev;
+  }
+  return pos != size;
+}
+
+static unsigned int hashLZ(const unsigned char *p) {
+  unsigned int v;
+  memcpy(&v, p, sizeof(v));
+  return (v * 2654435761u) >> (32 - TAPE_LZ_HASH_BITS);
+}
+
+/* Greedy LZ77 compression into sequences of
+ *   literal length | literals | match length - 4 | match offset
+ * with a final sequence holding literals only. Returns the size of the
+ * encoding or 0 if it would not be smaller than capacity. */
+size_t encodeLZ(const unsigned char *in, size_t size, unsigned char *out,
+                size_t capacity) {
+  size_t table[1 << TAPE_LZ_HASH_BITS];
+  size_t ip = 0, anchor = 0, n = 0, ref, len, h;
+
+  memset(table, 0, sizeof(table));
+  while (ip + TAPE_LZ_MIN_MATCH <= size) {
+    h = hashLZ(in + ip);
+    ref = table[h];
+    table[h] = ip + 1;
+    if (ref == 0 || memcmp(in + ref - 1, in + ip, TAPE_LZ_MIN_MATCH) != 0) {
+      /* skip faster through data that does not compress */
+      ip += 1 + ((ip - anchor) >> 6);
+      continue;
+    }
+    --ref;
+    len = TAPE_LZ_MIN_MATCH;
+    while (ip + len < size && in[ref + len] == in[ip + len])
+      ++len;
+    if (n + 3 * TAPE_VARINT_MAX + (ip - anchor) > capacity)
+      return 0;
+    n += putVarint(out + n, ip - anchor);
+    memcpy(out + n, in + anchor, ip - anchor);
+    n += ip - anchor;
+    n += putVarint(out + n, len - TAPE_LZ_MIN_MATCH);
+    n += putVarint(out + n, ip - ref);
+    ip += len;
+    anchor = ip;
+  }
+  if (n + TAPE_VARINT_MAX + (size - anchor) >= capacity)
+    return 0;
+  n += putVarint(out + n, size - anchor);
+  memcpy(out + n, in + anchor, size - anchor);
+  return n + size - anchor;
+}
+
+int decodeLZ(const unsigned char *in, size_t size, unsigned char *out,
+             size_t outSize) {
+  size_t pos = 0, n = 0, len, offset, i;
+  for (;;) {
+    if (getVarint(in, size, &pos, &len) || len > outSize - n ||
+        len > size - pos)
+      return 1;
+    memcpy(out + n, in + pos, len);
+    n += len;
+    pos += len;
+    if (n == outSize)
+      return pos != size;
+    if (getVarint(in, size, &pos, &len) || getVarint(in, size, &pos, &offset))
+      return 1;
+    len += TAPE_LZ_MIN_MATCH;
+    if (offset == 0 || offset > n || len > outSize - n)
+      return 1;
+    /* byte by byte, matches may overlap */
+    for (i = 0; i < len; ++i, ++n)
+      out[n] = out[n - offset];
+  }
+}
+
+/* Writes count elements of buffer as one block, returns nonzero on error. */
+static int writeTapeBlock(FILE *file, const void *buffer, size_t count,
+                          size_t elemSize, int method) {
+  TapeBlockHeader header;
+  unsigned char *payload;
+  const void *data;
+  int error;
+
+  header.count = count;
+  header.bytes = count * elemSize;
+  payload = (unsigned char *)malloc(header.bytes);
+  if (payload == NULL)
+    fail(ADOLC_MALLOC_FAILED);
+  if (method == TAPE_BLOCK_DELTA)
+    header.bytes =
+        encodeLocDeltas((const locint *)buffer, count, payload, header.bytes);
+  else
+    header.bytes = encodeLZ((const unsigned char *)buffer, header.bytes,
+                            payload, header.bytes);
+  header.method = method;
+  data = payload;
+  if (header.bytes == 0) {
+    header.method = TAPE_BLOCK_RAW;
+    header.bytes = count * elemSize;
+    data = buffer;
+  }
+  error = fwrite(&header, sizeof(header), 1, file) != 1 ||
+          (header.bytes != 0 && fwrite(data, header.bytes, 1, file) != 1) ||
+          fwrite(&header.bytes, sizeof(size_t), 1, file) != 1;
+  free(payload);
+  return error;
+}
+
+/* Reads the block at the current file position which has to contain count
+ * elements. On return the file is positioned behind the block. */
+static void readTapeBlock(FILE *file, void *buffer, size_t count,
+                          size_t elemSize, int error) {
+  TapeBlockHeader header;
+  unsigned char *payload;
+  size_t trailer;
+  int corrupt;
+
+  if (fread(&header, sizeof(header), 1, file) != 1 || header.count != count)
+    fail(error);
+  if (header.method == TAPE_BLOCK_RAW) {
+    if (header.bytes != count * elemSize ||
+        (header.bytes != 0 && fread(buffer, header.bytes, 1, file) != 1))
+      fail(error);
+  } else {
+    if (header.bytes == 0 || header.bytes >= count * elemSize)
+      fail(error);
+    payload = (unsigned char *)malloc(header.bytes);
+    if (payload == NULL)
+      fail(ADOLC_MALLOC_FAILED);
+    corrupt = fread(payload, header.bytes, 1, file) != 1;
+    if (!corrupt && header.method == TAPE_BLOCK_DELTA)
+      corrupt = decodeLocDeltas(payload, header.bytes, (locint *)buffer, count);
+    else if (!corrupt && header.method == TAPE_BLOCK_LZ)
+      corrupt = decodeLZ(payload, header.bytes, (unsigned char *)buffer,
+                         count * elemSize);
+    else
+      corrupt = 1;
+    free(payload);
+    if (corrupt)
+      fail(error);
+  }
+  if (fread(&trailer, sizeof(size_t), 1, file) != 1 || trailer != header.bytes)
+    fail(error);
+}
+
+/* Reads the block that ends at *pos and moves *pos to its beginning. */
+static void readTapeBlockR(FILE *file, size_t *pos, void *buffer, size_t count,
+                           size_t elemSize, int error) {
+  size_t bytes;
+
+  if (*pos < sizeof(TapeBlockHeader) + sizeof(size_t) ||
+      fseek(file, (long)(*pos - sizeof(size_t)), SEEK_SET) != 0 ||
+      fread(&bytes, sizeof(size_t), 1, file) != 1 ||
+      bytes > *pos - sizeof(TapeBlockHeader) - sizeof(size_t))
+    fail(error);
+  *pos -= sizeof(TapeBlockHeader) + bytes + sizeof(size_t);
+  fseek(file, (long)*pos, SEEK_SET);
+  readTapeBlock(file, buffer, count, elemSize, error);
+}
+
 /****************************************************************************/
 /* Set up statics for writing taylor data                                   */
 /****************************************************************************/
@@ -724,6 +1173,9 @@ void taylor_begin(uint bufferSize, int degreeSave) {
   } else { /* check if new buffer is allowed */
     if (numTBuffersInUse == ADOLC_GLOBAL_TAPE_VARS.maxNumberTaylorBuffers)
       fail(ADOLC_TAPING_TO_MANY_TAYLOR_BUFFERS);
+#if defined(_OPENMP)
+#pragma omp atomic
+#endif
     ++numTBuffersInUse;
     if (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tay_fileName == NULL)
       ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tay_fileName =
@@ -759,6 +1211,7 @@ void taylor_close(bool resetData) {
     /* enforces failure of reverse => retaping */
     ADOLC_CURRENT_TAPE_INFOS.deg_save = -1;
     if (ADOLC_CURRENT_TAPE_INFOS.tay_file != NULL) {
+      waitTapeIO(ADOLC_CURRENT_TAPE_INFOS.tay_io);
       fclose(ADOLC_CURRENT_TAPE_INFOS.tay_file);
       remove(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tay_fileName);
       ADOLC_CURRENT_TAPE_INFOS.tay_file = NULL;
@@ -822,6 +1275,7 @@ void taylor_back(short tag, int *dep, int *ind, int *degree) {
   ADOLC_CURRENT_TAPE_INFOS.currTay =
       ADOLC_CURRENT_TAPE_INFOS.tayBuffer + number;
   if (ADOLC_CURRENT_TAPE_INFOS.lastTayBlockInCore != 1) {
+    syncTapeIO(ADOLC_CURRENT_TAPE_INFOS.tay_io);
     if (fseek(ADOLC_CURRENT_TAPE_INFOS.tay_file,
               sizeof(revreal) * ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber *
                   ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE],
@@ -844,6 +1298,17 @@ void taylor_back(short tag, int *dep, int *ind, int *degree) {
         fail(ADOLC_TAPING_FATAL_IO_ERROR);
   }
   --ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber;
+  if (useTapeIO() && ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber >= 0)
+    prefetchTapeBlock(&ADOLC_CURRENT_TAPE_INFOS.tay_io,
+                      ADOLC_CURRENT_TAPE_INFOS.tay_file,
+                      sizeof(revreal) *
+                          ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber *
+                          ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE],
+                      ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE] *
+                          sizeof(revreal),
+                      ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE] *
+                          sizeof(revreal),
+                      ADOLC_TAPING_FATAL_IO_ERROR);
 }
 
 /****************************************************************************/
@@ -952,6 +1417,7 @@ void write_scaylors(revreal *x, uint size) {
 void put_tay_block(revreal *lastTayP1) {
   int i, chunks;
   size_t number, remain, chunkSize;
+  void *buffer;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
@@ -962,7 +1428,22 @@ void put_tay_block(revreal *lastTayP1) {
       fail(ADOLC_TAPING_TAYLOR_OPEN_FAILED);
   }
   number = lastTayP1 - ADOLC_CURRENT_TAPE_INFOS.tayBuffer;
-  if (number != 0) {
+  buffer = NULL;
+  if (number == ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE] && useTapeIO())
+    buffer = writeBehindTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.tay_io, ADOLC_CURRENT_TAPE_INFOS.tay_file,
+        ADOLC_CURRENT_TAPE_INFOS.tayBuffer, number * sizeof(revreal),
+        number * sizeof(revreal));
+  if (buffer != NULL) {
+    /* continue in the second buffer */
+    ADOLC_CURRENT_TAPE_INFOS.tayBuffer = (revreal *)buffer;
+    ADOLC_CURRENT_TAPE_INFOS.lastTayP1 =
+        ADOLC_CURRENT_TAPE_INFOS.tayBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE];
+    ADOLC_CURRENT_TAPE_INFOS.numTays_Tape += number;
+  } else if (number != 0) {
+    if (waitTapeIO(ADOLC_CURRENT_TAPE_INFOS.tay_io))
+      fail(ADOLC_TAPING_FATAL_IO_ERROR);
     chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(revreal);
     chunks = number / chunkSize;
     for (i = 0; i < chunks; ++i)
@@ -1059,33 +1540,51 @@ void get_taylors_p(locint loc, int degree, int numDir) {
 void get_tay_block_r() {
   int i, chunks;
   size_t number, remain, chunkSize;
+  void *block;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   ADOLC_CURRENT_TAPE_INFOS.lastTayBlockInCore = 0;
   number = ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE];
-  if (fseek(ADOLC_CURRENT_TAPE_INFOS.tay_file,
-            sizeof(revreal) * ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber *
-                number,
-            SEEK_SET) == -1)
-    fail(ADOLC_EVAL_SEEK_VALUE_STACK);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(revreal);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if ((failAdditionalInfo1 =
-             fread(ADOLC_CURRENT_TAPE_INFOS.tayBuffer + i * chunkSize,
-                   chunkSize * sizeof(revreal), 1,
-                   ADOLC_CURRENT_TAPE_INFOS.tay_file)) != 1)
-      fail(ADOLC_TAPING_FATAL_IO_ERROR);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if ((failAdditionalInfo1 =
-             fread(ADOLC_CURRENT_TAPE_INFOS.tayBuffer + chunks * chunkSize,
-                   remain * sizeof(revreal), 1,
-                   ADOLC_CURRENT_TAPE_INFOS.tay_file)) != 1)
-      fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  block = takePrefetchedBlock(
+      ADOLC_CURRENT_TAPE_INFOS.tay_io, ADOLC_CURRENT_TAPE_INFOS.tayBuffer,
+      sizeof(revreal) * ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber * number,
+      number * sizeof(revreal), ADOLC_TAPING_FATAL_IO_ERROR);
+  if (block != NULL) {
+    ADOLC_CURRENT_TAPE_INFOS.tayBuffer = (revreal *)block;
+    ADOLC_CURRENT_TAPE_INFOS.lastTayP1 =
+        ADOLC_CURRENT_TAPE_INFOS.tayBuffer + number;
+  } else {
+    if (fseek(ADOLC_CURRENT_TAPE_INFOS.tay_file,
+              sizeof(revreal) * ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber *
+                  number,
+              SEEK_SET) == -1)
+      fail(ADOLC_EVAL_SEEK_VALUE_STACK);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(revreal);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if ((failAdditionalInfo1 =
+               fread(ADOLC_CURRENT_TAPE_INFOS.tayBuffer + i * chunkSize,
+                     chunkSize * sizeof(revreal), 1,
+                     ADOLC_CURRENT_TAPE_INFOS.tay_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if ((failAdditionalInfo1 =
+               fread(ADOLC_CURRENT_TAPE_INFOS.tayBuffer + chunks * chunkSize,
+                     remain * sizeof(revreal), 1,
+                     ADOLC_CURRENT_TAPE_INFOS.tay_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  }
   ADOLC_CURRENT_TAPE_INFOS.currTay = ADOLC_CURRENT_TAPE_INFOS.lastTayP1;
   --ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber;
+  if (useTapeIO() && ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber >= 0)
+    prefetchTapeBlock(&ADOLC_CURRENT_TAPE_INFOS.tay_io,
+                      ADOLC_CURRENT_TAPE_INFOS.tay_file,
+                      sizeof(revreal) *
+                          ADOLC_CURRENT_TAPE_INFOS.nextBufferNumber * number,
+                      number * sizeof(revreal), number * sizeof(revreal),
+                      ADOLC_TAPING_FATAL_IO_ERROR);
 }
 
 /****************************************************************************/
@@ -1122,6 +1621,136 @@ void initTapeBuffers() {
       ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
 }
 
+/****************************************************************************/
+/* Memory mapped tape files (ADOLC_TAPE_STORE_MMAP). The files written      */
+/* during taping are mapped at the beginning of a sweep and the buffer      */
+/* pointers are moved block by block over the mapping instead of reading    */
+/* every block into the buffers.                                            */
+/****************************************************************************/
+#if defined(ADOLC_HAVE_MMAP)
+/* maps size bytes of the tape file fileName read only, returns NULL if this
+ * is not possible => buffered reading is used instead */
+static void *mapTapeFile(const char *fileName, size_t size, int advice) {
+  void *map;
+  int fd;
+
+  if (size == 0)
+    return NULL;
+  if ((fd = open(fileName, O_RDONLY)) == -1)
+    return NULL;
+  map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (map == MAP_FAILED)
+    return NULL;
+  madvise(map, size, advice);
+  return map;
+}
+
+/* access hint for the bytes [offset, offset + length) of a tape mapping */
+static void adviseTapeRange(void *map, size_t mapSize, size_t offset,
+                            size_t length, int advice) {
+  size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+  size_t start = offset - offset % pageSize;
+
+  if (offset >= mapSize)
+    return;
+  if (offset + length > mapSize)
+    length = mapSize - offset;
+  madvise((char *)map + start, offset + length - start, advice);
+}
+#endif
+
+/* Maps the tape files of the current tape if its storage type asks for it.
+ * Forward sweeps read the mapping front to back, reverse sweeps request the
+ * blocks one at a time (see get_*_block_r). */
+static void mapTapeFiles(char mode) {
+#if defined(ADOLC_HAVE_MMAP)
+  int advice;
+  size_t size;
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  if (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.tapeStorage !=
+          ADOLC_TAPE_STORE_MMAP ||
+      ADOLC_CURRENT_TAPE_INFOS.stats[TAPE_CODEC] != ADOLC_TAPE_CODEC_NONE)
+    return;
+  advice = (mode == ADOLC_FORWARD) ? MADV_SEQUENTIAL : MADV_NORMAL;
+
+  if (ADOLC_CURRENT_TAPE_INFOS.stats[OP_FILE_ACCESS] == 1 &&
+      ADOLC_CURRENT_TAPE_INFOS.op_map == NULL) {
+    size = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] *
+           sizeof(unsigned char);
+    ADOLC_CURRENT_TAPE_INFOS.op_map = (unsigned char *)mapTapeFile(
+        ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.op_fileName, size, advice);
+    if (ADOLC_CURRENT_TAPE_INFOS.op_map != NULL) {
+      ADOLC_CURRENT_TAPE_INFOS.op_mapSize = size;
+      free(ADOLC_CURRENT_TAPE_INFOS.opBuffer);
+      ADOLC_CURRENT_TAPE_INFOS.opBuffer = ADOLC_CURRENT_TAPE_INFOS.op_map;
+    }
+  }
+  if (ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_ACCESS] == 1 &&
+      ADOLC_CURRENT_TAPE_INFOS.loc_map == NULL) {
+    size = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] * sizeof(locint);
+    ADOLC_CURRENT_TAPE_INFOS.loc_map = (locint *)mapTapeFile(
+        ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.loc_fileName, size, advice);
+    if (ADOLC_CURRENT_TAPE_INFOS.loc_map != NULL) {
+      ADOLC_CURRENT_TAPE_INFOS.loc_mapSize = size;
+      free(ADOLC_CURRENT_TAPE_INFOS.locBuffer);
+      ADOLC_CURRENT_TAPE_INFOS.locBuffer = ADOLC_CURRENT_TAPE_INFOS.loc_map;
+    }
+  }
+  if (ADOLC_CURRENT_TAPE_INFOS.stats[VAL_FILE_ACCESS] == 1 &&
+      ADOLC_CURRENT_TAPE_INFOS.val_map == NULL) {
+    size = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] * sizeof(double);
+    ADOLC_CURRENT_TAPE_INFOS.val_map = (double *)mapTapeFile(
+        ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.val_fileName, size, advice);
+    if (ADOLC_CURRENT_TAPE_INFOS.val_map != NULL) {
+      ADOLC_CURRENT_TAPE_INFOS.val_mapSize = size;
+      free(ADOLC_CURRENT_TAPE_INFOS.valBuffer);
+      ADOLC_CURRENT_TAPE_INFOS.valBuffer = ADOLC_CURRENT_TAPE_INFOS.val_map;
+    }
+  }
+#endif
+}
+
+/* Requests the block preceding the one at offset bytes of a mapping ahead of
+ * time, such that reverse sweeps do not stall on page faults. */
+static void prefetchPrevBlock(void *map, size_t mapSize, size_t offset,
+                              size_t blockBytes) {
+#if defined(ADOLC_HAVE_MMAP)
+  if (offset >= blockBytes)
+    adviseTapeRange(map, mapSize, offset - blockBytes, blockBytes,
+                    MADV_WILLNEED);
+#endif
+}
+
+/****************************************************************************/
+/* Releases the mappings of a tape. The buffers of mapped tapes are         */
+/* reallocated by initTapeBuffers when needed.                              */
+/****************************************************************************/
+void unmapTapeFiles(TapeInfos *tapeInfos) {
+#if defined(ADOLC_HAVE_MMAP)
+  if (tapeInfos->op_map != NULL) {
+    munmap(tapeInfos->op_map, tapeInfos->op_mapSize);
+    tapeInfos->op_map = NULL;
+    tapeInfos->op_mapSize = 0;
+    tapeInfos->opBuffer = NULL;
+  }
+  if (tapeInfos->loc_map != NULL) {
+    munmap(tapeInfos->loc_map, tapeInfos->loc_mapSize);
+    tapeInfos->loc_map = NULL;
+    tapeInfos->loc_mapSize = 0;
+    tapeInfos->locBuffer = NULL;
+  }
+  if (tapeInfos->val_map != NULL) {
+    munmap(tapeInfos->val_map, tapeInfos->val_mapSize);
+    tapeInfos->val_map = NULL;
+    tapeInfos->val_mapSize = 0;
+    tapeInfos->valBuffer = NULL;
+  }
+#endif
+}
+
 /****************************************************************************/
 /* start_trace: (part of trace_on)                                          */
 /* Initialization for the taping process. Does buffer allocation, sets      */
@@ -1158,28 +1787,13 @@ void start_trace() {
   markNewTape();
 }
 
-static void save_params() {
+/* appends the parameters of the current tape to its values tape */
+static void write_params() {
   size_t np;
   size_t ip, avail, remain, chunk;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
-  ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM] = ADOLC_GLOBAL_TAPE_VARS.numparam;
-  if (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore != NULL)
-    free(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore);
-
-  ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore =
-      malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM] * sizeof(double));
-
-  // Sometimes we have pStore == nullptr and stats[NUM_PARAM] == 0.
-  // Calling memcpy with that is undefined behavior, and sanitizers will issue a
-  // warning.
-  if (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM] > 0) {
-    memcpy(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore,
-           ADOLC_GLOBAL_TAPE_VARS.pStore,
-           ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM] * sizeof(double));
-  }
-  free_all_taping_params();
   if (ADOLC_CURRENT_TAPE_INFOS.currVal +
           ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM] <
       ADOLC_CURRENT_TAPE_INFOS.lastValP1)
@@ -1202,6 +1816,29 @@ static void save_params() {
   }
 }
 
+static void save_params() {
+  ADOLC_OPENMP_THREAD_NUMBER;
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+
+  ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM] = ADOLC_GLOBAL_TAPE_VARS.numparam;
+  if (ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore != NULL)
+    free(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore);
+
+  ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore =
+      malloc(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM] * sizeof(double));
+
+  // Sometimes we have pStore == nullptr and stats[NUM_PARAM] == 0.
+  // Calling memcpy with that is undefined behavior, and sanitizers will issue a
+  // warning.
+  if (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM] > 0) {
+    memcpy(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.paramstore,
+           ADOLC_GLOBAL_TAPE_VARS.pStore,
+           ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM] * sizeof(double));
+  }
+  free_all_taping_params();
+  write_params();
+}
+
 /****************************************************************************/
 /* Stop Tracing.  Clean up, and turn off trace_flag.                        */
 /****************************************************************************/
@@ -1244,6 +1881,16 @@ void stop_trace(int flag) {
                        tape stats to the integer tape */
 }
 
+/****************************************************************************/
+/* Finish a tape that has been rewritten from an existing one. The caller   */
+/* has set the stats, the parameters are taken from the tape infos.         */
+/****************************************************************************/
+void stop_retrace(int flag) {
+  put_op(end_of_tape); /* Mark end of tape. */
+  write_params();
+  close_tape(flag);
+}
+
 /****************************************************************************/
 /* Close open tapes, update stats and clean up.                             */
 /****************************************************************************/
@@ -1255,6 +1902,7 @@ void close_tape(int flag) {
     if (ADOLC_CURRENT_TAPE_INFOS.currOp != ADOLC_CURRENT_TAPE_INFOS.opBuffer) {
       put_op_block(ADOLC_CURRENT_TAPE_INFOS.currOp);
     }
+    syncTapeIO(ADOLC_CURRENT_TAPE_INFOS.op_io);
     if (ADOLC_CURRENT_TAPE_INFOS.op_file != NULL)
       fclose(ADOLC_CURRENT_TAPE_INFOS.op_file);
     ADOLC_CURRENT_TAPE_INFOS.op_file = NULL;
@@ -1274,6 +1922,7 @@ void close_tape(int flag) {
         ADOLC_CURRENT_TAPE_INFOS.valBuffer) {
       put_val_block(ADOLC_CURRENT_TAPE_INFOS.currVal);
     }
+    syncTapeIO(ADOLC_CURRENT_TAPE_INFOS.val_io);
     if (ADOLC_CURRENT_TAPE_INFOS.val_file != NULL)
       fclose(ADOLC_CURRENT_TAPE_INFOS.val_file);
     ADOLC_CURRENT_TAPE_INFOS.val_file = NULL;
@@ -1293,6 +1942,7 @@ void close_tape(int flag) {
         ADOLC_CURRENT_TAPE_INFOS.locBuffer) {
       put_loc_block(ADOLC_CURRENT_TAPE_INFOS.currLoc);
     }
+    syncTapeIO(ADOLC_CURRENT_TAPE_INFOS.loc_io);
     ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] =
         ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape;
     ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_ACCESS] = 1;
@@ -1311,12 +1961,15 @@ void close_tape(int flag) {
     ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] =
         ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape;
   }
+  releaseTapeIO(&ADOLC_CURRENT_TAPE_INFOS);
 }
 
 /****************************************************************************/
 /* Free all resources used by a tape before overwriting the tape.           */
 /****************************************************************************/
 void freeTapeResources(TapeInfos *tapeInfos) {
+  unmapTapeFiles(tapeInfos);
+  releaseTapeIO(tapeInfos);
   free(tapeInfos->opBuffer);
   tapeInfos->opBuffer = NULL;
   free(tapeInfos->locBuffer);
@@ -1326,6 +1979,9 @@ void freeTapeResources(TapeInfos *tapeInfos) {
   if (tapeInfos->tayBuffer != NULL) {
     free(tapeInfos->tayBuffer);
     tapeInfos->tayBuffer = NULL;
+#if defined(_OPENMP)
+#pragma omp atomic
+#endif
     --numTBuffersInUse;
   }
   if (tapeInfos->op_file != NULL) {
@@ -1350,6 +2006,27 @@ void freeTapeResources(TapeInfos *tapeInfos) {
   }
 }
 
+/****************************************************************************/
+/* Free the Taylor stack of a tape only, the tape itself is left untouched. */
+/****************************************************************************/
+void freeTaylorStack(TapeInfos *tapeInfos) {
+  releaseTapeIOJob(&tapeInfos->tay_io);
+  if (tapeInfos->tay_file != NULL) {
+    fclose(tapeInfos->tay_file);
+    tapeInfos->tay_file = NULL;
+    remove(tapeInfos->pTapeInfos.tay_fileName);
+  }
+  if (tapeInfos->tayBuffer != NULL) {
+    free(tapeInfos->tayBuffer);
+    tapeInfos->tayBuffer = NULL;
+#if defined(_OPENMP)
+#pragma omp atomic
+#endif
+    --numTBuffersInUse;
+  }
+  tapeInfos->deg_save = -1;
+}
+
 /****************************************************************************/
 /* Tapestats:                                                               */
 /* Returns statistics on the tape tag with following meaning:               */
@@ -1429,7 +2106,8 @@ static void read_params(TapeInfos *tapeInfos) {
   int i, chunks;
   size_t number, remain, chunkSize, nVT;
   double *valBuffer = NULL, *currVal = NULL, *lastValP1 = NULL;
-  size_t np, ip, avail, rsize;
+  size_t np, ip, avail, rsize, pos = 0;
+  int coded = tapeInfos->stats[TAPE_CODEC] != ADOLC_TAPE_CODEC_NONE;
   if (tapeInfos->pTapeInfos.paramstore == NULL)
     tapeInfos->pTapeInfos.paramstore =
         malloc(tapeInfos->stats[NUM_PARAM] * sizeof(double));
@@ -1440,9 +2118,16 @@ static void read_params(TapeInfos *tapeInfos) {
     fail(ADOLC_VALUE_TAPE_FOPEN_FAILED);
   number = (tapeInfos->stats[NUM_VALUES] / tapeInfos->stats[VAL_BUFFER_SIZE]) *
            tapeInfos->stats[VAL_BUFFER_SIZE];
-  fseek(val_file, number * sizeof(double), SEEK_SET);
+  if (coded) {
+    fseek(val_file, 0, SEEK_END);
+    pos = ftell(val_file);
+  } else
+    fseek(val_file, number * sizeof(double), SEEK_SET);
   number = tapeInfos->stats[NUM_VALUES] % tapeInfos->stats[VAL_BUFFER_SIZE];
-  if (number != 0) {
+  if (number != 0 && coded)
+    readTapeBlockR(val_file, &pos, valBuffer, number, sizeof(double),
+                   ADOLC_VALUE_TAPE_FREAD_FAILED);
+  else if (number != 0) {
     chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
     chunks = number / chunkSize;
     for (i = 0; i < chunks; ++i)
@@ -1466,18 +2151,23 @@ static void read_params(TapeInfos *tapeInfos) {
       tapeInfos->pTapeInfos.paramstore[--ip] = *--currVal;
     if (ip > 0) {
       number = tapeInfos->stats[VAL_BUFFER_SIZE];
-      fseek(val_file, sizeof(double) * (nVT - number), SEEK_SET);
-      chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
-      chunks = number / chunkSize;
-      for (i = 0; i < chunks; ++i)
-        if (fread(valBuffer + i * chunkSize, chunkSize * sizeof(double), 1,
-                  val_file) != 1)
-          fail(ADOLC_VALUE_TAPE_FREAD_FAILED);
-      remain = number % chunkSize;
-      if (remain != 0)
-        if (fread(valBuffer + chunks * chunkSize, remain * sizeof(double), 1,
-                  val_file) != 1)
-          fail(ADOLC_VALUE_TAPE_FREAD_FAILED);
+      if (coded)
+        readTapeBlockR(val_file, &pos, valBuffer, number, sizeof(double),
+                       ADOLC_VALUE_TAPE_FREAD_FAILED);
+      else {
+        fseek(val_file, sizeof(double) * (nVT - number), SEEK_SET);
+        chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
+        chunks = number / chunkSize;
+        for (i = 0; i < chunks; ++i)
+          if (fread(valBuffer + i * chunkSize, chunkSize * sizeof(double), 1,
+                    val_file) != 1)
+            fail(ADOLC_VALUE_TAPE_FREAD_FAILED);
+        remain = number % chunkSize;
+        if (remain != 0)
+          if (fread(valBuffer + chunks * chunkSize, remain * sizeof(double),
+                    1, val_file) != 1)
+            fail(ADOLC_VALUE_TAPE_FREAD_FAILED);
+      }
       nVT -= number;
       currVal = lastValP1;
     }
@@ -1570,6 +2260,16 @@ void skip_tracefile_cleanup(short tnum) {
   tinfo->pTapeInfos.skipFileCleanup = 1;
 }
 
+void set_tape_storage(short tnum, int storageType) {
+  TapeInfos *tinfo = getTapeInfos(tnum);
+  tinfo->pTapeInfos.tapeStorage = storageType;
+}
+
+void set_tape_codec(short tnum, int codec) {
+  TapeInfos *tinfo = getTapeInfos(tnum);
+  tinfo->pTapeInfos.tapeCodec = codec;
+}
+
 /****************************************************************************/
 /* Initialize a forward sweep. Get stats, open tapes, fill buffers, ...     */
 /****************************************************************************/
@@ -1585,64 +2285,102 @@ void init_for_sweep(short tag) {
   /* make room for tapeInfos and read tape stats if necessary, keep value
    * stack information */
   openTape(tag, ADOLC_FORWARD);
+  mapTapeFiles(ADOLC_FORWARD);
   initTapeBuffers();
 
   /* init operations */
   number = 0;
   if (ADOLC_CURRENT_TAPE_INFOS.stats[OP_FILE_ACCESS] == 1) {
-    ADOLC_CURRENT_TAPE_INFOS.op_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.op_fileName, "rb");
     /* how much to read ? */
     number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE],
                        ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS]);
-    if (number != 0) {
-      chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
-      chunks = number / chunkSize;
-      for (i = 0; i < chunks; ++i)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
-                  chunkSize * sizeof(unsigned char), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
-          fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
-      remain = number % chunkSize;
-      if (remain != 0)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
-                  remain * sizeof(unsigned char), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
-          fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+    if (ADOLC_CURRENT_TAPE_INFOS.op_map == NULL) {
+      ADOLC_CURRENT_TAPE_INFOS.op_file =
+          fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.op_fileName, "rb");
+      if (number != 0 && useTapeCodec())
+        readTapeBlock(ADOLC_CURRENT_TAPE_INFOS.op_file,
+                      ADOLC_CURRENT_TAPE_INFOS.opBuffer, number,
+                      sizeof(unsigned char), ADOLC_EVAL_OP_TAPE_READ_FAILED);
+      else if (number != 0) {
+        chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
+        chunks = number / chunkSize;
+        for (i = 0; i < chunks; ++i)
+          if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
+                    chunkSize * sizeof(unsigned char), 1,
+                    ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
+            fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+        remain = number % chunkSize;
+        if (remain != 0)
+          if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
+                    remain * sizeof(unsigned char), 1,
+                    ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
+            fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+      }
     }
     /* how much remains ? */
     number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] - number;
   }
   ADOLC_CURRENT_TAPE_INFOS.numOps_Tape = number;
+  if (useTapeIO())
+    prefetchTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.op_io, ADOLC_CURRENT_TAPE_INFOS.op_file,
+        (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] -
+         ADOLC_CURRENT_TAPE_INFOS.numOps_Tape) *
+            sizeof(unsigned char),
+        MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE],
+                  ADOLC_CURRENT_TAPE_INFOS.numOps_Tape) *
+            sizeof(unsigned char),
+        ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE] * sizeof(unsigned char),
+        ADOLC_EVAL_OP_TAPE_READ_FAILED);
   ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer;
 
   /* init locations */
   number = 0;
   if (ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_ACCESS] == 1) {
-    ADOLC_CURRENT_TAPE_INFOS.loc_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.loc_fileName, "rb");
     /* how much to read ? */
     number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE],
                        ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS]);
-    if (number != 0) {
-      chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
-      chunks = number / chunkSize;
-      for (i = 0; i < chunks; ++i)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
-                  chunkSize * sizeof(locint), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
-          fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
-      remain = number % chunkSize;
-      if (remain != 0)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
-                  remain * sizeof(locint), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
-          fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+    if (ADOLC_CURRENT_TAPE_INFOS.loc_map == NULL) {
+      ADOLC_CURRENT_TAPE_INFOS.loc_file =
+          fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.loc_fileName, "rb");
+      if (useTapeCodec())
+        fseek(ADOLC_CURRENT_TAPE_INFOS.loc_file, statSpace * sizeof(locint),
+              SEEK_SET);
+      if (number != 0 && useTapeCodec())
+        readTapeBlock(ADOLC_CURRENT_TAPE_INFOS.loc_file,
+                      ADOLC_CURRENT_TAPE_INFOS.locBuffer, number,
+                      sizeof(locint), ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+      else if (number != 0) {
+        chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
+        chunks = number / chunkSize;
+        for (i = 0; i < chunks; ++i)
+          if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
+                    chunkSize * sizeof(locint), 1,
+                    ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+            fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+        remain = number % chunkSize;
+        if (remain != 0)
+          if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
+                    remain * sizeof(locint), 1,
+                    ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+            fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+      }
     }
     /* how much remains ? */
     number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] - number;
   }
   ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape = number;
+  if (useTapeIO())
+    prefetchTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.loc_io, ADOLC_CURRENT_TAPE_INFOS.loc_file,
+        (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] -
+         ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape) *
+            sizeof(locint),
+        MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE],
+                  ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape) *
+            sizeof(locint),
+        ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE] * sizeof(locint),
+        ADOLC_EVAL_LOC_TAPE_READ_FAILED);
 
   /* skip stats */
   numLocsForStats = statSpace;
@@ -1656,30 +2394,47 @@ void init_for_sweep(short tag) {
   /* init constants */
   number = 0;
   if (ADOLC_CURRENT_TAPE_INFOS.stats[VAL_FILE_ACCESS] == 1) {
-    ADOLC_CURRENT_TAPE_INFOS.val_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.val_fileName, "rb");
     /* how much to read ? */
     number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE],
                        ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES]);
-    if (number != 0) {
-      chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
-      chunks = number / chunkSize;
-      for (i = 0; i < chunks; ++i)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
-                  chunkSize * sizeof(double), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-          fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
-      remain = number % chunkSize;
-      if (remain != 0)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
-                  remain * sizeof(double), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-          fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+    if (ADOLC_CURRENT_TAPE_INFOS.val_map == NULL) {
+      ADOLC_CURRENT_TAPE_INFOS.val_file =
+          fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.val_fileName, "rb");
+      if (number != 0 && useTapeCodec())
+        readTapeBlock(ADOLC_CURRENT_TAPE_INFOS.val_file,
+                      ADOLC_CURRENT_TAPE_INFOS.valBuffer, number,
+                      sizeof(double), ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+      else if (number != 0) {
+        chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
+        chunks = number / chunkSize;
+        for (i = 0; i < chunks; ++i)
+          if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
+                    chunkSize * sizeof(double), 1,
+                    ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+            fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+        remain = number % chunkSize;
+        if (remain != 0)
+          if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
+                    remain * sizeof(double), 1,
+                    ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+            fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+      }
     }
     /* how much remains ? */
     number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] - number;
   }
   ADOLC_CURRENT_TAPE_INFOS.numVals_Tape = number;
+  if (useTapeIO())
+    prefetchTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.val_io, ADOLC_CURRENT_TAPE_INFOS.val_file,
+        (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] -
+         ADOLC_CURRENT_TAPE_INFOS.numVals_Tape) *
+            sizeof(double),
+        MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE],
+                  ADOLC_CURRENT_TAPE_INFOS.numVals_Tape) *
+            sizeof(double),
+        ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE] * sizeof(double),
+        ADOLC_EVAL_VAL_TAPE_READ_FAILED);
   ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.valBuffer;
 #ifdef ADOLC_AMPI_SUPPORT
   TAPE_AMPI_resetBottom();
@@ -1701,21 +2456,46 @@ void init_rev_sweep(short tag) {
   /* make room for tapeInfos and read tape stats if necessary, keep value
    * stack information */
   openTape(tag, ADOLC_REVERSE);
+  mapTapeFiles(ADOLC_REVERSE);
   initTapeBuffers();
 
   /* init operations */
   number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS];
   if (ADOLC_CURRENT_TAPE_INFOS.stats[OP_FILE_ACCESS] == 1) {
-    ADOLC_CURRENT_TAPE_INFOS.op_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.op_fileName, "rb");
     number = (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] /
               ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE]) *
              ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
-    fseek(ADOLC_CURRENT_TAPE_INFOS.op_file, number * sizeof(unsigned char),
-          SEEK_SET);
+    if (ADOLC_CURRENT_TAPE_INFOS.op_map != NULL) {
+      /* the last block is the current buffer */
+      ADOLC_CURRENT_TAPE_INFOS.opBuffer =
+          ADOLC_CURRENT_TAPE_INFOS.op_map + number;
+      ADOLC_CURRENT_TAPE_INFOS.lastOpP1 =
+          ADOLC_CURRENT_TAPE_INFOS.opBuffer +
+          ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
+      prefetchPrevBlock(ADOLC_CURRENT_TAPE_INFOS.op_map,
+                        ADOLC_CURRENT_TAPE_INFOS.op_mapSize,
+                        number * sizeof(unsigned char),
+                        ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE] *
+                            sizeof(unsigned char));
+    } else {
+      ADOLC_CURRENT_TAPE_INFOS.op_file =
+          fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.op_fileName, "rb");
+      if (useTapeCodec()) {
+        fseek(ADOLC_CURRENT_TAPE_INFOS.op_file, 0, SEEK_END);
+        ADOLC_CURRENT_TAPE_INFOS.op_revPos =
+            ftell(ADOLC_CURRENT_TAPE_INFOS.op_file);
+      } else
+        fseek(ADOLC_CURRENT_TAPE_INFOS.op_file, number * sizeof(unsigned char),
+              SEEK_SET);
+    }
     number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] %
              ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
-    if (number != 0) {
+    if (number != 0 && useTapeCodec())
+      readTapeBlockR(ADOLC_CURRENT_TAPE_INFOS.op_file,
+                     &ADOLC_CURRENT_TAPE_INFOS.op_revPos,
+                     ADOLC_CURRENT_TAPE_INFOS.opBuffer, number,
+                     sizeof(unsigned char), ADOLC_EVAL_OP_TAPE_READ_FAILED);
+    else if (number != 0 && ADOLC_CURRENT_TAPE_INFOS.op_map == NULL) {
       chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
       chunks = number / chunkSize;
       for (i = 0; i < chunks; ++i)
@@ -1733,20 +2513,54 @@ void init_rev_sweep(short tag) {
   }
   ADOLC_CURRENT_TAPE_INFOS.numOps_Tape =
       ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] - number;
+  if (useTapeIO() && ADOLC_CURRENT_TAPE_INFOS.op_map == NULL &&
+      ADOLC_CURRENT_TAPE_INFOS.numOps_Tape > 0)
+    prefetchTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.op_io, ADOLC_CURRENT_TAPE_INFOS.op_file,
+        (ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -
+         ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE]) *
+            sizeof(unsigned char),
+        ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE] * sizeof(unsigned char),
+        ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE] * sizeof(unsigned char),
+        ADOLC_EVAL_OP_TAPE_READ_FAILED);
   ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer + number;
 
   /* init locations */
   number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS];
   if (ADOLC_CURRENT_TAPE_INFOS.stats[LOC_FILE_ACCESS] == 1) {
-    ADOLC_CURRENT_TAPE_INFOS.loc_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.loc_fileName, "rb");
     number = (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] /
               ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE]) *
              ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
-    fseek(ADOLC_CURRENT_TAPE_INFOS.loc_file, number * sizeof(locint), SEEK_SET);
+    if (ADOLC_CURRENT_TAPE_INFOS.loc_map != NULL) {
+      ADOLC_CURRENT_TAPE_INFOS.locBuffer =
+          ADOLC_CURRENT_TAPE_INFOS.loc_map + number;
+      ADOLC_CURRENT_TAPE_INFOS.lastLocP1 =
+          ADOLC_CURRENT_TAPE_INFOS.locBuffer +
+          ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
+      prefetchPrevBlock(ADOLC_CURRENT_TAPE_INFOS.loc_map,
+                        ADOLC_CURRENT_TAPE_INFOS.loc_mapSize,
+                        number * sizeof(locint),
+                        ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE] *
+                            sizeof(locint));
+    } else {
+      ADOLC_CURRENT_TAPE_INFOS.loc_file =
+          fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.loc_fileName, "rb");
+      if (useTapeCodec()) {
+        fseek(ADOLC_CURRENT_TAPE_INFOS.loc_file, 0, SEEK_END);
+        ADOLC_CURRENT_TAPE_INFOS.loc_revPos =
+            ftell(ADOLC_CURRENT_TAPE_INFOS.loc_file);
+      } else
+        fseek(ADOLC_CURRENT_TAPE_INFOS.loc_file, number * sizeof(locint),
+              SEEK_SET);
+    }
     number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] %
              ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
-    if (number != 0) {
+    if (number != 0 && useTapeCodec())
+      readTapeBlockR(ADOLC_CURRENT_TAPE_INFOS.loc_file,
+                     &ADOLC_CURRENT_TAPE_INFOS.loc_revPos,
+                     ADOLC_CURRENT_TAPE_INFOS.locBuffer, number, sizeof(locint),
+                     ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+    else if (number != 0 && ADOLC_CURRENT_TAPE_INFOS.loc_map == NULL) {
       chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
       chunks = number / chunkSize;
       for (i = 0; i < chunks; ++i)
@@ -1764,21 +2578,55 @@ void init_rev_sweep(short tag) {
   }
   ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape =
       ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] - number;
+  if (useTapeIO() && ADOLC_CURRENT_TAPE_INFOS.loc_map == NULL &&
+      ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape > 0)
+    prefetchTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.loc_io, ADOLC_CURRENT_TAPE_INFOS.loc_file,
+        (ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape -
+         ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE]) *
+            sizeof(locint),
+        ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE] * sizeof(locint),
+        ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE] * sizeof(locint),
+        ADOLC_EVAL_LOC_TAPE_READ_FAILED);
   ADOLC_CURRENT_TAPE_INFOS.currLoc =
       ADOLC_CURRENT_TAPE_INFOS.locBuffer + number;
 
   /* init constants */
   number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES];
   if (ADOLC_CURRENT_TAPE_INFOS.stats[VAL_FILE_ACCESS] == 1) {
-    ADOLC_CURRENT_TAPE_INFOS.val_file =
-        fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.val_fileName, "rb");
     number = (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] /
               ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE]) *
              ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
-    fseek(ADOLC_CURRENT_TAPE_INFOS.val_file, number * sizeof(double), SEEK_SET);
+    if (ADOLC_CURRENT_TAPE_INFOS.val_map != NULL) {
+      ADOLC_CURRENT_TAPE_INFOS.valBuffer =
+          ADOLC_CURRENT_TAPE_INFOS.val_map + number;
+      ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+          ADOLC_CURRENT_TAPE_INFOS.valBuffer +
+          ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
+      prefetchPrevBlock(ADOLC_CURRENT_TAPE_INFOS.val_map,
+                        ADOLC_CURRENT_TAPE_INFOS.val_mapSize,
+                        number * sizeof(double),
+                        ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE] *
+                            sizeof(double));
+    } else {
+      ADOLC_CURRENT_TAPE_INFOS.val_file =
+          fopen(ADOLC_CURRENT_TAPE_INFOS.pTapeInfos.val_fileName, "rb");
+      if (useTapeCodec()) {
+        fseek(ADOLC_CURRENT_TAPE_INFOS.val_file, 0, SEEK_END);
+        ADOLC_CURRENT_TAPE_INFOS.val_revPos =
+            ftell(ADOLC_CURRENT_TAPE_INFOS.val_file);
+      } else
+        fseek(ADOLC_CURRENT_TAPE_INFOS.val_file, number * sizeof(double),
+              SEEK_SET);
+    }
     number = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] %
              ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
-    if (number != 0) {
+    if (number != 0 && useTapeCodec())
+      readTapeBlockR(ADOLC_CURRENT_TAPE_INFOS.val_file,
+                     &ADOLC_CURRENT_TAPE_INFOS.val_revPos,
+                     ADOLC_CURRENT_TAPE_INFOS.valBuffer, number, sizeof(double),
+                     ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+    else if (number != 0 && ADOLC_CURRENT_TAPE_INFOS.val_map == NULL) {
       chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
       chunks = number / chunkSize;
       for (i = 0; i < chunks; ++i)
@@ -1796,6 +2644,16 @@ void init_rev_sweep(short tag) {
   }
   ADOLC_CURRENT_TAPE_INFOS.numVals_Tape =
       ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] - number;
+  if (useTapeIO() && ADOLC_CURRENT_TAPE_INFOS.val_map == NULL &&
+      ADOLC_CURRENT_TAPE_INFOS.numVals_Tape > 0)
+    prefetchTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.val_io, ADOLC_CURRENT_TAPE_INFOS.val_file,
+        (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -
+         ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE]) *
+            sizeof(double),
+        ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE] * sizeof(double),
+        ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE] * sizeof(double),
+        ADOLC_EVAL_VAL_TAPE_READ_FAILED);
   ADOLC_CURRENT_TAPE_INFOS.currVal =
       ADOLC_CURRENT_TAPE_INFOS.valBuffer + number;
 #ifdef ADOLC_AMPI_SUPPORT
@@ -1809,6 +2667,8 @@ void init_rev_sweep(short tag) {
 void end_sweep() {
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
+  syncTapeIO(ADOLC_CURRENT_TAPE_INFOS.tay_io);
+  releaseTapeIO(&ADOLC_CURRENT_TAPE_INFOS);
   if (ADOLC_CURRENT_TAPE_INFOS.op_file != NULL) {
     fclose(ADOLC_CURRENT_TAPE_INFOS.op_file);
     ADOLC_CURRENT_TAPE_INFOS.op_file = NULL;
@@ -1821,12 +2681,39 @@ void end_sweep() {
     fclose(ADOLC_CURRENT_TAPE_INFOS.val_file);
     ADOLC_CURRENT_TAPE_INFOS.val_file = NULL;
   }
+  unmapTapeFiles(&ADOLC_CURRENT_TAPE_INFOS);
   if (ADOLC_CURRENT_TAPE_INFOS.deg_save > 0)
     releaseTape(); /* keep value stack */
   else
     releaseTape(); /* no value stack */
 }
 
+/****************************************************************************/
+/* Returns 1 if tape "tag" contains one of the numOps operations ops[],     */
+/* otherwise 0. Only the operations are read from the tape.                 */
+/****************************************************************************/
+int tapeContainsOps(short tag, const unsigned char *ops, int numOps) {
+  unsigned char op;
+  int found = 0;
+  ADOLC_OPENMP_THREAD_NUMBER;
+
+  ADOLC_OPENMP_GET_THREAD_NUMBER;
+  init_for_sweep(tag);
+  op = get_op_f();
+  while (op != end_of_tape && !found) {
+    if (op == end_of_op) {
+      get_op_block_f();
+      op = get_op_f();
+      /* Skip next operation, it's another end_of_op */
+    }
+    for (int i = 0; i < numOps && !found; ++i)
+      found = op == ops[i];
+    op = get_op_f();
+  }
+  end_sweep();
+  return found;
+}
+
 /* --- Operations --- */
 
 const int maxLocsPerOp = 10;
@@ -1898,6 +2785,7 @@ void put_op_reserve(unsigned char op, unsigned int reserveExtraLocations) {
 void put_op_block(unsigned char *lastOpP1) {
   size_t i, chunks;
   size_t number, remain, chunkSize;
+  void *buffer;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
@@ -1923,21 +2811,47 @@ void put_op_block(unsigned char *lastOpP1) {
   }
 
   number = lastOpP1 - ADOLC_CURRENT_TAPE_INFOS.opBuffer;
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if ((failAdditionalInfo1 =
-             fwrite(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
-                    chunkSize * sizeof(unsigned char), 1,
-                    ADOLC_CURRENT_TAPE_INFOS.op_file)) != 1)
+  if (useTapeCodec()) {
+    if (writeTapeBlock(ADOLC_CURRENT_TAPE_INFOS.op_file,
+                       ADOLC_CURRENT_TAPE_INFOS.opBuffer, number,
+                       sizeof(unsigned char), TAPE_BLOCK_LZ))
       fail(ADOLC_TAPING_FATAL_IO_ERROR);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if ((failAdditionalInfo1 =
-             fwrite(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
-                    remain * sizeof(unsigned char), 1,
-                    ADOLC_CURRENT_TAPE_INFOS.op_file)) != 1)
+    ADOLC_CURRENT_TAPE_INFOS.numOps_Tape += number;
+    ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer;
+    ADOLC_OPENMP_RESTORE_THREAD_NUMBER;
+    return;
+  }
+  buffer = NULL;
+  if (number == ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE] && useTapeIO())
+    buffer = writeBehindTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.op_io, ADOLC_CURRENT_TAPE_INFOS.op_file,
+        ADOLC_CURRENT_TAPE_INFOS.opBuffer, number * sizeof(unsigned char),
+        number * sizeof(unsigned char));
+  if (buffer != NULL) {
+    /* continue taping in the second buffer */
+    ADOLC_CURRENT_TAPE_INFOS.opBuffer = (unsigned char *)buffer;
+    ADOLC_CURRENT_TAPE_INFOS.lastOpP1 =
+        ADOLC_CURRENT_TAPE_INFOS.opBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
+  } else {
+    if (waitTapeIO(ADOLC_CURRENT_TAPE_INFOS.op_io))
       fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if ((failAdditionalInfo1 =
+               fwrite(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
+                      chunkSize * sizeof(unsigned char), 1,
+                      ADOLC_CURRENT_TAPE_INFOS.op_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if ((failAdditionalInfo1 =
+               fwrite(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
+                      remain * sizeof(unsigned char), 1,
+                      ADOLC_CURRENT_TAPE_INFOS.op_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  }
   ADOLC_CURRENT_TAPE_INFOS.numOps_Tape += number;
   ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer;
   ADOLC_OPENMP_RESTORE_THREAD_NUMBER;
@@ -1949,26 +2863,78 @@ void put_op_block(unsigned char *lastOpP1) {
 void get_op_block_f() {
   size_t i, chunks;
   size_t number, remain, chunkSize;
+  void *block;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE],
                      ADOLC_CURRENT_TAPE_INFOS.numOps_Tape);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
-              chunkSize * sizeof(unsigned char), 1,
-              ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
-      fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
-              remain * sizeof(unsigned char), 1,
-              ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
-      fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
-  ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -= remain;
+  if (ADOLC_CURRENT_TAPE_INFOS.op_map != NULL) {
+    /* the next block is already in the mapping */
+    ADOLC_CURRENT_TAPE_INFOS.opBuffer =
+        ADOLC_CURRENT_TAPE_INFOS.op_map +
+        (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] -
+         ADOLC_CURRENT_TAPE_INFOS.numOps_Tape);
+    ADOLC_CURRENT_TAPE_INFOS.lastOpP1 =
+        ADOLC_CURRENT_TAPE_INFOS.opBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
+    ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer;
+    return;
+  }
+  if (useTapeCodec()) {
+    readTapeBlock(ADOLC_CURRENT_TAPE_INFOS.op_file,
+                  ADOLC_CURRENT_TAPE_INFOS.opBuffer, number,
+                  sizeof(unsigned char), ADOLC_EVAL_OP_TAPE_READ_FAILED);
+    ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer;
+    return;
+  }
+  block = takePrefetchedBlock(
+      ADOLC_CURRENT_TAPE_INFOS.op_io, ADOLC_CURRENT_TAPE_INFOS.opBuffer,
+      (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] -
+       ADOLC_CURRENT_TAPE_INFOS.numOps_Tape) *
+          sizeof(unsigned char),
+      number * sizeof(unsigned char), ADOLC_EVAL_OP_TAPE_READ_FAILED);
+  if (block != NULL) {
+    ADOLC_CURRENT_TAPE_INFOS.opBuffer = (unsigned char *)block;
+    ADOLC_CURRENT_TAPE_INFOS.lastOpP1 =
+        ADOLC_CURRENT_TAPE_INFOS.opBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
+  } else {
+    if (ADOLC_CURRENT_TAPE_INFOS.op_io != NULL)
+      fseek(ADOLC_CURRENT_TAPE_INFOS.op_file,
+            (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] -
+             ADOLC_CURRENT_TAPE_INFOS.numOps_Tape) *
+                sizeof(unsigned char),
+            SEEK_SET);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
+                chunkSize * sizeof(unsigned char), 1,
+                ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
+        fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
+                remain * sizeof(unsigned char), 1,
+                ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
+        fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+  }
+  ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -= number;
   ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer;
+  if (useTapeIO())
+    prefetchTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.op_io, ADOLC_CURRENT_TAPE_INFOS.op_file,
+        (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_OPERATIONS] -
+         ADOLC_CURRENT_TAPE_INFOS.numOps_Tape) *
+            sizeof(unsigned char),
+        MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE],
+                  ADOLC_CURRENT_TAPE_INFOS.numOps_Tape) *
+            sizeof(unsigned char),
+        ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE] * sizeof(unsigned char),
+        ADOLC_EVAL_OP_TAPE_READ_FAILED);
 }
 
 /****************************************************************************/
@@ -1977,27 +2943,75 @@ void get_op_block_f() {
 void get_op_block_r() {
   size_t i, chunks;
   size_t number, remain, chunkSize;
+  void *block;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   number = ADOLC_CURRENT_TAPE_INFOS.stats[OP_BUFFER_SIZE];
-  fseek(ADOLC_CURRENT_TAPE_INFOS.op_file,
-        sizeof(unsigned char) * (ADOLC_CURRENT_TAPE_INFOS.numOps_Tape - number),
-        SEEK_SET);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
-              chunkSize * sizeof(unsigned char), 1,
-              ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
-      fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
-              remain * sizeof(unsigned char), 1,
-              ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
-      fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+  if (ADOLC_CURRENT_TAPE_INFOS.op_map != NULL) {
+    /* the previous block is already in the mapping, just move the window */
+    ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.opBuffer =
+        ADOLC_CURRENT_TAPE_INFOS.op_map +
+        ADOLC_CURRENT_TAPE_INFOS.numOps_Tape;
+    ADOLC_CURRENT_TAPE_INFOS.lastOpP1 =
+        ADOLC_CURRENT_TAPE_INFOS.opBuffer + number;
+    prefetchPrevBlock(
+        ADOLC_CURRENT_TAPE_INFOS.op_map, ADOLC_CURRENT_TAPE_INFOS.op_mapSize,
+        ADOLC_CURRENT_TAPE_INFOS.numOps_Tape * sizeof(unsigned char),
+        number * sizeof(unsigned char));
+    ADOLC_CURRENT_TAPE_INFOS.currOp =
+        ADOLC_CURRENT_TAPE_INFOS.opBuffer + number;
+    return;
+  }
+  if (useTapeCodec()) {
+    readTapeBlockR(ADOLC_CURRENT_TAPE_INFOS.op_file,
+                   &ADOLC_CURRENT_TAPE_INFOS.op_revPos,
+                   ADOLC_CURRENT_TAPE_INFOS.opBuffer, number,
+                   sizeof(unsigned char), ADOLC_EVAL_OP_TAPE_READ_FAILED);
+    ADOLC_CURRENT_TAPE_INFOS.lastOpP1 =
+        ADOLC_CURRENT_TAPE_INFOS.opBuffer + number;
+    ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.currOp =
+        ADOLC_CURRENT_TAPE_INFOS.opBuffer + number;
+    return;
+  }
+  block = takePrefetchedBlock(
+      ADOLC_CURRENT_TAPE_INFOS.op_io, ADOLC_CURRENT_TAPE_INFOS.opBuffer,
+      (ADOLC_CURRENT_TAPE_INFOS.numOps_Tape - number) * sizeof(unsigned char),
+      number * sizeof(unsigned char), ADOLC_EVAL_OP_TAPE_READ_FAILED);
+  if (block != NULL) {
+    ADOLC_CURRENT_TAPE_INFOS.opBuffer = (unsigned char *)block;
+    ADOLC_CURRENT_TAPE_INFOS.lastOpP1 =
+        ADOLC_CURRENT_TAPE_INFOS.opBuffer + number;
+  } else {
+    fseek(ADOLC_CURRENT_TAPE_INFOS.op_file,
+          sizeof(unsigned char) *
+              (ADOLC_CURRENT_TAPE_INFOS.numOps_Tape - number),
+          SEEK_SET);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(unsigned char);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + i * chunkSize,
+                chunkSize * sizeof(unsigned char), 1,
+                ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
+        fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.opBuffer + chunks * chunkSize,
+                remain * sizeof(unsigned char), 1,
+                ADOLC_CURRENT_TAPE_INFOS.op_file) != 1)
+        fail(ADOLC_EVAL_OP_TAPE_READ_FAILED);
+  }
   ADOLC_CURRENT_TAPE_INFOS.numOps_Tape -= number;
+  if (useTapeIO() && ADOLC_CURRENT_TAPE_INFOS.numOps_Tape > 0)
+    prefetchTapeBlock(&ADOLC_CURRENT_TAPE_INFOS.op_io,
+                      ADOLC_CURRENT_TAPE_INFOS.op_file,
+                      (ADOLC_CURRENT_TAPE_INFOS.numOps_Tape - number) *
+                          sizeof(unsigned char),
+                      number * sizeof(unsigned char),
+                      number * sizeof(unsigned char),
+                      ADOLC_EVAL_OP_TAPE_READ_FAILED);
   ADOLC_CURRENT_TAPE_INFOS.currOp = ADOLC_CURRENT_TAPE_INFOS.opBuffer + number;
 }
 
@@ -2010,6 +3024,7 @@ void get_op_block_r() {
 void put_loc_block(locint *lastLocP1) {
   size_t i, chunks;
   size_t number, remain, chunkSize;
+  void *buffer;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
@@ -2035,21 +3050,55 @@ void put_loc_block(locint *lastLocP1) {
   }
 
   number = lastLocP1 - ADOLC_CURRENT_TAPE_INFOS.locBuffer;
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if ((failAdditionalInfo1 =
-             fwrite(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
-                    chunkSize * sizeof(locint), 1,
-                    ADOLC_CURRENT_TAPE_INFOS.loc_file)) != 1)
+  if (useTapeCodec()) {
+    if (ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape == 0) {
+      /* raw region for the tape stats */
+      locint reserved[statSpace];
+      memset(reserved, 0, sizeof(reserved));
+      if (fwrite(reserved, sizeof(reserved), 1,
+                 ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    }
+    if (writeTapeBlock(ADOLC_CURRENT_TAPE_INFOS.loc_file,
+                       ADOLC_CURRENT_TAPE_INFOS.locBuffer, number,
+                       sizeof(locint), TAPE_BLOCK_DELTA))
       fail(ADOLC_TAPING_FATAL_IO_ERROR);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if ((failAdditionalInfo1 =
-             fwrite(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
-                    remain * sizeof(locint), 1,
-                    ADOLC_CURRENT_TAPE_INFOS.loc_file)) != 1)
+    ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape += number;
+    ADOLC_CURRENT_TAPE_INFOS.currLoc = ADOLC_CURRENT_TAPE_INFOS.locBuffer;
+    ADOLC_OPENMP_RESTORE_THREAD_NUMBER;
+    return;
+  }
+  buffer = NULL;
+  if (number == ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE] && useTapeIO())
+    buffer = writeBehindTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.loc_io, ADOLC_CURRENT_TAPE_INFOS.loc_file,
+        ADOLC_CURRENT_TAPE_INFOS.locBuffer, number * sizeof(locint),
+        number * sizeof(locint));
+  if (buffer != NULL) {
+    /* continue taping in the second buffer */
+    ADOLC_CURRENT_TAPE_INFOS.locBuffer = (locint *)buffer;
+    ADOLC_CURRENT_TAPE_INFOS.lastLocP1 =
+        ADOLC_CURRENT_TAPE_INFOS.locBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
+  } else {
+    if (waitTapeIO(ADOLC_CURRENT_TAPE_INFOS.loc_io))
       fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if ((failAdditionalInfo1 =
+               fwrite(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
+                      chunkSize * sizeof(locint), 1,
+                      ADOLC_CURRENT_TAPE_INFOS.loc_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if ((failAdditionalInfo1 =
+               fwrite(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
+                      remain * sizeof(locint), 1,
+                      ADOLC_CURRENT_TAPE_INFOS.loc_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  }
   ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape += number;
   ADOLC_CURRENT_TAPE_INFOS.currLoc = ADOLC_CURRENT_TAPE_INFOS.locBuffer;
   ADOLC_OPENMP_RESTORE_THREAD_NUMBER;
@@ -2061,26 +3110,78 @@ void put_loc_block(locint *lastLocP1) {
 void get_loc_block_f() {
   size_t i, chunks;
   size_t number, remain, chunkSize;
+  void *block;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE],
                      ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
-              chunkSize * sizeof(locint), 1,
-              ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
-      fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
-              remain * sizeof(locint), 1,
-              ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
-      fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+  if (ADOLC_CURRENT_TAPE_INFOS.loc_map != NULL) {
+    /* the next block is already in the mapping */
+    ADOLC_CURRENT_TAPE_INFOS.locBuffer =
+        ADOLC_CURRENT_TAPE_INFOS.loc_map +
+        (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] -
+         ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape);
+    ADOLC_CURRENT_TAPE_INFOS.lastLocP1 =
+        ADOLC_CURRENT_TAPE_INFOS.locBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
+    ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.currLoc = ADOLC_CURRENT_TAPE_INFOS.locBuffer;
+    return;
+  }
+  if (useTapeCodec()) {
+    readTapeBlock(ADOLC_CURRENT_TAPE_INFOS.loc_file,
+                  ADOLC_CURRENT_TAPE_INFOS.locBuffer, number, sizeof(locint),
+                  ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+    ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.currLoc = ADOLC_CURRENT_TAPE_INFOS.locBuffer;
+    return;
+  }
+  block = takePrefetchedBlock(
+      ADOLC_CURRENT_TAPE_INFOS.loc_io, ADOLC_CURRENT_TAPE_INFOS.locBuffer,
+      (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] -
+       ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape) *
+          sizeof(locint),
+      number * sizeof(locint), ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+  if (block != NULL) {
+    ADOLC_CURRENT_TAPE_INFOS.locBuffer = (locint *)block;
+    ADOLC_CURRENT_TAPE_INFOS.lastLocP1 =
+        ADOLC_CURRENT_TAPE_INFOS.locBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
+  } else {
+    if (ADOLC_CURRENT_TAPE_INFOS.loc_io != NULL)
+      fseek(ADOLC_CURRENT_TAPE_INFOS.loc_file,
+            (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] -
+             ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape) *
+                sizeof(locint),
+            SEEK_SET);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
+                chunkSize * sizeof(locint), 1,
+                ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+        fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
+                remain * sizeof(locint), 1,
+                ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+        fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+  }
   ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape -= number;
   ADOLC_CURRENT_TAPE_INFOS.currLoc = ADOLC_CURRENT_TAPE_INFOS.locBuffer;
+  if (useTapeIO())
+    prefetchTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.loc_io, ADOLC_CURRENT_TAPE_INFOS.loc_file,
+        (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_LOCATIONS] -
+         ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape) *
+            sizeof(locint),
+        MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE],
+                  ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape) *
+            sizeof(locint),
+        ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE] * sizeof(locint),
+        ADOLC_EVAL_LOC_TAPE_READ_FAILED);
 }
 
 /****************************************************************************/
@@ -2089,28 +3190,76 @@ void get_loc_block_f() {
 void get_loc_block_r() {
   size_t i, chunks;
   size_t number, remain, chunkSize;
+  void *block;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   number = ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
-  fseek(ADOLC_CURRENT_TAPE_INFOS.loc_file,
-        sizeof(locint) * (ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape - number),
-        SEEK_SET);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
-              chunkSize * sizeof(locint), 1,
-              ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
-      fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
-              remain * sizeof(locint), 1,
-              ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
-      fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+  if (ADOLC_CURRENT_TAPE_INFOS.loc_map != NULL) {
+    /* the previous block is already in the mapping, just move the window */
+    ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.locBuffer =
+        ADOLC_CURRENT_TAPE_INFOS.loc_map +
+        ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape;
+    ADOLC_CURRENT_TAPE_INFOS.lastLocP1 =
+        ADOLC_CURRENT_TAPE_INFOS.locBuffer + number;
+    prefetchPrevBlock(ADOLC_CURRENT_TAPE_INFOS.loc_map,
+                      ADOLC_CURRENT_TAPE_INFOS.loc_mapSize,
+                      ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape * sizeof(locint),
+                      number * sizeof(locint));
+    ADOLC_CURRENT_TAPE_INFOS.currLoc =
+        ADOLC_CURRENT_TAPE_INFOS.lastLocP1 -
+        *(ADOLC_CURRENT_TAPE_INFOS.lastLocP1 - 1);
+    return;
+  }
+  if (useTapeCodec()) {
+    readTapeBlockR(ADOLC_CURRENT_TAPE_INFOS.loc_file,
+                   &ADOLC_CURRENT_TAPE_INFOS.loc_revPos,
+                   ADOLC_CURRENT_TAPE_INFOS.locBuffer, number, sizeof(locint),
+                   ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+    ADOLC_CURRENT_TAPE_INFOS.lastLocP1 =
+        ADOLC_CURRENT_TAPE_INFOS.locBuffer + number;
+    ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.currLoc =
+        ADOLC_CURRENT_TAPE_INFOS.lastLocP1 -
+        *(ADOLC_CURRENT_TAPE_INFOS.lastLocP1 - 1);
+    return;
+  }
+  block = takePrefetchedBlock(
+      ADOLC_CURRENT_TAPE_INFOS.loc_io, ADOLC_CURRENT_TAPE_INFOS.locBuffer,
+      (ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape - number) * sizeof(locint),
+      number * sizeof(locint), ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+  if (block != NULL) {
+    ADOLC_CURRENT_TAPE_INFOS.locBuffer = (locint *)block;
+    ADOLC_CURRENT_TAPE_INFOS.lastLocP1 =
+        ADOLC_CURRENT_TAPE_INFOS.locBuffer + number;
+  } else {
+    fseek(ADOLC_CURRENT_TAPE_INFOS.loc_file,
+          sizeof(locint) * (ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape - number),
+          SEEK_SET);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(locint);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + i * chunkSize,
+                chunkSize * sizeof(locint), 1,
+                ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+        fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.locBuffer + chunks * chunkSize,
+                remain * sizeof(locint), 1,
+                ADOLC_CURRENT_TAPE_INFOS.loc_file) != 1)
+        fail(ADOLC_EVAL_LOC_TAPE_READ_FAILED);
+  }
   ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape -=
       ADOLC_CURRENT_TAPE_INFOS.stats[LOC_BUFFER_SIZE];
+  if (useTapeIO() && ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape > 0)
+    prefetchTapeBlock(&ADOLC_CURRENT_TAPE_INFOS.loc_io,
+                      ADOLC_CURRENT_TAPE_INFOS.loc_file,
+                      (ADOLC_CURRENT_TAPE_INFOS.numLocs_Tape - number) *
+                          sizeof(locint),
+                      number * sizeof(locint), number * sizeof(locint),
+                      ADOLC_EVAL_LOC_TAPE_READ_FAILED);
   ADOLC_CURRENT_TAPE_INFOS.currLoc = ADOLC_CURRENT_TAPE_INFOS.lastLocP1 -
                                      *(ADOLC_CURRENT_TAPE_INFOS.lastLocP1 - 1);
 }
@@ -2166,6 +3315,7 @@ void put_vals_notWriteBlock(double *vals, locint numVals) {
 void put_val_block(double *lastValP1) {
   size_t i, chunks;
   size_t number, remain, chunkSize;
+  void *buffer;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
@@ -2191,21 +3341,47 @@ void put_val_block(double *lastValP1) {
   }
 
   number = lastValP1 - ADOLC_CURRENT_TAPE_INFOS.valBuffer;
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if ((failAdditionalInfo1 =
-             fwrite(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
-                    chunkSize * sizeof(double), 1,
-                    ADOLC_CURRENT_TAPE_INFOS.val_file)) != 1)
+  if (useTapeCodec()) {
+    if (writeTapeBlock(ADOLC_CURRENT_TAPE_INFOS.val_file,
+                       ADOLC_CURRENT_TAPE_INFOS.valBuffer, number,
+                       sizeof(double), TAPE_BLOCK_LZ))
       fail(ADOLC_TAPING_FATAL_IO_ERROR);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if ((failAdditionalInfo1 =
-             fwrite(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
-                    remain * sizeof(double), 1,
-                    ADOLC_CURRENT_TAPE_INFOS.val_file)) != 1)
+    ADOLC_CURRENT_TAPE_INFOS.numVals_Tape += number;
+    ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.valBuffer;
+    ADOLC_OPENMP_RESTORE_THREAD_NUMBER;
+    return;
+  }
+  buffer = NULL;
+  if (number == ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE] && useTapeIO())
+    buffer = writeBehindTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.val_io, ADOLC_CURRENT_TAPE_INFOS.val_file,
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer, number * sizeof(double),
+        number * sizeof(double));
+  if (buffer != NULL) {
+    /* continue taping in the second buffer */
+    ADOLC_CURRENT_TAPE_INFOS.valBuffer = (double *)buffer;
+    ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
+  } else {
+    if (waitTapeIO(ADOLC_CURRENT_TAPE_INFOS.val_io))
       fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if ((failAdditionalInfo1 =
+               fwrite(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
+                      chunkSize * sizeof(double), 1,
+                      ADOLC_CURRENT_TAPE_INFOS.val_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if ((failAdditionalInfo1 =
+               fwrite(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
+                      remain * sizeof(double), 1,
+                      ADOLC_CURRENT_TAPE_INFOS.val_file)) != 1)
+        fail(ADOLC_TAPING_FATAL_IO_ERROR);
+  }
   ADOLC_CURRENT_TAPE_INFOS.numVals_Tape += number;
   ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.valBuffer;
   ADOLC_OPENMP_RESTORE_THREAD_NUMBER;
@@ -2217,26 +3393,80 @@ void put_val_block(double *lastValP1) {
 void get_val_block_f() {
   size_t i, chunks;
   size_t number, remain, chunkSize;
+  void *block;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   number = MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE],
                      ADOLC_CURRENT_TAPE_INFOS.numVals_Tape);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
-              chunkSize * sizeof(double), 1,
-              ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-      fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
-              remain * sizeof(double), 1,
-              ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-      fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+  if (ADOLC_CURRENT_TAPE_INFOS.val_map != NULL) {
+    /* the next block is already in the mapping */
+    ADOLC_CURRENT_TAPE_INFOS.valBuffer =
+        ADOLC_CURRENT_TAPE_INFOS.val_map +
+        (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] -
+         ADOLC_CURRENT_TAPE_INFOS.numVals_Tape);
+    ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
+    ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.valBuffer;
+    ++ADOLC_CURRENT_TAPE_INFOS.currLoc;
+    return;
+  }
+  if (useTapeCodec()) {
+    readTapeBlock(ADOLC_CURRENT_TAPE_INFOS.val_file,
+                  ADOLC_CURRENT_TAPE_INFOS.valBuffer, number, sizeof(double),
+                  ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+    ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.valBuffer;
+    ++ADOLC_CURRENT_TAPE_INFOS.currLoc;
+    return;
+  }
+  block = takePrefetchedBlock(
+      ADOLC_CURRENT_TAPE_INFOS.val_io, ADOLC_CURRENT_TAPE_INFOS.valBuffer,
+      (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] -
+       ADOLC_CURRENT_TAPE_INFOS.numVals_Tape) *
+          sizeof(double),
+      number * sizeof(double), ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+  if (block != NULL) {
+    ADOLC_CURRENT_TAPE_INFOS.valBuffer = (double *)block;
+    ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer +
+        ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
+  } else {
+    if (ADOLC_CURRENT_TAPE_INFOS.val_io != NULL)
+      fseek(ADOLC_CURRENT_TAPE_INFOS.val_file,
+            (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] -
+             ADOLC_CURRENT_TAPE_INFOS.numVals_Tape) *
+                sizeof(double),
+            SEEK_SET);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
+                chunkSize * sizeof(double), 1,
+                ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+        fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
+                remain * sizeof(double), 1,
+                ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+        fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+  }
   ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
   ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.valBuffer;
+  if (useTapeIO())
+    prefetchTapeBlock(
+        &ADOLC_CURRENT_TAPE_INFOS.val_io, ADOLC_CURRENT_TAPE_INFOS.val_file,
+        (ADOLC_CURRENT_TAPE_INFOS.stats[NUM_VALUES] -
+         ADOLC_CURRENT_TAPE_INFOS.numVals_Tape) *
+            sizeof(double),
+        MIN_ADOLC(ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE],
+                  ADOLC_CURRENT_TAPE_INFOS.numVals_Tape) *
+            sizeof(double),
+        ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE] * sizeof(double),
+        ADOLC_EVAL_VAL_TAPE_READ_FAILED);
   /* get_locint_f(); value used in reverse only */
   ++ADOLC_CURRENT_TAPE_INFOS.currLoc;
 }
@@ -2247,28 +3477,78 @@ void get_val_block_f() {
 void get_val_block_r() {
   size_t i, chunks;
   size_t number, remain, chunkSize;
+  void *block;
   locint temp;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
   number = ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
-  fseek(ADOLC_CURRENT_TAPE_INFOS.val_file,
-        sizeof(double) * (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number),
-        SEEK_SET);
-  chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
-  chunks = number / chunkSize;
-  for (i = 0; i < chunks; ++i)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
-              chunkSize * sizeof(double), 1,
-              ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-      fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
-  remain = number % chunkSize;
-  if (remain != 0)
-    if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
-              remain * sizeof(double), 1,
-              ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-      fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+  if (ADOLC_CURRENT_TAPE_INFOS.val_map != NULL) {
+    /* the previous block is already in the mapping, just move the window */
+    ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
+    ADOLC_CURRENT_TAPE_INFOS.valBuffer =
+        ADOLC_CURRENT_TAPE_INFOS.val_map +
+        ADOLC_CURRENT_TAPE_INFOS.numVals_Tape;
+    ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer + number;
+    prefetchPrevBlock(ADOLC_CURRENT_TAPE_INFOS.val_map,
+                      ADOLC_CURRENT_TAPE_INFOS.val_mapSize,
+                      ADOLC_CURRENT_TAPE_INFOS.numVals_Tape * sizeof(double),
+                      number * sizeof(double));
+    --ADOLC_CURRENT_TAPE_INFOS.currLoc;
+    temp = *ADOLC_CURRENT_TAPE_INFOS.currLoc;
+    ADOLC_CURRENT_TAPE_INFOS.currVal =
+        ADOLC_CURRENT_TAPE_INFOS.lastValP1 - temp;
+    return;
+  }
+  if (useTapeCodec()) {
+    readTapeBlockR(ADOLC_CURRENT_TAPE_INFOS.val_file,
+                   &ADOLC_CURRENT_TAPE_INFOS.val_revPos,
+                   ADOLC_CURRENT_TAPE_INFOS.valBuffer, number, sizeof(double),
+                   ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+    ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer + number;
+    ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
+    --ADOLC_CURRENT_TAPE_INFOS.currLoc;
+    temp = *ADOLC_CURRENT_TAPE_INFOS.currLoc;
+    ADOLC_CURRENT_TAPE_INFOS.currVal =
+        ADOLC_CURRENT_TAPE_INFOS.lastValP1 - temp;
+    return;
+  }
+  block = takePrefetchedBlock(
+      ADOLC_CURRENT_TAPE_INFOS.val_io, ADOLC_CURRENT_TAPE_INFOS.valBuffer,
+      (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number) * sizeof(double),
+      number * sizeof(double), ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+  if (block != NULL) {
+    ADOLC_CURRENT_TAPE_INFOS.valBuffer = (double *)block;
+    ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer + number;
+  } else {
+    fseek(ADOLC_CURRENT_TAPE_INFOS.val_file,
+          sizeof(double) * (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number),
+          SEEK_SET);
+    chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
+    chunks = number / chunkSize;
+    for (i = 0; i < chunks; ++i)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
+                chunkSize * sizeof(double), 1,
+                ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+        fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+    remain = number % chunkSize;
+    if (remain != 0)
+      if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
+                remain * sizeof(double), 1,
+                ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+        fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+  }
   ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
+  if (useTapeIO() && ADOLC_CURRENT_TAPE_INFOS.numVals_Tape > 0)
+    prefetchTapeBlock(&ADOLC_CURRENT_TAPE_INFOS.val_io,
+                      ADOLC_CURRENT_TAPE_INFOS.val_file,
+                      (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number) *
+                          sizeof(double),
+                      number * sizeof(double), number * sizeof(double),
+                      ADOLC_EVAL_VAL_TAPE_READ_FAILED);
   --ADOLC_CURRENT_TAPE_INFOS.currLoc;
   temp = *ADOLC_CURRENT_TAPE_INFOS.currLoc;
   ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.lastValP1 - temp;
@@ -2307,6 +3587,7 @@ locint get_val_space(void) {
 void discard_params_r(void) {
   size_t i, np, ip, avail, rsize, chunks;
   size_t number, remain, chunkSize;
+  void *block;
   ADOLC_OPENMP_THREAD_NUMBER;
   ADOLC_OPENMP_GET_THREAD_NUMBER;
   np = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_PARAM];
@@ -2319,23 +3600,60 @@ void discard_params_r(void) {
     ADOLC_CURRENT_TAPE_INFOS.currVal -= rsize;
     if (ip > 0) {
       number = ADOLC_CURRENT_TAPE_INFOS.stats[VAL_BUFFER_SIZE];
-      fseek(ADOLC_CURRENT_TAPE_INFOS.val_file,
-            sizeof(double) * (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number),
-            SEEK_SET);
-      chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
-      chunks = number / chunkSize;
-      for (i = 0; i < chunks; ++i)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
-                  chunkSize * sizeof(double), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-          fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
-      remain = number % chunkSize;
-      if (remain != 0)
-        if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
-                  remain * sizeof(double), 1,
-                  ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
-          fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+      if (ADOLC_CURRENT_TAPE_INFOS.val_map != NULL) {
+        ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer =
+            ADOLC_CURRENT_TAPE_INFOS.val_map +
+            ADOLC_CURRENT_TAPE_INFOS.numVals_Tape;
+        ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+            ADOLC_CURRENT_TAPE_INFOS.valBuffer + number;
+        ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.lastValP1;
+        continue;
+      }
+      if (useTapeCodec()) {
+        readTapeBlockR(ADOLC_CURRENT_TAPE_INFOS.val_file,
+                       &ADOLC_CURRENT_TAPE_INFOS.val_revPos,
+                       ADOLC_CURRENT_TAPE_INFOS.valBuffer, number,
+                       sizeof(double), ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+        ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
+        ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+            ADOLC_CURRENT_TAPE_INFOS.valBuffer + number;
+        ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.lastValP1;
+        continue;
+      }
+      block = takePrefetchedBlock(
+          ADOLC_CURRENT_TAPE_INFOS.val_io, ADOLC_CURRENT_TAPE_INFOS.valBuffer,
+          (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number) * sizeof(double),
+          number * sizeof(double), ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+      if (block != NULL) {
+        ADOLC_CURRENT_TAPE_INFOS.valBuffer = (double *)block;
+        ADOLC_CURRENT_TAPE_INFOS.lastValP1 =
+            ADOLC_CURRENT_TAPE_INFOS.valBuffer + number;
+      } else {
+        fseek(ADOLC_CURRENT_TAPE_INFOS.val_file,
+              sizeof(double) * (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number),
+              SEEK_SET);
+        chunkSize = ADOLC_IO_CHUNK_SIZE / sizeof(double);
+        chunks = number / chunkSize;
+        for (i = 0; i < chunks; ++i)
+          if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + i * chunkSize,
+                    chunkSize * sizeof(double), 1,
+                    ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+            fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+        remain = number % chunkSize;
+        if (remain != 0)
+          if (fread(ADOLC_CURRENT_TAPE_INFOS.valBuffer + chunks * chunkSize,
+                    remain * sizeof(double), 1,
+                    ADOLC_CURRENT_TAPE_INFOS.val_file) != 1)
+            fail(ADOLC_EVAL_VAL_TAPE_READ_FAILED);
+      }
       ADOLC_CURRENT_TAPE_INFOS.numVals_Tape -= number;
+      if (useTapeIO() && ADOLC_CURRENT_TAPE_INFOS.numVals_Tape > 0)
+        prefetchTapeBlock(
+            &ADOLC_CURRENT_TAPE_INFOS.val_io, ADOLC_CURRENT_TAPE_INFOS.val_file,
+            (ADOLC_CURRENT_TAPE_INFOS.numVals_Tape - number) * sizeof(double),
+            number * sizeof(double), number * sizeof(double),
+            ADOLC_EVAL_VAL_TAPE_READ_FAILED);
       ADOLC_CURRENT_TAPE_INFOS.currVal = ADOLC_CURRENT_TAPE_INFOS.lastValP1;
     }
   }
@@ -44,6 +44,18 @@ enum WORKMODES {
   ADOLC_TAPING
 };
 
+/* kinds of the arrays a tape keeps for repeated sweeps and driver calls
+ * (see borrowWorkspace), one array of each kind per tape and thread */
+enum WorkspaceKinds {
+  ADOLC_WS_TAYLOR,  /* zero order Taylors of forward and reverse sweeps */
+  ADOLC_WS_DERIV,   /* vector and higher order Taylors of forward sweeps */
+  ADOLC_WS_ADJOINT, /* adjoints of reverse sweeps */
+  ADOLC_WS_TEMP,    /* temporaries of the sweeps */
+  ADOLC_WS_DRIVER,  /* seeds and results of the drivers */
+
+  ADOLC_NUM_WORKSPACES
+};
+
 /****************************************************************************/
 /* Tape identification (ADOLC & version check)                              */
 /****************************************************************************/
@@ -116,7 +128,8 @@ enum ADOLC_ERRORS {
   ADOLC_WRONG_PLATFORM_32,
   ADOLC_WRONG_PLATFORM_64,
   ADOLC_TAPING_NOT_ACTUALLY_TAPING,
-  ADOLC_VEC_LOCATIONGAP
+  ADOLC_VEC_LOCATIONGAP,
+  ADOLC_TAPING_TAPE_FROZEN
 };
 /* additional infos fail can work with */
 extern int failAdditionalInfo1;
@@ -196,6 +209,21 @@ typedef struct PersistantTapeInfos { /* survive tape re-usage */
    */
   int skipFileCleanup;
 
+  /* how the tape files are accessed (see TapeStorageType) */
+  int tapeStorage;
+  /* codec for the tape files of the next taping (see TapeCodecType) */
+  int tapeCodec;
+
+  /* set by freeze_tape, the tape is shared read-only with OpenMP workers */
+  int frozen;
+
+  /* arrays kept between sweeps (see enumeration WorkspaceKinds) */
+  void *workspace[ADOLC_NUM_WORKSPACES];
+
+  /* data a driver keeps between calls, e.g. the coefficient list of
+   * tensor_eval (see borrowDriverCache) */
+  void *driverCache;
+
   revreal *paramstore;
 #ifdef __cplusplus
   PersistantTapeInfos();
@@ -266,6 +294,27 @@ typedef struct TapeInfos {
   locint *lowestXLoc_ext_v2;
   locint *lowestYLoc_ext_v2;
 
+  /* memory mapped tape files (ADOLC_TAPE_STORE_MMAP), while a mapping is
+   * active the corresponding buffer pointer refers into the mapping */
+  unsigned char *op_map;
+  size_t op_mapSize; /* size of the mapping in bytes */
+  locint *loc_map;
+  size_t loc_mapSize;
+  double *val_map;
+  size_t val_mapSize;
+
+  /* background transfers of ADOLC_TAPE_STORE_ASYNC, one per tape file */
+  struct TapeIOJob *op_io;
+  struct TapeIOJob *loc_io;
+  struct TapeIOJob *val_io;
+  struct TapeIOJob *tay_io;
+
+  /* compressed tape files: offset behind the block to be read next in
+   * reverse direction */
+  size_t op_revPos;
+  size_t loc_revPos;
+  size_t val_revPos;
+
   /* evaluation forward */
   double *dp_T0;
   int gDegree, numTay;
@@ -291,6 +340,9 @@ typedef struct TapeInfos {
   locint *switchlocs;
   double *signature;
 
+  /* the frozen tape of the serial part a worker view refers to */
+  const struct TapeInfos *frozenTape;
+
   PersistantTapeInfos pTapeInfos;
 
 #if defined(__cplusplus)
@@ -315,6 +367,9 @@ typedef struct GlobalTapeVarsCL {
   locint valueBufferSize;     /* in a local config file .adolcrc. */
   locint taylorBufferSize;
   int maxNumberTaylorBuffers;
+  int tapeStorage; /* default storage type for new tapes */
+  int tapeCodec;   /* default tape file codec for new tapes */
+  size_t dirChunkSize; /* Taylor bytes per chunk of multithreaded sweeps */
 
   char inParallelRegion; /* set to 1 if in an OpenMP parallel region */
   char newTape;          /* signals: at least one tape created (0/1) */
@@ -419,6 +474,72 @@ TapeInfos *getTapeInfos(short tapeID);
 /* updates the tape infos for the given ID - a tapeInfos struct is created
  * and registered if non is found but its state will remain "not in use" */
 
+const char *opLayout(unsigned char op, int *numVals, bool *essential);
+/* roles of the locations an operation writes to the tape, NULL for
+ * operations the tape optimizer does not handle (see tape_optimizer.cpp) */
+
+const TapeInfos *shareableTape(short tapeID);
+/* returns the tape infos if the tape resides in main memory and can be
+ * swept by several threads at once, NULL otherwise */
+
+const TapeInfos *sharedReverseTape(short tapeID, int m, int n);
+/* as shareableTape, the Taylor stack of an m x n reverse sweep has to
+ * reside in main memory as well */
+
+int sweepWorkers(int nthreads, int numDirs);
+/* number of threads a multithreaded sweep over numDirs directions uses if
+ * nthreads are requested (all available ones if nthreads <= 0), 1 within a
+ * parallel region and in builds without OpenMP */
+
+int edgePushHess(short tag, int n, const double *x, int *nnz,
+                 unsigned int **rind, unsigned int **cind, double **values,
+                 int fallback);
+/* edge_push_hess; if fallback is set, tapes with operations the edge
+ * pushing sweep does not handle return -2 without an error message */
+
+#if defined(_OPENMP)
+int maxParallelThreads();
+/* maximal number of workers of an ADOL-C parallel region */
+
+TapeInfos *attachSharedTape(const TapeInfos *tapeInfos, TapeInfos **hidden);
+/* registers a TapeInfos for the calling worker that shares the buffers of
+ * the given in-core tape, any TapeInfos of the worker for the same tape is
+ * returned in hidden */
+
+void detachSharedTape(TapeInfos *view, TapeInfos *hidden);
+/* removes a TapeInfos registered by attachSharedTape and restores hidden */
+#endif
+
+void *borrowWorkspace(TapeInfos *tapeInfos, int kind, size_t bytes, int clear);
+/* takes the array of the given kind (see enumeration WorkspaceKinds) kept by
+ * tapeInfos if it has room for bytes, a larger one is allocated otherwise.
+ * The array is zeroed if clear is set. */
+
+double **borrowWorkspace2(TapeInfos *tapeInfos, int kind, size_t m, size_t n);
+/* as borrowWorkspace, a zeroed m x n matrix laid out as by myalloc2 */
+
+void returnWorkspace(TapeInfos *tapeInfos, int kind, void *block);
+/* gives a borrowed array back to tapeInfos for the next borrowWorkspace */
+
+void *borrowDriverWorkspace(short tag, size_t bytes);
+/* a zeroed array of the driver kind kept by tape tag, taken from the current
+ * tape infos while tag is swept */
+
+void returnDriverWorkspace(short tag, void *block);
+/* gives an array of borrowDriverWorkspace back to tape tag */
+
+void *borrowDriverCache(short tag);
+/* takes the malloc'ed block a driver has given to tape tag by
+ * returnDriverCache, NULL if there is none. A nested call on the same tape
+ * does not see the block until it is given back. */
+
+void returnDriverCache(short tag, void *cache);
+/* gives a block of the driver cache to tape tag, the one kept so far is
+ * freed. The block is freed at once if there is no tape tag. */
+
+void freeWorkspaces(PersistantTapeInfos *pTapeInfos);
+/* frees the arrays and the driver cache kept by a tape */
+
 #ifdef SPARSE
 void setTapeInfoJacSparse(short tapeID, SparseJacInfos sJinfos);
 /* updates the tape infos on sparse Jac for the given ID */
@@ -518,6 +639,22 @@ void get_tay_block_r();
 void initTapeBuffers();
 /* free/allocate memory for buffers, initialize pointers */
 
+void unmapTapeFiles(TapeInfos *tapeInfos);
+/* releases the mappings of a tape read with ADOLC_TAPE_STORE_MMAP */
+
+void releaseTapeIO(TapeInfos *tapeInfos);
+/* waits for outstanding background transfers of a tape and frees their
+ * buffers (ADOLC_TAPE_STORE_ASYNC) */
+
+size_t encodeLZ(const unsigned char *in, size_t size, unsigned char *out,
+                size_t capacity);
+/* LZ77 compression of the blocks of ADOLC_TAPE_CODEC_BLOCK, returns the size
+ * of the encoding or 0 if it would not be smaller than capacity */
+
+int decodeLZ(const unsigned char *in, size_t size, unsigned char *out,
+             size_t outSize);
+/* inverse of encodeLZ, returns nonzero if the encoding is corrupt */
+
 void start_trace();
 /* initialization for the taping process -> buffer allocation, sets
  * files names, and calls appropriate setup routines */
@@ -525,12 +662,18 @@ void start_trace();
 void stop_trace(int flag);
 /* stop Tracing, clean up, and turn off trace_flag */
 
+void stop_retrace(int flag);
+/* finish a tape rewritten from an existing one, e.g., by optimize_tape */
+
 void close_tape(int flag);
 /* close open tapes, update stats and clean up */
 
 void freeTapeResources(TapeInfos *tapeInfos);
 /* free all resources used by a tape before overwriting the tape */
 
+void freeTaylorStack(TapeInfos *tapeInfos);
+/* frees the Taylor buffer and removes the Taylor file of the tape infos */
+
 void read_tape_stats(TapeInfos *tapeInfos);
 /* does the actual reading from the hard disk into the stats buffer */
 
@@ -543,6 +686,9 @@ void init_rev_sweep(short tag);
 void end_sweep();
 /* finish a forward or reverse sweep */
 
+int tapeContainsOps(short tag, const unsigned char *ops, int numOps);
+/* checks whether the tape contains one of the given operations */
+
 void fail(int error);
 /* outputs an appropriate error message using DIAG_OUT and exits the running
  * program */
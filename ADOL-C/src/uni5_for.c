@@ -34,6 +34,7 @@ and _NTIGHT__
 #include "externfcts_p.h"
 #include "oplate.h"
 #include "taping_p.h"
+#include "vec_kernels.h"
 #include <adolc/adalloc.h>
 #include <adolc/externfcts.h>
 #include <adolc/interfaces.h>
@@ -155,10 +156,16 @@ void merge_3_index_domains(int res, int arg1, int arg2, locint **ind_dom);
 
 #if defined(_INDOPRO_) && !defined(_NONLIND_OLD_)
 #if defined(_TIGHT_)
+#if defined(_CHUNKED_)
+#define GENERATED_FILENAME "indopro_offset_forward_t"
+#else
 #define GENERATED_FILENAME "indopro_forward_t"
 #endif
+#endif
 #if defined(_NTIGHT_)
-#if defined(_ABS_NORM_)
+#if defined(_CHUNKED_)
+#define GENERATED_FILENAME "indopro_offset_forward_s"
+#elif defined(_ABS_NORM_)
 #define GENERATED_FILENAME "indopro_forward_pl"
 #else
 #define GENERATED_FILENAME "indopro_forward_s"
@@ -476,6 +483,14 @@ void extend_nonlinearity_domain_binary(int arg1, int arg2, locint **ind_dom,
 #define HOV_INC(T, inc)
 #endif
 
+/* length of the block of Taylor coefficients of one location that linear
+ * operations pass to the kernels of vec_kernels.c */
+#if defined(_HOV_) || defined(_HOV_WK_)
+#define VEC_KERNEL_LEN pk
+#elif defined(_FOV_)
+#define VEC_KERNEL_LEN p
+#endif
+
 /*--------------------------------------------------------------------------*/
 /*                                                        higher order case */
 #if defined(_HIGHER_ORDER_)
@@ -604,6 +619,29 @@ and pass a bit pattern version of the identity matrix as an argument    */
 #endif
 #else
 #if defined(_INDOPRO_) && !defined(_NONLIND_OLD_)
+#if defined(_CHUNKED_)
+#if defined(_TIGHT_)
+/****************************************************************************/
+/* Index domains of the independents offset, ..., offset + count - 1, tight */
+/****************************************************************************/
+int indopro_offset_forward_tight(
+#else
+/****************************************************************************/
+/* Index domains of the independents offset, ..., offset + count - 1, safe  */
+/****************************************************************************/
+int indopro_offset_forward_safe(
+#endif
+    short tnum,              /* tape id                              */
+    int depcheck,            /* consistency chk on # of dependents   */
+    int indcheck,            /* consistency chk on # of independents */
+    int offset,              /* first independent with a domain      */
+    int count,               /* number of independents with domains  */
+    const double *basepoint, /* independent variable values   (in)   */
+    unsigned int **crs)      /* returned row index storage (out)     */
+
+/* indopro_offset_forward_{safe,tight}( tag, m, n, offset, count, x[n],
+ * *crs[m]), crs[i] only holds the independents of the range */
+#else
 #if defined(_TIGHT_)
 /****************************************************************************/
 /* First Order Vector version of the forward mode for bit patterns, tight   */
@@ -647,6 +685,7 @@ int indopro_forward_tight(
   */
 #endif
 #endif
+#endif /* _CHUNKED_ */
 #else
 #if defined(_NONLIND_)
 #if defined(_TIGHT_)
@@ -908,7 +947,10 @@ int hov_forward(
   double *dp_T;
 #define T_TEMP Ttemp;
 #else
-  double *dp_Ttemp, **dpp_T;
+  double **dpp_T;
+#if defined(_FOV_)
+  double *dp_Ttemp;
+#endif
 #endif
   double *Tres, *Targ, *Targ1, *Targ2, *Tqo;
 
@@ -1048,6 +1090,11 @@ int hov_forward(
   /* Set up stuff for the tape */
   ADOLC_OPENMP_GET_THREAD_NUMBER;
 
+#if defined(_INDOPRO_) && defined(_CHUNKED_) && defined(_NTIGHT_)
+  /* the safe variant keeps the signature of the tight one it replaces */
+  (void)basepoint;
+#endif
+
   /* Initialize the Forward Sweep */
 
   init_for_sweep(tnum);
@@ -1091,7 +1138,9 @@ int hov_forward(
 
   /*--------------------------------------------------------------------------*/
 #if !defined(_NTIGHT_)
-  dp_T0 = myalloc1(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES]);
+  dp_T0 = (double *)borrowWorkspace(
+      &ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TAYLOR,
+      ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * sizeof(double), 1);
   ADOLC_CURRENT_TAPE_INFOS.dp_T0 = dp_T0;
 
   if ((ADOLC_CURRENT_TAPE_INFOS.stats[NO_MIN_MAX]) &&
@@ -1131,7 +1180,9 @@ int hov_forward(
     adolc_exit(-1, "", __func__, __FILE__, __LINE__);
   }
 #endif
-  dp_T = myalloc1(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES]);
+  dp_T = (double *)borrowWorkspace(
+      &ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_DERIV,
+      ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES] * sizeof(double), 1);
   ADOLC_CURRENT_TAPE_INFOS.dpp_T = &dp_T;
   ADOLC_CURRENT_TAPE_INFOS.numTay = 1;
   ADOLC_CURRENT_TAPE_INFOS.gDegree = 1;
@@ -1147,7 +1198,16 @@ int hov_forward(
   /*--------------------------------------------------------------------------*/
 #else /* INF_FOR */
 #if defined(_INT_FOR_)
-  up_T = myalloc2_ulong(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES], p);
+  {
+    const size_t lives = ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES];
+
+    up_T = (unsigned long int **)borrowWorkspace(
+        &ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_DERIV,
+        lives * (sizeof(unsigned long int *) + p * sizeof(unsigned long int)),
+        1);
+    for (size_t i = 0; i < lives; ++i)
+      up_T[i] = (unsigned long int *)(up_T + lives) + i * p;
+  }
 #define TAYLOR_BUFFER up_T
 
   /*--------------------------------------------------------------------------*/
@@ -1201,27 +1261,29 @@ int hov_forward(
   /*--------------------------------------------------------------------------*/
 #else /* FOV */
 #if defined(_FOV_)
-  dpp_T = myalloc2(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES], p);
+  dpp_T = borrowWorkspace2(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_DERIV,
+                           ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES], p);
   ADOLC_CURRENT_TAPE_INFOS.dpp_T = dpp_T;
   ADOLC_CURRENT_TAPE_INFOS.numTay = p;
   ADOLC_CURRENT_TAPE_INFOS.gDegree = 1;
   ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_FOV_FORWARD;
 #define TAYLOR_BUFFER dpp_T
-  dp_Ttemp = myalloc1(p);
+  dp_Ttemp = (double *)borrowWorkspace(&ADOLC_CURRENT_TAPE_INFOS,
+                                       ADOLC_WS_TEMP, p * sizeof(double), 1);
 #define T_TEMP dp_Ttemp;
 
   /*--------------------------------------------------------------------------*/
 #else /* HOS */
 #if defined(_HOS_)
-  dpp_T = myalloc2(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES], k);
+  dpp_T = borrowWorkspace2(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_DERIV,
+                           ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES], k);
   ADOLC_CURRENT_TAPE_INFOS.dpp_T = dpp_T;
   ADOLC_CURRENT_TAPE_INFOS.numTay = 1;
   ADOLC_CURRENT_TAPE_INFOS.gDegree = k;
   ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_HOS_FORWARD;
 #define TAYLOR_BUFFER dpp_T
-  dp_z = myalloc1(k);
-  dp_Ttemp = myalloc1(k);
-#define T_TEMP dp_Ttemp;
+  dp_z = (double *)borrowWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TEMP,
+                                   k * sizeof(double), 1);
 #if defined(_KEEP_)
   if (keep) {
     const size_t taylbuf = ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE];
@@ -1231,15 +1293,15 @@ int hov_forward(
 
   /*--------------------------------------------------------------------------*/
 #else /* HOV and HOV_WK */
-  dpp_T = myalloc2(ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES], p * k);
+  dpp_T = borrowWorkspace2(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_DERIV,
+                           ADOLC_CURRENT_TAPE_INFOS.stats[NUM_MAX_LIVES], p * k);
   ADOLC_CURRENT_TAPE_INFOS.dpp_T = dpp_T;
   ADOLC_CURRENT_TAPE_INFOS.numTay = p;
   ADOLC_CURRENT_TAPE_INFOS.gDegree = k;
   ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_HOV_FORWARD;
 #define TAYLOR_BUFFER dpp_T
-  dp_z = myalloc1(k);
-  dp_Ttemp = myalloc1(p * k);
-#define T_TEMP dp_Ttemp;
+  dp_z = (double *)borrowWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TEMP,
+                                   k * sizeof(double), 1);
 #if defined(_KEEP_)
   if (keep) {
     const size_t taylbuf = ADOLC_CURRENT_TAPE_INFOS.stats[TAY_BUFFER_SIZE];
@@ -1598,8 +1660,15 @@ int hov_forward(
 
 #if defined(_INDO_)
 #if defined(_INDOPRO_)
-      ind_dom[res][0] = 1;
-      ind_dom[res][2] = indexi;
+#if defined(_CHUNKED_)
+      if (indexi < offset || indexi >= offset + count)
+        ind_dom[res][0] = 0;
+      else
+#endif
+      {
+        ind_dom[res][0] = 1;
+        ind_dom[res][2] = indexi;
+      }
 #endif
 #if defined(_NONLIND_)
       fod[opind].entry = indexi;
@@ -1726,7 +1795,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_pk TRES_INC |= TARG_INC;
+      vec_bit_or(p, Tres, Targ, Tres);
 #else
       FOR_0_LE_l_LT_pk TRES_INC += TARG_INC;
 #endif
@@ -1794,7 +1863,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_pk TRES_INC |= TARG_INC;
+      vec_bit_or(p, Tres, Targ, Tres);
 #else
       FOR_0_LE_l_LT_pk TRES_INC -= TARG_INC;
 #endif
@@ -1966,7 +2035,9 @@ int hov_forward(
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_pk TRES_INC = TARG1_INC | TARG2_INC;
+      vec_bit_or(p, Targ1, Targ2, Tres);
+#elif defined(VEC_KERNEL_LEN)
+      vec_add(VEC_KERNEL_LEN, Targ1, Targ2, Tres);
 #else
       FOR_0_LE_l_LT_pk TRES_INC = TARG1_INC + TARG2_INC;
 #endif
@@ -2074,7 +2145,9 @@ int hov_forward(
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_pk TRES_INC = TARG1_INC | TARG2_INC;
+      vec_bit_or(p, Targ1, Targ2, Tres);
+#elif defined(VEC_KERNEL_LEN)
+      vec_sub(VEC_KERNEL_LEN, Targ1, Targ2, Tres);
 #else
       FOR_0_LE_l_LT_pk TRES_INC = TARG1_INC - TARG2_INC;
 #endif
@@ -2111,7 +2184,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_pk TRES_INC = TARG_INC;
+      vec_bit_copy(p, Targ, Tres);
 #else
       FOR_0_LE_l_LT_pk TRES_INC = -TARG_INC;
 #endif
@@ -2151,7 +2224,9 @@ int hov_forward(
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG2_INC | TARG1_INC;
+      vec_bit_or(p, Targ2, Targ1, Tres);
+#elif defined(_FOV_)
+      vec_lincomb(p, dp_T0[arg1], Targ2, dp_T0[arg2], Targ1, Tres);
 #else
       /* olvo 980915 now in reverse order to allow x = x*x etc. */
       INC_pk_1(Tres) INC_pk_1(Targ1) INC_pk_1(Targ2)
@@ -2218,7 +2293,9 @@ int hov_forward(
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC |= TARG2_INC | TARG1_INC;
+      vec_bit_add_or(p, Targ2, Targ1, Tres);
+#elif defined(_FOV_)
+      vec_add_lincomb(p, dp_T0[arg1], Targ2, dp_T0[arg2], Targ1, Tres);
 #else
       /* olvo 980915 now in reverse order to allow x = x*x etc. */
       INC_pk_1(Tres) INC_pk_1(Targ1) INC_pk_1(Targ2)
@@ -2284,7 +2361,10 @@ int hov_forward(
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC |= TARG2_INC | TARG1_INC;
+      vec_bit_add_or(p, Targ2, Targ1, Tres);
+#elif defined(_FOV_)
+      /* negating both factors is exact */
+      vec_add_lincomb(p, -dp_T0[arg1], Targ2, -dp_T0[arg2], Targ1, Tres);
 #else
       /* olvo 980915 now in reverse order to allow x = x*x etc. */
       INC_pk_1(Tres) INC_pk_1(Targ1) INC_pk_1(Targ2)
@@ -2339,7 +2419,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_pk TRES_INC = TARG_INC;
+      vec_bit_copy(p, Targ, Tres);
 #else
       FOR_0_LE_l_LT_pk TRES_INC = TARG_INC * coval;
 #endif
@@ -2376,7 +2456,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_pk TRES_INC = TARG_INC;
+      vec_bit_copy(p, Targ, Tres);
 #else
       FOR_0_LE_l_LT_pk TRES_INC = TARG_INC * coval;
 #endif
@@ -2426,7 +2506,7 @@ int hov_forward(
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG1_INC | TARG2_FOINC;
+      vec_bit_or(p, Targ1, Targ2, Tres);
 #else
       FOR_0_LE_l_LT_p
           FOR_0_LE_i_LT_k { /* olvo 980922 changed order to allow x = y/x */
@@ -2496,7 +2576,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG_FOINC;
+      vec_bit_copy(p, Targ, Tres);
 #else
       FOR_0_LE_l_LT_p
           FOR_0_LE_i_LT_k { /* olvo 980922 changed order to allow x = d/x */
@@ -2567,7 +2647,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG_FOINC;
+      vec_bit_copy(p, Targ, Tres);
 #else
       FOR_0_LE_l_LT_p
           FOR_0_LE_i_LT_k { /* olvo 980922 changed order to allow x = d/x */
@@ -2647,7 +2727,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_pk TRES_INC = TARG_INC;
+      vec_bit_copy(p, Targ, Tres);
 #else
       FOR_0_LE_l_LT_pk TRES_INC = -TARG_INC;
 #endif
@@ -2693,7 +2773,9 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG_FOINC;
+      vec_bit_copy(p, Targ, Tres);
+#elif defined(_FOV_)
+      vec_scale(p, dp_T0[res], Targ, Tres);
 #else
       FOR_0_LE_l_LT_p
           FOR_0_LE_i_LT_k { /* olvo 980915 changed order to allow x = exp(x) */
@@ -2758,10 +2840,13 @@ int hov_forward(
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p { /* olvo 980923 changed order to allow x = sin(x) */
-        TARG2_FOINC = TARG1;
-        TRES_FOINC = TARG1_FOINC;
-      }
+      /* Note: always arg2 != arg1, and res == arg1 for x = sin(x) */
+      vec_bit_copy(p, Targ1, Targ2);
+      vec_bit_copy(p, Targ1, Tres);
+#elif defined(_FOV_)
+      /* Note: always arg2 != arg1 */
+      vec_scale(p, -dp_T0[res], Targ1, Targ2);
+      vec_scale(p, dp_T0[arg2], Targ1, Tres);
 #else
       FOR_0_LE_l_LT_p
           FOR_0_LE_i_LT_k { /* olvo 980921 changed order to allow x = sin(x) */
@@ -2833,10 +2918,13 @@ int hov_forward(
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p { /* olvo 980923 changed order to allow x = cos(x) */
-        TARG2_FOINC = TARG1;
-        TRES_FOINC = TARG1_FOINC;
-      }
+      /* Note: always arg2 != arg1, and res == arg1 for x = cos(x) */
+      vec_bit_copy(p, Targ1, Targ2);
+      vec_bit_copy(p, Targ1, Tres);
+#elif defined(_FOV_)
+      /* Note: always arg2 != arg1 */
+      vec_scale(p, dp_T0[res], Targ1, Targ2);
+      vec_scale(p, -dp_T0[arg2], Targ1, Tres);
 #else
       FOR_0_LE_l_LT_p
           FOR_0_LE_i_LT_k { /* olvo 980921 changed order to allow x = cos(x) */
@@ -2902,7 +2990,7 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
       ASSIGN_T(Targ1, TAYLOR_BUFFER[arg1])
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG1_FOINC;
+      vec_bit_copy(p, Targ1, Tres);
 #else
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
@@ -2965,7 +3053,7 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
       ASSIGN_T(Targ1, TAYLOR_BUFFER[arg1])
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG1_FOINC;
+      vec_bit_copy(p, Targ1, Tres);
 #else
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
@@ -3067,7 +3155,7 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
       ASSIGN_T(Targ1, TAYLOR_BUFFER[arg1])
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG1_FOINC;
+      vec_bit_copy(p, Targ1, Tres);
 #else
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
@@ -3169,7 +3257,7 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
       ASSIGN_T(Targ1, TAYLOR_BUFFER[arg1])
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG1_FOINC;
+      vec_bit_copy(p, Targ1, Tres);
 #else
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
@@ -3232,7 +3320,7 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
       ASSIGN_T(Targ1, TAYLOR_BUFFER[arg1])
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG1_FOINC;
+      vec_bit_copy(p, Targ1, Tres);
 #else
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
@@ -3319,7 +3407,7 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
       ASSIGN_T(Targ1, TAYLOR_BUFFER[arg1])
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG1_FOINC;
+      vec_bit_copy(p, Targ1, Tres);
 #else
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
@@ -3424,7 +3512,7 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
       ASSIGN_T(Targ1, TAYLOR_BUFFER[arg1])
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG1_FOINC;
+      vec_bit_copy(p, Targ1, Tres);
 #else
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
@@ -3483,7 +3571,7 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
       ASSIGN_T(Targ1, TAYLOR_BUFFER[arg1])
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG1_FOINC;
+      vec_bit_copy(p, Targ1, Tres);
 #else
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
@@ -3540,7 +3628,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG_INC;
+      vec_bit_copy(p, Targ, Tres);
 #else
       divs = 1.0 / dp_T0[arg];
       FOR_0_LE_l_LT_p {
@@ -3629,7 +3717,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG_INC;
+      vec_bit_copy(p, Targ, Tres);
 #else
       if (T0arg == 0.0) {
         if (coval <= 0.0)
@@ -3774,7 +3862,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG_INC;
+      vec_bit_copy(p, Targ, Tres);
 #else
       if (T0arg == 0.0) {
         if (coval <= 0.0)
@@ -3904,7 +3992,7 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG_INC;
+      vec_bit_copy(p, Targ, Tres);
 #else
       FOR_0_LE_l_LT_p {
         TargOP = Targ;
@@ -3988,7 +4076,7 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG_INC;
+      vec_bit_copy(p, Targ, Tres);
 #else
       FOR_0_LE_l_LT_p {
         TargOP = Targ;
@@ -4065,7 +4153,7 @@ int hov_forward(
       ASSIGN_T(Tres, TAYLOR_BUFFER[res])
       ASSIGN_T(Targ1, TAYLOR_BUFFER[arg1])
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_p TRES_FOINC = TARG1_FOINC;
+      vec_bit_copy(p, Targ1, Tres);
 #else
       ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2])
 
@@ -4162,7 +4250,6 @@ int hov_forward(
       fod[opind].left = &fod[arg_index[arg1]];
       fod[opind].right = &fod[arg_index[arg2]];
       arg_index[res] = opind++;
-      arg_index[res] = opind++;
 #endif
 #endif
 #else
@@ -4204,7 +4291,7 @@ int hov_forward(
       dp_T0[res] = MIN_ADOLC(dp_T0[arg1], dp_T0[arg2]);
 #endif /* _TIGHT_ */
 #ifdef _NTIGHT_
-      TRES_INC = TARG1_INC | TARG2_INC;
+      FOR_0_LE_l_LT_p TRES_INC = TARG1_INC | TARG2_INC;
 #endif /* _NTIGHT_ */
 #else
       Tqo = NULL;
@@ -5227,8 +5314,15 @@ int hov_forward(
       dp_T0[res] = basepoint[indexi];
 #if defined(_INDO_)
 #if defined(_INDOPRO_)
-      ind_dom[res][0] = 1;
-      ind_dom[res][2] = indexi;
+#if defined(_CHUNKED_)
+      if (indexi < offset || indexi >= offset + count)
+        ind_dom[res][0] = 0;
+      else
+#endif
+      {
+        ind_dom[res][0] = 1;
+        ind_dom[res][2] = indexi;
+      }
 #endif
 #if defined(_NONLIND_)
       fod[opind].entry = indexi;
@@ -5320,7 +5414,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_pk TRES_INC |= TARG_INC;
+      vec_bit_or(p, Tres, Targ, Tres);
 #else
       FOR_0_LE_l_LT_pk TRES_INC += TARG_INC;
 #endif
@@ -5397,7 +5491,7 @@ int hov_forward(
       ASSIGN_T(Targ, TAYLOR_BUFFER[arg])
 
 #ifdef _INT_FOR_
-      FOR_0_LE_l_LT_pk TRES_INC |= TARG_INC;
+      vec_bit_or(p, Tres, Targ, Tres);
 #else
       FOR_0_LE_l_LT_pk TRES_INC -= TARG_INC;
 #endif
@@ -5617,7 +5711,7 @@ int hov_forward(
         ASSIGN_T(Targ2, TAYLOR_BUFFER[arg2 + qq])
 
 #ifdef _INT_FOR_
-        FOR_0_LE_l_LT_p TRES_FOINC |= TARG2_INC | TARG1_INC;
+        vec_bit_add_or(p, Targ2, Targ1, Tres);
 #else
         /* olvo 980915 now in reverse order to allow x = x*x etc. */
         INC_pk_1(Tres) INC_pk_1(Targ1) INC_pk_1(Targ2)
@@ -6469,24 +6563,28 @@ int hov_forward(
     taylor_close(true);
 #endif
 
-  /* clean up */
+  /* clean up, the arrays are kept for the next sweep */
 #if !defined(_NTIGHT_)
-  free(dp_T0);
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TAYLOR, dp_T0);
 #endif /* !_NTIGHT_ */
 #if !defined(_INDO_)
 #if !defined(_ZOS_)
 #if defined(_FOS_)
-  free(dp_T);
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_DERIV, dp_T);
 #else
 #if !defined(_INT_FOR_)
-  myfree2(dpp_T);
-  free(dp_Ttemp);
-#endif /* !_NTIGHT_ */
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_DERIV, dpp_T);
+#if defined(_FOV_)
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TEMP, dp_Ttemp);
+#endif
+#else
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_DERIV, up_T);
+#endif /* !_INT_FOR_ */
 #endif
 #endif
 #endif
 #if defined(_HIGHER_ORDER_)
-  free(dp_z);
+  returnWorkspace(&ADOLC_CURRENT_TAPE_INFOS, ADOLC_WS_TEMP, dp_z);
 #endif
 
   ADOLC_CURRENT_TAPE_INFOS.workMode = ADOLC_NO_MODE;
@@ -6601,7 +6699,7 @@ short ext_firstsign2(double sigbase, int p, double *u, double *du) {
 /*--------------------------------------------------------------------------*/
 /* operations on index domains                                              */
 
-#if defined(_TIGHT_)
+#if defined(_TIGHT_) && !defined(_CHUNKED_)
 void copy_index_domain(int res, int arg, locint **ind_dom) {
 
   int i;
@@ -0,0 +1,205 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     vec_kernels.c
+ Revision: $Id$
+ Contents: kernels of the vector forward and reverse sweeps operating on the
+           contiguous block of directions of one location (used by
+           uni5_for.c and fo_rev.c)
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#include "vec_kernels.h"
+
+/*--------------------------------------------------------------------------*/
+/* The loops are vectorized by "omp simd" if the compiler is called with    */
+/* -fopenmp-simd (ADOLC_OPENMP_SIMD) or OpenMP. With ADOLC_TARGET_CLONES    */
+/* every kernel is compiled for AVX-512, AVX2 and the baseline instruction  */
+/* set, the variant is chosen at load time according to the CPU. The build  */
+/* disables floating-point contraction for this file, hence the results do  */
+/* not depend on the CPU and agree with the scalar modes.                   */
+#if defined(ADOLC_TARGET_CLONES)
+#define VEC_KERNEL                                                           \
+  __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define VEC_KERNEL
+#endif
+
+#if defined(_OPENMP) || defined(ADOLC_OPENMP_SIMD)
+#define VEC_LOOP _Pragma("omp simd") for (int l = 0; l < n; l++)
+#else
+#define VEC_LOOP for (int l = 0; l < n; l++)
+#endif
+#define SCALAR_LOOP for (int l = 0; l < n; l++)
+
+BEGIN_C_DECLS
+
+/****************************************************************************/
+/*                                                          FORWARD KERNELS */
+/* Every entry of the result depends on the same entries of the arguments   */
+/* only, hence res == x is harmless for the vectorized loops.               */
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_add(int n, const double *x, const double *y, double *res) {
+  VEC_LOOP res[l] = x[l] + y[l];
+}
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_sub(int n, const double *x, const double *y, double *res) {
+  VEC_LOOP res[l] = x[l] - y[l];
+}
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_scale(int n, double a, const double *x, double *res) {
+  VEC_LOOP res[l] = a * x[l];
+}
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_lincomb(int n, double a, const double *x, double b,
+                            const double *y, double *res) {
+  VEC_LOOP res[l] = a * x[l] + b * y[l];
+}
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_add_lincomb(int n, double a, const double *x, double b,
+                                const double *y, double *res) {
+  VEC_LOOP res[l] += a * x[l] + b * y[l];
+}
+
+/****************************************************************************/
+/*                                                          REVERSE KERNELS */
+/* The adjoints of x = x * x or of results sharing a location with an       */
+/* argument are updated twice per entry, such calls use the scalar loops.   */
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_rev_push1(int n, revreal a, revreal *res, revreal *arg) {
+  if (res == arg) {
+    SCALAR_LOOP {
+      revreal aTmp = res[l];
+      res[l] = 0.0;
+      arg[l] += aTmp * a;
+    }
+  } else {
+    VEC_LOOP {
+      revreal aTmp = res[l];
+      res[l] = 0.0;
+      arg[l] += aTmp * a;
+    }
+  }
+}
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_rev_push2(int n, revreal a1, revreal a2, revreal *res,
+                              revreal *arg1, revreal *arg2) {
+  if (res == arg1 || res == arg2 || arg1 == arg2) {
+    SCALAR_LOOP {
+      revreal aTmp = res[l];
+      res[l] = 0.0;
+      arg2[l] += aTmp * a2;
+      arg1[l] += aTmp * a1;
+    }
+  } else {
+    VEC_LOOP {
+      revreal aTmp = res[l];
+      res[l] = 0.0;
+      arg2[l] += aTmp * a2;
+      arg1[l] += aTmp * a1;
+    }
+  }
+}
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_rev_add2(int n, revreal a1, revreal a2, const revreal *res,
+                             revreal *arg1, revreal *arg2) {
+  if (res == arg1 || res == arg2 || arg1 == arg2) {
+    SCALAR_LOOP {
+      arg2[l] += res[l] * a2;
+      arg1[l] += res[l] * a1;
+    }
+  } else {
+    VEC_LOOP {
+      arg2[l] += res[l] * a2;
+      arg1[l] += res[l] * a1;
+    }
+  }
+}
+
+/****************************************************************************/
+/*                                                      BIT PATTERN KERNELS */
+/* The bit patterns of a strip are processed in words of the vector         */
+/* registers, i.e. 256 or 512 bits at once with AVX2 or AVX-512. As above,  */
+/* res == x is harmless in the forward kernels. Or-ing is idempotent, so    */
+/* only adjoints that are reset after pushing them need the scalar loops.   */
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_bit_or(int n, const unsigned long int *x,
+                           const unsigned long int *y,
+                           unsigned long int *res) {
+  VEC_LOOP res[l] = x[l] | y[l];
+}
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_bit_add_or(int n, const unsigned long int *x,
+                               const unsigned long int *y,
+                               unsigned long int *res) {
+  VEC_LOOP res[l] |= x[l] | y[l];
+}
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_bit_copy(int n, const unsigned long int *x,
+                             unsigned long int *res) {
+  if (res != x)
+    VEC_LOOP res[l] = x[l];
+}
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_bit_push1(int n, unsigned long int *res,
+                              unsigned long int *arg) {
+  if (res == arg) {
+    SCALAR_LOOP {
+      unsigned long int aTmp = res[l];
+      res[l] = 0;
+      arg[l] |= aTmp;
+    }
+  } else {
+    VEC_LOOP {
+      arg[l] |= res[l];
+      res[l] = 0;
+    }
+  }
+}
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_bit_push2(int n, unsigned long int *res,
+                              unsigned long int *arg1,
+                              unsigned long int *arg2) {
+  if (res == arg1 || res == arg2) {
+    SCALAR_LOOP {
+      unsigned long int aTmp = res[l];
+      res[l] = 0;
+      arg1[l] |= aTmp;
+      arg2[l] |= aTmp;
+    }
+  } else {
+    VEC_LOOP {
+      arg1[l] |= res[l];
+      arg2[l] |= res[l];
+      res[l] = 0;
+    }
+  }
+}
+
+/*--------------------------------------------------------------------------*/
+VEC_KERNEL void vec_bit_add2(int n, const unsigned long int *res,
+                             unsigned long int *arg1,
+                             unsigned long int *arg2) {
+  VEC_LOOP {
+    arg1[l] |= res[l];
+    arg2[l] |= res[l];
+  }
+}
+
+END_C_DECLS
@@ -0,0 +1,72 @@
+/*----------------------------------------------------------------------------
+ ADOL-C -- Automatic Differentiation by Overloading in C++
+ File:     vec_kernels.h
+ Revision: $Id$
+ Contents: kernels of the vector forward and reverse sweeps operating on the
+           contiguous block of directions of one location
+
+ This file is part of ADOL-C. This software is provided as open source.
+ Any use, reproduction, or distribution of the software constitutes
+ recipient's acceptance of the terms of the accompanying license file.
+
+----------------------------------------------------------------------------*/
+
+#if !defined(ADOLC_VEC_KERNELS_H)
+#define ADOLC_VEC_KERNELS_H 1
+
+#include <adolc/internal/common.h>
+
+BEGIN_C_DECLS
+/****************************************************************************/
+/* All kernels process n entries. Result and argument blocks may coincide,  */
+/* e.g. for x = sin(x), but must not overlap otherwise.                     */
+
+/* res = x + y */
+void vec_add(int n, const double *x, const double *y, double *res);
+/* res = x - y */
+void vec_sub(int n, const double *x, const double *y, double *res);
+/* res = a * x */
+void vec_scale(int n, double a, const double *x, double *res);
+/* res = a * x + b * y */
+void vec_lincomb(int n, double a, const double *x, double b, const double *y,
+                 double *res);
+/* res += a * x + b * y */
+void vec_add_lincomb(int n, double a, const double *x, double b,
+                     const double *y, double *res);
+
+/* arg += a * res, res = 0 */
+void vec_rev_push1(int n, revreal a, revreal *res, revreal *arg);
+/* arg1 += a1 * res, arg2 += a2 * res, res = 0 */
+void vec_rev_push2(int n, revreal a1, revreal a2, revreal *res, revreal *arg1,
+                   revreal *arg2);
+/* arg1 += a1 * res, arg2 += a2 * res */
+void vec_rev_add2(int n, revreal a1, revreal a2, const revreal *res,
+                  revreal *arg1, revreal *arg2);
+
+/****************************************************************************/
+/* Kernels of the bit pattern propagation of int_forward_* and              */
+/* int_reverse_*, the n entries are the words of the bit pattern strip.     */
+
+/* res = x | y */
+void vec_bit_or(int n, const unsigned long int *x, const unsigned long int *y,
+                unsigned long int *res);
+/* res |= x | y */
+void vec_bit_add_or(int n, const unsigned long int *x,
+                    const unsigned long int *y, unsigned long int *res);
+/* res = x */
+void vec_bit_copy(int n, const unsigned long int *x, unsigned long int *res);
+
+/* arg |= res, res = 0 */
+void vec_bit_push1(int n, unsigned long int *res, unsigned long int *arg);
+/* arg1 |= res, arg2 |= res, res = 0 */
+void vec_bit_push2(int n, unsigned long int *res, unsigned long int *arg1,
+                   unsigned long int *arg2);
+/* arg1 |= res, arg2 |= res */
+void vec_bit_add2(int n, const unsigned long int *res, unsigned long int *arg1,
+                  unsigned long int *arg2);
+
+END_C_DECLS
+
+/****************************************************************************/
+
+#endif /* ADOLC_VEC_KERNELS_H */